@@ -1,4 +1,4 @@
-/*                                                      v.2.3 - 30.Nov.2009
+/*                                                      v.2.4 - 16.Oct.2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -74,6 +74,12 @@ HISTORY:
 
    30 Nov 09   v2.3     round() function is now round_fx().
                         saturate() is not referencable from outside application
+
+   16 Oct 26   v2.4     With BASOP_INLINE only the globals and the operators
+                        not inlined in basop32.h (L_macNs, L_msuNs, L_add_c,
+                        L_sub_c, L_sat, div_s, div_l) are compiled here.
+                        Overflow and Carry are thread-local with
+                        BASOP_THREAD_SAFE.
   =============================================================================
 */
 
@@ -127,8 +133,8 @@ HISTORY:
 
 
 #if (WMOPS)
-extern BASIC_OP multiCounter[MAXCOUNTERS];
-extern int currCounter;
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+extern BASOP_TLS int currCounter;
 #endif
 
 
@@ -137,7 +143,9 @@ extern int currCounter;
  |   Local Functions                                                         |
  |___________________________________________________________________________|
 */
+#ifndef BASOP_INLINE
 static Word16 saturate (Word32 L_var1);
+#endif /* ifndef BASOP_INLINE */
 
 
 /*___________________________________________________________________________
@@ -145,8 +153,8 @@ static Word16 saturate (Word32 L_var1);
  |   Constants and Globals                                                   |
  |___________________________________________________________________________|
 */
-Flag Overflow = 0;
-Flag Carry = 0;
+BASOP_TLS Flag Overflow = 0;
+BASOP_TLS Flag Carry = 0;
 
 
 /*___________________________________________________________________________
@@ -155,6 +163,7 @@ Flag Carry = 0;
  |___________________________________________________________________________|
 */
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |                                                                           |
  |   Function Name : saturate                                                |
@@ -849,6 +858,7 @@ Word32 L_msu (Word32 L_var3, Word16 var1, Word16 var2) {
 #endif
   return (L_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*___________________________________________________________________________
@@ -966,6 +976,7 @@ Word32 L_msuNs (Word32 L_var3, Word16 var1, Word16 var2) {
 }
 
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |                                                                           |
  |   Function Name : L_add                                                   |
@@ -1062,6 +1073,7 @@ Word32 L_sub (Word32 L_var1, Word32 L_var2) {
 #endif
   return (L_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*___________________________________________________________________________
@@ -1240,6 +1252,7 @@ Word32 L_sub_c (Word32 L_var1, Word32 L_var2) {
 }
 
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |                                                                           |
  |   Function Name : L_negate                                                |
@@ -1833,6 +1846,7 @@ Word32 L_abs (Word32 L_var1) {
 #endif
   return (L_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*___________________________________________________________________________
@@ -1888,6 +1902,7 @@ Word32 L_sat (Word32 L_var1) {
 }
 
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |                                                                           |
  |   Function Name : norm_s                                                  |
@@ -1943,6 +1958,7 @@ Word16 norm_s (Word16 var1) {
 #endif
   return (var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*___________________________________________________________________________
@@ -2032,6 +2048,7 @@ Word16 div_s (Word16 var1, Word16 var2) {
 }
 
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |                                                                           |
  |   Function Name : norm_l                                                  |
@@ -2087,6 +2104,7 @@ Word16 norm_l (Word32 L_var1) {
 #endif
   return (var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 /*
  ******************************************************************************
@@ -2095,6 +2113,7 @@ Word16 norm_l (Word32 L_var1) {
  ******************************************************************************
 */
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |                                                                           |
  |   Function Name : L_mls                                                   |
@@ -2151,6 +2170,7 @@ Word32 L_mls (Word32 Lv, Word16 v) {
 
   return Temp;
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*__________________________________________________________________________
@@ -2245,6 +2265,7 @@ Word16 div_l (Word32 L_num, Word16 den) {
 }
 
 
+#ifndef BASOP_INLINE
 /*__________________________________________________________________________
 |                                                                           |
 |   Function Name : i_mult                                                  |
@@ -2286,6 +2307,7 @@ Word16 i_mult (Word16 a, Word16 b) {
   return saturate (c);
 #endif
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*
@@ -2296,6 +2318,7 @@ Word16 i_mult (Word16 a, Word16 b) {
  ******************************************************************************
 */
 
+#ifndef BASOP_INLINE
 /*___________________________________________________________________________
  |
  |   Function Name : L_mult0
@@ -2424,6 +2447,7 @@ Word32 L_msu0 (Word32 L_var3, Word16 var1, Word16 var2) {
 #endif
   return (L_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /* end of file */
@@ -1,6 +1,6 @@
 /*
   ===========================================================================
-   File: BASOP32.H                                       v.2.3 - 30.Nov.2009
+   File: BASOP32.H                                       v.2.4 - 16.Oct.2026
   ===========================================================================
 
             ITU-T STL  BASIC OPERATORS
@@ -37,6 +37,14 @@
 
    30 Nov 09   v2.3     round() function is now round_fx().
                         saturate() is not referencable from outside application
+
+   16 Oct 26   v2.4     Optional inline build (compile with BASOP_INLINE):
+                        the arithmetic operators become static __inline
+                        functions using compiler intrinsics where available.
+                        Bit-exact to the library operators, including the
+                        Overflow flag; no complexity counting in this mode.
+                        Thread-local Overflow and Carry flags when compiled
+                        with BASOP_THREAD_SAFE.
   ============================================================================
 */
 
@@ -51,8 +59,26 @@
  | $Id $
  |___________________________________________________________________________|
 */
-extern Flag Overflow;
-extern Flag Carry;
+/*
+ * With BASOP_THREAD_SAFE the Overflow and Carry flags and the complexity
+ * counters (count.c, control.c) are thread-local, so that several codec
+ * instances can run on separate threads; see WMOPS_merge_thread() in
+ * count.h for collecting the per-thread complexity figures.
+ */
+#ifdef BASOP_THREAD_SAFE
+#if defined(_MSC_VER)
+#define BASOP_TLS __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define BASOP_TLS _Thread_local
+#else /* if defined(_MSC_VER) */
+#define BASOP_TLS __thread
+#endif /* if defined(_MSC_VER) */
+#else /* ifdef BASOP_THREAD_SAFE */
+#define BASOP_TLS
+#endif /* ifdef BASOP_THREAD_SAFE */
+
+extern BASOP_TLS Flag Overflow;
+extern BASOP_TLS Flag Carry;
 
 #define MAX_32 (Word32)0x7fffffffL
 #define MIN_32 (Word32)0x80000000L
@@ -60,62 +86,389 @@ extern Flag Carry;
 #define MAX_16 (Word16)0x7fff
 #define MIN_16 (Word16)0x8000
 
+/*
+ * With BASOP_INLINE the arithmetic operators are defined at the end of
+ * this file as static __inline functions instead of being linked from
+ * basop32.c. WMOPS counting is disabled in this mode (see count.h).
+ */
+#ifdef BASOP_INLINE
+#define BASOP_INL static __inline
+#else /* ifdef BASOP_INLINE */
+#define BASOP_INL
+#endif /* ifdef BASOP_INLINE */
+
 /*___________________________________________________________________________
  |                                                                           |
  |   Prototypes for basic arithmetic operators                               |
  |___________________________________________________________________________|
 */
 
-Word16 add (Word16 var1, Word16 var2);  /* Short add, 1 */
-Word16 sub (Word16 var1, Word16 var2);  /* Short sub, 1 */
-Word16 abs_s (Word16 var1);     /* Short abs, 1 */
-Word16 shl (Word16 var1, Word16 var2);  /* Short shift left, 1 */
-Word16 shr (Word16 var1, Word16 var2);  /* Short shift right, 1 */
-Word16 mult (Word16 var1, Word16 var2); /* Short mult, 1 */
-Word32 L_mult (Word16 var1, Word16 var2);       /* Long mult, 1 */
-Word16 negate (Word16 var1);    /* Short negate, 1 */
-Word16 extract_h (Word32 L_var1);       /* Extract high, 1 */
-Word16 extract_l (Word32 L_var1);       /* Extract low, 1 */
-Word16 round_fx (Word32 L_var1);        /* Round, 1 */
-Word32 L_mac (Word32 L_var3, Word16 var1, Word16 var2); /* Mac, 1 */
-Word32 L_msu (Word32 L_var3, Word16 var1, Word16 var2); /* Msu, 1 */
+BASOP_INL Word16 add (Word16 var1, Word16 var2);  /* Short add, 1 */
+BASOP_INL Word16 sub (Word16 var1, Word16 var2);  /* Short sub, 1 */
+BASOP_INL Word16 abs_s (Word16 var1);     /* Short abs, 1 */
+BASOP_INL Word16 shl (Word16 var1, Word16 var2);  /* Short shift left, 1 */
+BASOP_INL Word16 shr (Word16 var1, Word16 var2);  /* Short shift right, 1 */
+BASOP_INL Word16 mult (Word16 var1, Word16 var2); /* Short mult, 1 */
+BASOP_INL Word32 L_mult (Word16 var1, Word16 var2);       /* Long mult, 1 */
+BASOP_INL Word16 negate (Word16 var1);    /* Short negate, 1 */
+BASOP_INL Word16 extract_h (Word32 L_var1);       /* Extract high, 1 */
+BASOP_INL Word16 extract_l (Word32 L_var1);       /* Extract low, 1 */
+BASOP_INL Word16 round_fx (Word32 L_var1);        /* Round, 1 */
+BASOP_INL Word32 L_mac (Word32 L_var3, Word16 var1, Word16 var2); /* Mac, 1 */
+BASOP_INL Word32 L_msu (Word32 L_var3, Word16 var1, Word16 var2); /* Msu, 1 */
 Word32 L_macNs (Word32 L_var3, Word16 var1, Word16 var2);       /* Mac without sat, 1 */
 Word32 L_msuNs (Word32 L_var3, Word16 var1, Word16 var2);       /* Msu without sat, 1 */
-Word32 L_add (Word32 L_var1, Word32 L_var2);    /* Long add, 1 */
-Word32 L_sub (Word32 L_var1, Word32 L_var2);    /* Long sub, 1 */
+BASOP_INL Word32 L_add (Word32 L_var1, Word32 L_var2);    /* Long add, 1 */
+BASOP_INL Word32 L_sub (Word32 L_var1, Word32 L_var2);    /* Long sub, 1 */
 Word32 L_add_c (Word32 L_var1, Word32 L_var2);  /* Long add with c, 2 */
 Word32 L_sub_c (Word32 L_var1, Word32 L_var2);  /* Long sub with c, 2 */
-Word32 L_negate (Word32 L_var1);        /* Long negate, 1 */
-Word16 mult_r (Word16 var1, Word16 var2);       /* Mult with round, 1 */
-Word32 L_shl (Word32 L_var1, Word16 var2);      /* Long shift left, 1 */
-Word32 L_shr (Word32 L_var1, Word16 var2);      /* Long shift right, 1 */
-Word16 shr_r (Word16 var1, Word16 var2);        /* Shift right with round, 2 */
-Word16 mac_r (Word32 L_var3, Word16 var1, Word16 var2); /* Mac with rounding, 1 */
-Word16 msu_r (Word32 L_var3, Word16 var1, Word16 var2); /* Msu with rounding, 1 */
-Word32 L_deposit_h (Word16 var1);       /* 16 bit var1 -> MSB, 1 */
-Word32 L_deposit_l (Word16 var1);       /* 16 bit var1 -> LSB, 1 */
-
-Word32 L_shr_r (Word32 L_var1, Word16 var2);    /* Long shift right with round, 3 */
-Word32 L_abs (Word32 L_var1);   /* Long abs, 1 */
+BASOP_INL Word32 L_negate (Word32 L_var1);        /* Long negate, 1 */
+BASOP_INL Word16 mult_r (Word16 var1, Word16 var2);       /* Mult with round, 1 */
+BASOP_INL Word32 L_shl (Word32 L_var1, Word16 var2);      /* Long shift left, 1 */
+BASOP_INL Word32 L_shr (Word32 L_var1, Word16 var2);      /* Long shift right, 1 */
+BASOP_INL Word16 shr_r (Word16 var1, Word16 var2);        /* Shift right with round, 2 */
+BASOP_INL Word16 mac_r (Word32 L_var3, Word16 var1, Word16 var2); /* Mac with rounding, 1 */
+BASOP_INL Word16 msu_r (Word32 L_var3, Word16 var1, Word16 var2); /* Msu with rounding, 1 */
+BASOP_INL Word32 L_deposit_h (Word16 var1);       /* 16 bit var1 -> MSB, 1 */
+BASOP_INL Word32 L_deposit_l (Word16 var1);       /* 16 bit var1 -> LSB, 1 */
+
+BASOP_INL Word32 L_shr_r (Word32 L_var1, Word16 var2);    /* Long shift right with round, 3 */
+BASOP_INL Word32 L_abs (Word32 L_var1);   /* Long abs, 1 */
 Word32 L_sat (Word32 L_var1);   /* Long saturation, 4 */
-Word16 norm_s (Word16 var1);    /* Short norm, 1 */
+BASOP_INL Word16 norm_s (Word16 var1);    /* Short norm, 1 */
 Word16 div_s (Word16 var1, Word16 var2);        /* Short division, 18 */
-Word16 norm_l (Word32 L_var1);  /* Long norm, 1 */
+BASOP_INL Word16 norm_l (Word32 L_var1);  /* Long norm, 1 */
 
 
 /*
  * Additional G.723.1 operators
 */
-Word32 L_mls (Word32, Word16);  /* Weight FFS; currently assigned 5 */
+BASOP_INL Word32 L_mls (Word32, Word16);  /* Weight FFS; currently assigned 5 */
 Word16 div_l (Word32, Word16);  /* Weight FFS; currently assigned 32 */
-Word16 i_mult (Word16 a, Word16 b);     /* Weight FFS; currently assigned 3 */
+BASOP_INL Word16 i_mult (Word16 a, Word16 b);     /* Weight FFS; currently assigned 3 */
 
 /*
  *  New shiftless operators, not used in G.729/G.723.1
 */
-Word32 L_mult0 (Word16 v1, Word16 v2);  /* 32-bit Multiply w/o shift 1 */
-Word32 L_mac0 (Word32 L_v3, Word16 v1, Word16 v2);      /* 32-bit Mac w/o shift 1 */
-Word32 L_msu0 (Word32 L_v3, Word16 v1, Word16 v2);      /* 32-bit Msu w/o shift 1 */
+BASOP_INL Word32 L_mult0 (Word16 v1, Word16 v2);  /* 32-bit Multiply w/o shift 1 */
+BASOP_INL Word32 L_mac0 (Word32 L_v3, Word16 v1, Word16 v2);      /* 32-bit Mac w/o shift 1 */
+BASOP_INL Word32 L_msu0 (Word32 L_v3, Word16 v1, Word16 v2);      /* 32-bit Msu w/o shift 1 */
+
+
+/*___________________________________________________________________________
+ |                                                                           |
+ |   Inline definitions of the basic arithmetic operators (BASOP_INLINE)     |
+ |                                                                           |
+ |   Same results and same Overflow side effects as the functions in         |
+ |   basop32.c, which hold the reference description of each operator.       |
+ |   L_macNs(), L_msuNs(), L_add_c(), L_sub_c(), L_sat(), div_s() and        |
+ |   div_l() are always taken from basop32.c.                                |
+ |___________________________________________________________________________|
+*/
+#ifdef BASOP_INLINE
+
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))
+#define BASOP_BUILTINS          /* __builtin_*_overflow() and __builtin_clz() */
+#endif /* if defined(__GNUC__) */
+
+BASOP_INL Word16 add (Word16 var1, Word16 var2) {
+  Word32 L_sum = (Word32) var1 + var2;
+
+  if (L_sum != (Word16) L_sum) {
+    Overflow = 1;
+    return (L_sum > 0) ? MAX_16 : MIN_16;
+  }
+  return ((Word16) L_sum);
+}
+
+BASOP_INL Word16 sub (Word16 var1, Word16 var2) {
+  Word32 L_diff = (Word32) var1 - var2;
+
+  if (L_diff != (Word16) L_diff) {
+    Overflow = 1;
+    return (L_diff > 0) ? MAX_16 : MIN_16;
+  }
+  return ((Word16) L_diff);
+}
+
+BASOP_INL Word16 abs_s (Word16 var1) {
+  if (var1 == MIN_16)
+    return MAX_16;
+  return (var1 < 0) ? (Word16) - var1 : var1;
+}
+
+BASOP_INL Word16 shl (Word16 var1, Word16 var2) {
+  Word32 result;
+
+  if (var2 < 0) {
+    if (var2 < -16)
+      var2 = -16;
+    return shr (var1, (Word16) - var2);
+  }
+  if (var1 == 0)
+    return 0;
+  if (var2 > 15) {
+    Overflow = 1;
+    return (var1 > 0) ? MAX_16 : MIN_16;
+  }
+  result = (Word32) var1 *((Word32) 1 << var2);
+  if (result != (Word16) result) {
+    Overflow = 1;
+    return (var1 > 0) ? MAX_16 : MIN_16;
+  }
+  return ((Word16) result);
+}
+
+BASOP_INL Word16 shr (Word16 var1, Word16 var2) {
+  if (var2 < 0) {
+    if (var2 < -16)
+      var2 = -16;
+    return shl (var1, (Word16) - var2);
+  }
+  if (var2 >= 15)
+    return (var1 < 0) ? -1 : 0;
+  return (var1 < 0) ? (Word16) ~ ((~var1) >> var2) : (Word16) (var1 >> var2);
+}
+
+BASOP_INL Word16 mult (Word16 var1, Word16 var2) {
+  Word32 L_product = (Word32) var1 *(Word32) var2;
+
+  /* 0x8000 * 0x8000 is the only product that does not fit */
+  if (L_product == (Word32) 0x40000000L) {
+    Overflow = 1;
+    return MAX_16;
+  }
+  return ((Word16) (L_product >> 15));
+}
+
+BASOP_INL Word32 L_mult (Word16 var1, Word16 var2) {
+  Word32 L_var_out = (Word32) var1 *(Word32) var2;
+
+  if (L_var_out == (Word32) 0x40000000L) {
+    Overflow = 1;
+    return MAX_32;
+  }
+  return (L_var_out * 2);
+}
+
+BASOP_INL Word16 negate (Word16 var1) {
+  return (var1 == MIN_16) ? MAX_16 : (Word16) - var1;
+}
+
+BASOP_INL Word16 extract_h (Word32 L_var1) {
+  return ((Word16) (L_var1 >> 16));
+}
+
+BASOP_INL Word16 extract_l (Word32 L_var1) {
+  return ((Word16) L_var1);
+}
+
+BASOP_INL Word32 L_add (Word32 L_var1, Word32 L_var2) {
+  Word32 L_var_out;
+  int ovf;
+
+#ifdef BASOP_BUILTINS
+  ovf = __builtin_add_overflow (L_var1, L_var2, &L_var_out);
+#else /* ifdef BASOP_BUILTINS */
+  L_var_out = (Word32) ((UWord32) L_var1 + (UWord32) L_var2);
+  ovf = (((L_var1 ^ L_var_out) & (L_var2 ^ L_var_out)) & MIN_32) != 0;
+#endif /* ifdef BASOP_BUILTINS */
+  if (ovf) {
+    Overflow = 1;
+    L_var_out = (L_var1 < 0) ? MIN_32 : MAX_32;
+  }
+  return (L_var_out);
+}
+
+BASOP_INL Word32 L_sub (Word32 L_var1, Word32 L_var2) {
+  Word32 L_var_out;
+  int ovf;
+
+#ifdef BASOP_BUILTINS
+  ovf = __builtin_sub_overflow (L_var1, L_var2, &L_var_out);
+#else /* ifdef BASOP_BUILTINS */
+  L_var_out = (Word32) ((UWord32) L_var1 - (UWord32) L_var2);
+  ovf = (((L_var1 ^ L_var2) & (L_var1 ^ L_var_out)) & MIN_32) != 0;
+#endif /* ifdef BASOP_BUILTINS */
+  if (ovf) {
+    Overflow = 1;
+    L_var_out = (L_var1 < 0) ? MIN_32 : MAX_32;
+  }
+  return (L_var_out);
+}
+
+BASOP_INL Word16 round_fx (Word32 L_var1) {
+  return extract_h (L_add (L_var1, (Word32) 0x00008000L));
+}
+
+BASOP_INL Word32 L_mac (Word32 L_var3, Word16 var1, Word16 var2) {
+  return L_add (L_var3, L_mult (var1, var2));
+}
+
+BASOP_INL Word32 L_msu (Word32 L_var3, Word16 var1, Word16 var2) {
+  return L_sub (L_var3, L_mult (var1, var2));
+}
+
+BASOP_INL Word32 L_negate (Word32 L_var1) {
+  return (L_var1 == MIN_32) ? MAX_32 : -L_var1;
+}
+
+BASOP_INL Word16 mult_r (Word16 var1, Word16 var2) {
+  Word32 L_product_arr = ((Word32) var1 * (Word32) var2 + (Word32) 0x00004000L) >> 15;
+
+  /* only 0x8000 * 0x8000 rounds above MAX_16, nothing rounds below MIN_16 */
+  if (L_product_arr > MAX_16) {
+    Overflow = 1;
+    return MAX_16;
+  }
+  return ((Word16) L_product_arr);
+}
+
+BASOP_INL Word16 norm_s (Word16 var1) {
+  Word16 var_out;
+
+  if (var1 == 0)
+    return 0;
+  if (var1 == (Word16) 0xffff)
+    return 15;
+  if (var1 < 0)
+    var1 = ~var1;
+#ifdef BASOP_BUILTINS
+  var_out = (Word16) (__builtin_clz ((unsigned int) var1) - 17);
+#else /* ifdef BASOP_BUILTINS */
+  for (var_out = 0; var1 < 0x4000; var_out++) {
+    var1 <<= 1;
+  }
+#endif /* ifdef BASOP_BUILTINS */
+  return (var_out);
+}
+
+BASOP_INL Word16 norm_l (Word32 L_var1) {
+  Word16 var_out;
+
+  if (L_var1 == 0)
+    return 0;
+  if (L_var1 == (Word32) 0xffffffffL)
+    return 31;
+  if (L_var1 < 0)
+    L_var1 = ~L_var1;
+#ifdef BASOP_BUILTINS
+  var_out = (Word16) (__builtin_clz ((unsigned int) L_var1) - 1);
+#else /* ifdef BASOP_BUILTINS */
+  for (var_out = 0; L_var1 < (Word32) 0x40000000L; var_out++) {
+    L_var1 <<= 1;
+  }
+#endif /* ifdef BASOP_BUILTINS */
+  return (var_out);
+}
+
+BASOP_INL Word32 L_shl (Word32 L_var1, Word16 var2) {
+  if (var2 <= 0) {
+    if (var2 < -32)
+      var2 = -32;
+    return L_shr (L_var1, (Word16) - var2);
+  }
+  if (L_var1 == 0)
+    return 0;
+  /* norm_l() is the number of left shifts the loop in basop32.c accepts */
+  if (var2 > norm_l (L_var1)) {
+    Overflow = 1;
+    return (L_var1 < 0) ? MIN_32 : MAX_32;
+  }
+  return ((Word32) ((UWord32) L_var1 << var2));
+}
+
+BASOP_INL Word32 L_shr (Word32 L_var1, Word16 var2) {
+  if (var2 < 0) {
+    if (var2 < -32)
+      var2 = -32;
+    return L_shl (L_var1, (Word16) - var2);
+  }
+  if (var2 >= 31)
+    return (L_var1 < 0L) ? -1 : 0;
+  return (L_var1 < 0) ? ~((~L_var1) >> var2) : L_var1 >> var2;
+}
+
+BASOP_INL Word16 shr_r (Word16 var1, Word16 var2) {
+  Word16 var_out;
+
+  if (var2 > 15)
+    return 0;
+  var_out = shr (var1, var2);
+  if (var2 > 0 && (var1 & ((Word16) 1 << (var2 - 1))) != 0)
+    var_out++;
+  return (var_out);
+}
+
+BASOP_INL Word16 mac_r (Word32 L_var3, Word16 var1, Word16 var2) {
+  return extract_h (L_add (L_mac (L_var3, var1, var2), (Word32) 0x00008000L));
+}
+
+BASOP_INL Word16 msu_r (Word32 L_var3, Word16 var1, Word16 var2) {
+  return extract_h (L_add (L_msu (L_var3, var1, var2), (Word32) 0x00008000L));
+}
+
+BASOP_INL Word32 L_deposit_h (Word16 var1) {
+  return ((Word32) var1 << 16);
+}
+
+BASOP_INL Word32 L_deposit_l (Word16 var1) {
+  return ((Word32) var1);
+}
+
+BASOP_INL Word32 L_shr_r (Word32 L_var1, Word16 var2) {
+  Word32 L_var_out;
+
+  if (var2 > 31)
+    return 0;
+  L_var_out = L_shr (L_var1, var2);
+  if (var2 > 0 && (L_var1 & ((Word32) 1 << (var2 - 1))) != 0)
+    L_var_out++;
+  return (L_var_out);
+}
+
+BASOP_INL Word32 L_abs (Word32 L_var1) {
+  if (L_var1 == MIN_32)
+    return MAX_32;
+  return (L_var1 < 0) ? -L_var1 : L_var1;
+}
+
+BASOP_INL Word32 L_mls (Word32 Lv, Word16 v) {
+  Word32 Temp;
+
+  Temp = Lv & (Word32) 0x0000ffff;
+  Temp = Temp * (Word32) v;
+  Temp = L_shr (Temp, (Word16) 15);
+  return L_mac (Temp, v, extract_h (Lv));
+}
+
+BASOP_INL Word16 i_mult (Word16 a, Word16 b) {
+#ifdef ORIGINAL_G7231
+  return a * b;
+#else
+  Word32 c = (Word32) a *(Word32) b;
+
+  if (c != (Word16) c) {
+    Overflow = 1;
+    return (c > 0) ? MAX_16 : MIN_16;
+  }
+  return ((Word16) c);
+#endif
+}
+
+BASOP_INL Word32 L_mult0 (Word16 var1, Word16 var2) {
+  return ((Word32) var1 * (Word32) var2);
+}
+
+BASOP_INL Word32 L_mac0 (Word32 L_var3, Word16 var1, Word16 var2) {
+  return L_add (L_var3, L_mult0 (var1, var2));
+}
+
+BASOP_INL Word32 L_msu0 (Word32 L_var3, Word16 var1, Word16 var2) {
+  return L_sub (L_var3, L_mult0 (var1, var2));
+}
+
+#endif /* ifdef BASOP_INLINE */
 
 
 #endif /* ifndef _BASIC_OP_H */
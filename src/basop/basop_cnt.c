@@ -291,6 +291,18 @@ const char basops[][20] = {     /* all basicop commands */
   "Mpy_32_16_uu",
   "norm_ul",
   "UL_deposit_l",
+  /* vector basic operators */
+  "V_L_mac",
+  "V_add",
+  "V_sub",
+  "V_L_add",
+  "V_L_sub",
+  "V_shl",
+  "V_L_shl",
+  "V_max_abs",
+  "V_L_max_abs",
+  "V_norm",
+  "V_L_norm",
   /* new control code STL basic operators */
   "LT_16",
   "GT_16",
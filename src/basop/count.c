@@ -1,6 +1,6 @@
 /*
   ===========================================================================
-   File: COUNT.C                                         v.2.3 - 30.Nov.2009
+   File: COUNT.C                                         v.2.4 - 16.Oct.2026
   ===========================================================================
 
             ITU-T   STL   BASIC   OPERATORS
@@ -32,6 +32,12 @@
                         L_mls() weight of 5.
                         div_l() weight of 32.
                         i_mult() weight of 3.
+   Oct 26      v2.4     Thread-local counters with BASOP_THREAD_SAFE, and
+                        WMOPS_merge_thread() to add up the figures of
+                        several threads in the reports.
+                        Names and weights of the vector operators.
+                        With BASOP_THREAD_SAFE, the per-function worst-case
+                        table is allocated by each thread on first use.
   ============================================================================
 */
 
@@ -48,14 +54,22 @@
 #include <string.h>
 #include "stl.h"
 
+#if defined(WMOPS) && defined(BASOP_THREAD_SAFE)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif /* if defined(WMOPS) && defined(BASOP_THREAD_SAFE) */
+
 #ifdef WMOPS
 static double frameRate = FRAME_RATE;   /* default value : 10 ms */
 #endif /* ifdef WMOPS */
 
 #ifdef WMOPS
 /* Global counter variable for calculation of complexity weight */
-BASIC_OP multiCounter[MAXCOUNTERS];
-int currCounter = 0;            /* Zero equals global counter */
+BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+BASOP_TLS int currCounter = 0;  /* Zero equals global counter */
 #endif /* ifdef WMOPS */
 
 #ifdef WMOPS
@@ -170,6 +184,15 @@ char *BasicOperationList[] = {
   , "UL_deposit_l"  
 #endif /* #ifdef ENH_U_32_BIT_OPERATOR */
 
+#ifdef ENH_VEC_OPERATOR
+  , "V_L_mac"
+  , "V_add"           , "V_sub"
+  , "V_L_add"         , "V_L_sub"
+  , "V_shl"           , "V_L_shl"
+  , "V_max_abs"       , "V_L_max_abs"
+  , "V_norm"          , "V_L_norm"
+#endif /* #ifdef ENH_VEC_OPERATOR */
+
 #ifdef CONTROL_CODE_OPS
   , "LT_16"   
   , "GT_16"   
@@ -289,6 +312,16 @@ const BASIC_OP op_weight = {
   , 1
 #endif /* #ifdef ENH_U_32_BIT_OPERATOR */
 
+#ifdef ENH_VEC_OPERATOR
+  /* Weights per element of the vector basops */
+  , 1
+  , 1        , 1
+  , 1        , 1
+  , 1        , 1
+  , 2        , 2
+  , 2        , 2
+#endif /* #ifdef ENH_VEC_OPERATOR */
+
 #ifdef CONTROL_CODE_OPS
   , 1   
   , 1   
@@ -325,18 +358,88 @@ static int maxCounter = 0;
 static char *objectName[MAXCOUNTERS + 1];
 
 static Word16 fwc_corr[MAXCOUNTERS + 1];
-static long int nbTimeObjectIsCalled[MAXCOUNTERS + 1];
+static BASOP_TLS long int nbTimeObjectIsCalled[MAXCOUNTERS + 1];
 
 #define NbFuncMax  1024
 
-static Word16 funcid[MAXCOUNTERS], nbframe[MAXCOUNTERS];
-static Word32 glob_wc[MAXCOUNTERS], wc[MAXCOUNTERS][NbFuncMax];
-static float total_wmops[MAXCOUNTERS];
+static BASOP_TLS Word16 funcid[MAXCOUNTERS], nbframe[MAXCOUNTERS];
+static BASOP_TLS Word32 glob_wc[MAXCOUNTERS];
+static BASOP_TLS float total_wmops[MAXCOUNTERS];
+
+#ifdef BASOP_THREAD_SAFE
+/* Per-function worst cases (1 MB): allocated by each thread on first use,
+   released by WMOPS_merge_thread() */
+static BASOP_TLS Word32 (*wc)[NbFuncMax] = NULL;
 
-static Word32 LastWOper[MAXCOUNTERS];
+static void WMOPS_allocWC () {
+  if (wc == NULL && (wc = (Word32 (*)[NbFuncMax]) calloc (MAXCOUNTERS, sizeof (*wc))) == NULL) {
+    fprintf (stderr, "count: cannot allocate the WMOPS counters\n");
+    exit (1);
+  }
+}
+#else
+static Word32 wc[MAXCOUNTERS][NbFuncMax];
+#define WMOPS_allocWC()
+#endif /* ifdef BASOP_THREAD_SAFE */
+
+static BASOP_TLS Word32 LastWOper[MAXCOUNTERS];
 #endif /* ifdef WMOPS */
 
 
+#if defined(WMOPS) && defined(BASOP_THREAD_SAFE)
+/*
+ * Figures handed over by the threads calling WMOPS_merge_thread(). They
+ * are added to the counters of the thread printing the next report, with
+ * the rules a serial run would give: frames and WMOPS are summed, worst
+ * cases are maximised.
+ */
+typedef struct {
+  Word16 funcid, nbframe;
+  Word32 glob_wc, wc[NbFuncMax];
+  float total_wmops;
+  long int nbTimeObjectIsCalled;
+} MERGED_COUNTER;
+
+static MERGED_COUNTER merged[MAXCOUNTERS];
+static int merged_pending = 0;
+
+#if defined(_WIN32)
+static SRWLOCK merge_lock = SRWLOCK_INIT;
+#define merge_lock_acquire() AcquireSRWLockExclusive (&merge_lock)
+#define merge_lock_release() ReleaseSRWLockExclusive (&merge_lock)
+#else
+static pthread_mutex_t merge_lock = PTHREAD_MUTEX_INITIALIZER;
+#define merge_lock_acquire() pthread_mutex_lock (&merge_lock)
+#define merge_lock_release() pthread_mutex_unlock (&merge_lock)
+#endif
+
+/* Add the merged figures, if any, to the counters of the calling thread */
+static void WMOPS_collectMerged () {
+  int c, i;
+
+  WMOPS_allocWC ();
+  merge_lock_acquire ();
+  if (merged_pending) {
+    for (c = 0; c <= maxCounter; c++) {
+      for (i = 0; i < NbFuncMax; i++)
+        if (merged[c].wc[i] > wc[c][i])
+          wc[c][i] = merged[c].wc[i];
+      if (merged[c].funcid > funcid[c])
+        funcid[c] = merged[c].funcid;
+      if (merged[c].glob_wc > glob_wc[c])
+        glob_wc[c] = merged[c].glob_wc;
+      nbframe[c] += merged[c].nbframe;
+      total_wmops[c] += merged[c].total_wmops;
+      nbTimeObjectIsCalled[c] += merged[c].nbTimeObjectIsCalled;
+    }
+    memset (merged, 0, sizeof (merged));
+    merged_pending = 0;
+  }
+  merge_lock_release ();
+}
+#endif /* if defined(WMOPS) && defined(BASOP_THREAD_SAFE) */
+
+
 #ifdef WMOPS
 static char *my_strdup (const char *s) {
   /*
@@ -505,6 +608,7 @@ void Init_WMOPS_counter (void) {
 
   /* reset function weight operation counter variable */
 
+  WMOPS_allocWC ();
   for (i = 0; i < NbFuncMax; i++)
     wc[currCounter][i] = (Word32) 0;
   glob_wc[currCounter] = 0;
@@ -546,6 +650,7 @@ Word32 fwc (void) {
 #if WMOPS
   Word32 tot;
 
+  WMOPS_allocWC ();
   tot = DeltaWeightedOperation ();
   if (tot > wc[currCounter][funcid[currCounter]])
     wc[currCounter][funcid[currCounter]] = tot;
@@ -559,11 +664,60 @@ Word32 fwc (void) {
 #endif /* ifdef WMOPS */
 }
 
+void WMOPS_merge_thread (void) {
+#if defined(WMOPS) && defined(BASOP_THREAD_SAFE)
+  int saved_value, c, i;
+  Word32 tot;
+
+  saved_value = currCounter;
+  WMOPS_allocWC ();
+  merge_lock_acquire ();
+  for (c = 0; c <= maxCounter; c++) {
+    /* the frame in progress ends with the thread */
+    currCounter = c;
+    tot = TotalWeightedOperation ();
+    if (tot > glob_wc[c])
+      glob_wc[c] = tot;
+    total_wmops[c] += (float) (tot * frameRate);
+
+    for (i = 0; i < NbFuncMax; i++)
+      if (wc[c][i] > merged[c].wc[i])
+        merged[c].wc[i] = wc[c][i];
+    if (funcid[c] > merged[c].funcid)
+      merged[c].funcid = funcid[c];
+    if (glob_wc[c] > merged[c].glob_wc)
+      merged[c].glob_wc = glob_wc[c];
+    merged[c].nbframe += nbframe[c];
+    merged[c].total_wmops += total_wmops[c];
+    merged[c].nbTimeObjectIsCalled += nbTimeObjectIsCalled[c];
+  }
+  merged_pending = 1;
+  merge_lock_release ();
+
+  /* the figures now belong to the merged totals */
+  for (c = 0; c <= maxCounter; c++) {
+    currCounter = c;
+    Init_WMOPS_counter ();
+    nbTimeObjectIsCalled[c] = 0;
+  }
+  currCounter = saved_value;
+
+  /* allocated again if the thread goes on counting */
+  free (wc);
+  wc = NULL;
+#endif /* if defined(WMOPS) && defined(BASOP_THREAD_SAFE) */
+}
+
+
 void WMOPS_output (Word16 dtx_mode) {
 #if WMOPS
   Word16 i;
   Word32 tot, tot_wm, tot_wc;
 
+#ifdef BASOP_THREAD_SAFE
+  WMOPS_collectMerged ();
+#endif /* ifdef BASOP_THREAD_SAFE */
+
   /* get operations since last reset (or init), but do not update the counters (except the glob_wc[] maximum) 
      so output CAN be called in each frame without problems. The frame counter is NOT updated! */
   tot = WMOPS_frameStat ();
@@ -596,6 +750,10 @@ void WMOPS_output_avg (Word16 dtx_mode, Word32 * tot_wm, Word16 * num_frames) {
   Word16 i;
   Word32 tot, tot_wc;
 
+#ifdef BASOP_THREAD_SAFE
+  WMOPS_collectMerged ();
+#endif /* ifdef BASOP_THREAD_SAFE */
+
   /* get operations since last reset (or init), but do not update the counters (except the glob_wc[] maximum) 
      so output CAN be called in each frame without problems. The frame counter is NOT updated! */
   tot = WMOPS_frameStat ();
@@ -629,6 +787,9 @@ void generic_WMOPS_output (Word16 dtx_mode, char *test_file_name) {
   Word40 grand_total;
   FILE *WMOPS_file;
 
+#ifdef BASOP_THREAD_SAFE
+  WMOPS_collectMerged ();
+#endif /* ifdef BASOP_THREAD_SAFE */
   saved_value = currCounter;
 
   /* Count the grand_total WMOPS so that % ratio per function group can be displayed. */
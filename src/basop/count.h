@@ -1,6 +1,6 @@
 /*
   ===========================================================================
-   File: COUNT.H                                         v.2.3 - 30.Nov.2009
+   File: COUNT.H                                         v.2.4 - 16.Oct.2026
   ===========================================================================
 
             ITU-T         STL         BASIC       OPERATORS
@@ -27,6 +27,11 @@
                         L_mls() weight of 5.
                         div_l() weight of 32.
                         i_mult() weight of 3.
+   Oct 26      v2.4     WMOPS is not defined when BASOP_INLINE is defined;
+                        defining both is an error.
+                        Added WMOPS_merge_thread().
+                        Counters of the vector operators (ENH_VEC_OPERATOR),
+                        weighted per element.
   ============================================================================
 */
 
@@ -59,8 +64,14 @@
 
 #ifndef _COUNT_H
 #define _COUNT_H "$Id$"
+#ifdef BASOP_INLINE              /* inline basic operators are not counted */
+#ifdef WMOPS
+#error "WMOPS and BASOP_INLINE are mutually exclusive"
+#endif /* ifdef WMOPS */
+#else /* ifdef BASOP_INLINE */
 #define WMOPS 1                 /* enable WMOPS profiling features */
 // #undef WMOPS /* disable WMOPS profiling features */
+#endif /* ifdef BASOP_INLINE */
 
 #define MAXCOUNTERS (256)
 
@@ -154,6 +165,21 @@ void setFrameRate (int samplingFreq, int frameLength);
  * initialized by the FRAME_RATE constant.
  */
 
+void WMOPS_merge_thread (void);
+/*
+ * With BASOP_THREAD_SAFE, the counters are thread-local. A thread calls
+ * this function when it is done to hand its figures, for all counter
+ * groups, over to the next WMOPS_output(), WMOPS_output_avg() or
+ * generic_WMOPS_output() call of any thread; its frame in progress is
+ * closed and its own counters are cleared. Counter groups must be
+ * created with getCounterId() before the threads start, and each thread
+ * selects its group with setCounter(). The counters of a thread take
+ * about 110 kB of thread-local storage, plus 1 MB of per-function worst
+ * cases, allocated on first use and released by this function.
+ * Does nothing in other builds, where all threads share one set of
+ * counters.
+ */
+
 
 #define WMOPS_DATA_FILENAME "wmops_data.txt"
 /*
@@ -421,6 +447,20 @@ typedef struct {
   UWord32 UL_deposit_l;            /* Complexity Weight of 1 */
 #endif /* #ifdef ENH_U_32_BIT_OPERATOR */
 
+#ifdef ENH_VEC_OPERATOR
+  UWord32 V_L_mac;                 /* Complexity Weight of 1 per element */
+  UWord32 V_add;                   /* Complexity Weight of 1 per element */
+  UWord32 V_sub;                   /* Complexity Weight of 1 per element */
+  UWord32 V_L_add;                 /* Complexity Weight of 1 per element */
+  UWord32 V_L_sub;                 /* Complexity Weight of 1 per element */
+  UWord32 V_shl;                   /* Complexity Weight of 1 per element */
+  UWord32 V_L_shl;                 /* Complexity Weight of 1 per element */
+  UWord32 V_max_abs;               /* Complexity Weight of 2 per element */
+  UWord32 V_L_max_abs;             /* Complexity Weight of 2 per element */
+  UWord32 V_norm;                  /* Complexity Weight of 2 per element */
+  UWord32 V_L_norm;                /* Complexity Weight of 2 per element */
+#endif /* #ifdef ENH_VEC_OPERATOR */
+
 #ifdef CONTROL_CODE_OPS
   UWord32 LT_16;                   /* Complexity Weight of 1 */
   UWord32 GT_16;                   /* Complexity Weight of 1 */
@@ -1,6 +1,6 @@
 /*
   ===========================================================================
-   File: ENH40.C                                         v.2.3 - 30.Nov.2009
+   File: ENH40.C                                         v.2.4 - 16.Oct.2026
   ===========================================================================
 
             ITU-T  STL  BASIC OPERATORS
@@ -13,6 +13,8 @@
                         described in Geneva, 20-30 January 2004 WP 3/16 Q10/16
                         TD 11 document and subsequent discussions on the
                         wp3audio@yahoogroups.com email reflector.
+   16 Oct 26   v2.4     Operators defined inline in enh40.h are skipped
+                        when compiled with BASOP_INLINE.
 
   ============================================================================
 */
@@ -65,8 +67,8 @@
 #include "stl.h"
 
 #if (WMOPS)
-extern BASIC_OP multiCounter[MAXCOUNTERS];
-extern int currCounter;
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+extern BASOP_TLS int currCounter;
 #endif /* ifdef WMOPS */
 
 
@@ -167,6 +169,7 @@ Word40 L40_shl (Word40 L40_var1, Word16 var2) {
 }
 
 
+#ifndef BASOP_INLINE
 /*****************************************************************************
  *
  *  Function Name : L40_shr
@@ -562,6 +565,7 @@ Word32 L_saturate40 (Word40 L40_var1) {
 
   return (L_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*****************************************************************************
@@ -728,6 +732,7 @@ void Mpy_32_32_ss (Word32 L_var1, Word32 L_var2, Word32 * L_varout_h, UWord32 *
 }
 
 
+#ifndef BASOP_INLINE
 /*****************************************************************************
  *
  *  Function Name : L40_lshl
@@ -847,6 +852,7 @@ Word40 L40_lshr (Word40 L40_var1, Word16 var2) {
 
   return (L40_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /*****************************************************************************
@@ -921,6 +927,7 @@ Word16 norm_L40 (Word40 L40_var1) {
 
 
 
+#ifndef BASOP_INLINE
 /*****************************************************************************
  *
  *  Function Name : L40_shr_r
@@ -1040,6 +1047,7 @@ Word40 L40_shl_r (Word40 L40_var1, Word16 var2) {
 
   return (L40_var_out);
 }
+#endif /* ifndef BASOP_INLINE */
 
 
 /* end of file */
@@ -1,6 +1,6 @@
 /*
   ===========================================================================
-   File: ENH40.H                                         v.2.3 - 30.Nov.2009
+   File: ENH40.H                                         v.2.4 - 16.Oct.2026
   ===========================================================================
 
             ITU-T  STL  BASIC OPERATORS
@@ -14,6 +14,9 @@
                         TD 11 document and subsequent discussions on the
                         wp3audio@yahoogroups.com email reflector.
    March 06   v2.1      Changed to improve portability.
+   16 Oct 26  v2.4      Inline definitions of the enh40.c operators except
+                        L40_shl(), norm_L40() and Mpy_32_xx_ss() when
+                        compiled with BASOP_INLINE.
 
   ============================================================================
 */
@@ -25,10 +28,13 @@
 
 #include "stl.h"
 
+#ifdef BASOP_INLINE
+#include <stdlib.h>             /* exit() in L40_OVERFLOW_OCCURED() */
+#endif /* ifdef BASOP_INLINE */
 
 #ifdef WMOPS
-extern BASIC_OP multiCounter[MAXCOUNTERS];
-extern int currCounter;
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+extern BASOP_TLS int currCounter;
 #endif /* ifdef WMOPS */
 
 
@@ -61,10 +67,10 @@ extern int currCounter;
  *  Prototypes for enhanced 40 bit arithmetic operators
  *
  *****************************************************************************/
-Word40 L40_shr (Word40 L40_var1, Word16 var2);
-Word40 L40_shr_r (Word40 L40_var1, Word16 var2);
+BASOP_INL Word40 L40_shr (Word40 L40_var1, Word16 var2);
+BASOP_INL Word40 L40_shr_r (Word40 L40_var1, Word16 var2);
 Word40 L40_shl (Word40 L40_var1, Word16 var2);
-Word40 L40_shl_r (Word40 L40_var1, Word16 var2);
+BASOP_INL Word40 L40_shl_r (Word40 L40_var1, Word16 var2);
 
 static __inline Word40 L40_mult (Word16 var1, Word16 var2);
 
@@ -79,8 +85,8 @@ void Mpy_32_16_ss (Word32 L_var1, Word16 var2, Word32 * L_varout_h, UWord16 * va
 void Mpy_32_32_ss (Word32 L_var1, Word32 L_var2, Word32 * L_varout_h, UWord32 * L_varout_l);
 
 
-Word40 L40_lshl (Word40 L40_var1, Word16 var2);
-Word40 L40_lshr (Word40 L40_var1, Word16 var2);
+BASOP_INL Word40 L40_lshl (Word40 L40_var1, Word16 var2);
+BASOP_INL Word40 L40_lshr (Word40 L40_var1, Word16 var2);
 
 static __inline Word40 L40_set (Word40 L40_var1);
 static __inline UWord16 Extract40_H (Word40 L40_var1);
@@ -95,13 +101,13 @@ static __inline Word40 L40_round (Word40 L40_var1);
 static __inline Word16 round40 (Word40 L40_var1);
 
 
-Word40 L40_add (Word40 L40_var1, Word40 L40_var2);
-Word40 L40_sub (Word40 L40_var1, Word40 L40_var2);
-Word40 L40_abs (Word40 L40_var1);
-Word40 L40_negate (Word40 L40_var1);
-Word40 L40_max (Word40 L40_var1, Word40 L40_var2);
-Word40 L40_min (Word40 L40_var1, Word40 L40_var2);
-Word32 L_saturate40 (Word40 L40_var1);
+BASOP_INL Word40 L40_add (Word40 L40_var1, Word40 L40_var2);
+BASOP_INL Word40 L40_sub (Word40 L40_var1, Word40 L40_var2);
+BASOP_INL Word40 L40_abs (Word40 L40_var1);
+BASOP_INL Word40 L40_negate (Word40 L40_var1);
+BASOP_INL Word40 L40_max (Word40 L40_var1, Word40 L40_var2);
+BASOP_INL Word40 L40_min (Word40 L40_var1, Word40 L40_var2);
+BASOP_INL Word32 L_saturate40 (Word40 L40_var1);
 Word16 norm_L40 (Word40 L40_var1);
 
 
@@ -794,6 +800,112 @@ static __inline Word16 msu_r40 (Word40 L40_var1, Word16 var2, Word16 var3) {
 }
 
 
+/*****************************************************************************
+ *
+ *  Inline definitions (BASOP_INLINE) of operators otherwise taken from
+ *  enh40.c, which holds the reference description of each operator.
+ *  L40_shl(), Mpy_32_16_ss(), Mpy_32_32_ss() and norm_L40() are always
+ *  taken from enh40.c.
+ *
+ *****************************************************************************/
+#ifdef BASOP_INLINE
+
+BASOP_INL Word40 L40_shr (Word40 L40_var1, Word16 var2) {
+  if (var2 < 0)
+    return L40_shl (L40_var1, (Word16) - var2);
+  return (L40_var1 >> var2);
+}
+
+BASOP_INL Word40 L40_shr_r (Word40 L40_var1, Word16 var2) {
+  Word40 L40_var_out;
+
+  if (var2 > 39)
+    return 0;
+  L40_var_out = L40_shr (L40_var1, var2);
+  if (var2 > 0 && (L40_var1 & ((Word40) 1 << (var2 - 1))) != 0)
+    L40_var_out++;
+  return (L40_var_out);
+}
+
+BASOP_INL Word40 L40_shl_r (Word40 L40_var1, Word16 var2) {
+  if (var2 >= 0)
+    return L40_shl (L40_var1, var2);
+  return L40_shr_r (L40_var1, (Word16) - var2);
+}
+
+BASOP_INL Word40 L40_lshl (Word40 L40_var1, Word16 var2) {
+  if (var2 <= 0)
+    return L40_lshr (L40_var1, (Word16) - var2);
+  if (var2 >= 40)
+    return 0;
+  return L40_set (L40_var1 << var2);
+}
+
+BASOP_INL Word40 L40_lshr (Word40 L40_var1, Word16 var2) {
+  if (var2 < 0)
+    return L40_lshl (L40_var1, (Word16) - var2);
+  if (var2 >= 40)
+    return 0;
+  return ((L40_var1 & 0xffffffffff) >> var2);
+}
+
+BASOP_INL Word40 L40_add (Word40 L40_var1, Word40 L40_var2) {
+  Word40 L40_var_out = L40_var1 + L40_var2;
+
+  /* operands of equal bit 39 and a result of the other bit 39 */
+  if (((L40_var1 ^ L40_var_out) & (L40_var2 ^ L40_var_out) & 0x8000000000) != 0) {
+    if (L40_var1 & 0x8000000000)
+      L40_var_out = L40_UNDERFLOW_OCCURED (L40_var_out);
+    else
+      L40_var_out = L40_OVERFLOW_OCCURED (L40_var_out);
+  }
+  return (L40_var_out);
+}
+
+BASOP_INL Word40 L40_sub (Word40 L40_var1, Word40 L40_var2) {
+  Word40 L40_var_out = L40_var1 - L40_var2;
+
+  /* operands of different bit 39 and a result whose bit 39 differs from L40_var1 */
+  if (((L40_var1 ^ L40_var2) & (L40_var1 ^ L40_var_out) & 0x8000000000) != 0) {
+    if (L40_var1 & 0x8000000000)
+      L40_var_out = L40_UNDERFLOW_OCCURED (L40_var_out);
+    else
+      L40_var_out = L40_OVERFLOW_OCCURED (L40_var_out);
+  }
+  return (L40_var_out);
+}
+
+BASOP_INL Word40 L40_negate (Word40 L40_var1) {
+  return L40_add (~L40_var1, 0x01);
+}
+
+BASOP_INL Word40 L40_abs (Word40 L40_var1) {
+  return (L40_var1 < 0) ? L40_negate (L40_var1) : L40_var1;
+}
+
+BASOP_INL Word40 L40_max (Word40 L40_var1, Word40 L40_var2) {
+  return (L40_var1 < L40_var2) ? L40_var2 : L40_var1;
+}
+
+BASOP_INL Word40 L40_min (Word40 L40_var1, Word40 L40_var2) {
+  return (L40_var1 < L40_var2) ? L40_var1 : L40_var2;
+}
+
+BASOP_INL Word32 L_saturate40 (Word40 L40_var1) {
+  if (L40_var1 < -((Word40) 1 << 31)) {
+    L40_var1 = -((Word40) 1 << 31);
+    Overflow = 1;
+  }
+  if (L40_var1 > ((Word40) 1 << 31) - 1) {
+    L40_var1 = ((Word40) 1 << 31) - 1;
+    Overflow = 1;
+  }
+  return (Word32) L_Extract40 (L40_var1);
+}
+
+#endif /* ifdef BASOP_INLINE */
+
+
 
 
 
@@ -19,8 +19,8 @@
 #include "enh64.h"
 
 #if (WMOPS)
-extern BASIC_OP multiCounter[MAXCOUNTERS];
-extern int currCounter;
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+extern BASOP_TLS int currCounter;
 #endif /* if WMOPS */
 
 
@@ -43,7 +43,7 @@ extern int currCounter;
 *
 *****************************************************************************/
 
-#ifdef ENH_64_BIT_OPERATOR
+#if defined(ENH_64_BIT_OPERATOR) && !defined(BASOP_INLINE) /* else inline in enh64.h */
 
 
 /*___________________________________________________________________________
@@ -1660,6 +1660,6 @@ Word32 W_round64_L (Word64 L64_var1) {
   return (L_result);
 }
 
-#endif /* #ifdef ENH_64_BIT_OPERATOR */
+#endif /* if defined(ENH_64_BIT_OPERATOR) && !defined(BASOP_INLINE) */
 
 /* end of file */
@@ -21,50 +21,278 @@
  *
  *****************************************************************************/
 #ifdef ENH_64_BIT_OPERATOR
-Word64 W_add_nosat (Word64 L64_var1, Word64 L64_var2);
-Word64 W_sub_nosat (Word64 L64_var1, Word64 L64_var2);
-Word64 W_shl (Word64 L64_var1, Word16 var2);
-Word64 W_shr (Word64 L64_var1, Word16 var2);
-Word64 W_shl_nosat (Word64 L64_var1, Word16 var2);
-Word64 W_shr_nosat (Word64 L64_var1, Word16 var2);
-Word64 W_mult_32_16 (Word32 L_var1, Word16 var2);
-Word64 W_mac_32_16 (Word64  L64_acc, Word32 L_var1, Word16 var2);
-Word64 W_msu_32_16 (Word64  L64_acc, Word32 L_var1, Word16 var2);
-Word64 W_mult0_16_16 (Word16 var1, Word16 var2);
-Word64 W_mac0_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
-Word64 W_msu0_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
-Word64 W_mult_16_16 (Word16 var1, Word16 var2);
-Word64 W_mac_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
-Word64 W_msu_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
-
-Word64 W_deposit32_l (Word32 L_var1);
-Word64 W_deposit32_h (Word32 L_var1);
-
-Word32 W_sat_l (Word64 L64_var);
-Word32 W_sat_m (Word64 L64_var);
-Word32 W_shl_sat_l (Word64 L64_var, Word32 n);
-
-Word32 W_extract_l (Word64 L64_var1);
-Word32 W_extract_h (Word64 L64_var1);
-
-Word32 W_round48_L (Word64 L64_var1);
-Word16 W_round32_s (Word64 L64_var1);
-
-Word16 W_norm (Word64 L_var1);
-
-
-Word64 W_add (Word64 L64_var1, Word64 L64_var2);
-Word64 W_sub (Word64 L64_var1, Word64 L64_var2);
-Word64 W_neg (Word64 L64_var1);
-Word64 W_abs (Word64 L64_var1);
-Word64 W_mult_32_32 (Word32 L_var1, Word32 L_var2);
-Word64 W_mult0_32_32 (Word32 L_var1, Word32 L_var2);
-UWord64 W_lshl (UWord64 L64_var1, Word16 var2);
-UWord64 W_lshr (UWord64 L64_var1, Word16 var2);
-Word32 W_round64_L (Word64 L64_var1) ;
+BASOP_INL Word64 W_add_nosat (Word64 L64_var1, Word64 L64_var2);
+BASOP_INL Word64 W_sub_nosat (Word64 L64_var1, Word64 L64_var2);
+BASOP_INL Word64 W_shl (Word64 L64_var1, Word16 var2);
+BASOP_INL Word64 W_shr (Word64 L64_var1, Word16 var2);
+BASOP_INL Word64 W_shl_nosat (Word64 L64_var1, Word16 var2);
+BASOP_INL Word64 W_shr_nosat (Word64 L64_var1, Word16 var2);
+BASOP_INL Word64 W_mult_32_16 (Word32 L_var1, Word16 var2);
+BASOP_INL Word64 W_mac_32_16 (Word64  L64_acc, Word32 L_var1, Word16 var2);
+BASOP_INL Word64 W_msu_32_16 (Word64  L64_acc, Word32 L_var1, Word16 var2);
+BASOP_INL Word64 W_mult0_16_16 (Word16 var1, Word16 var2);
+BASOP_INL Word64 W_mac0_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
+BASOP_INL Word64 W_msu0_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
+BASOP_INL Word64 W_mult_16_16 (Word16 var1, Word16 var2);
+BASOP_INL Word64 W_mac_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
+BASOP_INL Word64 W_msu_16_16 (Word64  L64_acc, Word16 var1, Word16 var2);
+
+BASOP_INL Word64 W_deposit32_l (Word32 L_var1);
+BASOP_INL Word64 W_deposit32_h (Word32 L_var1);
+
+BASOP_INL Word32 W_sat_l (Word64 L64_var);
+BASOP_INL Word32 W_sat_m (Word64 L64_var);
+BASOP_INL Word32 W_shl_sat_l (Word64 L64_var, Word32 n);
+
+BASOP_INL Word32 W_extract_l (Word64 L64_var1);
+BASOP_INL Word32 W_extract_h (Word64 L64_var1);
+
+BASOP_INL Word32 W_round48_L (Word64 L64_var1);
+BASOP_INL Word16 W_round32_s (Word64 L64_var1);
+
+BASOP_INL Word16 W_norm (Word64 L_var1);
+
+
+BASOP_INL Word64 W_add (Word64 L64_var1, Word64 L64_var2);
+BASOP_INL Word64 W_sub (Word64 L64_var1, Word64 L64_var2);
+BASOP_INL Word64 W_neg (Word64 L64_var1);
+BASOP_INL Word64 W_abs (Word64 L64_var1);
+BASOP_INL Word64 W_mult_32_32 (Word32 L_var1, Word32 L_var2);
+BASOP_INL Word64 W_mult0_32_32 (Word32 L_var1, Word32 L_var2);
+BASOP_INL UWord64 W_lshl (UWord64 L64_var1, Word16 var2);
+BASOP_INL UWord64 W_lshr (UWord64 L64_var1, Word16 var2);
+BASOP_INL Word32 W_round64_L (Word64 L64_var1) ;
 
 #endif /* #ifdef ENH_64_BIT_OPERATOR */
 
+/*****************************************************************************
+ *
+ *  Inline definitions (BASOP_INLINE) of the enh64.c operators, which holds
+ *  the reference description of each operator.
+ *
+ *****************************************************************************/
+#if defined(ENH_64_BIT_OPERATOR) && defined(BASOP_INLINE)
+
+BASOP_INL Word64 W_add_nosat (Word64 L64_var1, Word64 L64_var2) {
+  return L64_var1 + L64_var2;
+}
+
+BASOP_INL Word64 W_sub_nosat (Word64 L64_var1, Word64 L64_var2) {
+  return L64_var1 - L64_var2;
+}
+
+BASOP_INL Word16 W_norm (Word64 L64_var1) {
+  Word16 var_out;
+
+  if (L64_var1 == 0)
+    return 0;
+  if (L64_var1 == (Word64) 0xffffffffffffffffLL)
+    return 63;
+  if (L64_var1 < 0)
+    L64_var1 = ~L64_var1;
+#ifdef BASOP_BUILTINS
+  var_out = (Word16) (__builtin_clzll ((UWord64) L64_var1) - 1);
+#else /* ifdef BASOP_BUILTINS */
+  for (var_out = 0; L64_var1 < (Word64) 0x4000000000000000LL; var_out++) {
+    L64_var1 <<= 1;
+  }
+#endif /* ifdef BASOP_BUILTINS */
+  return (var_out);
+}
+
+BASOP_INL Word64 W_shl (Word64 L64_var1, Word16 var2) {
+  if (var2 <= 0) {
+    if (var2 < -64)
+      var2 = -64;
+    return L64_var1 >> (-var2);
+  }
+  if (L64_var1 == 0)
+    return 0;
+  /* W_norm() is the number of left shifts the loop in enh64.c accepts */
+  if (var2 > W_norm (L64_var1)) {
+    Overflow = 1;
+    return (L64_var1 < 0) ? MIN_64 : MAX_64;
+  }
+  return (Word64) ((UWord64) L64_var1 << var2);
+}
+
+BASOP_INL Word64 W_shr (Word64 L64_var1, Word16 var2) {
+  if (var2 < 0)
+    return W_shl (L64_var1, (Word16) - var2);
+  return L64_var1 >> var2;
+}
+
+BASOP_INL Word64 W_shl_nosat (Word64 L64_var1, Word16 var2) {
+  if (var2 <= 0)
+    return L64_var1 >> (-var2);
+  return L64_var1 << var2;
+}
+
+BASOP_INL Word64 W_shr_nosat (Word64 L64_var1, Word16 var2) {
+  if (var2 < 0)
+    return L64_var1 << (-var2);
+  return L64_var1 >> var2;
+}
+
+BASOP_INL Word64 W_mult_32_16 (Word32 L_var1, Word16 var2) {
+  return ((Word64) L_var1 * var2) << 1;
+}
+
+BASOP_INL Word64 W_mac_32_16 (Word64 L64_acc, Word32 L_var1, Word16 var2) {
+  return L64_acc + (((Word64) L_var1 * var2) << 1);
+}
+
+BASOP_INL Word64 W_msu_32_16 (Word64 L64_acc, Word32 L_var1, Word16 var2) {
+  return L64_acc - (((Word64) L_var1 * var2) << 1);
+}
+
+BASOP_INL Word64 W_mult0_16_16 (Word16 var1, Word16 var2) {
+  return (Word64) var1 *var2;
+}
+
+BASOP_INL Word64 W_mac0_16_16 (Word64 L64_acc, Word16 var1, Word16 var2) {
+  return L64_acc + (Word64) var1 *var2;
+}
+
+BASOP_INL Word64 W_msu0_16_16 (Word64 L64_acc, Word16 var1, Word16 var2) {
+  return L64_acc - (Word64) var1 *var2;
+}
+
+BASOP_INL Word64 W_mult_16_16 (Word16 var1, Word16 var2) {
+  return ((Word64) var1 * var2) << 1;
+}
+
+BASOP_INL Word64 W_mac_16_16 (Word64 L64_acc, Word16 var1, Word16 var2) {
+  return L64_acc + (((Word64) var1 * var2) << 1);
+}
+
+BASOP_INL Word64 W_msu_16_16 (Word64 L64_acc, Word16 var1, Word16 var2) {
+  return L64_acc - (((Word64) var1 * var2) << 1);
+}
+
+BASOP_INL Word64 W_deposit32_l (Word32 L_var1) {
+  return (Word64) L_var1;
+}
+
+BASOP_INL Word64 W_deposit32_h (Word32 L_var1) {
+  return (Word64) L_var1 << 32;
+}
+
+BASOP_INL Word32 W_sat_l (Word64 L64_var) {
+  /* no Overflow flag, as in enh64.c */
+  if (L64_var > 0x7FFFFFFF)
+    return 0x7FFFFFFF;
+  if (L64_var < (int) 0x80000000)
+    return 0x80000000;
+  return (Word32) L64_var;
+}
+
+BASOP_INL Word32 W_sat_m (Word64 L64_var) {
+  return W_sat_l (L64_var >> 16);
+}
+
+BASOP_INL Word32 W_shl_sat_l (Word64 L64_var, Word32 n) {
+  return W_sat_l (W_shl (L64_var, n));
+}
+
+BASOP_INL Word32 W_extract_l (Word64 L64_var1) {
+  return (Word32) L64_var1;
+}
+
+BASOP_INL Word32 W_extract_h (Word64 L64_var1) {
+  return (Word32) (L64_var1 >> 32);
+}
+
+BASOP_INL Word64 W_add (Word64 L64_var1, Word64 L64_var2) {
+  Word64 L64_var_out;
+  int ovf;
+
+#ifdef BASOP_BUILTINS
+  ovf = __builtin_add_overflow (L64_var1, L64_var2, &L64_var_out);
+#else /* ifdef BASOP_BUILTINS */
+  L64_var_out = (Word64) ((UWord64) L64_var1 + (UWord64) L64_var2);
+  ovf = (((L64_var1 ^ L64_var_out) & (L64_var2 ^ L64_var_out)) & MIN_64) != 0;
+#endif /* ifdef BASOP_BUILTINS */
+  if (ovf) {
+    Overflow = 1;
+    L64_var_out = (L64_var1 < 0) ? MIN_64 : MAX_64;
+  }
+  return L64_var_out;
+}
+
+BASOP_INL Word64 W_sub (Word64 L64_var1, Word64 L64_var2) {
+  Word64 L64_var_out;
+  int ovf;
+
+#ifdef BASOP_BUILTINS
+  ovf = __builtin_sub_overflow (L64_var1, L64_var2, &L64_var_out);
+#else /* ifdef BASOP_BUILTINS */
+  L64_var_out = (Word64) ((UWord64) L64_var1 - (UWord64) L64_var2);
+  ovf = (((L64_var1 ^ L64_var2) & (L64_var1 ^ L64_var_out)) & MIN_64) != 0;
+#endif /* ifdef BASOP_BUILTINS */
+  if (ovf) {
+    Overflow = 1;
+    L64_var_out = (L64_var1 < 0) ? MIN_64 : MAX_64;
+  }
+  return L64_var_out;
+}
+
+BASOP_INL Word32 W_round48_L (Word64 L64_var1) {
+  /* W_add() with Overflow, on the saturated left shift by 16 */
+  return W_extract_h (W_add (W_shl (L64_var1, 16), 0x80000000));
+}
+
+BASOP_INL Word16 W_round32_s (Word64 L64_var1) {
+  return extract_h (W_extract_h (W_add (W_shl (L64_var1, 16), 0x800000000000LL)));
+}
+
+BASOP_INL Word64 W_neg (Word64 L64_var1) {
+  if (L64_var1 == MIN_64) {
+    Overflow = 1;
+    return MAX_64;
+  }
+  return -L64_var1;
+}
+
+BASOP_INL Word64 W_abs (Word64 L64_var1) {
+  if (L64_var1 == MIN_64) {
+    Overflow = 1;
+    return MAX_64;
+  }
+  return (L64_var1 < 0) ? -L64_var1 : L64_var1;
+}
+
+BASOP_INL Word64 W_mult_32_32 (Word32 L_var1, Word32 L_var2) {
+  if ((L_var1 == MIN_32) && (L_var2 == MIN_32)) {
+    Overflow = 1;
+    return MAX_64;
+  }
+  return ((Word64) L_var1 * L_var2) << 1;
+}
+
+BASOP_INL Word64 W_mult0_32_32 (Word32 L_var1, Word32 L_var2) {
+  return (Word64) L_var1 *L_var2;
+}
+
+BASOP_INL UWord64 W_lshl (UWord64 L64_var1, Word16 var2) {
+  if (var2 < 0)
+    return L64_var1 >> (-var2);
+  return L64_var1 << var2;
+}
+
+BASOP_INL UWord64 W_lshr (UWord64 L64_var1, Word16 var2) {
+  if (var2 < 0)
+    return L64_var1 << (-var2);
+  return L64_var1 >> var2;
+}
+
+BASOP_INL Word32 W_round64_L (Word64 L64_var1) {
+  return W_extract_h (W_add (L64_var1, 0x80000000));
+}
+
+#endif /* if defined(ENH_64_BIT_OPERATOR) && defined(BASOP_INLINE) */
+
+
 #endif /*_ENH64_H*/
 
 
@@ -1,11 +1,12 @@
 /*
   ============================================================================
-   File: ENHUL32.C                                       v.1.0 - 01.July.2018
+   File: ENHUL32.C                                       v.1.1 - 16.Oct.2026
   ============================================================================
 
             ENHANCED UNSIGNED 32-BIT ARITHMETIC OPERATORS
    History:
    v.0.5 - 21.March.2014
+   v.1.1 - 16.Oct.2026  Not compiled with BASOP_INLINE (inline in enhUL32.h).
  
   ============================================================================
 */
@@ -28,8 +29,8 @@
 #include "enhUL32.h"
 
 #if (WMOPS)
-extern BASIC_OP multiCounter[MAXCOUNTERS];
-extern int currCounter;
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+extern BASOP_TLS int currCounter;
 #endif /* if WMOPS */
 
 
@@ -45,7 +46,7 @@ extern int currCounter;
  *   Functions
  *
  *****************************************************************************/
-#ifdef ENH_U_32_BIT_OPERATOR
+#if defined(ENH_U_32_BIT_OPERATOR) && !defined(BASOP_INLINE) /* else inline in enhUL32.h */
 
 /*___________________________________________________________________________
  |                                                                           |
@@ -347,6 +348,6 @@ UWord32 UL_Mpy_32_32 (UWord32 UL_var1, UWord32 UL_var2) {
   return UL_varout_l;
 }
 
-#endif /* ENH_U_32_BIT_OPERATOR */
+#endif /* if defined(ENH_U_32_BIT_OPERATOR) && !defined(BASOP_INLINE) */
 
 /* end of file */
@@ -1,8 +1,11 @@
 /*
   ============================================================================
-   File: ENHUL32.H                                       v.1.0 - 01.July.2018
+   File: ENHUL32.H                                       v.1.1 - 16.Oct.2026
   ============================================================================
 
+   History:
+   v.1.1 - 16.Oct.2026  Inline definitions when compiled with BASOP_INLINE.
+
 
   ============================================================================
 */
@@ -23,8 +26,8 @@
 
 #if (WMOPS)
 #include "count.h"
-extern BASIC_OP multiCounter[MAXCOUNTERS];  /* existing signed counters are reused for unsigedn operators */
-extern int currCounter;
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];  /* existing signed counters are reused for unsigedn operators */
+extern BASOP_TLS int currCounter;
 #endif /* if WMOPS */
 
 /*****************************************************************************
@@ -33,17 +36,75 @@ extern int currCounter;
  *
  *****************************************************************************/
 #ifdef ENH_U_32_BIT_OPERATOR
-UWord32 UL_addNs (UWord32 a, UWord32 b, UWord16* wrap);
-UWord32 UL_subNs (UWord32 a, UWord32 b, UWord16* sgn);
+BASOP_INL UWord32 UL_addNs (UWord32 a, UWord32 b, UWord16* wrap);
+BASOP_INL UWord32 UL_subNs (UWord32 a, UWord32 b, UWord16* sgn);
 
-UWord32 UL_Mpy_32_32 (UWord32 a, UWord32 b);
-void Mpy_32_32_uu (UWord32 a, UWord32 b, UWord32 *c_h, UWord32 *c_l);    /* does not saturate */
-void Mpy_32_16_uu (UWord32 a, UWord16 b, UWord32 *c_h, UWord16 *c_l);    /* does not saturate */
+BASOP_INL UWord32 UL_Mpy_32_32 (UWord32 a, UWord32 b);
+BASOP_INL void Mpy_32_32_uu (UWord32 a, UWord32 b, UWord32 *c_h, UWord32 *c_l);    /* does not saturate */
+BASOP_INL void Mpy_32_16_uu (UWord32 a, UWord16 b, UWord32 *c_h, UWord16 *c_l);    /* does not saturate */
 
-Word16 norm_ul (UWord32 UL_var1);
-UWord32 UL_deposit_l (UWord16);             /* deposit low without sign extension */
+BASOP_INL Word16 norm_ul (UWord32 UL_var1);
+BASOP_INL UWord32 UL_deposit_l (UWord16);             /* deposit low without sign extension */
 #endif /* ENH_U_32_BIT_OPERATOR */
 
+/*****************************************************************************
+ *
+ *  Inline definitions (BASOP_INLINE) of the enhUL32.c operators
+ *
+ *****************************************************************************/
+#if defined(ENH_U_32_BIT_OPERATOR) && defined(BASOP_INLINE)
+
+BASOP_INL UWord32 UL_deposit_l (UWord16 uvar) {
+  return (UWord32) uvar;
+}
+
+BASOP_INL Word16 norm_ul (UWord32 UL_var1) {
+  Word16 var_out;
+
+  if (UL_var1 == 0)
+    return 0;
+#ifdef BASOP_BUILTINS
+  var_out = (Word16) __builtin_clz ((unsigned int) UL_var1);
+#else /* ifdef BASOP_BUILTINS */
+  for (var_out = 0; UL_var1 < (UWord32) 0x80000000U; var_out++) {
+    UL_var1 <<= 1;
+  }
+#endif /* ifdef BASOP_BUILTINS */
+  return (var_out);
+}
+
+BASOP_INL UWord32 UL_addNs (UWord32 UL_var1, UWord32 UL_var2, UWord16 * wrap) {
+  UWord32 UL_var3 = UL_var1 + UL_var2;
+
+  *wrap = (((UWord64) UL_var1 + (UWord64) UL_var2) > 0xFFFFFFFFU) ? 1 : 0;
+  return UL_var3;
+}
+
+BASOP_INL UWord32 UL_subNs (UWord32 UL_var1, UWord32 UL_var2, UWord16 * sgn) {
+  *sgn = (UL_var1 >= UL_var2) ? 0 : 1;
+  return UL_var1 - UL_var2;
+}
+
+BASOP_INL void Mpy_32_16_uu (UWord32 UL_var1, UWord16 uvar2, UWord32 * UL_varout_h, UWord16 * varout_l) {
+  UWord64 UL64_var1 = ((UWord64) UL_var1) * ((UWord64) uvar2);
+
+  *varout_l = (UWord16) UL64_var1;
+  *UL_varout_h = (UWord32) (UL64_var1 >> 16);
+}
+
+BASOP_INL void Mpy_32_32_uu (UWord32 UL_var1, UWord32 UL_var2, UWord32 * UL_varout_h, UWord32 * UL_varout_l) {
+  UWord64 UL64_var1 = ((UWord64) UL_var1) * ((UWord64) UL_var2);
+
+  *UL_varout_h = (UWord32) (UL64_var1 >> 32);
+  *UL_varout_l = (UWord32) (UL64_var1);
+}
+
+BASOP_INL UWord32 UL_Mpy_32_32 (UWord32 UL_var1, UWord32 UL_var2) {
+  return (UL_var1 * UL_var2) & 0xFFFFFFFFU;
+}
+
+#endif /* if defined(ENH_U_32_BIT_OPERATOR) && defined(BASOP_INLINE) */
+
 #endif /*_ENHUL32_H*/
 
 /* end of file */
@@ -0,0 +1,1090 @@
+/*****************************************************************************
+*
+*  Enhanced vector operators :
+*
+*    V_L_mac()
+*    V_add()
+*    V_sub()
+*    V_L_add()
+*    V_L_sub()
+*    V_shl()
+*    V_L_shl()
+*    V_max_abs()
+*    V_L_max_abs()
+*    V_norm()
+*    V_L_norm()
+*
+*  Each operator is bit-exact to a loop of basic operators, given as
+*  "Reference" in its description, including the Overflow flag: where the
+*  loop saturates, the vector operator saturates at the same element.
+*  The work is done by portable C kernels, or by SSE4.1 or AVX2 kernels
+*  on x86 (GCC/Clang) once selected with V_kernel().
+*
+*****************************************************************************/
+
+
+/*****************************************************************************
+*
+*  Include-Files
+*
+*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "enhvec.h"
+
+#ifdef ENH_VEC_OPERATOR
+
+/* SSE4.1 and AVX2 kernels, compiled with target attribute and selected at run time */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VEC_USE_X86
+#include <immintrin.h>
+#endif
+
+
+/*****************************************************************************
+*
+*  Local Functions
+*
+*****************************************************************************/
+
+/*
+ * Kernels. They work on any length and return non-zero when a result
+ * saturated, so that the caller sets Overflow; shift counts are within
+ * -15..15 (shl) and -31..31 (L_shl), negative for right shifts. dot()
+ * sums x[i]*y[i] (not doubled) and |x[i]*y[i]| over n samples, and
+ * returns non-zero if some x[i] = y[i] = MIN_16.
+ */
+typedef struct {
+  int (*dot) (const Word16 * x, const Word16 * y, int n, Word64 * L64_sum, Word64 * L64_mag);
+  int (*add) (const Word16 * x, const Word16 * y, Word16 * z, int n, int sub);
+  int (*L_add) (const Word32 * x, const Word32 * y, Word32 * z, int n, int sub);
+  int (*shl) (const Word16 * x, int shift, Word16 * y, int n);
+  int (*L_shl) (const Word32 * x, int shift, Word32 * y, int n);
+  void (*minmax) (const Word16 * x, int n, Word16 * var_min, Word16 * var_max);
+  void (*L_minmax) (const Word32 * x, int n, Word32 * L_min, Word32 * L_max);
+} VEC_KERNELS;
+
+
+/* L_mac() loop without complexity counting */
+static Word32 vec_L_mac_ref (Word32 L_var3, const Word16 * x, const Word16 * y, int n) {
+  Word32 L_product;
+  Word64 L64_sum;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    L_product = (Word32) x[i] * y[i];
+    if (L_product != (Word32) 0x40000000L) {
+      L_product *= 2;
+    } else {
+      Overflow = 1;
+      L_product = MAX_32;
+    }
+    L64_sum = (Word64) L_var3 + L_product;
+    if (L64_sum > MAX_32) {
+      Overflow = 1;
+      L_var3 = MAX_32;
+    } else if (L64_sum < MIN_32) {
+      Overflow = 1;
+      L_var3 = MIN_32;
+    } else {
+      L_var3 = (Word32) L64_sum;
+    }
+  }
+  return L_var3;
+}
+
+
+static int vec_dot_c (const Word16 * x, const Word16 * y, int n, Word64 * L64_sum, Word64 * L64_mag) {
+  Word32 L_product;
+  Word64 L64_s = 0, L64_m = 0;
+  int i, special = 0;
+
+  for (i = 0; i < n; i++) {
+    L_product = (Word32) x[i] * y[i];
+    special |= (L_product == (Word32) 0x40000000L);
+    L64_s += L_product;
+    L64_m += (L_product < 0) ? -L_product : L_product;
+  }
+  *L64_sum = L64_s;
+  *L64_mag = L64_m;
+  return special;
+}
+
+
+static int vec_add_c (const Word16 * x, const Word16 * y, Word16 * z, int n, int sub) {
+  Word32 L_sum;
+  int i, ovf = 0;
+
+  for (i = 0; i < n; i++) {
+    L_sum = sub ? (Word32) x[i] - y[i] : (Word32) x[i] + y[i];
+    if (L_sum > MAX_16) {
+      ovf = 1;
+      L_sum = MAX_16;
+    } else if (L_sum < MIN_16) {
+      ovf = 1;
+      L_sum = MIN_16;
+    }
+    z[i] = (Word16) L_sum;
+  }
+  return ovf;
+}
+
+
+static int vec_L_add_c (const Word32 * x, const Word32 * y, Word32 * z, int n, int sub) {
+  Word64 L64_sum;
+  int i, ovf = 0;
+
+  for (i = 0; i < n; i++) {
+    L64_sum = sub ? (Word64) x[i] - y[i] : (Word64) x[i] + y[i];
+    if (L64_sum > MAX_32) {
+      ovf = 1;
+      L64_sum = MAX_32;
+    } else if (L64_sum < MIN_32) {
+      ovf = 1;
+      L64_sum = MIN_32;
+    }
+    z[i] = (Word32) L64_sum;
+  }
+  return ovf;
+}
+
+
+static int vec_shl_c (const Word16 * x, int shift, Word16 * y, int n) {
+  Word32 L_var;
+  int i, ovf = 0;
+
+  for (i = 0; i < n; i++) {
+    if (shift < 0) {
+      y[i] = (x[i] < 0) ? ~((~x[i]) >> -shift) : x[i] >> -shift;
+    } else {
+      L_var = (Word32) x[i] * ((Word32) 1 << shift);
+      if (L_var != (Word32) ((Word16) L_var)) {
+        ovf = 1;
+        L_var = (x[i] > 0) ? MAX_16 : MIN_16;
+      }
+      y[i] = (Word16) L_var;
+    }
+  }
+  return ovf;
+}
+
+
+static int vec_L_shl_c (const Word32 * x, int shift, Word32 * y, int n) {
+  Word64 L64_var;
+  int i, ovf = 0;
+
+  for (i = 0; i < n; i++) {
+    if (shift < 0) {
+      y[i] = (x[i] < 0) ? ~((~x[i]) >> -shift) : x[i] >> -shift;
+    } else {
+      L64_var = (Word64) x[i] * ((Word64) 1 << shift);
+      if (L64_var > MAX_32) {
+        ovf = 1;
+        L64_var = MAX_32;
+      } else if (L64_var < MIN_32) {
+        ovf = 1;
+        L64_var = MIN_32;
+      }
+      y[i] = (Word32) L64_var;
+    }
+  }
+  return ovf;
+}
+
+
+static void vec_minmax_c (const Word16 * x, int n, Word16 * var_min, Word16 * var_max) {
+  Word16 vmin = MAX_16, vmax = MIN_16;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    if (x[i] < vmin)
+      vmin = x[i];
+    if (x[i] > vmax)
+      vmax = x[i];
+  }
+  *var_min = vmin;
+  *var_max = vmax;
+}
+
+
+static void vec_L_minmax_c (const Word32 * x, int n, Word32 * L_min, Word32 * L_max) {
+  Word32 L_vmin = MAX_32, L_vmax = MIN_32;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    if (x[i] < L_vmin)
+      L_vmin = x[i];
+    if (x[i] > L_vmax)
+      L_vmax = x[i];
+  }
+  *L_min = L_vmin;
+  *L_max = L_vmax;
+}
+
+
+static const VEC_KERNELS vec_kernels_c = {
+  vec_dot_c, vec_add_c, vec_L_add_c, vec_shl_c, vec_L_shl_c, vec_minmax_c, vec_L_minmax_c
+};
+
+
+#ifdef VEC_USE_X86
+
+/* ......... SSE4.1 kernels (8 x Word16, 4 x Word32) ......... */
+
+__attribute__ ((target ("sse4.1")))
+static int vec_dot_sse41 (const Word16 * x, const Word16 * y, int n, Word64 * L64_sum, Word64 * L64_mag) {
+  __m128i vx, vy, vp, vm, vlo, vhi, vsum, vmag, vspecial, vmin16;
+  Word64 L64_s[2], L64_m[2];
+  int i, special;
+
+  vsum = vmag = vspecial = _mm_setzero_si128 ();
+  vmin16 = _mm_set1_epi16 (MIN_16);
+  for (i = 0; i + 8 <= n; i += 8) {
+    vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+    vy = _mm_loadu_si128 ((const __m128i *) &y[i]);
+
+    /* pairwise sums of products; MIN_16*MIN_16 pairs wrap but are flagged */
+    vp = _mm_madd_epi16 (vx, vy);
+    vspecial = _mm_or_si128 (vspecial, _mm_and_si128 (_mm_cmpeq_epi16 (vx, vmin16), _mm_cmpeq_epi16 (vy, vmin16)));
+
+    /* |x|*|y| as unsigned 16x16 products (|MIN_16| is 0x8000), summed pairwise */
+    vx = _mm_abs_epi16 (vx);
+    vy = _mm_abs_epi16 (vy);
+    vlo = _mm_mullo_epi16 (vx, vy);
+    vhi = _mm_mulhi_epu16 (vx, vy);
+    vm = _mm_add_epi32 (_mm_unpacklo_epi16 (vlo, vhi), _mm_unpackhi_epi16 (vlo, vhi));
+
+    vsum = _mm_add_epi64 (vsum, _mm_cvtepi32_epi64 (vp));
+    vsum = _mm_add_epi64 (vsum, _mm_cvtepi32_epi64 (_mm_srli_si128 (vp, 8)));
+    vmag = _mm_add_epi64 (vmag, _mm_cvtepu32_epi64 (vm));
+    vmag = _mm_add_epi64 (vmag, _mm_cvtepu32_epi64 (_mm_srli_si128 (vm, 8)));
+  }
+  _mm_storeu_si128 ((__m128i *) L64_s, vsum);
+  _mm_storeu_si128 ((__m128i *) L64_m, vmag);
+
+  special = vec_dot_c (&x[i], &y[i], n - i, L64_sum, L64_mag);
+  *L64_sum += L64_s[0] + L64_s[1];
+  *L64_mag += L64_m[0] + L64_m[1];
+  return special | !_mm_testz_si128 (vspecial, vspecial);
+}
+
+
+__attribute__ ((target ("sse4.1")))
+static int vec_add_sse41 (const Word16 * x, const Word16 * y, Word16 * z, int n, int sub) {
+  __m128i vx, vy, vz, vovf;
+  int i;
+
+  vovf = _mm_setzero_si128 ();
+  for (i = 0; i + 8 <= n; i += 8) {
+    vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+    vy = _mm_loadu_si128 ((const __m128i *) &y[i]);
+    if (sub) {
+      vz = _mm_subs_epi16 (vx, vy);
+      vovf = _mm_or_si128 (vovf, _mm_xor_si128 (vz, _mm_sub_epi16 (vx, vy)));
+    } else {
+      vz = _mm_adds_epi16 (vx, vy);
+      vovf = _mm_or_si128 (vovf, _mm_xor_si128 (vz, _mm_add_epi16 (vx, vy)));
+    }
+    _mm_storeu_si128 ((__m128i *) &z[i], vz);
+  }
+  return vec_add_c (&x[i], &y[i], &z[i], n - i, sub) | !_mm_testz_si128 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("sse4.1")))
+static int vec_L_add_sse41 (const Word32 * x, const Word32 * y, Word32 * z, int n, int sub) {
+  __m128i vx, vy, vz, vsat, vmask, vovf, vmax32;
+  int i;
+
+  vovf = _mm_setzero_si128 ();
+  vmax32 = _mm_set1_epi32 (MAX_32);
+  for (i = 0; i + 4 <= n; i += 4) {
+    vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+    vy = _mm_loadu_si128 ((const __m128i *) &y[i]);
+    /* overflow when the result sign differs from x while y has the sign of x (add) or not (sub) */
+    if (sub) {
+      vz = _mm_sub_epi32 (vx, vy);
+      vmask = _mm_and_si128 (_mm_xor_si128 (vx, vy), _mm_xor_si128 (vx, vz));
+    } else {
+      vz = _mm_add_epi32 (vx, vy);
+      vmask = _mm_andnot_si128 (_mm_xor_si128 (vx, vy), _mm_xor_si128 (vx, vz));
+    }
+    vmask = _mm_srai_epi32 (vmask, 31);
+    vsat = _mm_xor_si128 (_mm_srai_epi32 (vx, 31), vmax32);
+    vz = _mm_blendv_epi8 (vz, vsat, vmask);
+    vovf = _mm_or_si128 (vovf, vmask);
+    _mm_storeu_si128 ((__m128i *) &z[i], vz);
+  }
+  return vec_L_add_c (&x[i], &y[i], &z[i], n - i, sub) | !_mm_testz_si128 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("sse4.1")))
+static int vec_shl_sse41 (const Word16 * x, int shift, Word16 * y, int n) {
+  __m128i vx, vy, vhi, vlo, vcnt, vlimit_hi, vlimit_lo, vovf, vmax16, vmin16;
+  int i;
+
+  vovf = _mm_setzero_si128 ();
+  if (shift < 0) {
+    vcnt = _mm_cvtsi32_si128 (-shift);
+    for (i = 0; i + 8 <= n; i += 8) {
+      vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+      _mm_storeu_si128 ((__m128i *) &y[i], _mm_sra_epi16 (vx, vcnt));
+    }
+  } else {
+    vcnt = _mm_cvtsi32_si128 (shift);
+    vlimit_hi = _mm_set1_epi16 ((Word16) (MAX_16 >> shift));
+    vlimit_lo = _mm_set1_epi16 ((Word16) ~(MAX_16 >> shift));
+    vmax16 = _mm_set1_epi16 (MAX_16);
+    vmin16 = _mm_set1_epi16 (MIN_16);
+    for (i = 0; i + 8 <= n; i += 8) {
+      vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+      vhi = _mm_cmpgt_epi16 (vx, vlimit_hi);
+      vlo = _mm_cmplt_epi16 (vx, vlimit_lo);
+      vy = _mm_sll_epi16 (vx, vcnt);
+      vy = _mm_blendv_epi8 (vy, vmax16, vhi);
+      vy = _mm_blendv_epi8 (vy, vmin16, vlo);
+      vovf = _mm_or_si128 (vovf, _mm_or_si128 (vhi, vlo));
+      _mm_storeu_si128 ((__m128i *) &y[i], vy);
+    }
+  }
+  return vec_shl_c (&x[i], shift, &y[i], n - i) | !_mm_testz_si128 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("sse4.1")))
+static int vec_L_shl_sse41 (const Word32 * x, int shift, Word32 * y, int n) {
+  __m128i vx, vy, vhi, vlo, vcnt, vlimit_hi, vlimit_lo, vovf, vmax32, vmin32;
+  int i;
+
+  vovf = _mm_setzero_si128 ();
+  if (shift < 0) {
+    vcnt = _mm_cvtsi32_si128 (-shift);
+    for (i = 0; i + 4 <= n; i += 4) {
+      vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+      _mm_storeu_si128 ((__m128i *) &y[i], _mm_sra_epi32 (vx, vcnt));
+    }
+  } else {
+    vcnt = _mm_cvtsi32_si128 (shift);
+    vlimit_hi = _mm_set1_epi32 (MAX_32 >> shift);
+    vlimit_lo = _mm_set1_epi32 (~(MAX_32 >> shift));
+    vmax32 = _mm_set1_epi32 (MAX_32);
+    vmin32 = _mm_set1_epi32 (MIN_32);
+    for (i = 0; i + 4 <= n; i += 4) {
+      vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+      vhi = _mm_cmpgt_epi32 (vx, vlimit_hi);
+      vlo = _mm_cmplt_epi32 (vx, vlimit_lo);
+      vy = _mm_sll_epi32 (vx, vcnt);
+      vy = _mm_blendv_epi8 (vy, vmax32, vhi);
+      vy = _mm_blendv_epi8 (vy, vmin32, vlo);
+      vovf = _mm_or_si128 (vovf, _mm_or_si128 (vhi, vlo));
+      _mm_storeu_si128 ((__m128i *) &y[i], vy);
+    }
+  }
+  return vec_L_shl_c (&x[i], shift, &y[i], n - i) | !_mm_testz_si128 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("sse4.1")))
+static void vec_minmax_sse41 (const Word16 * x, int n, Word16 * var_min, Word16 * var_max) {
+  __m128i vx, vmin, vmax;
+  Word16 lane_min[8], lane_max[8];
+  int i;
+
+  vmin = _mm_set1_epi16 (MAX_16);
+  vmax = _mm_set1_epi16 (MIN_16);
+  for (i = 0; i + 8 <= n; i += 8) {
+    vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+    vmin = _mm_min_epi16 (vmin, vx);
+    vmax = _mm_max_epi16 (vmax, vx);
+  }
+  _mm_storeu_si128 ((__m128i *) lane_min, vmin);
+  _mm_storeu_si128 ((__m128i *) lane_max, vmax);
+
+  vec_minmax_c (&x[i], n - i, var_min, var_max);
+  for (i = 0; i < 8; i++) {
+    if (lane_min[i] < *var_min)
+      *var_min = lane_min[i];
+    if (lane_max[i] > *var_max)
+      *var_max = lane_max[i];
+  }
+}
+
+
+__attribute__ ((target ("sse4.1")))
+static void vec_L_minmax_sse41 (const Word32 * x, int n, Word32 * L_min, Word32 * L_max) {
+  __m128i vx, vmin, vmax;
+  Word32 lane_min[4], lane_max[4];
+  int i;
+
+  vmin = _mm_set1_epi32 (MAX_32);
+  vmax = _mm_set1_epi32 (MIN_32);
+  for (i = 0; i + 4 <= n; i += 4) {
+    vx = _mm_loadu_si128 ((const __m128i *) &x[i]);
+    vmin = _mm_min_epi32 (vmin, vx);
+    vmax = _mm_max_epi32 (vmax, vx);
+  }
+  _mm_storeu_si128 ((__m128i *) lane_min, vmin);
+  _mm_storeu_si128 ((__m128i *) lane_max, vmax);
+
+  vec_L_minmax_c (&x[i], n - i, L_min, L_max);
+  for (i = 0; i < 4; i++) {
+    if (lane_min[i] < *L_min)
+      *L_min = lane_min[i];
+    if (lane_max[i] > *L_max)
+      *L_max = lane_max[i];
+  }
+}
+
+
+static const VEC_KERNELS vec_kernels_sse41 = {
+  vec_dot_sse41, vec_add_sse41, vec_L_add_sse41, vec_shl_sse41, vec_L_shl_sse41, vec_minmax_sse41, vec_L_minmax_sse41
+};
+
+
+/* ......... AVX2 kernels (16 x Word16, 8 x Word32), same scheme ......... */
+
+__attribute__ ((target ("avx2")))
+static int vec_dot_avx2 (const Word16 * x, const Word16 * y, int n, Word64 * L64_sum, Word64 * L64_mag) {
+  __m256i vx, vy, vp, vm, vlo, vhi, vsum, vmag, vspecial, vmin16;
+  Word64 L64_s[4], L64_m[4];
+  int i, special;
+
+  vsum = vmag = vspecial = _mm256_setzero_si256 ();
+  vmin16 = _mm256_set1_epi16 (MIN_16);
+  for (i = 0; i + 16 <= n; i += 16) {
+    vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+    vy = _mm256_loadu_si256 ((const __m256i *) &y[i]);
+
+    vp = _mm256_madd_epi16 (vx, vy);
+    vspecial = _mm256_or_si256 (vspecial, _mm256_and_si256 (_mm256_cmpeq_epi16 (vx, vmin16), _mm256_cmpeq_epi16 (vy, vmin16)));
+
+    vx = _mm256_abs_epi16 (vx);
+    vy = _mm256_abs_epi16 (vy);
+    vlo = _mm256_mullo_epi16 (vx, vy);
+    vhi = _mm256_mulhi_epu16 (vx, vy);
+    vm = _mm256_add_epi32 (_mm256_unpacklo_epi16 (vlo, vhi), _mm256_unpackhi_epi16 (vlo, vhi));
+
+    vsum = _mm256_add_epi64 (vsum, _mm256_cvtepi32_epi64 (_mm256_castsi256_si128 (vp)));
+    vsum = _mm256_add_epi64 (vsum, _mm256_cvtepi32_epi64 (_mm256_extracti128_si256 (vp, 1)));
+    vmag = _mm256_add_epi64 (vmag, _mm256_cvtepu32_epi64 (_mm256_castsi256_si128 (vm)));
+    vmag = _mm256_add_epi64 (vmag, _mm256_cvtepu32_epi64 (_mm256_extracti128_si256 (vm, 1)));
+  }
+  _mm256_storeu_si256 ((__m256i *) L64_s, vsum);
+  _mm256_storeu_si256 ((__m256i *) L64_m, vmag);
+
+  special = vec_dot_c (&x[i], &y[i], n - i, L64_sum, L64_mag);
+  *L64_sum += L64_s[0] + L64_s[1] + L64_s[2] + L64_s[3];
+  *L64_mag += L64_m[0] + L64_m[1] + L64_m[2] + L64_m[3];
+  return special | !_mm256_testz_si256 (vspecial, vspecial);
+}
+
+
+__attribute__ ((target ("avx2")))
+static int vec_add_avx2 (const Word16 * x, const Word16 * y, Word16 * z, int n, int sub) {
+  __m256i vx, vy, vz, vovf;
+  int i;
+
+  vovf = _mm256_setzero_si256 ();
+  for (i = 0; i + 16 <= n; i += 16) {
+    vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+    vy = _mm256_loadu_si256 ((const __m256i *) &y[i]);
+    if (sub) {
+      vz = _mm256_subs_epi16 (vx, vy);
+      vovf = _mm256_or_si256 (vovf, _mm256_xor_si256 (vz, _mm256_sub_epi16 (vx, vy)));
+    } else {
+      vz = _mm256_adds_epi16 (vx, vy);
+      vovf = _mm256_or_si256 (vovf, _mm256_xor_si256 (vz, _mm256_add_epi16 (vx, vy)));
+    }
+    _mm256_storeu_si256 ((__m256i *) &z[i], vz);
+  }
+  return vec_add_c (&x[i], &y[i], &z[i], n - i, sub) | !_mm256_testz_si256 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("avx2")))
+static int vec_L_add_avx2 (const Word32 * x, const Word32 * y, Word32 * z, int n, int sub) {
+  __m256i vx, vy, vz, vsat, vmask, vovf, vmax32;
+  int i;
+
+  vovf = _mm256_setzero_si256 ();
+  vmax32 = _mm256_set1_epi32 (MAX_32);
+  for (i = 0; i + 8 <= n; i += 8) {
+    vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+    vy = _mm256_loadu_si256 ((const __m256i *) &y[i]);
+    if (sub) {
+      vz = _mm256_sub_epi32 (vx, vy);
+      vmask = _mm256_and_si256 (_mm256_xor_si256 (vx, vy), _mm256_xor_si256 (vx, vz));
+    } else {
+      vz = _mm256_add_epi32 (vx, vy);
+      vmask = _mm256_andnot_si256 (_mm256_xor_si256 (vx, vy), _mm256_xor_si256 (vx, vz));
+    }
+    vmask = _mm256_srai_epi32 (vmask, 31);
+    vsat = _mm256_xor_si256 (_mm256_srai_epi32 (vx, 31), vmax32);
+    vz = _mm256_blendv_epi8 (vz, vsat, vmask);
+    vovf = _mm256_or_si256 (vovf, vmask);
+    _mm256_storeu_si256 ((__m256i *) &z[i], vz);
+  }
+  return vec_L_add_c (&x[i], &y[i], &z[i], n - i, sub) | !_mm256_testz_si256 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("avx2")))
+static int vec_shl_avx2 (const Word16 * x, int shift, Word16 * y, int n) {
+  __m256i vx, vy, vhi, vlo, vlimit_hi, vlimit_lo, vovf, vmax16, vmin16;
+  __m128i vcnt;
+  int i;
+
+  vovf = _mm256_setzero_si256 ();
+  if (shift < 0) {
+    vcnt = _mm_cvtsi32_si128 (-shift);
+    for (i = 0; i + 16 <= n; i += 16) {
+      vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+      _mm256_storeu_si256 ((__m256i *) &y[i], _mm256_sra_epi16 (vx, vcnt));
+    }
+  } else {
+    vcnt = _mm_cvtsi32_si128 (shift);
+    vlimit_hi = _mm256_set1_epi16 ((Word16) (MAX_16 >> shift));
+    vlimit_lo = _mm256_set1_epi16 ((Word16) ~(MAX_16 >> shift));
+    vmax16 = _mm256_set1_epi16 (MAX_16);
+    vmin16 = _mm256_set1_epi16 (MIN_16);
+    for (i = 0; i + 16 <= n; i += 16) {
+      vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+      vhi = _mm256_cmpgt_epi16 (vx, vlimit_hi);
+      vlo = _mm256_cmpgt_epi16 (vlimit_lo, vx);
+      vy = _mm256_sll_epi16 (vx, vcnt);
+      vy = _mm256_blendv_epi8 (vy, vmax16, vhi);
+      vy = _mm256_blendv_epi8 (vy, vmin16, vlo);
+      vovf = _mm256_or_si256 (vovf, _mm256_or_si256 (vhi, vlo));
+      _mm256_storeu_si256 ((__m256i *) &y[i], vy);
+    }
+  }
+  return vec_shl_c (&x[i], shift, &y[i], n - i) | !_mm256_testz_si256 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("avx2")))
+static int vec_L_shl_avx2 (const Word32 * x, int shift, Word32 * y, int n) {
+  __m256i vx, vy, vhi, vlo, vlimit_hi, vlimit_lo, vovf, vmax32, vmin32;
+  __m128i vcnt;
+  int i;
+
+  vovf = _mm256_setzero_si256 ();
+  if (shift < 0) {
+    vcnt = _mm_cvtsi32_si128 (-shift);
+    for (i = 0; i + 8 <= n; i += 8) {
+      vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+      _mm256_storeu_si256 ((__m256i *) &y[i], _mm256_sra_epi32 (vx, vcnt));
+    }
+  } else {
+    vcnt = _mm_cvtsi32_si128 (shift);
+    vlimit_hi = _mm256_set1_epi32 (MAX_32 >> shift);
+    vlimit_lo = _mm256_set1_epi32 (~(MAX_32 >> shift));
+    vmax32 = _mm256_set1_epi32 (MAX_32);
+    vmin32 = _mm256_set1_epi32 (MIN_32);
+    for (i = 0; i + 8 <= n; i += 8) {
+      vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+      vhi = _mm256_cmpgt_epi32 (vx, vlimit_hi);
+      vlo = _mm256_cmpgt_epi32 (vlimit_lo, vx);
+      vy = _mm256_sll_epi32 (vx, vcnt);
+      vy = _mm256_blendv_epi8 (vy, vmax32, vhi);
+      vy = _mm256_blendv_epi8 (vy, vmin32, vlo);
+      vovf = _mm256_or_si256 (vovf, _mm256_or_si256 (vhi, vlo));
+      _mm256_storeu_si256 ((__m256i *) &y[i], vy);
+    }
+  }
+  return vec_L_shl_c (&x[i], shift, &y[i], n - i) | !_mm256_testz_si256 (vovf, vovf);
+}
+
+
+__attribute__ ((target ("avx2")))
+static void vec_minmax_avx2 (const Word16 * x, int n, Word16 * var_min, Word16 * var_max) {
+  __m256i vx, vmin, vmax;
+  Word16 lane_min[16], lane_max[16];
+  int i;
+
+  vmin = _mm256_set1_epi16 (MAX_16);
+  vmax = _mm256_set1_epi16 (MIN_16);
+  for (i = 0; i + 16 <= n; i += 16) {
+    vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+    vmin = _mm256_min_epi16 (vmin, vx);
+    vmax = _mm256_max_epi16 (vmax, vx);
+  }
+  _mm256_storeu_si256 ((__m256i *) lane_min, vmin);
+  _mm256_storeu_si256 ((__m256i *) lane_max, vmax);
+
+  vec_minmax_c (&x[i], n - i, var_min, var_max);
+  for (i = 0; i < 16; i++) {
+    if (lane_min[i] < *var_min)
+      *var_min = lane_min[i];
+    if (lane_max[i] > *var_max)
+      *var_max = lane_max[i];
+  }
+}
+
+
+__attribute__ ((target ("avx2")))
+static void vec_L_minmax_avx2 (const Word32 * x, int n, Word32 * L_min, Word32 * L_max) {
+  __m256i vx, vmin, vmax;
+  Word32 lane_min[8], lane_max[8];
+  int i;
+
+  vmin = _mm256_set1_epi32 (MAX_32);
+  vmax = _mm256_set1_epi32 (MIN_32);
+  for (i = 0; i + 8 <= n; i += 8) {
+    vx = _mm256_loadu_si256 ((const __m256i *) &x[i]);
+    vmin = _mm256_min_epi32 (vmin, vx);
+    vmax = _mm256_max_epi32 (vmax, vx);
+  }
+  _mm256_storeu_si256 ((__m256i *) lane_min, vmin);
+  _mm256_storeu_si256 ((__m256i *) lane_max, vmax);
+
+  vec_L_minmax_c (&x[i], n - i, L_min, L_max);
+  for (i = 0; i < 8; i++) {
+    if (lane_min[i] < *L_min)
+      *L_min = lane_min[i];
+    if (lane_max[i] > *L_max)
+      *L_max = lane_max[i];
+  }
+}
+
+
+static const VEC_KERNELS vec_kernels_avx2 = {
+  vec_dot_avx2, vec_add_avx2, vec_L_add_avx2, vec_shl_avx2, vec_L_shl_avx2, vec_minmax_avx2, vec_L_minmax_avx2
+};
+
+#endif /* ifdef VEC_USE_X86 */
+
+
+/*****************************************************************************
+*
+*  Constants and Globals
+*
+*****************************************************************************/
+
+/* Largest and smallest number of samples V_L_mac() sums before checking the accumulator range */
+#define VEC_CHUNK_MAX  256
+#define VEC_CHUNK_MIN  16
+
+/* Kernels in use; set statically to the portable ones, so that the operators may be called concurrently */
+static const VEC_KERNELS *vec_kernels = &vec_kernels_c;
+
+
+/*****************************************************************************
+*
+*  Functions
+*
+*****************************************************************************/
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Name : V_kernel                                                |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   Selects the kernels used by the vector operators: VEC_KERNEL_AUTO, or   |
+|   VEC_KERNEL_PORTABLE, VEC_KERNEL_SSE41, VEC_KERNEL_AVX2, the latter two  |
+|   limited to what the CPU supports. All kernels give the same results.    |
+|   The portable kernels are used until this function is called; the        |
+|   selection is process-wide and should be done before any thread starts   |
+|   using the operators.                                                    |
+|   Not a basic operator: no complexity is counted.                         |
+|                                                                           |
+|   Return Value :                                                          |
+|                                                                           |
+|    The kernel selected.                                                   |
+|___________________________________________________________________________|
+*/
+Word16 V_kernel (Word16 mode) {
+  Word16 supported = VEC_KERNEL_PORTABLE;
+
+#ifdef VEC_USE_X86
+  if (__builtin_cpu_supports ("avx2"))
+    supported = VEC_KERNEL_AVX2;
+  else if (__builtin_cpu_supports ("sse4.1"))
+    supported = VEC_KERNEL_SSE41;
+#endif /* ifdef VEC_USE_X86 */
+
+  if (mode < VEC_KERNEL_PORTABLE || mode > supported)
+    mode = supported;
+
+  switch (mode) {
+#ifdef VEC_USE_X86
+  case VEC_KERNEL_AVX2:
+    vec_kernels = &vec_kernels_avx2;
+    break;
+  case VEC_KERNEL_SSE41:
+    vec_kernels = &vec_kernels_sse41;
+    break;
+#endif /* ifdef VEC_USE_X86 */
+  default:
+    vec_kernels = &vec_kernels_c;
+    break;
+  }
+  return mode;
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Name : V_L_mac                                                 |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   Dot product of x[] and y[] accumulated on L_var3 with saturation after  |
+|   each product, as by a chain of L_mac() operators:                       |
+|                                                                           |
+|   Reference :                                                             |
+|     for (i = 0; i < len; i++) L_var3 = L_mac (L_var3, x[i], y[i]);        |
+|                                                                           |
+|   Chunks of samples are summed exactly in 64 bits when the accumulator   |
+|   plus the sum of the absolute products cannot reach the saturation      |
+|   bounds; otherwise smaller chunks are tried, down to VEC_CHUNK_MIN       |
+|   samples, which are then accumulated sample by sample. The result of     |
+|   mac_r() as last operator of the chain is round_fx (V_L_mac (...)).      |
+|                                                                           |
+|   Complexity weight : 1 per element                                       |
+|___________________________________________________________________________|
+*/
+Word32 V_L_mac (Word32 L_var3, const Word16 x[], const Word16 y[], Word16 len) {
+  const VEC_KERNELS *kern = vec_kernels;
+  Word64 L64_sum, L64_mag, L64_abs;
+  int i, n, chunk, special;
+
+  chunk = VEC_CHUNK_MAX;
+  for (i = 0; i < len; i += n) {
+    n = (len - i < chunk) ? len - i : chunk;
+    special = kern->dot (&x[i], &y[i], n, &L64_sum, &L64_mag);
+    L64_abs = (L_var3 < 0) ? -(Word64) L_var3 : L_var3;
+
+    if (!special && L64_abs + 2 * L64_mag <= MAX_32) {
+      /* no partial sum of the chain can saturate */
+      L_var3 = (Word32) (L_var3 + 2 * L64_sum);
+      if (chunk < VEC_CHUNK_MAX)
+        chunk *= 2;
+    } else if (n <= VEC_CHUNK_MIN) {
+      L_var3 = vec_L_mac_ref (L_var3, &x[i], &y[i], n);
+    } else {
+      /* retry the same samples with a smaller chunk */
+      chunk = n / 2;
+      n = 0;
+    }
+  }
+
+#if (WMOPS)
+  if (len > 0)
+    multiCounter[currCounter].V_L_mac += len;
+#endif /* if WMOPS */
+  return L_var3;
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Names : V_add, V_sub                                           |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   16 bits addition / subtraction of two vectors with saturation. z[] may  |
+|   be x[] or y[].                                                          |
+|                                                                           |
+|   Reference :                                                             |
+|     for (i = 0; i < len; i++) z[i] = add (x[i], y[i]);   (resp. sub)      |
+|                                                                           |
+|   Complexity weight : 1 per element                                       |
+|___________________________________________________________________________|
+*/
+void V_add (const Word16 x[], const Word16 y[], Word16 z[], Word16 len) {
+  if (len > 0) {
+    if (vec_kernels->add (x, y, z, len, 0))
+      Overflow = 1;
+#if (WMOPS)
+    multiCounter[currCounter].V_add += len;
+#endif /* if WMOPS */
+  }
+}
+
+void V_sub (const Word16 x[], const Word16 y[], Word16 z[], Word16 len) {
+  if (len > 0) {
+    if (vec_kernels->add (x, y, z, len, 1))
+      Overflow = 1;
+#if (WMOPS)
+    multiCounter[currCounter].V_sub += len;
+#endif /* if WMOPS */
+  }
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Names : V_L_add, V_L_sub                                       |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   32 bits addition / subtraction of two vectors with saturation. z[] may  |
+|   be x[] or y[].                                                          |
+|                                                                           |
+|   Reference :                                                             |
+|     for (i = 0; i < len; i++) z[i] = L_add (x[i], y[i]); (resp. L_sub)    |
+|                                                                           |
+|   Complexity weight : 1 per element                                       |
+|___________________________________________________________________________|
+*/
+void V_L_add (const Word32 x[], const Word32 y[], Word32 z[], Word16 len) {
+  if (len > 0) {
+    if (vec_kernels->L_add (x, y, z, len, 0))
+      Overflow = 1;
+#if (WMOPS)
+    multiCounter[currCounter].V_L_add += len;
+#endif /* if WMOPS */
+  }
+}
+
+void V_L_sub (const Word32 x[], const Word32 y[], Word32 z[], Word16 len) {
+  if (len > 0) {
+    if (vec_kernels->L_add (x, y, z, len, 1))
+      Overflow = 1;
+#if (WMOPS)
+    multiCounter[currCounter].V_L_sub += len;
+#endif /* if WMOPS */
+  }
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Name : V_shl                                                   |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   Block scaling: arithmetic shift of the 16 bits vector x[] by var2       |
+|   positions, left with saturation or right (var2 < 0) with sign          |
+|   extension. y[] may be x[].                                              |
+|                                                                           |
+|   Reference :                                                             |
+|     for (i = 0; i < len; i++) y[i] = shl (x[i], var2);                    |
+|                                                                           |
+|   Complexity weight : 1 per element                                       |
+|___________________________________________________________________________|
+*/
+void V_shl (const Word16 x[], Word16 var2, Word16 y[], Word16 len) {
+  Word16 i;
+  int ovf = 0;
+
+  if (len <= 0)
+    return;
+
+  if (var2 > 15) {
+    /* every non-zero sample saturates */
+    for (i = 0; i < len; i++) {
+      if (x[i] != 0) {
+        ovf = 1;
+        y[i] = (x[i] > 0) ? MAX_16 : MIN_16;
+      } else {
+        y[i] = 0;
+      }
+    }
+  } else {
+    /* shr() by 15 or more gives the sign */
+    ovf = vec_kernels->shl (x, (var2 < -15) ? -15 : var2, y, len);
+  }
+  if (ovf)
+    Overflow = 1;
+
+#if (WMOPS)
+  multiCounter[currCounter].V_shl += len;
+#endif /* if WMOPS */
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Name : V_L_shl                                                 |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   Block scaling of the 32 bits vector x[], as V_shl(). y[] may be x[].    |
+|                                                                           |
+|   Reference :                                                             |
+|     for (i = 0; i < len; i++) y[i] = L_shl (x[i], var2);                  |
+|                                                                           |
+|   Complexity weight : 1 per element                                       |
+|___________________________________________________________________________|
+*/
+void V_L_shl (const Word32 x[], Word16 var2, Word32 y[], Word16 len) {
+  Word16 i;
+  int ovf = 0;
+
+  if (len <= 0)
+    return;
+
+  if (var2 > 31) {
+    /* every non-zero sample saturates */
+    for (i = 0; i < len; i++) {
+      if (x[i] != 0) {
+        ovf = 1;
+        y[i] = (x[i] > 0) ? MAX_32 : MIN_32;
+      } else {
+        y[i] = 0;
+      }
+    }
+  } else {
+    /* L_shr() by 31 or more gives the sign */
+    ovf = vec_kernels->L_shl (x, (var2 < -31) ? -31 : var2, y, len);
+  }
+  if (ovf)
+    Overflow = 1;
+
+#if (WMOPS)
+  multiCounter[currCounter].V_L_shl += len;
+#endif /* if WMOPS */
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Names : V_max_abs, V_L_max_abs                                 |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   Largest absolute value of a 16 / 32 bits vector, 0 if len <= 0.         |
+|                                                                           |
+|   Reference :                                                             |
+|     var_out = 0;                                                          |
+|     for (i = 0; i < len; i++) var_out = s_max (var_out, abs_s (x[i]));    |
+|     (resp. L_max() and L_abs())                                           |
+|                                                                           |
+|   Complexity weight : 2 per element                                       |
+|___________________________________________________________________________|
+*/
+Word16 V_max_abs (const Word16 x[], Word16 len) {
+  Word16 var_min, var_max, var_out = 0;
+
+  if (len > 0) {
+    vec_kernels->minmax (x, len, &var_min, &var_max);
+    var_out = (var_min == MIN_16) ? MAX_16 : (Word16) ((var_min < 0) ? -var_min : var_min);
+    if (var_max > var_out)
+      var_out = var_max;
+#if (WMOPS)
+    multiCounter[currCounter].V_max_abs += len;
+#endif /* if WMOPS */
+  }
+  return var_out;
+}
+
+Word32 V_L_max_abs (const Word32 x[], Word16 len) {
+  Word32 L_min, L_max, L_var_out = 0;
+
+  if (len > 0) {
+    vec_kernels->L_minmax (x, len, &L_min, &L_max);
+    L_var_out = (L_min == MIN_32) ? MAX_32 : ((L_min < 0) ? -L_min : L_min);
+    if (L_max > L_var_out)
+      L_var_out = L_max;
+#if (WMOPS)
+    multiCounter[currCounter].V_L_max_abs += len;
+#endif /* if WMOPS */
+  }
+  return L_var_out;
+}
+
+
+/*
+ * norm_s() / norm_l() of a non-zero value, without counting the operator:
+ * V_norm() and V_L_norm() are counted per element instead.
+ */
+static Word16 vec_norm_s (Word16 var1) {
+  Word16 var_out;
+
+  if (var1 == (Word16) 0xffff)
+    return 15;
+  if (var1 < 0)
+    var1 = ~var1;
+  for (var_out = 0; var1 < 0x4000; var_out++)
+    var1 <<= 1;
+  return var_out;
+}
+
+static Word16 vec_norm_l (Word32 L_var1) {
+  Word16 var_out;
+
+  if (L_var1 == (Word32) 0xffffffffL)
+    return 31;
+  if (L_var1 < 0)
+    L_var1 = ~L_var1;
+  for (var_out = 0; L_var1 < (Word32) 0x40000000L; var_out++)
+    L_var1 <<= 1;
+  return var_out;
+}
+
+
+/*___________________________________________________________________________
+|                                                                           |
+|   Function Names : V_norm, V_L_norm                                       |
+|                                                                           |
+|   Purpose :                                                               |
+|                                                                           |
+|   Headroom of a 16 / 32 bits vector: the largest left shift that does not |
+|   saturate any element, 15 (resp. 31) for an all-zero vector.             |
+|                                                                           |
+|   Reference :                                                             |
+|     var_out = 15;                                                         |
+|     for (i = 0; i < len; i++)                                             |
+|       if (x[i] != 0) var_out = s_min (var_out, norm_s (x[i]));            |
+|     (resp. 31, norm_l())                                                  |
+|                                                                           |
+|   norm_s() is non-increasing with the value for positive inputs and       |
+|   non-decreasing for negative ones, so only the extreme values of the     |
+|   vector are normalized.                                                  |
+|                                                                           |
+|   Complexity weight : 2 per element                                       |
+|___________________________________________________________________________|
+*/
+Word16 V_norm (const Word16 x[], Word16 len) {
+  Word16 var_min, var_max, var_norm, var_out = 15;
+
+  if (len > 0) {
+    vec_kernels->minmax (x, len, &var_min, &var_max);
+    if (var_max > 0) {
+      var_norm = vec_norm_s (var_max);
+      if (var_norm < var_out)
+        var_out = var_norm;
+    }
+    if (var_min < 0) {
+      var_norm = vec_norm_s (var_min);
+      if (var_norm < var_out)
+        var_out = var_norm;
+    }
+#if (WMOPS)
+    multiCounter[currCounter].V_norm += len;
+#endif /* if WMOPS */
+  }
+  return var_out;
+}
+
+Word16 V_L_norm (const Word32 x[], Word16 len) {
+  Word32 L_min, L_max;
+  Word16 var_norm, var_out = 31;
+
+  if (len > 0) {
+    vec_kernels->L_minmax (x, len, &L_min, &L_max);
+    if (L_max > 0) {
+      var_norm = vec_norm_l (L_max);
+      if (var_norm < var_out)
+        var_out = var_norm;
+    }
+    if (L_min < 0) {
+      var_norm = vec_norm_l (L_min);
+      if (var_norm < var_out)
+        var_out = var_norm;
+    }
+#if (WMOPS)
+    multiCounter[currCounter].V_L_norm += len;
+#endif /* if WMOPS */
+  }
+  return var_out;
+}
+
+#endif /* #ifdef ENH_VEC_OPERATOR */
+
+
+/* end of file */
@@ -0,0 +1,84 @@
+/*
+  ===========================================================================
+   File: ENHVEC.H                                        v.1.1 - 17.Oct.2026
+  ===========================================================================
+
+            ITU-T  STL  BASIC OPERATORS
+
+            ENHANCED VECTOR OPERATORS
+
+   History:
+   16 Oct 26  v1.0      Vector operators bit-exact to loops of basic
+                        operators, with SSE4.1/AVX2 kernels on x86.
+   17 Oct 26  v1.1      Portable kernels by default, SIMD kernels selected
+                        with V_kernel().
+
+  ============================================================================
+*/
+
+
+#ifndef _ENHVEC_H
+#define _ENHVEC_H
+
+
+/*****************************************************************************
+ *
+ *  Constants and Globals
+ *
+ *****************************************************************************/
+#include "stl.h"
+
+#ifndef Word64
+#define Word64 long long int
+#endif
+
+#if (WMOPS)
+#include "count.h"
+extern BASOP_TLS BASIC_OP multiCounter[MAXCOUNTERS];
+extern BASOP_TLS int currCounter;
+#endif /* if WMOPS */
+
+/*****************************************************************************
+ *
+ *  Kernel selection for the vector operators (V_kernel())
+ *
+ *****************************************************************************/
+#define VEC_KERNEL_AUTO      -1 /* best kernel supported by the CPU */
+#define VEC_KERNEL_PORTABLE   0 /* C code, any platform */
+#define VEC_KERNEL_SSE41      1 /* SSE4.1, x86 with GCC/Clang */
+#define VEC_KERNEL_AVX2       2 /* AVX2, x86 with GCC/Clang */
+
+ /*****************************************************************************
+ *
+ *  Prototypes for enhanced vector operators
+ *
+ *  Each operator returns the same result, and sets the Overflow flag in
+ *  the same way, as the loop of basic operators given as its reference
+ *  in enhvec.c; the complexity weight is counted per element.
+ *
+ *****************************************************************************/
+#ifdef ENH_VEC_OPERATOR
+
+Word32 V_L_mac (Word32 L_var3, const Word16 x[], const Word16 y[], Word16 len);
+
+void V_add (const Word16 x[], const Word16 y[], Word16 z[], Word16 len);
+void V_sub (const Word16 x[], const Word16 y[], Word16 z[], Word16 len);
+void V_L_add (const Word32 x[], const Word32 y[], Word32 z[], Word16 len);
+void V_L_sub (const Word32 x[], const Word32 y[], Word32 z[], Word16 len);
+
+void V_shl (const Word16 x[], Word16 var2, Word16 y[], Word16 len);
+void V_L_shl (const Word32 x[], Word16 var2, Word32 y[], Word16 len);
+
+Word16 V_max_abs (const Word16 x[], Word16 len);
+Word32 V_L_max_abs (const Word32 x[], Word16 len);
+Word16 V_norm (const Word16 x[], Word16 len);
+Word16 V_L_norm (const Word32 x[], Word16 len);
+
+Word16 V_kernel (Word16 mode);
+
+#endif /* #ifdef ENH_VEC_OPERATOR */
+
+#endif /*_ENHVEC_H*/
+
+
+/* end of file */
@@ -14,6 +14,7 @@
                         TD 11 document and subsequent discussions on the
                         wp3audio@yahoogroups.com email reflector.
    March 06   v2.1      Changed to improve portability.                        
+   Oct 26     v2.4      Vector operators enhvec.h (ENH_VEC_OPERATOR).
 
   ============================================================================
 */
@@ -47,6 +48,10 @@
 #include "enhUL32.h"
 #endif
 
+#ifdef ENH_VEC_OPERATOR
+#include "enhvec.h"
+#endif
+
 #endif /* ifndef _STL_H */
 
 
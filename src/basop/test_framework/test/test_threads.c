@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <string.h>
+#include "stl.h"
+
+/*
+ * Thread test (BASOP_THREAD_SAFE builds only): the same streams are
+ * processed one after the other and then each in its own thread. Results,
+ * Overflow flags and the WMOPS totals merged with WMOPS_merge_thread()
+ * must be identical in both runs.
+ */
+
+#ifdef BASOP_THREAD_SAFE
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define THR_NB_STREAMS    4
+#define THR_NB_FRAMES     200
+#define THR_FRAME_LEN     80
+
+typedef struct {
+  int stream;
+  int counterId;
+  Word32 checksum;
+} THR_TASK;
+
+
+/* One frame of a toy fixed-point filter, saturating often */
+static Word32 thr_frame (int stream, int frame, Word16 * mem) {
+  Word16 i, x, y;
+  Word32 L_acc, sum = 0;
+
+  Overflow = 0;
+  for (i = 0; i < THR_FRAME_LEN; i++) {
+    x = (Word16) (((stream + 1) * 7919 * (frame * THR_FRAME_LEN + i + 1)) & 0xffff);
+    L_acc = L_mult (x, 24576);
+    L_acc = L_mac (L_acc, *mem, 29491);
+    L_acc = L_shl (L_acc, (Word16) (stream & 1));
+    y = round_fx (L_acc);
+    *mem = y;
+    sum = L_add (L_shr (sum, 1), L_deposit_l (y));
+  }
+
+  return L_xor (sum, L_deposit_l (Overflow));
+}
+
+
+static Word32 thr_stream (int stream) {
+  int frame;
+  Word16 mem = 0;
+  Word32 checksum = 0;
+
+  for (frame = 0; frame < THR_NB_FRAMES; frame++) {
+    Reset_WMOPS_counter ();
+    checksum = L_add (L_shl (checksum, 1), thr_frame (stream, frame, &mem));
+    fwc ();
+  }
+  return checksum;
+}
+
+
+#if defined(_WIN32)
+static DWORD WINAPI thr_worker (LPVOID arg)
+#else
+static void *thr_worker (void *arg)
+#endif
+{
+  THR_TASK *task = (THR_TASK *) arg;
+
+  setCounter (task->counterId);
+  task->checksum = thr_stream (task->stream);
+  WMOPS_merge_thread ();
+
+  return 0;
+}
+
+
+int test_threads () {
+  int k, RetVal = 0, id_serial, id_parallel;
+  Word16 nb_serial, nb_parallel;
+  Word32 wm_serial, wm_parallel;
+  Word32 checksum[THR_NB_STREAMS];
+  THR_TASK task[THR_NB_STREAMS];
+#if defined(_WIN32)
+  HANDLE thread[THR_NB_STREAMS];
+#else
+  pthread_t thread[THR_NB_STREAMS];
+#endif
+
+  /* integer WMOPS figures keep the float totals exact */
+  setFrameRate (1000000, 1);
+  id_serial = getCounterId ("serial");
+  id_parallel = getCounterId ("parallel");
+
+  setCounter (id_serial);
+  for (k = 0; k < THR_NB_STREAMS; k++)
+    checksum[k] = thr_stream (k);
+
+  for (k = 0; k < THR_NB_STREAMS; k++) {
+    task[k].stream = k;
+    task[k].counterId = id_parallel;
+    task[k].checksum = 0;
+#if defined(_WIN32)
+    thread[k] = CreateThread (NULL, 0, thr_worker, &task[k], 0, NULL);
+#else
+    pthread_create (&thread[k], NULL, thr_worker, &task[k]);
+#endif
+  }
+  for (k = 0; k < THR_NB_STREAMS; k++) {
+#if defined(_WIN32)
+    WaitForSingleObject (thread[k], INFINITE);
+    CloseHandle (thread[k]);
+#else
+    pthread_join (thread[k], NULL);
+#endif
+    if (task[k].checksum != checksum[k]) {
+      printf ("Stream %d: checksum 0x%08lx in thread, 0x%08lx serial\n", k, (unsigned long) task[k].checksum, (unsigned long) checksum[k]);
+      RetVal = 1;
+    }
+  }
+
+  setCounter (id_serial);
+  WMOPS_output_avg (0, &wm_serial, &nb_serial);
+  setCounter (id_parallel);
+  WMOPS_output_avg (0, &wm_parallel, &nb_parallel);
+#ifdef WMOPS
+  if (wm_serial != wm_parallel || nb_serial != nb_parallel || nb_serial != THR_NB_STREAMS * THR_NB_FRAMES) {
+    printf ("WMOPS: %ld in %d frames in threads, %ld in %d frames serial\n", (long) wm_parallel, nb_parallel, (long) wm_serial, nb_serial);
+    RetVal = 1;
+  }
+#endif /* ifdef WMOPS */
+
+  return RetVal;
+}
+
+#else /* ifdef BASOP_THREAD_SAFE */
+
+int test_threads () {
+  printf ("Thread test needs a build with BASOP_THREAD_SAFE\n");
+  return 0;
+}
+
+#endif /* ifdef BASOP_THREAD_SAFE */
+/* End of file */
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <string.h>
+#include "stl.h"
+
+/*
+ * Vector operator test (ENH_VEC_OPERATOR builds only): every vector
+ * operator is compared with its reference loop of basic operators, for
+ * each kernel the CPU supports. Results, the Overflow flag and, with
+ * WMOPS, the weighted complexity must be identical.
+ */
+
+#ifdef ENH_VEC_OPERATOR
+
+#define VEC_NB_TRIALS     3000
+#define VEC_MAX_LEN       600
+
+static unsigned long vec_seed = 12345;
+
+static long vec_rand (void) {
+  vec_seed = vec_seed * 1103515245UL + 12345UL;
+  return (long) ((vec_seed >> 8) & 0xffffff);
+}
+
+/* Random 16 bit value in one of several ranges, so that saturation happens at various places */
+static Word16 vec_rand16 (int mode) {
+  switch (mode) {
+  case 0:
+    return (Word16) (vec_rand () & 0xffff);
+  case 1:
+    return (Word16) ((vec_rand () & 0x1ff) - 0x100);
+  case 2:
+    return (vec_rand () & 3) ? MIN_16 : (Word16) (vec_rand () & 0xffff);
+  default:
+    return (vec_rand () & 1) ? (Word16) (MAX_16 - (vec_rand () & 0xff)) : (Word16) (MIN_16 + (vec_rand () & 0xff));
+  }
+}
+
+static Word32 vec_rand32 (int mode) {
+  Word32 L_var = (Word32) (((unsigned long) vec_rand () << 16) ^ (unsigned long) vec_rand ());
+
+  switch (mode) {
+  case 0:
+    return L_var;
+  case 1:
+    return (L_var & 0xfffff) - 0x80000;
+  case 2:
+    return (vec_rand () & 3) ? MIN_32 : L_var;
+  default:
+    return (vec_rand () & 1) ? MAX_32 - (L_var & 0xffff) : MIN_32 + (L_var & 0xffff);
+  }
+}
+
+static int vec_check (const char *name, int trial, long res, long ref, Flag ovf, Flag ovf_ref) {
+  if (res != ref || ovf != ovf_ref) {
+    printf ("%s, trial %d: %ld (Overflow %d), reference %ld (Overflow %d)\n", name, trial, res, ovf, ref, ovf_ref);
+    return 1;
+  }
+  return 0;
+}
+
+static int vec_check_wmops (const char *name, int trial, Word32 wm, Word32 wm_ref) {
+#ifdef WMOPS
+  if (wm != wm_ref) {
+    printf ("%s, trial %d: complexity %ld, reference %ld\n", name, trial, (long) wm, (long) wm_ref);
+    return 1;
+  }
+#else /* ifdef WMOPS */
+  (void) name;
+  (void) trial;
+  (void) wm;
+  (void) wm_ref;
+#endif /* ifdef WMOPS */
+  return 0;
+}
+
+static int vec_test_kernel (void) {
+  static Word16 x[VEC_MAX_LEN], y[VEC_MAX_LEN], z[VEC_MAX_LEN], z_ref[VEC_MAX_LEN];
+  static Word32 L_x[VEC_MAX_LEN], L_y[VEC_MAX_LEN], L_z[VEC_MAX_LEN], L_z_ref[VEC_MAX_LEN];
+  Word16 i, len, var2, var_out, var_ref;
+  Word32 L_acc, L_ref, wm, wm_ref;
+  Flag ovf_ref;
+  int trial, mode, errors = 0;
+
+  for (trial = 0; trial < VEC_NB_TRIALS && errors < 10; trial++) {
+    mode = trial & 3;
+    len = (Word16) (vec_rand () % VEC_MAX_LEN);
+    if (trial % 7 == 0)
+      len = (Word16) (vec_rand () % 40);
+    for (i = 0; i < len; i++) {
+      x[i] = vec_rand16 (mode);
+      y[i] = vec_rand16 ((mode + (trial >> 2)) & 3);
+      L_x[i] = vec_rand32 (mode);
+      L_y[i] = vec_rand32 ((mode + (trial >> 2)) & 3);
+    }
+
+    /* V_L_mac */
+    L_acc = vec_rand32 (trial % 3);
+    DeltaWeightedOperation ();
+    Overflow = 0;
+    L_ref = L_acc;
+    for (i = 0; i < len; i++)
+      L_ref = L_mac (L_ref, x[i], y[i]);
+    ovf_ref = Overflow;
+    wm_ref = DeltaWeightedOperation ();
+    Overflow = 0;
+    L_acc = V_L_mac (L_acc, x, y, len);
+    wm = DeltaWeightedOperation ();
+    errors += vec_check ("V_L_mac", trial, L_acc, L_ref, Overflow, ovf_ref);
+    errors += vec_check_wmops ("V_L_mac", trial, wm, wm_ref);
+
+    /* energy, which often stays below saturation for small inputs */
+    L_acc = vec_rand32 (1);
+    Overflow = 0;
+    L_ref = L_acc;
+    for (i = 0; i < len; i++)
+      L_ref = L_mac (L_ref, x[i], x[i]);
+    ovf_ref = Overflow;
+    Overflow = 0;
+    L_acc = V_L_mac (L_acc, x, x, len);
+    errors += vec_check ("V_L_mac energy", trial, L_acc, L_ref, Overflow, ovf_ref);
+
+    /* V_add, V_sub */
+    DeltaWeightedOperation ();
+    Overflow = 0;
+    for (i = 0; i < len; i++)
+      z_ref[i] = add (x[i], y[i]);
+    ovf_ref = Overflow;
+    wm_ref = DeltaWeightedOperation ();
+    Overflow = 0;
+    V_add (x, y, z, len);
+    wm = DeltaWeightedOperation ();
+    errors += vec_check ("V_add", trial, memcmp (z, z_ref, len * sizeof (Word16)), 0, Overflow, ovf_ref);
+    errors += vec_check_wmops ("V_add", trial, wm, wm_ref);
+
+    Overflow = 0;
+    for (i = 0; i < len; i++)
+      z_ref[i] = sub (x[i], y[i]);
+    ovf_ref = Overflow;
+    Overflow = 0;
+    memcpy (z, x, len * sizeof (Word16));
+    V_sub (z, y, z, len);
+    errors += vec_check ("V_sub", trial, memcmp (z, z_ref, len * sizeof (Word16)), 0, Overflow, ovf_ref);
+
+    /* V_L_add, V_L_sub */
+    Overflow = 0;
+    for (i = 0; i < len; i++)
+      L_z_ref[i] = L_add (L_x[i], L_y[i]);
+    ovf_ref = Overflow;
+    Overflow = 0;
+    V_L_add (L_x, L_y, L_z, len);
+    errors += vec_check ("V_L_add", trial, memcmp (L_z, L_z_ref, len * sizeof (Word32)), 0, Overflow, ovf_ref);
+
+    Overflow = 0;
+    for (i = 0; i < len; i++)
+      L_z_ref[i] = L_sub (L_x[i], L_y[i]);
+    ovf_ref = Overflow;
+    Overflow = 0;
+    V_L_sub (L_x, L_y, L_z, len);
+    errors += vec_check ("V_L_sub", trial, memcmp (L_z, L_z_ref, len * sizeof (Word32)), 0, Overflow, ovf_ref);
+
+    /* V_shl, V_L_shl */
+    var2 = (Word16) (vec_rand () % 41 - 20);
+    Overflow = 0;
+    for (i = 0; i < len; i++)
+      z_ref[i] = shl (x[i], var2);
+    ovf_ref = Overflow;
+    Overflow = 0;
+    V_shl (x, var2, z, len);
+    errors += vec_check ("V_shl", trial, memcmp (z, z_ref, len * sizeof (Word16)), 0, Overflow, ovf_ref);
+
+    var2 = (Word16) (vec_rand () % 77 - 38);
+    DeltaWeightedOperation ();
+    Overflow = 0;
+    for (i = 0; i < len; i++)
+      L_z_ref[i] = L_shl (L_x[i], var2);
+    ovf_ref = Overflow;
+    wm_ref = DeltaWeightedOperation ();
+    Overflow = 0;
+    V_L_shl (L_x, var2, L_z, len);
+    wm = DeltaWeightedOperation ();
+    errors += vec_check ("V_L_shl", trial, memcmp (L_z, L_z_ref, len * sizeof (Word32)), 0, Overflow, ovf_ref);
+    errors += vec_check_wmops ("V_L_shl", trial, wm, wm_ref);
+
+    /* V_max_abs, V_L_max_abs */
+    DeltaWeightedOperation ();
+    var_ref = 0;
+    for (i = 0; i < len; i++)
+      var_ref = s_max (var_ref, abs_s (x[i]));
+    wm_ref = DeltaWeightedOperation ();
+    var_out = V_max_abs (x, len);
+    wm = DeltaWeightedOperation ();
+    errors += vec_check ("V_max_abs", trial, var_out, var_ref, 0, 0);
+    errors += vec_check_wmops ("V_max_abs", trial, wm, wm_ref);
+
+    L_ref = 0;
+    for (i = 0; i < len; i++)
+      L_ref = L_max (L_ref, L_abs (L_x[i]));
+    errors += vec_check ("V_L_max_abs", trial, V_L_max_abs (L_x, len), L_ref, 0, 0);
+
+    /* V_norm, V_L_norm, also on small values and zeros */
+    for (i = 0; i < len; i++) {
+      if (trial & 8) {
+        x[i] = shr (x[i], (Word16) (vec_rand () % 16));
+        L_x[i] = L_shr (L_x[i], (Word16) (vec_rand () % 32));
+      }
+    }
+    var_ref = 15;
+    for (i = 0; i < len; i++)
+      if (x[i] != 0)
+        var_ref = s_min (var_ref, norm_s (x[i]));
+    errors += vec_check ("V_norm", trial, V_norm (x, len), var_ref, 0, 0);
+
+    var_ref = 31;
+    for (i = 0; i < len; i++)
+      if (L_x[i] != 0)
+        var_ref = s_min (var_ref, norm_l (L_x[i]));
+    errors += vec_check ("V_L_norm", trial, V_L_norm (L_x, len), var_ref, 0, 0);
+  }
+  return errors;
+}
+
+
+int test_vec () {
+  Word16 mode, kernel, last = -1;
+  int errors, RetVal = 0;
+
+  for (mode = VEC_KERNEL_PORTABLE; mode <= VEC_KERNEL_AVX2; mode++) {
+    kernel = V_kernel (mode);
+    if (kernel == last)
+      continue;
+    last = kernel;
+    errors = vec_test_kernel ();
+    printf ("Kernel %d: %d errors\n", kernel, errors);
+    if (errors)
+      RetVal = 1;
+  }
+  V_kernel (VEC_KERNEL_PORTABLE);
+
+  return RetVal;
+}
+
+#else /* ifdef ENH_VEC_OPERATOR */
+
+int test_vec () {
+  printf ("Vector test needs a build with ENH_VEC_OPERATOR\n");
+  return 0;
+}
+
+#endif /* ifdef ENH_VEC_OPERATOR */
+/* End of file */
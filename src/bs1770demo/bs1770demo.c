@@ -4,12 +4,27 @@
     See LICENSE.md for terms.
 
     Author: erik.norvell@ericsson.com
+
+    History:
+    16.Oct.2026  The scaling factor is found on a histogram of the gating
+                 block energies, with suffix sums of the energies
+    16.Oct.2026  Added the streaming loudness meter (-meter) and the
+                 streaming normalization with look-ahead (-lookahead)
+    16.Oct.2026  The K-weighting filters and the energy of all channels
+                 are computed in one pass over the interleaved input
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>          /* SSE2 intrinsics, two channels per register */
+#endif
+#if defined(_WIN32)
+#include <io.h>                 /* for _setmode */
+#include <fcntl.h>
+#endif
 
 #define BLOCK_SIZE                19200      /* 400 ms in 48000 Hz sample rate */
 #define STEP_SIZE                 4800       /* 100 ms in 48000 Hz sample rate (75% overlap of 400 ms gating blocks) */   
@@ -19,6 +34,9 @@
 #define MAX_ITERATIONS            10
 #define RELATIVE_DIFF             0.0001
 #define MAX_CH_NUMBER             24
+#define SHORT_TERM_SUB_BLOCKS     30         /* 3 s short-term loudness window, in 100 ms sub-blocks */
+#define LOUD_HIST_SHIFT           44         /* Streaming histogram: 8 mantissa bits, 0.012 dB buckets */
+#define LOUD_HIST_SIZE            (33 << (52 - LOUD_HIST_SHIFT))  /* Gating block energies from the absolute threshold up to 2^10 */
 
 /*
     Channel weights for default channel ordering. Assumes channels are ordered as in 22.2 WAVE files:
@@ -106,6 +124,11 @@ void usage()
     fprintf( stdout, "                      '0' otherwise\n" );
     fprintf( stdout, "                      (Default conf nchan <= 18: %s)\n", default_conf_18 );
     fprintf( stdout, "                      (Default conf nchan  > 18: %s)\n", default_conf_24 );
+    fprintf( stdout, "-meter            Streaming loudness meter: print the momentary, short-term and\n" );
+    fprintf( stdout, "                  integrated loudness every 100 ms (<input file> may be - for stdin)\n" );
+    fprintf( stdout, "-lookahead T      Streaming normalization to the target level with a look-ahead\n" );
+    fprintf( stdout, "                  of T seconds instead of a second pass (<input file> and\n" );
+    fprintf( stdout, "                  <output file> may be - for stdin and stdout)\n" );
 
     exit(-1);
 }
@@ -127,61 +150,6 @@ void scale(
     return;
 }
 
-/*-------------------------------------------------
- * Sum of squares of input signal
- *-------------------------------------------------*/
-double sumsq(             /* o: Sum of squared signal */
-    const double *input,  /* i: Input signal          */
-    const long length     /* i: Length of signal      */
-)
-{
-    long i;
-    double result;
-    result = 0;
-    for( i = 0; i < length; i++ )
-    {
-        result = result + input[i] * input[i];
-    }
-
-    return result;
-}
-
-/*------------------------------------------------- 
- * 2nd order iir filter
- * y(n) = b[0] * x(n) + b[1] * x(n-1) + b[2] * x(n-2)
-                      - a[1] * y(n-1) - a[2] * y(n-2)
-    
-   a[0] assumed to be 1.0
-
- *-------------------------------------------------*/
-void iir2(
-    const double *input,  /* i  : Input signal         */
-          double *output, /* o  : Output signal        */
-    const long length,    /* i  : Length of signal     */
-    const double *B,      /* i  : B coefficients       */
-    const double *A,      /* i  : A coefficients       */
-          double *Bmem,   /* i/o: B memory (3 samples) */
-          double *Amem    /* i/o: A memory (3 samples) */
-    )
-{
-    long i;
-
-    for (i = 0; i < length; i++ )
-    {
-        Bmem[2] = Bmem[1];
-        Bmem[1] = Bmem[0];
-        Bmem[0] = input[i];
-
-        Amem[2] = Amem[1];
-        Amem[1] = Amem[0];
-        Amem[0] = B[0] * Bmem[0] + B[1] * Bmem[1] + B[2] * Bmem[2]
-                                 - A[1] * Amem[1] - A[2] * Amem[2];
-        output[i] = Amem[0];
-    }
-
-    return;
-}
-
 void deinterleave_short2double(
     short *input_short,  /* i: Input short signal     */
     double *input,       /* i: Input signal in double */
@@ -267,6 +235,133 @@ long interleave_double2short( /* returns number of clipped samples */
     return clip;
 }
 
+/*-------------------------------------------------
+ * K-weighting filter memories. Stage 2 filters the
+ * output of stage 1, so its input memories are the
+ * output memories of stage 1.
+ *-------------------------------------------------*/
+typedef struct
+{
+    double x1[MAX_CH_NUMBER];   /* Input x(n-1)             */
+    double x2[MAX_CH_NUMBER];   /* Input x(n-2)             */
+    double y1[MAX_CH_NUMBER];   /* Stage 1 output y(n-1)    */
+    double y2[MAX_CH_NUMBER];   /* Stage 1 output y(n-2)    */
+    double z1[MAX_CH_NUMBER];   /* Stage 2 output z(n-1)    */
+    double z2[MAX_CH_NUMBER];   /* Stage 2 output z(n-2)    */
+} kweight_state;
+
+/*-------------------------------------------------
+ * K-weighting of one 100 ms sub-block of all the
+ * channels, returning its weighted energy
+ *
+ * Both 2nd order iir stages
+ *   y(n) = b[0] * x(n) + b[1] * x(n-1) + b[2] * x(n-2)
+ *                      - a[1] * y(n-1) - a[2] * y(n-2)
+ * and the sum of squares are computed in one pass
+ * over the interleaved input, with the operations
+ * in the same order as filtering and summing each
+ * channel separately. With SSE2, pairs of channels
+ * are filtered in the two lanes of a register.
+ *-------------------------------------------------*/
+double kweight_sub_block(       /* o  : Weighted sub-block energy               */
+    const short *input_short,   /* i  : Interleaved input, STEP_SIZE samples    */
+    const long nchan,           /* i  : Number of channels                      */
+    const double *G,            /* i  : Channel weights                         */
+    kweight_state *st           /* i/o: Filter memories                         */
+)
+{
+    long i, k;
+    const short *p;
+    double x, x1, x2, y, y1, y2, z, z1, z2, acc;
+    double e;
+    double energy[MAX_CH_NUMBER];
+
+    i = 0;
+#if defined(__SSE2__)
+    for( ; i + 1 < nchan; i += 2 )
+    {
+        __m128d vx, vx1, vx2, vy, vy1, vy2, vz, vz1, vz2, vacc;
+        const __m128d scale = _mm_set1_pd( 32768.0 );
+
+        vx1 = _mm_loadu_pd( st->x1 + i );
+        vx2 = _mm_loadu_pd( st->x2 + i );
+        vy1 = _mm_loadu_pd( st->y1 + i );
+        vy2 = _mm_loadu_pd( st->y2 + i );
+        vz1 = _mm_loadu_pd( st->z1 + i );
+        vz2 = _mm_loadu_pd( st->z2 + i );
+        vacc = _mm_setzero_pd();
+        p = input_short + i;
+        for( k = 0; k < STEP_SIZE; k++, p += nchan )
+        {
+            vx = _mm_div_pd( _mm_set_pd( (double) p[1], (double) p[0] ), scale );
+            vy = _mm_sub_pd( _mm_sub_pd( _mm_add_pd( _mm_add_pd( _mm_mul_pd( _mm_set1_pd( B1[0] ), vx ),
+                                                                 _mm_mul_pd( _mm_set1_pd( B1[1] ), vx1 ) ),
+                                                     _mm_mul_pd( _mm_set1_pd( B1[2] ), vx2 ) ),
+                                         _mm_mul_pd( _mm_set1_pd( A1[1] ), vy1 ) ),
+                             _mm_mul_pd( _mm_set1_pd( A1[2] ), vy2 ) );
+            vz = _mm_sub_pd( _mm_sub_pd( _mm_add_pd( _mm_add_pd( _mm_mul_pd( _mm_set1_pd( B2[0] ), vy ),
+                                                                 _mm_mul_pd( _mm_set1_pd( B2[1] ), vy1 ) ),
+                                                     _mm_mul_pd( _mm_set1_pd( B2[2] ), vy2 ) ),
+                                         _mm_mul_pd( _mm_set1_pd( A2[1] ), vz1 ) ),
+                             _mm_mul_pd( _mm_set1_pd( A2[2] ), vz2 ) );
+            vacc = _mm_add_pd( vacc, _mm_mul_pd( vz, vz ) );
+            vx2 = vx1;
+            vx1 = vx;
+            vy2 = vy1;
+            vy1 = vy;
+            vz2 = vz1;
+            vz1 = vz;
+        }
+        _mm_storeu_pd( st->x1 + i, vx1 );
+        _mm_storeu_pd( st->x2 + i, vx2 );
+        _mm_storeu_pd( st->y1 + i, vy1 );
+        _mm_storeu_pd( st->y2 + i, vy2 );
+        _mm_storeu_pd( st->z1 + i, vz1 );
+        _mm_storeu_pd( st->z2 + i, vz2 );
+        _mm_storeu_pd( energy + i, vacc );
+    }
+#endif
+    for( ; i < nchan; i++ )
+    {
+        x1 = st->x1[i];
+        x2 = st->x2[i];
+        y1 = st->y1[i];
+        y2 = st->y2[i];
+        z1 = st->z1[i];
+        z2 = st->z2[i];
+        acc = 0;
+        p = input_short + i;
+        for( k = 0; k < STEP_SIZE; k++, p += nchan )
+        {
+            x = ((double) *p) / 32768.0;
+            y = B1[0] * x + B1[1] * x1 + B1[2] * x2 - A1[1] * y1 - A1[2] * y2;
+            z = B2[0] * y + B2[1] * y1 + B2[2] * y2 - A2[1] * z1 - A2[2] * z2;
+            acc = acc + z * z;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            z2 = z1;
+            z1 = z;
+        }
+        st->x1[i] = x1;
+        st->x2[i] = x2;
+        st->y1[i] = y1;
+        st->y2[i] = y2;
+        st->z1[i] = z1;
+        st->z2[i] = z2;
+        energy[i] = acc;
+    }
+
+    e = 0;
+    for( i = 0; i < nchan; i++ )
+    {
+        e += G[i] * energy[i];
+    }
+
+    return e;
+}
+
 double gated_loudness(                  /* o: gated loudness                 */
     const double *gating_block_energy,  /* i: gating_block_energy            */
     const double fac,                   /* i: Scaling factor                 */
@@ -310,6 +405,193 @@ double gated_loudness_adaptive(         /* o: gated loudness, using adaptive thr
 }
 
 
+/*-------------------------------------------------
+ * Histogram of the gating block energies, in buckets
+ * of 2^(1/16) (0.19 dB): as the energies are not
+ * negative, the upper bits of their IEEE 754 bit
+ * pattern (exponent and 4 mantissa bits) are a
+ * bucket index that is monotonic in the energy.
+ *-------------------------------------------------*/
+#define HIST_SHIFT                48
+#define HIST_SIZE                 (1L << (63 - HIST_SHIFT))
+
+typedef struct
+{
+    long n_gating_blocks;   /* Number of gating blocks                         */
+    long n_buckets;         /* Number of non-empty buckets                     */
+    long *start;            /* Index in energy[] of each bucket, and the end   */
+    double *max;            /* Largest energy in each bucket                   */
+    double *sum;            /* Sum of the energies of bucket k and above, and 0 */
+    double *energy;         /* Energies grouped by bucket, in ascending buckets */
+} gating_hist;
+
+static long hist_bucket( double energy )
+{
+    unsigned long long bits;
+
+    memcpy( &bits, &energy, sizeof( bits ) );
+    return (long) (bits >> HIST_SHIFT);
+}
+
+void gating_hist_init(
+    const double *gating_block_energy, /* i: gating_block_energy            */
+    const long n_gating_blocks,        /* i: Number of gating blocks        */
+          gating_hist *h               /* o: Histogram                      */
+)
+{
+    long i, k, b;
+    long *index;
+    long *fill;
+
+    index = calloc( HIST_SIZE, sizeof( long ) );
+    h->n_gating_blocks = n_gating_blocks;
+    h->energy = malloc( sizeof( double ) * (n_gating_blocks + 1) );
+
+    /* Count the blocks per bucket, and number the non-empty buckets */
+    for( i = 0; i < n_gating_blocks; i++ )
+    {
+        index[hist_bucket( gating_block_energy[i] )]++;
+    }
+    h->n_buckets = 0;
+    for( b = 0; b < HIST_SIZE; b++ )
+    {
+        h->n_buckets += (index[b] > 0);
+    }
+    h->start = malloc( sizeof( long ) * (h->n_buckets + 1) );
+    h->max = malloc( sizeof( double ) * (h->n_buckets + 1) );
+    h->sum = malloc( sizeof( double ) * (h->n_buckets + 1) );
+
+    k = 0;
+    h->start[0] = 0;
+    for( b = 0; b < HIST_SIZE; b++ )
+    {
+        if( index[b] > 0 )
+        {
+            h->start[k + 1] = h->start[k] + index[b];
+            index[b] = k++;
+        }
+    }
+
+    /* Group the energies by bucket */
+    fill = malloc( sizeof( long ) * (h->n_buckets + 1) );
+    for( k = 0; k < h->n_buckets; k++ )
+    {
+        h->max[k] = 0.0;
+        fill[k] = h->start[k];
+    }
+    for( i = 0; i < n_gating_blocks; i++ )
+    {
+        k = index[hist_bucket( gating_block_energy[i] )];
+        h->energy[fill[k]++] = gating_block_energy[i];
+        if( gating_block_energy[i] > h->max[k] )
+        {
+            h->max[k] = gating_block_energy[i];
+        }
+    }
+
+    /* Suffix sums of the bucket energies */
+    h->sum[h->n_buckets] = 0.0;
+    for( k = h->n_buckets - 1; k >= 0; k-- )
+    {
+        h->sum[k] = h->sum[k + 1];
+        for( i = h->start[k]; i < h->start[k + 1]; i++ )
+        {
+            h->sum[k] += h->energy[i];
+        }
+    }
+
+    free( index );
+    free( fill );
+
+    return;
+}
+
+void gating_hist_free(
+    gating_hist *h    /* i/o: Histogram */
+)
+{
+    free( h->start );
+    free( h->max );
+    free( h->sum );
+    free( h->energy );
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Same as gated_loudness(), on the histogram: the
+ * lowest bucket with blocks above the threshold is
+ * found by bisection on the bucket maxima, and only
+ * that bucket is scanned, with the same test as
+ * gated_loudness(). The same blocks are gated, only
+ * the order in which their energies are summed
+ * differs.
+ *-------------------------------------------------*/
+double gated_loudness_hist(             /* o: gated loudness                 */
+    const gating_hist *h,               /* i: Histogram                      */
+    const double fac,                   /* i: Scaling factor                 */
+    const double threshold              /* i: LKFS threshold                 */
+)
+{
+    long lo, hi, mid, i;
+    long count;
+    double energy;
+
+    lo = 0;
+    hi = h->n_buckets;
+    while( lo < hi )
+    {
+        mid = lo + (hi - lo) / 2;
+        if( (LKFS_OFFSET + 10 * log10( h->max[mid] * fac * fac )) > threshold )
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    energy = 0.0;
+    count = 0;
+    if( lo < h->n_buckets )
+    {
+        energy = h->sum[lo + 1];
+        count = h->n_gating_blocks - h->start[lo + 1];
+        for( i = h->start[lo]; i < h->start[lo + 1]; i++ )
+        {
+            if( (LKFS_OFFSET + 10 * log10( h->energy[i] * fac * fac )) > threshold )
+            {
+                energy += h->energy[i];
+                count++;
+            }
+        }
+    }
+
+    return LKFS_OFFSET + 10 * log10( energy * fac * fac / count );
+}
+
+double gated_loudness_adaptive_hist(    /* o: gated loudness, using adaptive threshold  */
+    const gating_hist *h,               /* i: Histogram                                 */
+    const double fac                    /* i: Scaling factor                            */
+)
+{
+    double relative_threshold;
+
+    relative_threshold = gated_loudness_hist( h, fac, ABSOLUTE_THRESHOLD ) + RELATIVE_THRESHOLD_OFFSET;
+    if( ABSOLUTE_THRESHOLD > relative_threshold )
+    {
+        relative_threshold = ABSOLUTE_THRESHOLD;
+    }
+    return gated_loudness_hist( h, fac, relative_threshold );
+}
+
+/*-------------------------------------------------
+ * Iterative search of the scaling factor. The gating
+ * blocks are put in a histogram once, so that each
+ * iteration only evaluates log10() for the blocks of
+ * one bucket instead of all the blocks.
+ *-------------------------------------------------*/
 double find_scaling_factor(            /* o: scaling factor                 */
     const double *gating_block_energy, /* i: gating_block_energy            */
     const long n_gating_blocks,        /* i: Number of gating blocks        */
@@ -322,6 +604,9 @@ double find_scaling_factor(            /* o: scaling factor                 */
     double last_fac;
     double fac;
     double gated_loudness_final;
+    gating_hist h;
+
+    gating_hist_init( gating_block_energy, n_gating_blocks, &h );
 
     last_fac = 100.0; /* Dummy init to trigger first iteration */
     fac = 1.0;
@@ -329,7 +614,7 @@ double find_scaling_factor(            /* o: scaling factor                 */
     while( (fabs( 1.0 - fac / last_fac ) > RELATIVE_DIFF) && (itr < MAX_ITERATIONS) )
     {
         /* Find scaling factor */
-        gated_loudness_final = gated_loudness_adaptive( gating_block_energy, fac, n_gating_blocks );
+        gated_loudness_final = gated_loudness_adaptive_hist( &h, fac );
         last_fac = fac;
         fac *= pow( 10.0, (lev - gated_loudness_final) / 20.0 );
         if (itr == 0 )
@@ -340,6 +625,9 @@ double find_scaling_factor(            /* o: scaling factor                 */
     }
 
     *lev_obtained = gated_loudness_final;
+
+    gating_hist_free( &h );
+
     return fac;
 }
 
@@ -372,6 +660,350 @@ long parse_conf(      /*  o: 0:success, -1:fail   */
     return 0;
 }
 
+/*-------------------------------------------------
+ * Streaming loudness measurement
+ *
+ * The integrated loudness is computed from a fixed
+ * size histogram of the gating blocks above the
+ * absolute threshold (count and sum of the energies
+ * in buckets of 2^(1/256), 0.012 dB, indexed by the
+ * upper bits of the IEEE 754 bit pattern), so the
+ * memory does not grow with the signal length. The
+ * relative gate is applied per bucket, on the mean
+ * energy of the bucket: only the blocks of the bucket
+ * at the relative threshold may be gated differently
+ * from gated_loudness_adaptive().
+ *-------------------------------------------------*/
+typedef struct
+{
+    long base;                         /* Bucket of the absolute threshold           */
+    long n;                            /* Number of blocks above the absolute gate   */
+    double energy;                     /* Their energy                               */
+    long count[LOUD_HIST_SIZE];        /* Number of blocks per bucket                */
+    double sum[LOUD_HIST_SIZE];        /* Energy of the blocks per bucket            */
+    double e_sub[SHORT_TERM_SUB_BLOCKS]; /* Energies of the last sub-blocks          */
+    long n_sub;                        /* Number of sub-blocks                       */
+} loudness_meter;
+
+void loudness_meter_init(
+    loudness_meter *lm     /* o: Loudness meter state */
+)
+{
+    memset( lm, 0, sizeof( loudness_meter ) );
+    lm->base = hist_bucket( pow( 10.0, (ABSOLUTE_THRESHOLD - LKFS_OFFSET) / 10.0 ) ) >> (HIST_SHIFT - LOUD_HIST_SHIFT);
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Add the weighted energy of a 100 ms sub-block:
+ * updates the short-term window and, from the 4th
+ * sub-block on, adds the 400 ms gating block
+ *-------------------------------------------------*/
+void loudness_meter_add(
+    loudness_meter *lm,    /* i/o: Loudness meter state    */
+    const double e_sub     /* i  : Sub-block energy        */
+)
+{
+    long k;
+    double e;
+
+    lm->e_sub[lm->n_sub % SHORT_TERM_SUB_BLOCKS] = e_sub;
+    lm->n_sub++;
+    if( lm->n_sub < 4 )
+    {
+        return;
+    }
+
+    e = 0.0;
+    for( k = lm->n_sub - 4; k < lm->n_sub; k++ )
+    {
+        e += lm->e_sub[k % SHORT_TERM_SUB_BLOCKS];
+    }
+    e /= (double) BLOCK_SIZE;
+    if( (LKFS_OFFSET + 10 * log10( e )) > ABSOLUTE_THRESHOLD )
+    {
+        k = (hist_bucket( e ) >> (HIST_SHIFT - LOUD_HIST_SHIFT)) - lm->base;
+        if( k < 0 )
+        {
+            k = 0;
+        }
+        if( k >= LOUD_HIST_SIZE )
+        {
+            k = LOUD_HIST_SIZE - 1;
+        }
+        lm->count[k]++;
+        lm->sum[k] += e;
+        lm->n++;
+        lm->energy += e;
+    }
+
+    return;
+}
+
+double loudness_meter_momentary(   /* o: Momentary loudness (last 400 ms) */
+    const loudness_meter *lm       /* i: Loudness meter state             */
+)
+{
+    long k;
+    double e = 0.0;
+
+    for( k = lm->n_sub - 4; k < lm->n_sub; k++ )
+    {
+        if( k >= 0 )
+        {
+            e += lm->e_sub[k % SHORT_TERM_SUB_BLOCKS];
+        }
+    }
+
+    return LKFS_OFFSET + 10 * log10( e / (double) BLOCK_SIZE );
+}
+
+double loudness_meter_short_term(  /* o: Short-term loudness (last 3 s)   */
+    const loudness_meter *lm       /* i: Loudness meter state             */
+)
+{
+    long k;
+    double e = 0.0;
+
+    for( k = 0; k < SHORT_TERM_SUB_BLOCKS; k++ )
+    {
+        e += lm->e_sub[k];
+    }
+
+    return LKFS_OFFSET + 10 * log10( e / (double) (SHORT_TERM_SUB_BLOCKS * STEP_SIZE) );
+}
+
+double loudness_meter_integrated(  /* o: Integrated loudness, -HUGE_VAL if no block is above the absolute gate */
+    const loudness_meter *lm       /* i: Loudness meter state                                               */
+)
+{
+    long k, count;
+    double relative_threshold, e_threshold, energy;
+
+    if( lm->n == 0 )
+    {
+        return -HUGE_VAL;
+    }
+
+    relative_threshold = LKFS_OFFSET + 10 * log10( lm->energy / lm->n ) + RELATIVE_THRESHOLD_OFFSET;
+    if( ABSOLUTE_THRESHOLD > relative_threshold )
+    {
+        relative_threshold = ABSOLUTE_THRESHOLD;
+    }
+    e_threshold = pow( 10.0, (relative_threshold - LKFS_OFFSET) / 10.0 );
+
+    energy = 0.0;
+    count = 0;
+    for( k = 0; k < LOUD_HIST_SIZE; k++ )
+    {
+        if( lm->count[k] > 0 && lm->sum[k] > e_threshold * lm->count[k] )
+        {
+            energy += lm->sum[k];
+            count += lm->count[k];
+        }
+    }
+
+    return LKFS_OFFSET + 10 * log10( energy / count );
+}
+
+/*-------------------------------------------------
+ * Read up to length samples, also from pipes
+ *-------------------------------------------------*/
+long read_samples(        /* o: Number of samples read    */
+    short *buf,           /* o: Samples                   */
+    const long length,    /* i: Number of samples to read */
+    FILE *f_input         /* i: Input file pointer        */
+)
+{
+    long n, got;
+
+    n = 0;
+    while( n < length && (got = (long) fread( buf + n, sizeof( short ), length - n, f_input )) > 0 )
+    {
+        n += got;
+    }
+
+    return n;
+}
+
+/*-------------------------------------------------
+ * Streaming loudness meter: prints the momentary,
+ * short-term and integrated loudness after each
+ * 100 ms sub-block. Returns the number of samples.
+ *-------------------------------------------------*/
+long stream_meter(
+    FILE *f_input,        /* i: Input file pointer        */
+    const long nchan,     /* i: Number of channels        */
+    const double *G,      /* i: Channel weights           */
+    double *lev_input     /* o: Integrated loudness       */
+)
+{
+    loudness_meter *lm;
+    short *input_short;
+    kweight_state *st;
+    long length_total;
+
+    lm = malloc( sizeof( loudness_meter ) );
+    input_short = malloc( sizeof( short ) * STEP_SIZE * nchan );
+    st = calloc( 1, sizeof( kweight_state ) );
+    loudness_meter_init( lm );
+
+    fprintf( stdout, "     Time   Momentary  Short-term  Integrated (LKFS)\n" );
+    length_total = 0;
+    while( read_samples( input_short, STEP_SIZE * nchan, f_input ) == STEP_SIZE * nchan )
+    {
+        loudness_meter_add( lm, kweight_sub_block( input_short, nchan, G, st ) );
+        length_total += STEP_SIZE;
+        fprintf( stdout, "%9.1f  %10.2f  %10.2f  %10.2f\n", (double) length_total / (double) STEP_SIZE / 10.0, loudness_meter_momentary( lm ), loudness_meter_short_term( lm ), loudness_meter_integrated( lm ) );
+    }
+    *lev_input = loudness_meter_integrated( lm );
+
+    free( lm );
+    free( input_short );
+    free( st );
+
+    return length_total;
+}
+
+/*-------------------------------------------------
+ * Scale a deinterleaved block with a gain ramped
+ * linearly from fac_start to fac_end
+ *-------------------------------------------------*/
+void scale_ramp(
+    const double *input,    /* i: Input signal (deinterleaved)  */
+    const double fac_start, /* i: Scaling factor before block   */
+    const double fac_end,   /* i: Scaling factor at end         */
+          double *output,   /* o: Output signal                 */
+    const long length,      /* i: Length per channel            */
+    const long nchan        /* i: Number of channels            */
+)
+{
+    long i, k;
+    double fac;
+
+    for( i = 0; i < nchan; i++ )
+    {
+        for( k = 0; k < length; k++ )
+        {
+            fac = fac_start + (fac_end - fac_start) * (double) (k + 1) / (double) length;
+            output[i * length + k] = input[i * length + k] * fac;
+        }
+    }
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Streaming normalization: the output is delayed by
+ * the look-ahead, and each sub-block is scaled to
+ * bring the integrated loudness of everything read
+ * so far (i.e. including the look-ahead) to the
+ * target level. The gain is ramped over each
+ * sub-block. When the look-ahead covers the whole
+ * signal, the gain is constant and the same as
+ * a single iteration of find_scaling_factor().
+ * Returns the number of samples.
+ *-------------------------------------------------*/
+long stream_normalize(
+    FILE *f_input,          /* i: Input file pointer             */
+    FILE *f_output,         /* o: Output file pointer            */
+    const long nchan,       /* i: Number of channels             */
+    const double *G,        /* i: Channel weights                */
+    const double lev,       /* i: Target level                   */
+    const double lookahead, /* i: Look-ahead in seconds          */
+    double *lev_input,      /* o: Integrated loudness of input   */
+    double *fac_last,       /* o: Last scaling factor            */
+    long *clip              /* o: Number of clipped samples      */
+)
+{
+    loudness_meter *lm;
+    short *delay;           /* Delay line of n_delay+1 sub-blocks */
+    short *p_in, *p_out;
+    double *input;
+    kweight_state *st;
+    double fac, fac_prev, lev_now;
+    long n_delay, n_in, n_out, length, length_total;
+    long *len;              /* Length of each sub-block in the delay line */
+    short eof;
+
+    n_delay = (long) ceil( lookahead * 10.0 );
+    lm = malloc( sizeof( loudness_meter ) );
+    delay = malloc( sizeof( short ) * STEP_SIZE * nchan * (n_delay + 1) );
+    len = malloc( sizeof( long ) * (n_delay + 1) );
+    input = malloc( sizeof( double ) * STEP_SIZE * nchan );
+    st = calloc( 1, sizeof( kweight_state ) );
+    loudness_meter_init( lm );
+
+    fac = 1.0;
+    fac_prev = -1.0;   /* No sub-block output yet */
+    length_total = 0;
+    *clip = 0;
+    n_in = 0;
+    n_out = 0;
+    eof = 0;
+    while( 1 )
+    {
+        /* Read and measure a sub-block, unless at the end of the input */
+        if( !eof )
+        {
+            p_in = delay + (n_in % (n_delay + 1)) * STEP_SIZE * nchan;
+            length = read_samples( p_in, STEP_SIZE * nchan, f_input );
+            if( length == STEP_SIZE * nchan )
+            {
+                loudness_meter_add( lm, kweight_sub_block( p_in, nchan, G, st ) );
+            }
+            else
+            {
+                eof = 1;
+            }
+            if( length > 0 )
+            {
+                len[n_in % (n_delay + 1)] = length;
+                n_in++;
+            }
+        }
+
+        /* Output the sub-block that is the look-ahead behind */
+        if( n_out == n_in || (!eof && n_in - n_out <= n_delay) )
+        {
+            if( eof )
+            {
+                break;
+            }
+            continue;
+        }
+        lev_now = loudness_meter_integrated( lm );
+        if( lev_now > -HUGE_VAL )
+        {
+            fac = pow( 10.0, (lev - lev_now) / 20.0 );
+        }
+        if( fac_prev < 0.0 )
+        {
+            fac_prev = fac;
+        }
+        p_out = delay + (n_out % (n_delay + 1)) * STEP_SIZE * nchan;
+        length = len[n_out % (n_delay + 1)];
+        deinterleave_short2double( p_out, input, length, nchan );
+        scale_ramp( input, fac_prev, fac, input, length / nchan, nchan );
+        *clip += interleave_double2short( input, p_out, length, nchan );
+        fwrite( p_out, sizeof( short ), length, f_output );
+        length_total += length / nchan;
+        fac_prev = fac;
+        n_out++;
+    }
+    *lev_input = loudness_meter_integrated( lm );
+    *fac_last = fac;
+
+    free( lm );
+    free( delay );
+    free( len );
+    free( input );
+    free( st );
+
+    return length_total;
+}
+
 int main(int argc, char **argv )
 {
     FILE* f_input;
@@ -379,9 +1011,8 @@ int main(int argc, char **argv )
     char *input_filename;
     char *output_filename;
     double *input;
-    double *p_input;
     short *input_short;
-    double *Bmem1, *Amem1, *Bmem2, *Amem2;
+    kweight_state *st;
     double *gating_block_energy; /* Buffer for energy values of gating block j */
     double *e_tmp;   /* Circular buffer for computing energy of each 100 ms sub-block */
     long nchan; 
@@ -397,12 +1028,17 @@ int main(int argc, char **argv )
     double fac;
     double G[MAX_CH_NUMBER];
     short zero_input_flag;
+    short meter;
+    double lookahead;
+    FILE *f_log;
 
     lev_target = -26;  /* Default target level       */
     i = 1;
     conf = NULL;
     nchan = -1;
     zero_input_flag = 1;
+    meter = 0;
+    lookahead = -1;
 
     /* Command line parsing */
     if( argc == 1 )
@@ -411,7 +1047,7 @@ int main(int argc, char **argv )
     }
     
     /* Process options */
-    while( argv[i][0] == '-' )
+    while( argv[i][0] == '-' && argv[i][1] != '\0' )
     {
         if( strcmp( argv[i], "-nchan" ) == 0 )
         {
@@ -441,6 +1077,20 @@ int main(int argc, char **argv )
             conf = argv[i + 1];
             i += 2;
         }
+        else if( strcmp( argv[i], "-meter" ) == 0 )
+        {
+            meter = 1;
+            i++;
+        }
+        else if( strcmp( argv[i], "-lookahead" ) == 0 )
+        {
+            if( sscanf( argv[i + 1], "%lf", &lookahead ) != 1 || lookahead < 0 )
+            {
+                fprintf( stderr, "*** Invalid look-ahead %s, exiting..\n", argv[i + 1] );
+                usage();
+            }
+            i += 2;
+        }
         else
         {
             fprintf( stderr, "*** Invalid option %s, exiting..\n", argv[i] );
@@ -456,7 +1106,25 @@ int main(int argc, char **argv )
     }
 
     input_filename = argv[i++];
-    if( (f_input = fopen( input_filename, "rb" )) == NULL )
+    if( meter && lookahead >= 0 )
+    {
+        fprintf( stderr, "*** Options -meter and -lookahead cannot be combined, exiting..\n" );
+        usage();
+    }
+    if( strcmp( input_filename, "-" ) == 0 )
+    {
+        /* Only the streaming modes can read from stdin, the other modes need two passes */
+        if( !meter && lookahead < 0 )
+        {
+            fprintf( stderr, "*** Reading from stdin needs -meter or -lookahead, exiting..\n" );
+            usage();
+        }
+#if defined(_WIN32)
+        _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+        f_input = stdin;
+    }
+    else if( (f_input = fopen( input_filename, "rb" )) == NULL )
     {
         fprintf( stderr, "*** Could not open input file %s, exiting..\n\n", input_filename );
         usage();
@@ -468,7 +1136,19 @@ int main(int argc, char **argv )
     else
     {
         output_filename = argv[i];
-        if( (f_output = fopen( output_filename, "wb" )) == NULL )
+        if( meter )
+        {
+            fprintf( stderr, "*** No output file with -meter, exiting..\n" );
+            usage();
+        }
+        if( strcmp( output_filename, "-" ) == 0 && lookahead >= 0 )
+        {
+#if defined(_WIN32)
+            _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+            f_output = stdout;
+        }
+        else if( (f_output = fopen( output_filename, "wb" )) == NULL )
         {
             fprintf( stderr, "*** Could not open output file %s, exiting..\n\n", output_filename );
             usage();
@@ -511,13 +1191,55 @@ int main(int argc, char **argv )
     }
 
 
-    /* Print settings */
-    fprintf( stdout, "Input file:       %s\n", input_filename );
+    if( lookahead >= 0 && f_output == NULL )
+    {
+        fprintf( stderr, "*** Output file needed with -lookahead, exiting..\n" );
+        usage();
+    }
+
+    /* Print settings, to stderr if the output goes to stdout */
+    f_log = (f_output == stdout) ? stderr : stdout;
+    fprintf( f_log, "Input file:       %s\n", input_filename );
     if (f_output != NULL )
     {
-        fprintf( stdout, "Output file:      %s\n", output_filename );
+        fprintf( f_log, "Output file:      %s\n", output_filename );
+    }
+    fprintf( f_log, "nchan:            %ld\n", nchan );
+
+    /* Streaming modes: one pass, with memory independent of the input length */
+    if( meter )
+    {
+        length_total = stream_meter( f_input, nchan, G, &lev_input );
+        fprintf( stdout, "Input level:      %.6f\n", lev_input );
+        fprintf( stdout, "\n--> Done processing %ld samples\n", length_total );
+        if( f_input != stdin )
+        {
+            fclose( f_input );
+        }
+        return 0;
+    }
+    if( lookahead >= 0 )
+    {
+        length_total = stream_normalize( f_input, f_output, nchan, G, lev_target, lookahead, &lev_input, &fac, &clip );
+        fprintf( f_log, "Input level:      %.6f\n", lev_input );
+        fprintf( f_log, "Target level:     %.6f\n", lev_target );
+        fprintf( f_log, "Look-ahead:       %.1f s\n", ceil( lookahead * 10.0 ) / 10.0 );
+        fprintf( f_log, "Scaling factor:   %.6f (last)\n", fac );
+        fprintf( f_log, "\n--> Done processing %ld samples\n", length_total );
+        if( clip > 0 )
+        {
+            fprintf( stderr, "*** Warning: %ld samples clipped\n", clip );
+        }
+        if( f_input != stdin )
+        {
+            fclose( f_input );
+        }
+        if( f_output != stdout )
+        {
+            fclose( f_output );
+        }
+        return 0;
     }
-    fprintf( stdout, "nchan:            %ld\n", nchan );
 
     /* Find length of input file */
     fseek( f_input, 0L, SEEK_END );
@@ -538,11 +1260,8 @@ int main(int argc, char **argv )
     /* Allocate input buffers */
     input = malloc( sizeof( double ) * STEP_SIZE * nchan );
     input_short = malloc( sizeof( short ) * STEP_SIZE * nchan ); 
-    /* Allocate filter buffers */
-    Bmem1 = calloc( sizeof( double ), 3 * nchan );
-    Amem1 = calloc( sizeof( double ), 3 * nchan );
-    Bmem2 = calloc( sizeof( double ), 3 * nchan );
-    Amem2 = calloc( sizeof( double ), 3 * nchan );
+    /* Allocate filter memories */
+    st = calloc( 1, sizeof( kweight_state ) );
     /* Allocate energy array to allow two passes */
     gating_block_energy = malloc( sizeof( double ) * n_gating_blocks);
     e_tmp = malloc( sizeof( double ) * 4 );
@@ -553,18 +1272,8 @@ int main(int argc, char **argv )
         /* Read next sub-block */
         fread( input_short, sizeof( short ), STEP_SIZE * nchan, f_input );
 
-        deinterleave_short2double( input_short, input, STEP_SIZE * nchan, nchan );
-
         /* Filter sub-block and store energy in circular buffer e_tmp */
-        p_input = input;
-        e_tmp[(n % 4)] = 0;
-        for(i = 0; i < nchan; i++ )
-        {
-            iir2( p_input, p_input, STEP_SIZE, B1, A1, Bmem1 + 3 * i, Amem1 + 3 * i );
-            iir2( p_input, p_input, STEP_SIZE, B2, A2, Bmem2 + 3 * i, Amem2 + 3 * i );
-            e_tmp[(n % 4)] += G[i] * sumsq( p_input, STEP_SIZE );
-            p_input += STEP_SIZE;
-        }
+        e_tmp[(n % 4)] = kweight_sub_block( input_short, nchan, G, st );
 
         /* Compute energies of block j from 4 current sub-blocks in circular buffer, excluding incomplete blocks */
         if( j >= 0 )
@@ -639,10 +1348,7 @@ int main(int argc, char **argv )
     /* Deallocate memory */
     free( input );
     free( input_short );
-    free( Bmem1 );
-    free( Amem1 );
-    free( Bmem2 );
-    free( Amem2 );
+    free( st );
     free( gating_block_energy );
     free( e_tmp );
 
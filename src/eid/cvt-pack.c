@@ -0,0 +1,235 @@
+/*                                                         16.Oct.2026 v.1.0
+   =========================================================================
+
+   cvt-pack.c
+   ~~~~~~~~~~
+
+   Program Description:
+   ~~~~~~~~~~~~~~~~~~~~
+
+   This example program converts an encoded speech bitstream or an
+   error pattern between the G.192 format (16-bit softbits) or the
+   byte-oriented G.192 format, and the packed G.192 format. The
+   direction of the conversion is defined by the format of the input
+   file: packed files are unpacked, other files are packed.
+
+   In the packed format, softbits, frame flags and the payload of
+   frames take one bit each, about 1/16 of the size of the G.192
+   file. Any other word (e.g. the frame length in the sync header, or
+   the zeros in the payload of an erased frame) is kept as is, hence
+   the conversion is lossless: unpacking a packed file gives the
+   original G.192 file back. The format is described in softbit.c.
+
+   Usage:
+   ~~~~~
+   cvt-pack [Options] in_bs out_bs
+   Where:
+   in_bs ...... input bitstream or error pattern file
+   out_bs ..... output bitstream or error pattern file
+
+   Options:
+   -byte ...... Unpack to the byte-oriented G.192 format
+   -q ......... Quiet operation
+   -? ......... Displays this message
+   -help ...... Displays a complete help message
+
+   History:
+   ~~~~~~~~
+   16.Oct.2026 v.1.0 Created based on bs-stats.c
+
+   ========================================================================= */
+
+/* ..... Generic include files ..... */
+#include "ugstdemo.h"           /* general UGST definitions */
+#include <stdio.h>              /* Standard I/O Definitions */
+#include <stdlib.h>
+#include <string.h>             /* strcmp */
+
+/* ..... Module definition files ..... */
+#include "softbit.h"            /* Soft bit definitions and prototypes */
+
+/* ..... Definitions used by the program ..... */
+
+/* Generic definitions */
+#define CVT_BUFFER_LENGTH 65536
+
+/* ************************* AUXILIARY FUNCTIONS ************************* */
+
+/*
+  --------------------------------------------------------------------------
+  display_usage()
+
+  Shows program usage.
+
+  History:
+  ~~~~~~~~
+  16/Oct/2026  v1.0 Created
+  --------------------------------------------------------------------------
+*/
+void display_usage (int level) {
+  printf ("cvt-pack.c - Version 1.0 of 16.Oct.2026 \n\n");
+
+  if (level) {
+    printf ("Program Description:\n");
+    printf ("\n");
+    printf ("This example program converts an encoded speech bitstream or an\n");
+    printf ("error pattern between the G.192 format (16-bit softbits) or the\n");
+    printf ("byte-oriented G.192 format, and the packed G.192 format. The\n");
+    printf ("direction of the conversion is defined by the format of the input\n");
+    printf ("file: packed files are unpacked, other files are packed.\n");
+    printf ("\n");
+    printf ("In the packed format, softbits, frame flags and the payload of\n");
+    printf ("frames take one bit each, about 1/16 of the size of the G.192\n");
+    printf ("file. Any other word is kept as is, hence the conversion is\n");
+    printf ("lossless: unpacking a packed file gives the original G.192 file\n");
+    printf ("back.\n");
+    printf ("\n");
+  } else {
+    printf ("Program to convert bitstreams and error patterns to/from the\n");
+    printf ("packed G.192 format.\n\n");
+  }
+
+  printf ("Usage:\n");
+  printf ("cvt-pack [Options] in_bs out_bs\n");
+  printf ("Where:\n");
+  printf (" in_bs ...... input bitstream or error pattern file\n");
+  printf (" out_bs ..... output bitstream or error pattern file\n");
+  printf ("\n");
+  printf ("Options:\n");
+  printf (" -byte ...... Unpack to the byte-oriented G.192 format\n");
+  printf (" -q ......... Quiet operation\n");
+  printf (" -? ......... Displays this message\n");
+  printf (" -help ...... Displays a complete help message\n");
+
+  /* Quit program */
+  exit (-128);
+}
+
+/* ....................... End of display_usage() ....................... */
+
+
+/* ************************************************************************* */
+/* ************************** MAIN_PROGRAM ********************************* */
+/* ************************************************************************* */
+int main (int argc, char *argv[]) {
+  /* Command line parameters */
+  char ibs_format;              /* Input bitstream format */
+  char obs_format;              /* Output bitstream format */
+  char unpack_format = g192;    /* Output format when unpacking */
+  char ibs_file[MAX_STRLEN];    /* Input bitstream file */
+  char obs_file[MAX_STRLEN];    /* Output bitstream file */
+
+  /* File I/O parameter */
+  FILE *Fibs;                   /* Pointer to input bitstream file */
+  FILE *Fobs;                   /* Pointer to output bitstream file */
+
+  /* Data arrays */
+  short *bs;                    /* Bitstream buffer */
+
+  /* Aux. variables */
+  double converted = 0;         /* Number of words converted */
+  char tmp_type;
+  long items;
+  char quiet = 0;
+
+  /* Pointer to a function */
+  long (*read_data) ();         /* To read input bitstream */
+  long (*save_data) ();         /* To save output bitstream */
+
+  /* ......... GET PARAMETERS ......... */
+
+  /* Check options */
+  if (argc < 2)
+    display_usage (0);
+  else {
+    while (argc > 1 && argv[1][0] == '-')
+      if (strcmp (argv[1], "-byte") == 0) {
+        /* Unpack to byte-oriented G.192 */
+        unpack_format = byte;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-q") == 0) {
+        /* Set quiet mode */
+        quiet = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-?") == 0) {
+        display_usage (0);
+      } else if (strstr (argv[1], "-help")) {
+        display_usage (1);
+      } else {
+        fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+        display_usage (0);
+      }
+  }
+
+  /* Get command line parameters */
+  GET_PAR_S (1, "_Input bit stream file ..................: ", ibs_file);
+  GET_PAR_S (2, "_Output bit stream file .................: ", obs_file);
+
+  /* Open files */
+  if ((Fibs = fopen (ibs_file, RB)) == NULL)
+    error_terminate ("Could not open input bitstream file\n", 1);
+  if ((Fobs = fopen (obs_file, WB)) == NULL)
+    error_terminate ("Could not create output file\n", 1);
+
+  /* *** CHECK FORMAT AND DIRECTION OF CONVERSION *** */
+  ibs_format = check_eid_format (Fibs, ibs_file, &tmp_type);
+
+  switch (ibs_format) {
+  case packed:
+    obs_format = unpack_format;
+    read_data = read_packed;
+    save_data = unpack_format == byte ? save_byte : save_g192;
+    break;
+  case g192:
+  case byte:
+    obs_format = packed;
+    read_data = ibs_format == byte ? read_byte : read_g192;
+    save_data = save_packed;
+    break;
+  default:
+    error_terminate ("Input must be in G.192, byte or packed format. Aborted.\n", 5);
+  }
+
+  /* Allocate memory for data buffer */
+  if ((bs = (short *) calloc (CVT_BUFFER_LENGTH, sizeof (short))) == NULL)
+    error_terminate ("Can't allocate memory for bitstream. Aborted.\n", 6);
+
+  /* *** START ACTUAL WORK *** */
+  while ((items = read_data (bs, (long) CVT_BUFFER_LENGTH, Fibs)) > 0) {
+    if (save_data (bs, items, Fobs) < items)
+      KILL (obs_file, 7);
+    converted += items;
+    if (!quiet)
+      fprintf (stderr, "\r%.0f words converted", converted);
+  }
+  if (items < 0)
+    KILL (ibs_file, 7);
+
+  /* *** PRINT SUMMARY OF OPTIONS & RESULTS ON SCREEN *** */
+  if (!quiet)
+    fprintf (stderr, "\n");
+  fprintf (stderr, "# Input bitstream format ................: %s (%s)\n", format_str ((int) ibs_format), type_str ((int) tmp_type));
+  fprintf (stderr, "# Output bitstream format ...............: %s\n", format_str ((int) obs_format));
+  fprintf (stderr, "# Converted words .......................: %.0f\n", converted);
+
+  /* *** FINALIZATIONS *** */
+
+  /* Free memory allocated */
+  free (bs);
+
+  /* Close the files and quit *** */
+  release_packed (Fibs);
+  release_packed (Fobs);
+  fclose (Fibs);
+  fclose (Fobs);
+
+#ifndef VMS                     /* return value to OS if not VMS */
+  return 0;
+#endif
+}
@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v1.2
+/*                                                          16.Oct.2026 v1.3
    =========================================================================
 
    eid-xor.c
@@ -13,13 +13,14 @@
 
    The file containing an encoded speech bitstream can be in a compact
    binary format, in the G.192 serial bitstream format (which uses
-   16-bit softbits), or in the byte-oriented G.192 format.
+   16-bit softbits), in the byte-oriented G.192 format, or in the
+   packed G.192 format.
 
-   The file containing the error pattern will be in one of three
+   The file containing the error pattern will be in one of four
    possible formats: G.192 16-bit softbit format (without synchronism
    header for bit errors), byte-oriented version of the G.192 format,
-   and compact, hard-bit binary (bit) mode. These are described in the
-   following.
+   compact, hard-bit binary (bit) mode, and packed G.192 format. These
+   are described in the following.
 
    The headerless G.192 serial bitstream format is as described in
    G.192, with the exceptions listed below. The main feature is that
@@ -36,6 +37,11 @@
    bits or frames that occur first in time. Here, '1' means that a bit
    is in error or that a frame should be erased, and a '0', otherwise.
 
+   In the packed mode, the file is a lossless image of a G.192 file
+   where softbits, frame flags and the payload of frames take one bit
+   each (see softbit.c). Unlike the compact mode, it keeps the frame
+   sync headers, so it can be used instead of G.192 everywhere.
+
    Conventions:
    ~~~~~~~~~~~~
 
@@ -83,8 +89,8 @@
    Options:
    -frame # ... Set the frame size to #. Necessary for headerless G.192
                 bitstreams or for compact binary files.
-   -bs mode ... Mode for bitstream (g192, byte, or bit)
-   -ep mode ... Mode for error pattern (g192, byte, or bit)
+   -bs mode ... Mode for bitstream (g192, byte, bit, or packed)
+   -ep mode ... Mode for error pattern (g192, byte, bit, or packed)
    -ber ....... Error pattern is a bit error pattern (needed for bit format)
    -fer ....... Error pattern is a frame erasure pattern (for bit format)
    -vbr ....... Enables variable bit rate operation
@@ -105,6 +111,7 @@
    09.Jun.05 v.1.1 Bug correction during EP file reading. <Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com>
    02.Feb.10 v.1.2 Modified maximum string length for filenames to avoid
                    buffer overruns (y.hiwasaki)
+   16.Oct.26 v.1.3 Added the packed format for bitstreams and patterns
 
    ========================================================================= */
 
@@ -203,13 +210,14 @@ void display_usage (int level) {
     printf ("\n");
     printf ("The file containing an encoded speech bitstream can be in a compact\n");
     printf ("binary format, in the G.192 serial bitstream format (which uses\n");
-    printf ("16-bit softbits), or in the byte-oriented G.192 format.\n");
+    printf ("16-bit softbits), in the byte-oriented G.192 format, or in the\n");
+    printf ("packed G.192 format.\n");
     printf ("\n");
-    printf ("The file containing the error pattern will be in one of three\n");
+    printf ("The file containing the error pattern will be in one of four\n");
     printf ("possible formats: G.192 16-bit softbit format (without synchronism\n");
     printf ("header for bit errors), byte-oriented version of the G.192 format,\n");
-    printf ("and compact, hard-bit binary (bit) mode. These are described in the\n");
-    printf ("following.\n");
+    printf ("compact, hard-bit binary (bit) mode, and packed G.192 format. These\n");
+    printf ("are described in the following.\n");
     printf ("\n");
     printf ("The headerless G.192 serial bitstream format is as described in\n");
     printf ("G.192, with the exceptions listed below. The main feature is that\n");
@@ -227,6 +235,11 @@ void display_usage (int level) {
     printf ("bits or frames that occur first in time. Here, '1' means that a bit\n");
     printf ("is in error or that a frame should be erased, and a '0', otherwise.\n");
     printf ("\n");
+    printf ("In the packed mode, the file is a lossless image of a G.192 file\n");
+    printf ("where softbits, frame flags and the payload of frames take one bit\n");
+    printf ("each. Unlike the compact mode, it keeps the frame sync headers, so\n");
+    printf ("it can be used instead of G.192 everywhere.\n");
+    printf ("\n");
     printf ("Conventions:\n");
     printf ("~~~~~~~~~~~~\n");
     printf ("\n");
@@ -265,8 +278,8 @@ void display_usage (int level) {
     printf ("\n");
   } else {
     printf ("Program to insert bit errors and frame erasures in bitstream \n");
-    printf ("files using a previously generated error pattern. Three formats \n");
-    printf ("are acceptable: g192, byte, and (compact) bit.\n\n");
+    printf ("files using a previously generated error pattern. Four formats \n");
+    printf ("are acceptable: g192, byte, (compact) bit, and packed.\n\n");
   }
 
   printf ("Usage:\n");
@@ -279,8 +292,8 @@ void display_usage (int level) {
   printf ("Options:\n");
   printf (" -frame # ... Set the frame size to # (for headerless G.192\n");
   printf ("              bitstreams or for compact binary files).\n");
-  printf (" -bs mode ... Mode for bitstream (g192, byte, or bit)\n");
-  printf (" -ep mode ... Mode for error pattern (g192, byte, or bit)\n");
+  printf (" -bs mode ... Mode for bitstream (g192, byte, bit, or packed)\n");
+  printf (" -ep mode ... Mode for error pattern (g192, byte, bit, or packed)\n");
   printf (" -ber ....... Error pattern is a bit error pattern (needed for bit format)\n");
   printf (" -fer ....... Error pattern is a frame erasure pattern (for bit format)\n");
   printf (" -vbr ....... Enables variable bit rate operation (different frame sizes)\n");
@@ -512,6 +525,29 @@ int main (int argc, char *argv[]) {
           vbr = 1;
       } else
         sync_header = 0;
+    } else if (bs_format == packed) {
+      short tmp[2], *skip;
+
+      /* Get presumed first G.192 sync header */
+      read_packed (tmp, 2l, Fibs);
+      /* tmp[1] should have the frame length */
+      i = tmp[1];
+      /* read over the payload; packed files can only be read sequentially */
+      if (i > 0 && (skip = (short *) calloc (i, sizeof (short))) != NULL) {
+        read_packed (skip, i, Fibs);
+        free (skip);
+      }
+      /* get (presumed) next G.192 sync header */
+      tmp[0] = 0;
+      read_packed (tmp, 2l, Fibs);
+      /* Verify */
+      if ((tmp[0] & 0xFFF0) == 0x6B20) {
+        fr_len = i;
+        sync_header = 1;
+        if (i != tmp[1])
+          vbr = 1;
+      } else
+        sync_header = 0;
     } else
       sync_header = 0;
 
@@ -570,9 +606,9 @@ int main (int argc, char *argv[]) {
   /* *** FINAL INITIALIZATIONS *** */
 
   /* Use the proper data I/O functions */
-  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : read_bit_ber);
-  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_type == BER ? read_bit_ber : read_bit_fer));
-  save_data = obs_format == byte ? save_byte : (obs_format == g192 ? save_g192 : save_bit);
+  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : (bs_format == packed ? read_packed : read_bit_ber));
+  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_format == packed ? read_packed : (ep_type == BER ? read_bit_ber : read_bit_fer)));
+  save_data = obs_format == byte ? save_byte : (obs_format == g192 ? save_g192 : (obs_format == packed ? save_packed : save_bit));
 
   /* Define BS sample size, in bytes */
   ibs_sample_len = bs_format == byte ? 1 : (bs_format == g192 ? 2 : 0);
@@ -584,20 +620,36 @@ int main (int argc, char *argv[]) {
     long max_fr_len = fr_len;   /* Maximum frame length found in file */
 
     /* Scan file for largest frame size */
-    while (!feof (Fibs)) {
-      /* Move to position where next frame length value is expected */
-      fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
+    if (bs_format == packed) {
+      short *skip;
+
+      /* Packed files can only be read sequentially: read over payloads */
+      if ((skip = (short *) calloc (32768, sizeof (short))) == NULL)
+        error_terminate ("Can't allocate memory for VBR scan. Aborted.\n", 6);
+      while (read_data (skip, 2l, Fibs) == 2) {
+        offset = skip[1];
+        if (offset > max_fr_len)
+          max_fr_len = offset;
+        if (offset > 0 && read_data (skip, (long) offset, Fibs) != offset)
+          break;
+      }
+      free (skip);
+    } else {
+      while (!feof (Fibs)) {
+        /* Move to position where next frame length value is expected */
+        fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
 
-      /* get (presumed) next G.192 sync header */
-      if ((items = read_data (&offset, 1l, Fibs)) != 1)
-        break;
+        /* get (presumed) next G.192 sync header */
+        if ((items = read_data (&offset, 1l, Fibs)) != 1)
+          break;
 
-      /* We have a different frame length here! */
-      if (offset > max_fr_len)
-        max_fr_len = offset;
+        /* We have a different frame length here! */
+        if (offset > max_fr_len)
+          max_fr_len = offset;
 
-      /* Convert offset number read to no.of bytes */
-      offset *= ibs_sample_len;
+        /* Convert offset number read to no.of bytes */
+        offset *= ibs_sample_len;
+      }
     }
 
     /* Rewind file */
@@ -828,6 +880,9 @@ int main (int argc, char *argv[]) {
   free (bs);
 
   /* Close the output file and quit *** */
+  release_packed (Fibs);
+  release_packed (Fep);
+  release_packed (Fobs);
   fclose (Fibs);
   fclose (Fep);
   fclose (Fobs);
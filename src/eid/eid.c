@@ -1,4 +1,4 @@
-/*                                                            02.Feb.2010  v2.7
+/*                                                            16.Oct.2026  v2.8
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -80,6 +80,15 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
                                       in one call.
                      Output: EPbuff = array, containing the error pattern
 
+                  - BER_generator_fast (SCD_EID *EID, long lseg,
+                                        unsigned char *mask)
+                     Faster, statistically equivalent version of
+                     BER_generator(), which samples run lengths between
+                     errors and returns the pattern as a packed bit mask.
+                     Input : EID    = pointer to EID-struct
+                     Input : lseg   = number of error bits to be generated
+                     Output: mask   = packed error pattern, LSb first
+
                   - BER_insertion (long lseg, short *ibuff,
                                               short *obuff, short *EPbuff)
                      Disturbes the input data bits according the error
@@ -142,6 +151,8 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
                  to extend Bellcore burst model resolution and operating
                  range to [0.5-30%]. <J.Sv. Ericsson>
   02.Feb.10 v2.7 Modified maximum string lenght for filenames (y.hiwasaki)
+  16.Oct.26 v2.8 Added BER_generator_fast(), which generates packed bit
+                 error patterns from run lengths between errors.
   =============================================================================
 */
 
@@ -467,12 +478,17 @@ int PORTABILITY_TEST_OPERATION = 1;
 #include <stdlib.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <string.h>
 
 /* ......... Include of EID prototypes and definitions .........*/
 #include "eid.h"
 
 /* Local function prototypes and definitions .........*/
 double EID_random ARGS ((unsigned long *seed));
+double EID_geometric ARGS ((unsigned long *seed, double lp));
+double EID_run_errors ARGS ((unsigned long *seed, double ber, double lok, unsigned char *mask, long begin, long end));
+#define EID_FAST_STATES 8       /* max. no.of states for BER_generator_fast() */
+#define EID_FAST_STAY 0.9       /* min. P(stay) for run lengths to be sampled */
 void update_EID_random ARGS ((long len_register, long *shift_register));
 long GEC_init ARGS ((SCD_EID * EID, double ber, double gamma));
 double bfer_comp (long index);
@@ -684,6 +700,250 @@ double BER_generator (EID, lseg, EPbuff)
 /* ....................... End of BER_generator() ....................... */
 
 
+/*
+  ============================================================================
+
+        double BER_generator_fast (SCD_EID *EID, long lseg,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  unsigned char *mask);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fast version of BER_generator(), which generates the bit error
+        pattern as a packed bit mask: bit i of the pattern is bit
+        (i % 8) of mask[i / 8], the LSb being the bit that occurs first
+        in time (the same bit order as the compact pattern format), and
+        set for a bit in error.
+
+        Instead of two random numbers per bit, the channel model is run
+        by sampling, for the current state, the geometrically distributed
+        number of bits until the next change of state and, within it,
+        the number of bits between errors. The random numbers come from
+        the same generator as in BER_generator(). Since the geometric
+        distribution is memoryless, the runs are simply restarted at
+        each call, and the only state carried over is the one in the
+        SCD_EID struct (seed and current channel state), which may be
+        saved/recalled and shared with BER_generator().
+
+        The pattern produced is statistically equivalent to that of
+        BER_generator() for the same channel model (same state
+        transition and per-state error probabilities), but it is NOT
+        the same sequence for the same seed. At low error rates, only
+        a few random numbers are drawn per call.
+
+        Parameters:
+        ~~~~~~~~~~~
+        EID: ...... (In/Out) struct with channel model
+        lseg: ..... (In)     number of bits in the pattern
+        mask: ..... (Out)    packed bit error pattern, (lseg+7)/8 bytes
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of bit errors in the pattern as a double.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+double BER_generator_fast (SCD_EID * EID, long lseg, unsigned char *mask) {
+  double lstay[EID_FAST_STATES];        /* log(P(stay in state)) */
+  double lok[EID_FAST_STATES];  /* log(1 - ber in state) */
+  double stay[EID_FAST_STATES]; /* P(stay in state) */
+  double low, RAN, g, ber;
+  long i, end, n, s;
+  short EPbuff[256];
+
+
+  /* Return if no samples are to be processed */
+  if (lseg == (long) 0)
+    return (0.0);
+
+  /* Clear pattern */
+  memset (mask, 0, (lseg + 7) / 8);
+
+  /* Models with many states: use the bit-by-bit generator */
+  if (EID->nstates > EID_FAST_STATES) {
+    for (ber = 0.0, i = 0; i < lseg; i += end) {
+      end = (lseg - i) < (long) sizeof (EPbuff) / (long) sizeof (short) ? lseg - i : (long) sizeof (EPbuff) / (long) sizeof (short);
+      ber += BER_generator (EID, end, EPbuff);
+      for (n = 0; n < end; n++)
+        if (EPbuff[n] == (short) 0x0081)
+          mask[(i + n) >> 3] |= (unsigned char) (1 << ((i + n) & 7));
+    }
+    return (ber);
+  }
+
+  /* Probabilities of each state, from the thresholds of the matrix */
+  for (n = 0; n < EID->nstates; n++) {
+    stay[n] = EID->matrix[n][n] - (n > 0 ? EID->matrix[n][n - 1] : 0.0);
+    if (stay[n] < 0.0)
+      stay[n] = 0.0;
+    lstay[n] = log (stay[n]);
+    lok[n] = log (1.0 - EID->ber[n]);
+  }
+
+  /* Run the channel model */
+  s = EID->current_state;
+  ber = 0.0;
+  for (i = 0; i < lseg;) {
+    /* Short stays: run the model bit by bit, as BER_generator() */
+    if (stay[s] < EID_FAST_STAY) {
+      RAN = EID_random (&(EID->seed));
+      for (n = 0; n < EID->nstates - 1; n++)
+        if (RAN < EID->matrix[s][n])
+          break;
+      s = n;
+      if (EID->ber[s] > 0.0 && EID_random (&(EID->seed)) < EID->ber[s]) {
+        mask[i >> 3] |= (unsigned char) (1 << (i & 7));
+        ber += 1.0;
+      }
+      i++;
+      continue;
+    }
+
+    /* Bits until the next change of state, and errors in them */
+    g = EID_geometric (&(EID->seed), lstay[s]);
+    end = (g >= (double) (lseg - i)) ? lseg : i + (long) g;
+    ber += EID_run_errors (&(EID->seed), EID->ber[s], lok[s], mask, i, end);
+    if ((i = end) == lseg)
+      break;
+
+    /* Select the new state: a random number outside the interval of the current state */
+    low = s > 0 ? EID->matrix[s][s - 1] : 0.0;
+    RAN = EID_random (&(EID->seed)) * (1.0 - stay[s]);
+    if (RAN >= low)
+      RAN += stay[s];
+    for (n = 0; n < EID->nstates - 1; n++)
+      if (n != s && RAN < EID->matrix[s][n])
+        break;
+    if (n == s)
+      n = s > 0 ? s - 1 : s + 1;        /* only on round-off */
+    s = n;
+
+    /* The bit where the state changed is already in the new state */
+    ber += EID_run_errors (&(EID->seed), EID->ber[s], lok[s], mask, i, i + 1);
+    i++;
+  }
+  EID->current_state = s;
+
+  return (ber);                 /* return number of error bits */
+}
+
+/* .................... End of BER_generator_fast() ..................... */
+
+
+/*
+  ============================================================================
+
+        double EID_geometric (unsigned long *seed, double lp);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Number of successes before the first failure in a sequence of
+        Bernoulli trials with success probability p, sampled by
+        inversion using one random number from EID_random().
+
+        Parameters:
+        ~~~~~~~~~~~
+        seed: ..... (In/Out) random number generator seed
+        lp: ....... (In)     log(p); 0 for p = 1 (never fails)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of successes as a double (HUGE_VAL if p = 1).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+double EID_geometric (unsigned long *seed, double lp) {
+  if (lp == 0.0)
+    return (HUGE_VAL);
+  return (floor (log (1.0 - EID_random (seed)) / lp));
+}
+
+/* ....................... End of EID_geometric() ....................... */
+
+
+/*
+  ============================================================================
+
+        double EID_run_errors (unsigned long *seed, double ber, double lok,
+        ~~~~~~~~~~~~~~~~~~~~~  unsigned char *mask, long begin, long end);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Set the bits in error in the bits begin..end-1 of a packed mask,
+        for a bit error probability `ber', sampling the number of correct
+        bits between errors. For ber = 0.5 (the BAD state of the
+        Gilbert-Elliot model), the bits are taken directly from the 16
+        most significant bits of each random number instead.
+
+        Parameters:
+        ~~~~~~~~~~~
+        seed: ..... (In/Out) random number generator seed
+        ber: ...... (In)     bit error rate
+        lok: ...... (In)     log(1 - ber)
+        mask: ..... (Out)    packed bit error pattern
+        begin: .... (In)     first bit of the run
+        end: ...... (In)     bit after the last bit of the run
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of bits in error as a double.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+double EID_run_errors (unsigned long *seed, double ber, double lok, unsigned char *mask, long begin, long end) {
+  double g, err = 0.0;
+  unsigned long bits;
+  long k;
+
+  /* No errors if the error rate is zero */
+  if (lok == 0.0)
+    return (0.0);
+
+  /* Fair coin: 16 bits per random number */
+  if (ber == 0.5) {
+    for (k = 0, bits = 0; begin < end; begin++, k--, bits >>= 1) {
+      if (k == 0) {
+        bits = (unsigned long) (EID_random (seed) * 65536.0);
+        k = 16;
+      }
+      if (bits & 1) {
+        mask[begin >> 3] |= (unsigned char) (1 << (begin & 7));
+        err += 1.0;
+      }
+    }
+    return (err);
+  }
+
+  for (;;) {
+    g = EID_geometric (seed, lok);
+    if (g >= (double) (end - begin))
+      break;
+    begin += (long) g;
+    mask[begin >> 3] |= (unsigned char) (1 << (begin & 7));
+    err += 1.0;
+    begin++;
+  }
+  return (err);
+}
+
+/* ...................... End of EID_run_errors() ...................... */
+
+
 /*
   ============================================================================
 
@@ -16,6 +16,7 @@
                         <Morgan.Lindqvist@era-t.ericsson.se> comments for the
 		        cc compiler in a DEC Alpha Unix machine.
    10.Oct.97    v2.4    Added prototype for reset_burst_eid() <simao>   
+   16.Oct.26    v2.5    Added prototype for BER_generator_fast()
   ============================================================================
 */
 
@@ -92,6 +93,7 @@ void set_GEC_current_state ARGS ((SCD_EID * EID, int /* char */ current_state));
 char get_GEC_current_state ARGS ((SCD_EID * EID));
 void BER_insertion ARGS ((long lseg, short *xbuff, short *ybuff, short *error_pattern));
 double BER_generator ARGS ((SCD_EID * EID, long lseg, short *EPbuff));
+double BER_generator_fast ARGS ((SCD_EID * EID, long lseg, unsigned char *mask));
 double FER_generator_random ARGS ((SCD_EID * EID));
 double FER_generator_burst ARGS ((BURST_EID * state));
 double FER_module ARGS ((SCD_EID * EID, long lseg, short *xbuff, short *ybuff));
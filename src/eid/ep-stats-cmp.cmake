@@ -0,0 +1,72 @@
+# Compare the statistics of two error patterns, as reported by ep-stats.
+#
+# Usage:
+#   cmake -DEP_STATS=<ep-stats> -DOPTS="<ep-stats options>" -DA=<pattern>
+#         -DB=<pattern> -DRATE_TOL=<%> -DBURST_TOL=<events>
+#         -P ep-stats-cmp.cmake
+#
+# The test fails if the overall error/erasure rates of A and B differ by
+# more than RATE_TOL (in percent), or if their average burst lengths
+# (disturbed bits/frames per error event) differ by more than BURST_TOL.
+
+separate_arguments(OPTS)
+
+function(ep_stats file rate burst)
+  execute_process(COMMAND ${EP_STATS} -q ${OPTS} ${file} 10
+                  OUTPUT_VARIABLE out ERROR_VARIABLE out
+                  RESULT_VARIABLE res)
+  if(NOT res EQUAL 0)
+    message(FATAL_ERROR "ep-stats failed on ${file}")
+  endif()
+  if(NOT out MATCHES "# Disturbed [a-z]+ \\.+ : ([0-9]+)")
+    message(FATAL_ERROR "No disturbed count for ${file}")
+  endif()
+  set(disturbed ${CMAKE_MATCH_1})
+  if(NOT out MATCHES "# Overall [a-z ]+rate ?\\.* : ([0-9.]+) %")
+    message(FATAL_ERROR "No overall rate for ${file}")
+  endif()
+  set(${rate} ${CMAKE_MATCH_1} PARENT_SCOPE)
+  # Number of error events: sum of the burst length histogram
+  string(REGEX MATCHALL "#  (Single|>?[0-9]+) events:[ \t]+[0-9]+" lines "${out}")
+  set(events 0)
+  foreach(line ${lines})
+    string(REGEX REPLACE ".*[ \t]([0-9]+)$" "\\1" n "${line}")
+    math(EXPR events "${events} + ${n}")
+  endforeach()
+  if(events EQUAL 0)
+    message(FATAL_ERROR "No error events in ${file}")
+  endif()
+  # Average burst length, in thousandths
+  math(EXPR burst_1k "1000 * ${disturbed} / ${events}")
+  set(${burst} ${burst_1k} PARENT_SCOPE)
+endfunction()
+
+ep_stats(${A} rate_a burst_a)
+ep_stats(${B} rate_b burst_b)
+
+# Rates in percent with six decimals: compare in millionths of a percent
+foreach(x rate_a rate_b RATE_TOL)
+  string(REGEX MATCH "^([0-9]*)\\.?([0-9]*)$" m "${${x}}")
+  string(SUBSTRING "${CMAKE_MATCH_2}000000" 0 6 frac)
+  math(EXPR ${x}_u "${CMAKE_MATCH_1}0 * 100000 + ${frac}")
+endforeach()
+math(EXPR drate "${rate_a_u} - ${rate_b_u}")
+if(drate LESS 0)
+  math(EXPR drate "-${drate}")
+endif()
+
+string(REGEX MATCH "^([0-9]*)\\.?([0-9]*)$" m "${BURST_TOL}")
+string(SUBSTRING "${CMAKE_MATCH_2}000" 0 3 frac)
+math(EXPR burst_tol "${CMAKE_MATCH_1}0 * 100 + ${frac}")
+math(EXPR dburst "${burst_a} - ${burst_b}")
+if(dburst LESS 0)
+  math(EXPR dburst "-${dburst}")
+endif()
+
+message("Rate: ${rate_a} % / ${rate_b} %, average burst: ${burst_a} / ${burst_b} (x1000)")
+if(drate GREATER RATE_TOL_u)
+  message(FATAL_ERROR "Rates differ by more than ${RATE_TOL} %")
+endif()
+if(dburst GREATER burst_tol)
+  message(FATAL_ERROR "Average burst lengths differ by more than ${BURST_TOL}")
+endif()
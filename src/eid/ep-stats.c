@@ -1,4 +1,4 @@
-/*                                                         02.Feb.2010 v.2.2
+/*                                                         16.Oct.2026 v.2.3
    =========================================================================
 
    ep-stats.c
@@ -11,11 +11,11 @@
    frame erasures in a pattern file, as well as a short-term histogram
    to see the number of burst frame erasures.
 
-   The file containing the error pattern will be in one of three
+   The file containing the error pattern will be in one of four
    possible formats: G.192 16-bit softbit format (without synchronism
    header for bit errors), byte-oriented version of the G.192 format,
-   and compact, hard-bit binary (bit) mode. These are described in the
-   following.
+   compact, hard-bit binary (bit) mode, and packed G.192 format. These
+   are described in the following.
 
    The headerless G.192 serial bitstream format is as described in
    G.192, with the exceptions listed below. The main feature is that
@@ -32,6 +32,9 @@
    bits or frames that occur first in time. Here, '1' means that a bit
    is in error or that a frame should be erased, and a '0', otherwise.
 
+   In the packed mode, the file is a lossless image of a G.192 pattern
+   where softbits and frame flags take one bit each (see softbit.c).
+
    Usage:
    ~~~~~
    ep-stats [Options] err_patt_file  burst_len
@@ -43,7 +46,7 @@
    -burst imax . Define max burst length to report
    -frame # .... Set the frame size to #.
    -start # .... First frame to start processing
-   -ep format .. Format for error pattern (g192, byte, or bit)
+   -ep format .. Format for error pattern (g192, byte, bit, or packed)
    -ber ........ Error pattern type is bit error pattern (important
                  for bit format)
    -fer ........ Error pattern type is frame erasure pattern (important
@@ -70,6 +73,7 @@
                      <Ericsson>
     2.Feb.2010 v.2.2 Modified maximum string length for filename to avoid
                      buffer overruns (y.hiwasaki)
+   16.Oct.2026 v.2.3 Added the packed format
    ========================================================================= */
 
 /* ..... Generic include files ..... */
@@ -127,11 +131,11 @@ void display_usage (int level) {
     printf ("frame erasures in a pattern file, as well as a short-term histogram\n");
     printf ("to see the number of burst frame erasures.\n");
     printf ("\n");
-    printf ("The file containing the error pattern will be in one of three\n");
+    printf ("The file containing the error pattern will be in one of four\n");
     printf ("possible formats: G.192 16-bit softbit format (without synchronism\n");
     printf ("header for bit errors), byte-oriented version of the G.192 format,\n");
-    printf ("and compact, hard-bit binary (bit) mode. These are described in the\n");
-    printf ("following.\n");
+    printf ("compact, hard-bit binary (bit) mode, and packed G.192 format. These\n");
+    printf ("are described in the following.\n");
     printf ("\n");
     printf ("The headerless G.192 serial bitstream format is as described in\n");
     printf ("G.192, with the exceptions listed below. The main feature is that\n");
@@ -147,6 +151,9 @@ void display_usage (int level) {
     printf ("have information about eight bits or frames. The LBbs will refer to\n");
     printf ("bits or frames that occur first in time. Here, '1' means that a bit\n");
     printf ("is in error or that a frame should be erased, and a '0', otherwise.\n");
+    printf ("\n");
+    printf ("In the packed mode, the file is a lossless image of a G.192 pattern\n");
+    printf ("where softbits and frame flags take one bit each.\n");
   } else {
     printf ("Program that calculates the number of occurences of errors/frame\n");
     printf ("erasures in a pattern file, as well as a short-term histogram.\n");
@@ -162,7 +169,7 @@ void display_usage (int level) {
   printf (" -frame # .... Set the frame size to #\n");
   printf (" -start # .... First frame to start processing\n");
   printf (" -burst max .. Define max burst length to report\n");
-  printf (" -ep format .. Format for error pattern (g192, byte, or bit)\n");
+  printf (" -ep format .. Format for error pattern (g192, byte, bit, or packed)\n");
   printf (" -ber ........ Pattern type is bit error pattern\n");
   printf (" -fer ........ Pattern type is frame erasure pattern\n");
   printf (" -q .......... Quiet operation\n");
@@ -330,7 +337,7 @@ int main (int argc, char *argv[]) {
   /* *** FINAL INITIALIZATIONS *** */
 
   /* Use the proper data I/O functions */
-  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_type == BER ? read_bit_ber : read_bit_fer));
+  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_format == packed ? read_packed : (ep_type == BER ? read_bit_ber : read_bit_fer)));
 
   /* Define how many samples are read for each frame */
   /* Bitstream may have sync headers, which are 2 samples-long */
@@ -359,6 +366,9 @@ int main (int argc, char *argv[]) {
   while (preamble_items < start_item) {
     if ((ep_format == byte) || (ep_format == g192)) {
       items = read_patt (ep, 1, Fep);   /* one item at a time consumed, for g.192 and byte */
+    } else if (ep_format == packed) {
+      /* any number of items can be consumed for packed */
+      items = read_patt (ep, start_item - preamble_items < ep_len ? start_item - preamble_items : ep_len, Fep);
     } else if (ep_format == compact) {
       if ((start_item % 8) == 0) {
         items = read_patt (ep, 8, Fep); /* 8 items time consumed, for bit/compact packed fer */
@@ -440,6 +450,7 @@ int main (int argc, char *argv[]) {
   free (ep);
 
   /* Close the output file and quit *** */
+  release_packed (Fep);
   fclose (Fep);
 
 #ifndef VMS                     /* return value to OS if not VMS */
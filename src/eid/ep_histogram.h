@@ -272,7 +272,9 @@ long compute_ep_histogram (short *pattern, long items, int ep_type, ep_histogram
 
 /*
   file .... file name
-  format .. error pattern format (g192, byte, compact
+  format .. error pattern format (g192, byte, compact, packed); the
+            size of packed files depends on the pattern, hence all
+            items up to the limit (if any) are processed
   start ... first item to process (bit or frame, depending on error
             pattern type)
   limit ... max number of items to process
@@ -292,6 +294,8 @@ long get_max_items (char *file, char format, long start, long limit) {
   case compact:
     bytes = fileinfo.st_size - start / 8;
     break;
+  default:
+    bytes = 0;
   }
 
 
@@ -305,6 +309,9 @@ long get_max_items (char *file, char format, long start, long limit) {
   case compact:
     max_items = bytes * 8;
     break;
+  case packed:
+    max_items = 0x7FFFFFFFL;
+    break;
   }
   if (limit > 0 && max_items > limit)
     max_items = limit;
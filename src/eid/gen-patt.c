@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v1.7
+/*                                                          16.Oct.2026 v1.9
    =========================================================================
 
    gen-patt.c
@@ -12,9 +12,10 @@
    insertion must be performed by "X-oring" the softbits produced with
    the softbits produced by the speech encoder. The error pattern can
    be generated according to 3 models: Random bit errors (BER), and
-   random (FER) and (BFER) burst frame erasure. Three output file
+   random (FER) and (BFER) burst frame erasure. Four output file
    formats are supported: G.192 serial bitstream, byte-oriented
-   softbit serial bitstream, and compact (hard) bit serial bitstream.
+   softbit serial bitstream, compact (hard) bit serial bitstream, and
+   packed G.192 serial bitstream.
 
    The headerless G.192 serial bitstream format is as described in
    G.192, with the exceptions listed below. The main feature is that
@@ -31,6 +32,10 @@
    or frames that occur first in time. Here, '1' means that a bit is
    in error or that a frame should be erased, and a '0', otherwise.
 
+   In the packed mode, the pattern takes one bit per bit or frame, as
+   in the compact mode, but the file is a lossless image of the G.192
+   pattern, and it is recognized as such by eid-xor and ep-stats.
+
    Valid range for the BER and FER is [0..0.5], and for the BFER is one of
    the 3 values 1%, 3%, and 5%.
 
@@ -106,9 +111,13 @@
    -g192 .... Save error pattern in 16-bit G.192 format
    -bit ..... Save error pattern in compact binary format (same as -compact)
    -compact . Save error pattern in compact binary format (same as -bit)
+   -packed .. Save error pattern in packed G.192 format
    -reset ... Reset EID state in between iteractions
    -max # ... Maximum number of iteractions
    -tol # ... Max deviation of specified BER/FER/BFER
+   -fast .... Use the fast pattern generator (BER/FER modes only): the
+              pattern has the same statistics, but is not the same
+              sequence as the default generator for the same state
    -q ....... Quiet operation mode
 
    Original Author:
@@ -152,6 +161,10 @@
                        (preamble part may now be excluded for teh iteration target) <Ericsson>
    02.Feb.2010,v1.7  Modified maximum string length for filenames to avoid
                      buffer overruns (y.hiwasaki)
+   16.Oct.2026,v1.8  Added option -fast, using BER_generator_fast() for
+                     the BER and FER modes.
+   16.Oct.2026,v1.9  Added option -packed, saving the pattern in the packed
+                     G.192 format.
 
   ========================================================================= */
 
@@ -174,6 +187,7 @@
 
 /* Buffer size definitions */
 #define EID_BUFFER_LENGTH 256
+#define FAST_BUFFER_LENGTH 65536        /* bits/frames per call, option -fast */
 #define OUT_RECORD_LENGTH 512
 
 /* Local function prototypes */
@@ -181,6 +195,7 @@ char *mode_str ARGS ((int mode));
 char check_bellcore ARGS ((long index));
 long run_FER_generator_random ARGS ((short *patt, SCD_EID * state, long n));
 long run_FER_generator_burst ARGS ((short *patt, BURST_EID * state, long n));
+double run_generator_fast ARGS ((SCD_EID * state, long n, int mode, int save_format, long (*save_data) (), FILE * F, double *saved));
 void display_usage ARGS ((void));
 
 
@@ -310,6 +325,63 @@ long run_FER_generator_burst (short *patt, BURST_EID * state, long n) {
 /* .................. End of run_FER_generator_burst() .................. */
 
 
+/*
+   -------------------------------------------------------------------------
+   double run_generator_fast (SCD_EID *state, long n, int mode,
+                              int save_format, long (*save_data)(),
+                              FILE *F, double *saved)
+
+   Generate n bits (mode R) or frame flags (mode F) with
+   BER_generator_fast(), in blocks of FAST_BUFFER_LENGTH, and save them
+   to file. In the compact and packed formats, the packed pattern is
+   written as is; otherwise it is expanded to G.192 words and saved by
+   save_data().
+
+   Parameters:
+   state ...... pointer to a Gilbert model EID state variable
+   n .......... number of bits|frames to generate
+   mode ....... R or F
+   save_format  format of the output file
+   save_data .. function to save G.192 words in the output format
+   F .......... output file
+   saved ...... incremented by the number of bits|frames saved
+
+   Returns the number of disturbed bits|frames.
+
+   Original author: 16.Oct.2026
+   -------------------------------------------------------------------------
+ */
+double run_generator_fast (SCD_EID * state, long n, int mode, int save_format, long (*save_data) (), FILE * F, double *saved) {
+  static unsigned char mask[FAST_BUFFER_LENGTH / 8];
+  static short patt[FAST_BUFFER_LENGTH];
+  short one = mode == 'R' ? G192_ONE : G192_FER, zero = mode == 'R' ? G192_ZERO : G192_SYNC;
+  double disturbed = 0.0;
+  long i, j, k, items;
+
+  for (i = 0; i < n; i += k) {
+    k = n - i > FAST_BUFFER_LENGTH ? FAST_BUFFER_LENGTH : n - i;
+    disturbed += BER_generator_fast (state, k, mask);
+
+    /* Save as is, or converted to G.192 words */
+    if (save_format == compact)
+      items = fwrite (mask, sizeof (char), (k + 7) / 8, F) < (size_t) ((k + 7) / 8) ? -1 : k;
+    else if (save_format == packed)
+      items = save_packed_bits (mask, k, mode == 'R' ? BER : FER, F);
+    else {
+      for (j = 0; j < k; j++)
+        patt[j] = (mask[j >> 3] >> (j & 7)) & 1 ? one : zero;
+      items = save_data (patt, k, F);
+    }
+    if (items < 0)
+      error_terminate ("Error saving data to file\n", 8);
+    *saved += items;
+  }
+  return (disturbed);
+}
+
+/* .................... End of run_generator_fast() ...................... */
+
+
 /*
    --------------------------------------------------------------------------
    display_usage()
@@ -322,7 +394,7 @@ long run_FER_generator_burst (short *patt, BURST_EID * state, long n) {
    --------------------------------------------------------------------------
  */
 void display_usage () {
-  printf ("gen-patt.c Version 1.7 of 02.Feb.2010\n");
+  printf ("gen-patt.c Version 1.9 of 16.Oct.2026\n");
 
   printf ("  This example program produces bit error pattern files for error\n");
   printf ("  insertion in G.192-compliant serial bitstreams encoded files. Error\n");
@@ -360,9 +432,12 @@ void display_usage () {
   printf ("   -g192 .... Save error pattern in 16-bit G.192 format\n");
   printf ("   -bit ..... Save error pattern in compact binary format (same as -compact)\n");
   printf ("   -compact . Save error pattern in compact binary format (same as -bit)\n");
+  printf ("   -packed .. Save error pattern in packed G.192 format\n");
   printf ("   -reset ... Reset EID state in between iteractions\n");
   printf ("   -max # ... Maximum number of iteractions\n");
   printf ("   -tol # ... Max deviation of specified BER/FER/BFER\n");
+  printf ("   -fast .... Fast generator for BER/FER modes (same statistics, but\n");
+  printf ("              not the same pattern as the default generator)\n");
   printf ("   -q ....... Quiet operation mode\n");
 
   /* Quit program */
@@ -420,7 +495,7 @@ int main (int argc, char *argv[]) {
   char mrs[15] = "mrs=512";
 #endif
   long max_iteraction = 100;
-  char quiet = 0, reset = 0, save_format = byte, tailstat = 0;
+  char quiet = 0, reset = 0, save_format = byte, tailstat = 0, fast = 0;
   long (*save_data) () = save_byte;     /* Pointer to a function */
 
 #ifdef PORT_TEST
@@ -527,6 +602,21 @@ int main (int argc, char *argv[]) {
         save_format = compact;
         save_data = save_bit;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-packed") == 0) {
+        /* Save bitstream as a packed G.192 bitstream */
+        save_format = packed;
+        save_data = save_packed;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Use the fast BER/FER pattern generator */
+        fast = 1;
+
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
@@ -755,6 +845,12 @@ int main (int argc, char *argv[]) {
         }
 
         /* Generate bits subject to disturbance */
+        if (fast) {
+          processed = generated;
+          disturbed = run_generator_fast (BEReid, number_of_frames - (long) generated, mode, save_format, save_data, out_file_ptr, &generated);
+          processed = generated - processed;
+          break;
+        }
         for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
           /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
           k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
@@ -794,6 +890,12 @@ int main (int argc, char *argv[]) {
         }
 
         /* Generate frame subject to disturbance */
+        if (fast && mode == 'F') {
+          processed = generated;
+          disturbed = run_generator_fast (FEReid, number_of_frames - (long) generated, mode, save_format, save_data, out_file_ptr, &generated);
+          processed = generated - processed;
+          break;
+        }
         for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
           /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
           k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
@@ -925,6 +1027,7 @@ int main (int argc, char *argv[]) {
   /*
    **  Close the output file and quit
    */
+  release_packed (out_file_ptr);
   fclose (out_file_ptr);
 
 #ifndef VMS                     /* return value to OS if not VMS */
@@ -25,6 +25,15 @@
    bits or frames that occur first in time. Here, '1' means that a bit
    is in error or that a frame should be erased, and a '0', otherwise.
 
+   In the packed mode, softbits and frame flags take one bit each, but
+   the file remains a lossless image of a G.192 bitstream or pattern.
+   The file starts with the 4-byte magic "G19P", followed by chunks,
+   each with a 16-bit little-endian header holding the chunk kind (2
+   MSbs) and a count (14 LSbs). Runs of softbits 0x007F/0x0081, runs
+   of frame flags 0x6B21/0x6B20 and whole frames (sync header and
+   softbits) are packed 8 per byte, LSb first; any other word is
+   kept as a raw 16-bit little-endian word. See save_packed().
+
    Conventions:
    ~~~~~~~~~~~~
 
@@ -519,6 +528,431 @@ long save_byte (short *patt, long n, FILE * F) {
 /* ....................... End of save_byte() ....................... */
 
 
+/*
+  -------------------------------------------------------------------------
+  Local state of each packed file being read or saved: whether the magic
+  was read or saved (ftell() cannot tell the start of a pipe), and, for
+  read_packed(), the words decoded from the current chunk, which may be
+  returned over several calls. It is kept until release_packed() is
+  called for the file.
+  -------------------------------------------------------------------------
+*/
+#define PACKED_MAX_FILES 8
+typedef struct {
+  FILE *F;                      /* File this state belongs to */
+  int started;                  /* Magic already read or saved */
+  short *word;                  /* Words decoded from the current chunk */
+  unsigned char *data;          /* Chunk data, as read from file */
+  long pos, len;                /* Next word to return, number of words */
+} PACKED_STATE;
+
+static PACKED_STATE packed_state[PACKED_MAX_FILES];
+
+
+/*
+  -------------------------------------------------------------------------
+  Return the state for file F, allocating one if needed.
+  -------------------------------------------------------------------------
+*/
+static PACKED_STATE *get_packed_state (FILE * F) {
+  PACKED_STATE *st, *fr = NULL;
+
+  for (st = packed_state; st < packed_state + PACKED_MAX_FILES; st++) {
+    if (st->F == F)
+      return (st);
+    if (fr == NULL && st->F == NULL)
+      fr = st;
+  }
+  if (fr == NULL)
+    error_terminate ("Too many packed bitstream files open\n", 6);
+
+  fr->F = F;
+  fr->started = 0;
+  fr->pos = fr->len = 0;
+  return (fr);
+}
+
+
+/*
+  -------------------------------------------------------------------------
+  Check if the next word of file F is the first one of the file: before
+  the first read or save (also for pipes), or after a rewind (seekable
+  files only, e.g. a new file that reuses the FILE pointer of a closed
+  one). Then flag the file as started.
+  -------------------------------------------------------------------------
+*/
+static int packed_at_start (PACKED_STATE * st, FILE * F) {
+  int at_start = !st->started || ftell (F) == 0;
+
+  st->started = 1;
+  return (at_start);
+}
+
+
+/*
+  -------------------------------------------------------------------------
+  Read and decode the next chunk of a packed file into st->word[].
+  Returns the number of words decoded, 0 on EOF, or -1 on error.
+  -------------------------------------------------------------------------
+*/
+static long read_packed_chunk (PACKED_STATE * st, FILE * F) {
+  unsigned char hdr[3];
+  short one = G192_ONE, zero = G192_ZERO, *p = st->word;
+  long count, nbytes, i;
+  int kind;
+
+  /* Chunk header */
+  if ((i = fread (hdr, sizeof (char), 2, F)) < 2)
+    return (i == 0 && !ferror (F) ? 0l : -1l);
+  kind = hdr[1] >> 6;
+  count = ((hdr[1] & 0x3F) << 8) | hdr[0];
+
+  switch (kind) {
+  case PACKED_RAW:
+    if (fread (st->data, sizeof (char), 2 * count, F) < (size_t) (2 * count))
+      return (-1l);
+    for (i = 0; i < count; i++)
+      p[i] = (short) (st->data[2 * i] | (st->data[2 * i + 1] << 8));
+    return (count);
+
+  case PACKED_FRAME:
+    /* Flags: bit 0 set for an erased frame, bit 1 set for a zero payload */
+    if (fread (&hdr[2], sizeof (char), 1, F) < 1)
+      return (-1l);
+    *p++ = (hdr[2] & 1) ? G192_FER : G192_SYNC;
+    *p++ = (short) count;
+    if (hdr[2] & 2) {
+      memset (p, 0, count * sizeof (short));
+      return (count + 2);
+    }
+    break;
+
+  case PACKED_SYNCS:
+    one = G192_FER;
+    zero = G192_SYNC;
+    break;
+  }
+
+  /* Unpack bits, LSb first */
+  nbytes = (count + 7) / 8;
+  if (fread (st->data, sizeof (char), nbytes, F) < (size_t) nbytes)
+    return (-1l);
+  for (i = 0; i < count; i++)
+    p[i] = (st->data[i >> 3] >> (i & 7)) & 1 ? one : zero;
+
+  return (count + (p - st->word));
+}
+
+
+/*
+  -------------------------------------------------------------------------
+  long read_packed (short *patt, long n, FILE *F);
+  ~~~~~~~~~~~~~~~~
+
+  Read n words of a G.192 bitstream or error pattern from a file in
+  packed format (see save_packed()). The words are returned exactly as
+  they were given to save_packed(), irrespective of how many words were
+  saved or are read at each call. The file magic is checked in the first
+  call, and whenever reading from the start of a seekable file, hence
+  files can be rewound with fseek(F, 0l, SEEK_SET); other seeks are not
+  supported. Files may also be pipes.
+
+  Parameter:
+  ~~~~~~~~~~
+  patt .... G.192 array with the softbits representing
+            the bit error/frame erasure pattern
+  n ....... number of words to be read
+  F ....... pointer to FILE where the pattern should be read
+
+  Return value:
+  ~~~~~~~~~~~~~
+  Returns a long with the number of words read from a file. On error,
+  or if the file is not in packed format, returns -1.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v.1.0  Created.
+  -------------------------------------------------------------------------
+*/
+long read_packed (short *patt, long n, FILE * F) {
+  PACKED_STATE *st = get_packed_state (F);
+  char magic[4];
+  long count, k;
+
+  /* Largest chunk is a frame: 2 header words and PACKED_MAX_RUN softbits */
+  if (st->word == NULL) {
+    st->word = (short *) calloc (PACKED_MAX_RUN + 2, sizeof (short));
+    st->data = (unsigned char *) calloc (2 * PACKED_MAX_RUN, sizeof (char));
+    if (st->word == NULL || st->data == NULL)
+      error_terminate ("Cannot allocate memory to read packed bitstream\n", 6);
+  }
+
+  /* At start of file: check magic and forget any pending words */
+  if (packed_at_start (st, F)) {
+    st->pos = st->len = 0;
+    if (fread (magic, sizeof (char), 4, F) < 4)
+      return (ferror (F) ? -1l : 0l);
+    if (strncmp (magic, PACKED_MAGIC, 4))
+      return (-1l);
+  }
+
+  for (count = 0; count < n; count += k) {
+    /* Decode next chunk when the current one is used up */
+    if (st->pos == st->len) {
+      st->pos = 0;
+      if ((st->len = read_packed_chunk (st, F)) <= 0) {
+        k = st->len;
+        st->len = 0;
+        if (k < 0)
+          return (-1l);
+        break;                  /* EOF */
+      }
+    }
+
+    k = st->len - st->pos < n - count ? st->len - st->pos : n - count;
+    memcpy (&patt[count], &st->word[st->pos], k * sizeof (short));
+    st->pos += k;
+  }
+
+  return (count);
+}
+
+/* ....................... End of read_packed() ....................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  long save_packed (short *patt, long n, FILE *F);
+  ~~~~~~~~~~~~~~~~
+
+  Save a G.192 bitstream or error pattern in packed format. The file
+  magic is written first when saving at the start of the file (in the
+  first call, for a pipe). The words are then split in chunks, each
+  with a 16-bit little-endian header (kind in the 2 MSbs, count in the
+  14 LSbs):
+
+  PACKED_FRAME ... a G.192 frame: sync header 0x6B21/0x6B20 followed by
+                   count softbits 0x007F/0x0081, or by count zeros
+                   (erased payload); one flag byte (bit 0: 0x6B20, bit
+                   1: zero payload), then the softbits, 1 bit each
+  PACKED_SYNCS ... count frame flags 0x6B21/0x6B20, 1 bit each
+  PACKED_BITS .... count softbits 0x007F/0x0081, 1 bit each
+  PACKED_RAW ..... count 16-bit words of any other value, as is
+
+  Bits are packed 8 per byte, the LSb being the first in time ('1' for
+  0x0081 or 0x6B20), as in the compact mode. The conversion is lossless
+  for any array, and each call is independent of the previous ones.
+
+  Parameter:
+  ~~~~~~~~~~
+  patt .... G.192 array with the softbits representing
+            the bit error/frame erasure pattern
+  n ....... number of words in the pattern
+  F ....... pointer to FILE where the pattern should be saved
+
+  Return value:
+  ~~~~~~~~~~~~~
+  Returns a long with the number of words saved to a file. On error,
+  returns -1.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v.1.0  Created.
+  -------------------------------------------------------------------------
+*/
+#define IS_SOFTBIT(x) ((x) == G192_ZERO || (x) == G192_ONE)
+#define IS_FLAG(x)    ((x) == G192_SYNC || (x) == G192_FER)
+long save_packed (short *patt, long n, FILE * F) {
+  unsigned char *buf, *p;
+  short *w, *bits, *end = patt + n;
+  long count, i, len, nbytes;
+  int kind, flags;
+
+  /* Skip function if no samples are to be saved */
+  if (n == 0)
+    return (0);
+
+  /* Worst case is one header per word */
+  if ((buf = (unsigned char *) calloc (4 * n + 4, sizeof (char))) == NULL)
+    error_terminate ("Cannot allocate memory to save packed bitstream\n", 6);
+  p = buf;
+
+  /* Magic at start of file */
+  if (packed_at_start (get_packed_state (F), F)) {
+    memcpy (p, PACKED_MAGIC, 4);
+    p += 4;
+  }
+
+  for (w = patt; w < end; w += count) {
+    /* A G.192 frame: sync header followed by softbits or by zeros */
+    kind = PACKED_RAW;
+    flags = 0;
+    if (IS_FLAG (w[0]) && end - w >= 2 && w[1] >= 0 && w[1] <= PACKED_MAX_RUN && end - w - 2 >= w[1]) {
+      len = w[1];
+      for (i = 0; i < len && IS_SOFTBIT (w[2 + i]); i++);
+      if (i < len) {
+        flags = 2;
+        for (i = 0; i < len && w[2 + i] == 0; i++);
+      }
+      if (i == len)
+        kind = PACKED_FRAME;
+    }
+
+    /* Otherwise, the longest run of words of the same kind */
+    if (kind == PACKED_FRAME) {
+      flags |= w[0] == G192_FER ? 1 : 0;
+      bits = w + 2;
+      count = len + 2;
+    } else {
+      if (IS_FLAG (w[0]))
+        kind = PACKED_SYNCS;
+      else if (IS_SOFTBIT (w[0]))
+        kind = PACKED_BITS;
+      for (len = 1; w + len < end && len < PACKED_MAX_RUN; len++) {
+        if (kind == PACKED_SYNCS ? !IS_FLAG (w[len]) : kind == PACKED_BITS ? !IS_SOFTBIT (w[len]) : IS_FLAG (w[len]) || IS_SOFTBIT (w[len]))
+          break;
+      }
+      bits = w;
+      count = len;
+    }
+
+    /* Chunk header */
+    *p++ = (unsigned char) (len & 0xFF);
+    *p++ = (unsigned char) ((kind << 6) | (len >> 8));
+
+    if (kind == PACKED_RAW) {
+      for (i = 0; i < len; i++) {
+        *p++ = (unsigned char) (w[i] & 0xFF);
+        *p++ = (unsigned char) ((w[i] >> 8) & 0xFF);
+      }
+      continue;
+    }
+    if (kind == PACKED_FRAME) {
+      *p++ = (unsigned char) flags;
+      if (flags & 2)
+        continue;
+    }
+
+    /* Packed bits, LSb first */
+    nbytes = (len + 7) / 8;
+    memset (p, 0, nbytes);
+    for (i = 0; i < len; i++)
+      if (bits[i] == G192_ONE || bits[i] == G192_FER)
+        p[i >> 3] |= (unsigned char) (1 << (i & 7));
+    p += nbytes;
+  }
+
+  /* Save chunks to file */
+  i = fwrite (buf, sizeof (char), p - buf, F);
+  count = (i < p - buf) ? -1l : n;
+
+  /* Free memory and quit */
+  free (buf);
+  return (count);
+}
+
+/* ....................... End of save_packed() ....................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  long save_packed_bits (unsigned char *bits, long n, char type, FILE *F);
+  ~~~~~~~~~~~~~~~~~~~~~
+
+  Save n hard bits, packed 8 per byte with the LSb first in time (as in
+  the compact mode), as a packed file of softbits (BER) or frame flags
+  (FER), without expanding them to G.192 words. The file decodes to the
+  same G.192 words as that of save_packed() for the equivalent array, but
+  the bytes differ for more than 0x3FF8 bits: runs are split in chunks
+  of PACKED_MAX_RUN & ~7 bits, so that each chunk starts at a byte
+  boundary, while save_packed() splits them at PACKED_MAX_RUN.
+
+  Parameter:
+  ~~~~~~~~~~
+  bits .... packed hard bits, '1' for a bit error/frame erasure
+  n ....... number of bits
+  type .... BER or FER
+  F ....... pointer to FILE where the pattern should be saved
+
+  Return value:
+  ~~~~~~~~~~~~~
+  Returns a long with the number of bits saved to a file. On error,
+  returns -1.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v.1.0  Created.
+  -------------------------------------------------------------------------
+*/
+long save_packed_bits (unsigned char *bits, long n, char type, FILE * F) {
+  unsigned char hdr[2];
+  long i, len;
+
+  /* Magic at start of file */
+  if (n > 0 && packed_at_start (get_packed_state (F), F) && fwrite (PACKED_MAGIC, sizeof (char), 4, F) < 4)
+    return (-1l);
+
+  /* Chunks start at byte boundaries, so that bits can be copied as is */
+  for (i = 0; i < n; i += len) {
+    len = n - i < (PACKED_MAX_RUN & ~7) ? n - i : (PACKED_MAX_RUN & ~7);
+    hdr[0] = (unsigned char) (len & 0xFF);
+    hdr[1] = (unsigned char) (((type == FER ? PACKED_SYNCS : PACKED_BITS) << 6) | (len >> 8));
+    if (fwrite (hdr, sizeof (char), 2, F) < 2 || fwrite (&bits[i >> 3], sizeof (char), len >> 3, F) < (size_t) (len >> 3))
+      return (-1l);
+
+    /* Last byte, with the unused bits cleared */
+    if (len & 7) {
+      hdr[0] = bits[(i + len) >> 3] & ((1 << (len & 7)) - 1);
+      if (fwrite (hdr, sizeof (char), 1, F) < 1)
+        return (-1l);
+    }
+  }
+
+  return (n);
+}
+
+/* .................... End of save_packed_bits() .................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  void release_packed (FILE *F);
+  ~~~~~~~~~~~~~~~~~~~
+
+  Release the state kept for file F by read_packed(), save_packed() and
+  save_packed_bits(), to be called before closing F. Up to 8 files can
+  have such a state at the same time. Nothing is done if F has none,
+  e.g. if it is not a packed file.
+
+  Parameter:
+  ~~~~~~~~~~
+  F ....... pointer to FILE of the packed bitstream or pattern
+
+  Return value:
+  ~~~~~~~~~~~~~
+  None.
+
+  History:
+  ~~~~~~~~
+  17.Oct.26  v.1.0  Created.
+  -------------------------------------------------------------------------
+*/
+void release_packed (FILE * F) {
+  PACKED_STATE *st;
+
+  for (st = packed_state; st < packed_state + PACKED_MAX_FILES; st++) {
+    if (st->F == F && F != NULL) {
+      free (st->word);
+      free (st->data);
+      memset (st, 0, sizeof (PACKED_STATE));
+      return;
+    }
+  }
+}
+
+/* ..................... End of release_packed() ..................... */
+
+
 /*
   ---------------------------------------------------------------------------
   char *format_str (int fmt);
@@ -554,6 +988,9 @@ char *format_str (int fmt) {
   case compact:
     return "bit";
     break;
+  case packed:
+    return "packed";
+    break;
   }
   return "";
 }
@@ -605,7 +1042,7 @@ char *type_str (int type) {
   char check_eid_format (FILE *F, char *file, char *type);
   ~~~~~~~~~~~~~~~~~~~~~
 
-  Function that checks the format (g192, byte, bit) in a given
+  Function that checks the format (g192, byte, bit, packed) in a given
   bitstream, and tries to guess the type of data (bit stream or frame
   erasure pattern)
 
@@ -617,7 +1054,7 @@ char *type_str (int type) {
 
   Returned value:
   ~~~~~~~~~~~~~~~
-  Returns the data format (g192, byte, bit) found in file.
+  Returns the data format (g192, byte, bit, packed) found in file.
 
   Original author: <simao.campos@comsat.com>
   ~~~~~~~~~~~~~~~~
@@ -627,6 +1064,8 @@ char *type_str (int type) {
   15.Aug.97  v.1.0  Created.
   01.Jun.05  v.1.1  Bug correction: switch is made on the "unsigned short" value
 					(v.1.0: "unsigned" only). <Cyril Guillaume & Stephane Ragot -- stephane.ragot@rd.francetelecom.com>
+  16.Oct.26  v.1.2  Added detection of the packed format; the type is
+                    inferred from the first chunk.
   --------------------------------------------------------------------------
 */
 char check_eid_format (FILE * F, char *file, char *type) {
@@ -634,10 +1073,30 @@ char check_eid_format (FILE * F, char *file, char *type) {
   char ret_val;
   unsigned long tmp = 0x41424344;       /* Hex version of the string ABCD */
   int little_endian;
+  unsigned char chunk[8];
 
   /* Find whether the OS is big- or little-endian */
   little_endian = strncmp ("ABCD", (char *) &tmp, 4);
 
+  /* Packed files start with a magic; the first chunk tells the type */
+  memset (chunk, 0, sizeof (chunk));
+  if (fread (chunk, sizeof (char), 8, F) >= 4 && strncmp ((char *) chunk, PACKED_MAGIC, 4) == 0) {
+    word = (short) (chunk[6] | (chunk[7] << 8));
+    switch (chunk[5] >> 6) {
+    case PACKED_BITS:
+      *type = BER;
+      break;
+    case PACKED_RAW:
+      *type = (word & 0xFFF0) == 0x6B20 ? FER : BER;
+      break;
+    default:
+      *type = FER;
+    }
+    fseek (F, 0l, SEEK_SET);
+    return (packed);
+  }
+  fseek (F, 0l, SEEK_SET);
+
   /* Get a 16-bit word from the file */
   fread (&word, sizeof (short), 1, F);
 
@@ -9,6 +9,9 @@
 
    History:
    10.Oct.97     1.00   Created
+   16.Oct.26     1.01   Added the packed format (read_packed, save_packed,
+                        save_packed_bits)
+   17.Oct.26     1.02   Added release_packed
   ============================================================================
 */
 #ifndef SOFTBIT_DEFINED
@@ -27,7 +30,7 @@
 /* ..... Definitions for softbit operations ..... */
 
 /* Operating modes */
-enum BS_formats { byte, g192, compact, nil };
+enum BS_formats { byte, g192, compact, packed, nil };
 enum BS_types { NO_HEADER, HAS_HEADER, HAS_FLAG_ONLY };
 enum EP_types { BER, FER };
 
@@ -43,6 +46,15 @@ enum EP_types { BER, FER };
 #define G192_SYNC	(short)0x6B21
 #define G192_FER	(short)0x6B20
 
+/* Definitions for packed mode: file magic, then chunks with a 16-bit
+   little-endian header (2-bit kind, 14-bit count) */
+#define PACKED_MAGIC	"G19P"
+#define PACKED_MAX_RUN	0x3FFF
+#define PACKED_BITS	0       /* count softbits 0x007F/0x0081, 1 bit each */
+#define PACKED_SYNCS	1       /* count flags 0x6B21/0x6B20, 1 bit each */
+#define PACKED_FRAME	2       /* sync header + count softbits, see save_packed() */
+#define PACKED_RAW	3       /* count 16-bit words as is */
+
 /* softbit.c */
 long read_g192 ARGS ((short *patt, long n, FILE * F));
 long read_bit_ber ARGS ((short *patt, long n, FILE * F));
@@ -52,6 +64,10 @@ long read_byte ARGS ((short *patt, long n, FILE * F));
 long save_g192 ARGS ((short *patt, long n, FILE * F));
 long save_bit ARGS ((short *patt, long n, FILE * F));
 long save_byte ARGS ((short *patt, long n, FILE * F));
+long read_packed ARGS ((short *patt, long n, FILE * F));
+long save_packed ARGS ((short *patt, long n, FILE * F));
+long save_packed_bits ARGS ((unsigned char *bits, long n, char type, FILE * F));
+void release_packed ARGS ((FILE * F));
 char *format_str ARGS ((int fmt));
 char *type_str ARGS ((int type));
 char check_eid_format ARGS ((FILE * F, char *file, char *type));
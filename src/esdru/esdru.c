@@ -2,6 +2,12 @@
     Implementation of ESDRU as defined in ITU-T Recommendation P.811
 
     Author: erik.norvell@ericsson.com
+
+    History:
+    16.Oct.2026  Added the streaming mode (-stream, or "-" as input or
+                 output file), the modulation curve output option -m_out
+                 (mc.double is no longer written unconditionally)
+                 and the streaming block size option -block
 */
 
 #include <stdio.h>
@@ -9,21 +15,38 @@
 #include <math.h>
 #include <string.h>
 #include "ugst-utl.h"           /* for ran16_32c */
+#if defined(_WIN32)
+#include <io.h>                 /* for _setmode */
+#include <fcntl.h>
+#endif
 
 #define LOCAL_PI       3.14159265358979323846
 
+/* Streaming mode */
+#define STREAM_BLOCK   262144   /* Default samples output per processing block  */
+#define STREAM_TOL     1e-20    /* Relative weight of the truncated tail of the
+                                   backward smoothing filters                   */
+
 void usage()
 {
     fprintf( stdout, "esdru.exe [options] <alpha> <input file> <output file>\n" );
     fprintf( stdout, "\n" );
     fprintf( stdout, "<alpha>           Alpha value [0.0 ... 1.0]\n" );
-    fprintf( stdout, "<input file>      Input file, 16 bit Stereo PCM\n" );
-    fprintf( stdout, "<output file>     Output file, 16 bit Stereo PCM\n" );
+    fprintf( stdout, "<input file>      Input file, 16 bit Stereo PCM (- for stdin)\n" );
+    fprintf( stdout, "<output file>     Output file, 16 bit Stereo PCM (- for stdout)\n" );
     fprintf( stdout, "\n" );
     fprintf( stdout, "Options:\n" );
     fprintf( stdout, "-sf FS            Sampling frequency FS Hz (Default: 48000 Hz)\n" );
     fprintf( stdout, "-e_step S         Max step S during high energy [0.0 ... 1.0] (Default: 0.5)\n" );
     fprintf( stdout, "-seed I           Set random seed I [unsigned int] (Default: 1)\n" );
+    fprintf( stdout, "-e_out F          Write smoothed energies to file F\n" );
+    fprintf( stdout, "-e_in F           Read smoothed energies from file F\n" );
+    fprintf( stdout, "-m_out F          Write modulation curve to file F\n" );
+    fprintf( stdout, "-stream           Process the input in blocks, with bounded memory\n" );
+    fprintf( stdout, "                  (implied when <input file> or <output file> is -,\n" );
+    fprintf( stdout, "                  for stdin or stdout)\n" );
+    fprintf( stdout, "-block N          Output N samples per block in streaming mode, implies\n" );
+    fprintf( stdout, "                  -stream (Default: %d)\n", STREAM_BLOCK );
 
     exit(-1);
 }
@@ -67,19 +90,21 @@ void energy(
 /*------------------------------------------------- 
  * First order one - pole iir filter of the form
  * y( n ) = fac * x( n ) + (1 - fac) * y( n - 1 )
+ * starting from, and updating, the filter memory
  *-------------------------------------------------*/
-void ar1(
-    const double fac,     /* i: filter coefficient */
-    const double *input,  /* i: Input signal       */
-          double *output, /* i: Output signal      */
-    const long length,    /* i: Length of signal   */
-    const long dir        /* i: Direction (1, -1)  */
+void ar1_mem(
+    const double fac,     /*  i: filter coefficient */
+    const double *input,  /*  i: Input signal       */
+          double *output, /*  i: Output signal      */
+    const long length,    /*  i: Length of signal   */
+    const long dir,       /*  i: Direction (1, -1)  */
+          double *filt_mem /*i/o: Filter memory     */
 )
 {
     long i;
     double mem;
 
-    mem = 0.0;
+    mem = *filt_mem;
 
     if( dir == 1 )
     { 
@@ -101,6 +126,27 @@ void ar1(
         }
     }
 
+    *filt_mem = mem;
+
+    return;
+}
+
+/*------------------------------------------------- 
+ * First order one - pole iir filter of the form
+ * y( n ) = fac * x( n ) + (1 - fac) * y( n - 1 )
+ *-------------------------------------------------*/
+void ar1(
+    const double fac,     /* i: filter coefficient */
+    const double *input,  /* i: Input signal       */
+          double *output, /* i: Output signal      */
+    const long length,    /* i: Length of signal   */
+    const long dir        /* i: Direction (1, -1)  */
+)
+{
+    double mem;
+
+    mem = 0.0;
+    ar1_mem( fac, input, output, length, dir, &mem );
 
     return;
 }
@@ -160,6 +206,83 @@ long convert_double2short( /* returns number of clipped samples */
     return clip;
 }
 
+/*-------------------------------------------------
+ * State of the modulation curve generator, so that
+ * the curve can be generated block by block
+ *-------------------------------------------------*/
+typedef struct
+{
+    double m_prev;   /* Modulation at the start of the transition */
+    double m_new;    /* Modulation at the end of the transition   */
+    long j;          /* Position in the transition                */
+} mod_state;
+
+void mod_state_init(
+    mod_state *ms    /* o: Modulation curve generator state */
+)
+{
+    ms->m_prev = 1.0;
+    ms->m_new = 1.0;
+    ms->j = 0;
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Modulation curve: a new target is drawn at the
+ * start of each transition of step samples, with a
+ * smaller step in high energy segments (es >= el)
+ *-------------------------------------------------*/
+void mod_curve(
+    const double *es,          /*  i: Short-term smoothed energy          */
+    const double *el,          /*  i: Long-term smoothed energy           */
+    const long length,         /*  i: Length of block in samples          */
+    const long step,           /*  i: Length of transition in samples     */
+    const double e_step,       /*  i: Energy step in high energy segments */
+          float *fseed,        /*i/o: Random number generator seed/state  */
+          mod_state *ms,       /*i/o: Modulation curve generator state    */
+          double *m            /*  o: Modulation curve                    */
+)
+{
+    long i;
+    double m_delta;
+    double xf_win;
+
+    for( i = 0; i < length; i++ )
+    {
+        if( ms->j == 0 )
+        {
+            if( (ran16_32c( fseed ) / ((double)RAN16_32C_MAX)) < 0.2 )
+            { 
+                if( es[i] < el[i] )
+                {
+                    m_delta = 1.0;
+                }
+                else
+                {
+                    m_delta = e_step;
+                }
+                ms->m_new = ran16_32c( fseed ) / ((double)RAN16_32C_MAX) * m_delta + ms->m_prev * (1.0 - m_delta);
+            }
+            else
+            {
+                ms->m_new = ms->m_prev;
+            }
+        }
+
+        xf_win = 0.5 * (1.0 - cos( LOCAL_PI * ms->j / step ));
+        m[i] = ms->m_new * xf_win + ms->m_prev * (1.0 - xf_win);
+
+        if( ++ms->j == step )
+        {
+            ms->m_prev = ms->m_new;
+            ms->j = 0;
+        }
+    }
+
+    return;
+}
+
 void g_mod_nrg(
     const double *input,       /*  i: Stereo input signal                 */
     const long length,         /*  i: Length of input signal in samples   */
@@ -168,21 +291,18 @@ void g_mod_nrg(
     const short energy_input,  /*  i: Flag for energy input               */
     const short energy_output, /*  i: Flag for energy output              */
     FILE* f_energy,            /*i/o: Energy file pointer                 */
+    FILE* f_mod,               /*  o: Modulation curve file, or NULL      */
           float *fseed,        /*i/o: Random number generator seed/state  */
           double *m            /*  o: Modulation curve                    */
 )
 {
-    long i, j, M;
     double *e,*es,*el;
-    double m_prev, m_delta, m_new;
-    double xf_win;
+    mod_state ms;
     
     e = malloc( sizeof( double )*length );
     es = malloc( sizeof( double )*length );
     el = malloc( sizeof( double )*length );
 
-    M = length / step + ((length % step) > 0); /* M = ceil(length/step) */
-
     energy( input, e, length );
 
     ar1( 0.001, e, es, length, -1 );
@@ -202,40 +322,12 @@ void g_mod_nrg(
         fwrite( el, sizeof( double ), length, f_energy );
     }
 
-    i = 0;
-    m_prev = 1.0;
-    while( i < length )    
-    {
-        if( (ran16_32c( fseed ) / ((double)RAN16_32C_MAX)) < 0.2 )
-        { 
-            if( es[i] < el[i] )
-            {
-                m_delta = 1.0;
-            }
-            else
-            {
-                m_delta = e_step;
-            }
-            m_new = ran16_32c( fseed ) / ((double)RAN16_32C_MAX) * m_delta + m_prev * (1.0 - m_delta);
-        }
-        else
-        {
-            m_new = m_prev;
-        }
-
-        for(j = 0; j < step && i < length; i++,j++ )
-        {
-            xf_win = 0.5 * (1.0 - cos( LOCAL_PI * j / step ));
-            m[i] = m_new * xf_win + m_prev * (1.0 - xf_win);
-        }
-        m_prev = m_new;
-    }
+    mod_state_init( &ms );
+    mod_curve( es, el, length, step, e_step, fseed, &ms, m );
 
+    if( f_mod != NULL )
     {
-    FILE *fp;
-    fp = fopen("mc.double","wb");
-    fwrite(m,sizeof(double),length,fp);
-    fclose(fp);
+        fwrite( m, sizeof( double ), length, f_mod );
     }
 
     free( e );
@@ -269,11 +361,230 @@ void apply_spatial_dist(
     return;
 }
 
+/*-------------------------------------------------
+ * Look-ahead after which the tail of a backward
+ * ar1() filter weighs less than STREAM_TOL
+ *-------------------------------------------------*/
+long ar1_lookahead(
+    const double fac      /* i: filter coefficient */
+)
+{
+    return (long) ceil( log( STREAM_TOL ) / log( 1.0 - fac ) );
+}
+
+/*-------------------------------------------------
+ * Read up to length stereo samples, also from pipes
+ *-------------------------------------------------*/
+long read_stereo(
+    short *buf,           /* o: Stereo samples               */
+    const long length,    /* i: Number of samples to read    */
+    FILE *f_input         /* i: Input file pointer           */
+)
+{
+    long n, got;
+
+    n = 0;
+    while( n < 2 * length && (got = (long) fread( buf + n, sizeof( short ), 2 * length - n, f_input )) > 0 )
+    {
+        n += got;
+    }
+
+    return n / 2;
+}
+
+/*-------------------------------------------------
+ * Streaming ESDRU: the signal is processed in blocks
+ * of `block' samples, with the memory bounded by
+ * the look-ahead of the backward smoothing filters.
+ *
+ * For each block, the backward ar1() passes start
+ * from a zero memory at the end of the look-ahead
+ * (or at the end of the signal, as the whole-file
+ * version does), while the forward passes and the
+ * modulation curve continue from the previous block.
+ * The look-ahead of each backward filter is such
+ * that the neglected tail weighs less than
+ * STREAM_TOL relative to the energies in the window,
+ * i.e. the smoothed energies match those of the
+ * whole-file version to within STREAM_TOL of the
+ * peak energy of the look-ahead (for signals shorter
+ * than the look-ahead, they are identical). The
+ * output is then the same, unless es and el are
+ * compared within that margin, e.g. after digital
+ * silence longer than the look-ahead.
+ *-------------------------------------------------*/
+long esdru_stream(         /* returns number of clipped samples       */
+    FILE* f_input,             /*  i: Input file pointer                  */
+    FILE* f_output,            /*  o: Output file pointer                 */
+    const long step,           /*  i: Length of transition in samples     */
+    const double e_step,       /*  i: Energy step in high energy segments */
+    const double alpha,        /*  i: Modulation strength [0.0 ... 1.0]   */
+    const short energy_input,  /*  i: Flag for energy input               */
+    const short energy_output, /*  i: Flag for energy output              */
+    FILE* f_energy,            /*i/o: Energy file pointer                 */
+    FILE* f_mod,               /*  o: Modulation curve file, or NULL      */
+    const long block,          /*  i: Samples output per block            */
+          float *fseed,        /*i/o: Random number generator seed/state  */
+          long *length         /*  o: Number of samples processed         */
+)
+{
+    long la_s, la_l, size, avail, nb, nl, pos, e_len, clip;
+    short *buf, *out_short;
+    double *es, *el, *m, *out;
+    double mem_es, mem_el;
+    short eof;
+    mod_state ms;
+    FILE *f_el;
+
+    la_s = ar1_lookahead( 0.001 );
+    la_l = ar1_lookahead( 0.0001 );
+    size = block + la_s + la_l;
+
+    buf = malloc( sizeof( short ) * size * 2 );
+    es = malloc( sizeof( double ) * size );
+    el = malloc( sizeof( double ) * size );
+    m = malloc( sizeof( double ) * block );
+    out = malloc( sizeof( double ) * block * 2 );
+    out_short = malloc( sizeof( short ) * block * 2 );
+    if( buf == NULL || es == NULL || el == NULL || m == NULL || out == NULL || out_short == NULL )
+    {
+        fprintf( stderr, "Could not allocate memory, exiting..\n" );
+        exit( -1 );
+    }
+
+    /* The energy file holds all es, then all el: el goes to a temporary file
+       on output, and is read at the offset given by the file size on input */
+    f_el = NULL;
+    e_len = 0;
+    if( energy_output == 1 && (f_el = tmpfile()) == NULL )
+    {
+        fprintf( stderr, "Could not open temporary energy file, exiting..\n" );
+        exit( -1 );
+    }
+    if( energy_input == 1 )
+    {
+        fseek( f_energy, 0L, SEEK_END );
+        e_len = ftell( f_energy ) / (2 * sizeof( double ));
+    }
+
+    mem_es = 0.0;
+    mem_el = 0.0;
+    mod_state_init( &ms );
+    clip = 0;
+    pos = 0;
+    avail = 0;
+    eof = 0;
+
+    while( 1 )
+    {
+        /* Fill the look-ahead */
+        if( !eof )
+        {
+            nb = read_stereo( buf + 2 * avail, size - avail, f_input );
+            avail += nb;
+            eof = (avail < size);
+        }
+        if( avail == 0 )
+        {
+            break;
+        }
+
+        /* Samples output in this block, and valid length of the forward-smoothed es */
+        if( eof )
+        {
+            nb = (avail < block) ? avail : block;
+            nl = avail;
+        }
+        else
+        {
+            nb = block;
+            nl = avail - la_s;
+        }
+
+        /* Short-term energy: backward pass over the look-ahead, forward pass continued */
+        {
+            long i;
+            for( i = 0; i < avail; i++ )
+            {
+                es[i] = (double) buf[2 * i] * buf[2 * i] + (double) buf[2 * i + 1] * buf[2 * i + 1];
+            }
+        }
+        {
+            double mem = 0.0, mem_fw = mem_es;
+            ar1_mem( 0.001, es, es, avail, -1, &mem );
+            ar1_mem( 0.001, es, es, nb, 1, &mem_fw );
+            mem_es = mem_fw;
+            ar1_mem( 0.001, es + nb, es + nb, nl - nb, 1, &mem_fw );
+        }
+
+        /* Long-term energy, from the short-term one */
+        {
+            double mem = 0.0;
+            ar1_mem( 0.0001, es, el, nl, -1, &mem );
+            ar1_mem( 0.0001, el, el, nb, 1, &mem_el );
+            scale_double( el, 0.77813, el, nb );
+        }
+
+        if( energy_input == 1 )
+        {
+            fseek( f_energy, (long) (pos * sizeof( double )), SEEK_SET );
+            fread( es, sizeof( double ), nb, f_energy );
+            fseek( f_energy, (long) ((e_len + pos) * sizeof( double )), SEEK_SET );
+            fread( el, sizeof( double ), nb, f_energy );
+        }
+        if( energy_output == 1 )
+        {
+            fwrite( es, sizeof( double ), nb, f_energy );
+            fwrite( el, sizeof( double ), nb, f_el );
+        }
+
+        mod_curve( es, el, nb, step, e_step, fseed, &ms, m );
+        if( f_mod != NULL )
+        {
+            fwrite( m, sizeof( double ), nb, f_mod );
+        }
+
+        convert_short2double( buf, out, nb * 2 );
+        apply_spatial_dist( out, nb, m, alpha );
+        clip += convert_double2short( out, out_short, nb * 2 );
+        fwrite( out_short, sizeof( short ), nb * 2, f_output );
+
+        /* Move on to the next block */
+        memmove( buf, buf + 2 * nb, sizeof( short ) * (avail - nb) * 2 );
+        avail -= nb;
+        pos += nb;
+    }
+
+    /* Append el to the energy file */
+    if( f_el != NULL )
+    {
+        rewind( f_el );
+        while( (nb = (long) fread( es, sizeof( double ), size, f_el )) > 0 )
+        {
+            fwrite( es, sizeof( double ), nb, f_energy );
+        }
+        fclose( f_el );
+    }
+
+    free( buf );
+    free( es );
+    free( el );
+    free( m );
+    free( out );
+    free( out_short );
+
+    *length = pos;
+
+    return clip;
+}
+
 int main(int argc, char **argv )
 {
     FILE* f_input;
     FILE* f_output;
     FILE* f_energy;
+    FILE* f_mod;
+    FILE* f_log;
     char *input_filename;
     char *output_filename;
     double *input;
@@ -290,6 +601,8 @@ int main(int argc, char **argv )
     long i;
     short energy_input;
     short energy_output;
+    short stream;
+    long block;
 
     fs = 48000;   /* Default sampling frequency */
     e_step = 0.5; /* Default allowed modulation step during high energy segments */
@@ -298,6 +611,9 @@ int main(int argc, char **argv )
     energy_input = 0;
     energy_output = 0;
     f_energy = NULL;
+    f_mod = NULL;
+    stream = 0;
+    block = STREAM_BLOCK;
 
     /* Command line parsing */
     if (argc == 1)
@@ -363,6 +679,30 @@ int main(int argc, char **argv )
             energy_input = 1;
             i += 2;
         }
+        else if( strcmp( argv[i], "-m_out" ) == 0 )
+        {
+            if( (f_mod = fopen( argv[i + 1], "wb" )) == NULL )
+            {
+                fprintf( stderr, "Could not open modulation curve output file %s, exiting..\n\n", argv[i + 1] );
+                usage();
+            }
+            i += 2;
+        }
+        else if( strcmp( argv[i], "-stream" ) == 0 )
+        {
+            stream = 1;
+            i++;
+        }
+        else if( strcmp( argv[i], "-block" ) == 0 )
+        {
+            if( sscanf( argv[i + 1], "%ld", &block ) != 1 || block <= 0 )
+            {
+                fprintf( stderr, "Invalid block size %s, exiting..\n", argv[i + 1] );
+                usage();
+            }
+            stream = 1;
+            i += 2;
+        }
         else
         {
             fprintf( stderr, "Invalid option %s, exiting..\n", argv[i] );
@@ -398,48 +738,79 @@ int main(int argc, char **argv )
     }
     input_filename = argv[i++];
     output_filename = argv[i];
-    if( (f_input = fopen( input_filename, "rb" )) == NULL )
+    f_log = stdout;
+    if( strcmp( input_filename, "-" ) == 0 )
+    {
+        f_input = stdin;
+#if defined(_WIN32)
+        _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+        stream = 1;
+    }
+    else if( (f_input = fopen( input_filename, "rb" )) == NULL )
     {
         fprintf( stderr, "Could not open input file %s, exiting..\n\n", input_filename );
         usage();
     }
-    if( (f_output = fopen( output_filename, "wb" )) == NULL )
+    if( strcmp( output_filename, "-" ) == 0 )
+    {
+        f_output = stdout;
+#if defined(_WIN32)
+        _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+        f_log = stderr;
+        stream = 1;
+    }
+    else if( (f_output = fopen( output_filename, "wb" )) == NULL )
     {
         fprintf( stderr, "Could not open output file %s, exiting..\n\n", output_filename );
         usage();
     }
 
     /* Print settings */
-    fprintf( stdout, "Input file:       %s\n", input_filename );
-    fprintf( stdout, "Output file:      %s\n", output_filename );
-    fprintf( stdout, "alpha:            %f\n", alpha );
-    fprintf( stdout, "e_step:           %f\n", e_step );
-    fprintf( stdout, "seed:             %u\n", intseed );
-    fprintf( stdout, "Sampling rate:    %ld\n", fs );
+    fprintf( f_log, "Input file:       %s\n", input_filename );
+    fprintf( f_log, "Output file:      %s\n", output_filename );
+    fprintf( f_log, "alpha:            %f\n", alpha );
+    fprintf( f_log, "e_step:           %f\n", e_step );
+    fprintf( f_log, "seed:             %u\n", intseed );
+    fprintf( f_log, "Sampling rate:    %ld\n", fs );
 
     /* Set random seed */
     fseed = (float) intseed;
 
-    /* Load input file */
-    fseek( f_input, 0L, SEEK_END );
-    length = ftell( f_input ) / 4; /* 2 bytes per sample, 2 channels */
-    rewind( f_input );
-    input = malloc(sizeof(double) * length * 2);
-    input_short = malloc( sizeof( short ) * length * 2 );
-    m = malloc( sizeof( double ) * length );
-    fread( input_short, sizeof(short), length * 2, f_input);
-    convert_short2double( input_short, input, length * 2);
-
     step = (long) (1.5 * fs / 50.0);
-    g_mod_nrg( input, length, step, e_step, energy_input, energy_output, f_energy, &fseed, m );
 
-    apply_spatial_dist( input, length, m, alpha );
+    if( stream == 1 )
+    {
+        fprintf( f_log, "Mode:             streaming\n" );
+        clip = esdru_stream( f_input, f_output, step, e_step, alpha, energy_input, energy_output, f_energy, f_mod, block, &fseed, &length );
+    }
+    else
+    {
+        /* Load input file */
+        fseek( f_input, 0L, SEEK_END );
+        length = ftell( f_input ) / 4; /* 2 bytes per sample, 2 channels */
+        rewind( f_input );
+        input = malloc(sizeof(double) * length * 2);
+        input_short = malloc( sizeof( short ) * length * 2 );
+        m = malloc( sizeof( double ) * length );
+        fread( input_short, sizeof(short), length * 2, f_input);
+        convert_short2double( input_short, input, length * 2);
+
+        g_mod_nrg( input, length, step, e_step, energy_input, energy_output, f_energy, f_mod, &fseed, m );
 
-    clip = convert_double2short(input, input_short, length * 2);
+        apply_spatial_dist( input, length, m, alpha );
 
-    fwrite( input_short, sizeof( short ), length * 2, f_output );
+        clip = convert_double2short(input, input_short, length * 2);
 
-    fprintf( stdout, "--> Done processing %ld samples\n", length );
+        fwrite( input_short, sizeof( short ), length * 2, f_output );
+
+        free( input );
+        free( input_short );
+        free( m );
+    }
+
+    fprintf( f_log, "--> Done processing %ld samples\n", length );
     if (clip > 0)
     {
         fprintf( stderr, "*** Warning: %ld samples clipped\n", clip );
@@ -449,11 +820,12 @@ int main(int argc, char **argv )
     {
         fclose( f_energy );
     }
+    if ( f_mod != NULL )
+    {
+        fclose( f_mod );
+    }
     fclose( f_input );
     fclose( f_output );
-    free( input );
-    free( input_short );
-    free( m );
 
 }
 
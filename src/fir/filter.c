@@ -41,6 +41,10 @@
                   samples are inserted in the begining of the file,
                   d<0 causes samples to be dropped. Default is d=0.
   -q ............ quiet processing (no progress flag)
+  -fast ......... use the fastest (SIMD) FIR dot-product kernel for this
+                  CPU; results may differ by +-1 LSB from the reference
+  -exact ........ use the scalar FIR dot-product kernel that is bit-exact to
+                  the reference implementation (default)
 
   Valid filter specifications:
   Flt_type Description
@@ -255,6 +259,8 @@ void display_usage () {
   printf ("               samples are inserted in the begining of the file,\n");
   printf ("               d<0 causes samples to be dropped. Default is d=0.\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
+  printf ("  -fast ...... use the SIMD FIR kernel (may differ by +-1 LSB)\n");
+  printf ("  -exact ..... use the bit-exact scalar FIR kernel (default)\n");
   printf ("\n");
   printf (" Valid filter specifications:\n");
   printf ("  Flt_type Description\n");
@@ -359,6 +365,20 @@ int main (int argc, char *argv[]) {
         /* Change sampling frequency */
         quiet = 1;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Use fastest FIR dot-product kernel */
+        hq_kernel_mode (FIR_KERNEL_FAST);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-exact") == 0) {
+        /* Use bit-exact FIR dot-product kernel */
+        hq_kernel_mode (FIR_KERNEL_EXACT);
+
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
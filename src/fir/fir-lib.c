@@ -1,4 +1,4 @@
-/*                                                          v2.3 - 03/Dec/2004
+/*                                                          v2.6 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -46,6 +46,9 @@ FUNCTIONS:
                                     (needed only if another signal should
                                     be processed with the same filter)
          = hq_free(...)          :  deallocate FIR-filter memory
+         = hq_kernel_mode(...)   :  select fast (SIMD) or bit-exact
+                                    dot-product kernel
+         = hq_kernel_name(...)   :  name of the selected kernel
 
   Local (Used by other sub-units of this module, should not be needed by
          the user's program. Prototypes here and in the sub-units that use
@@ -57,6 +60,8 @@ FUNCTIONS:
                                    up-sampling procedures;
          = fir_downsampling_kernel(...) : kernel function for all FIR
                                    down-sampling procedures;
+         = fir_dot_*(...)        : dot-product kernels (scalar, SSE2, AVX,
+                                   NEON) selected by hq_kernel_mode();
 
 HISTORY:
     16.Dec.91 v0.1 First beta-version <hf@pkinbg.uucp>
@@ -71,6 +76,24 @@ HISTORY:
 				   OpenVMS/AXP <simao@ctd.comsat.com>
     03.Dec.04 v2.3 Added correction in fir_downsampling_kernel() for sample-based
 				   operation.	<Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+    16.Oct.26 v2.4 fir_upsampling_kernel() uses a polyphase coefficient bank
+                   built by fir_initialization(), so that each output phase
+                   runs a unit-stride dot product over the non-zero taps only.
+                   Results are bit-exact to v2.3.
+    16.Oct.26 v2.5 Polyphase bank stored time-reversed, so that the
+                   steady-state part of both kernels is a dot product of two
+                   contiguous, ascending arrays. By default it is computed
+                   by a scalar kernel that keeps the summation order of v2.3
+                   and thus is bit-exact to it. hq_kernel_mode(FIR_KERNEL_FAST)
+                   selects a SIMD kernel at run time (SSE2/AVX on x86, NEON
+                   on ARM, scalar elsewhere); the SIMD kernels use several
+                   partial sums and may differ in the last bits of the
+                   single-precision result.
+    16.Oct.26 v2.6 Delay line T is a doubled circular buffer holding the
+                   last lenhp input samples twice, so that every dot product
+                   reads one contiguous window and no shift/copy of T is
+                   needed at the end of a segment. Per-segment overhead no
+                   longer depends on the filter length; bit-exact to v2.5.
 
   =============================================================================
 */
@@ -84,6 +107,20 @@ HISTORY:
 
 #include "firflt.h"             /* Global definitions for FIR-FIR filter */
 
+/* SIMD instruction sets usable for the dot-product kernels */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIR_USE_AVX             /* compiled with target attribute, selected at run time */
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FIR_USE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FIR_USE_NEON
+#include <arm_neon.h>
+#endif
+
 
 /*
  * ......... Local function prototypes .........
@@ -92,8 +129,19 @@ HISTORY:
 
 SCD_FIR *fir_initialization ARGS ((long lenh0, float h0[], double gain, long idwnup, int hswitch));
 
-static long fir_upsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long iupfac));
-static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long downfac, long *k0_ptr));
+static long fir_upsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenhp, float *hp_ptr, float *T_ptr, long *kT_ptr, long iupfac));
+static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *hr_ptr, float *T_ptr, long *kT_ptr, long downfac, long *k0_ptr));
+static float fir_dot_exact ARGS ((float *x, float *hr, long n));
+static float fir_dot_scalar ARGS ((float *x, float *hr, long n));
+
+
+/*
+ * ......... Local variables .........
+ */
+
+/* Dot-product kernel used by the up-/down-sampling kernels; set statically to the default (bit-exact) kernel, so that filters may be initialized concurrently */
+static float (*fir_dot) ARGS ((float *x, float *hr, long n)) = fir_dot_exact;
+static char *fir_dot_name = "exact";
 
 
 /*
@@ -149,9 +197,10 @@ long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
                                    lseg,        /* In : length of input signal */
                                    x_ptr,       /* In : array with input samples */
                                    y_ptr,       /* Out : array with output samples */
-                                   fir_ptr->lenh0,      /* In : number of FIR-coefficients */
-                                   fir_ptr->h0, /* In : array with FIR-coefficients */
+                                   fir_ptr->lenhp,      /* In : number of coefficients per phase */
+                                   fir_ptr->hp, /* In : polyphase coefficient bank */
                                    fir_ptr->T,  /* InOut: state variables */
+                                   &(fir_ptr->kT),      /* InOut: position in delay line */
                                    fir_ptr->dwn_up      /* In : upsampling factor */
       );
   else                          /* call down-sampling procedure */
@@ -160,8 +209,9 @@ long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
                                      x_ptr,     /* In : array with input samples */
                                      y_ptr,     /* Out : array with output samples */
                                      fir_ptr->lenh0,    /* In : number of FIR-coefficients */
-                                     fir_ptr->h0,       /* In : array with FIR-coefficients */
+                                     fir_ptr->hp,       /* In : time-reversed FIR-coefficients */
                                      fir_ptr->T,        /* InOut: state variables */
+                                     &(fir_ptr->kT),    /* InOut: position in delay line */
                                      fir_ptr->dwn_up,   /* In : downsampling factor */
                                      &(fir_ptr->k0)     /* InOut: starting index in * x-array */
       );
@@ -205,6 +255,7 @@ void hq_free (SCD_FIR * fir_ptr) {
 
   free (fir_ptr->T);            /* free state variables */
   free (fir_ptr->h0);           /* free state impulse response */
+  free (fir_ptr->hp);           /* free polyphase coefficient bank */
   free (fir_ptr);               /* free allocated struct */
 }
 
@@ -238,13 +289,15 @@ void hq_free (SCD_FIR * fir_ptr) {
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Circular delay line.
 
  ============================================================================
 */
 void hq_reset (SCD_FIR * fir_ptr) {
   long k;
-  for (k = 0; k < fir_ptr->lenh0 - 1; k++)      /* clear delay line */
+  for (k = 0; k < 2 * fir_ptr->lenhp; k++)      /* clear delay line */
     fir_ptr->T[k] = 0.0;        /* (= state variables) */
+  fir_ptr->kT = 0;              /* position of oldest sample in delay line */
   fir_ptr->k0 = 0;              /* default starting index in x-array */
 }
 
@@ -283,13 +336,18 @@ void hq_reset (SCD_FIR * fir_ptr) {
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
         12.Mar.92 v1.1 Corrected casting of malloc.
+        16.Oct.26 v1.2 Build polyphase coefficient bank for up-sampling.
+        16.Oct.26 v1.3 Bank stored time-reversed, also for down-sampling.
+        16.Oct.26 v1.4 Doubled circular delay line of 2*lenhp samples.
+        17.Oct.26 v1.5 Default kernel set statically instead of on the
+                       first call.
 
  ============================================================================
 */
 SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, int hswitch) {
   SCD_FIR *ptrFIR;              /* pointer to the new struct */
   float fak;
-  long k;
+  long k, iup;
 
 
 /*
@@ -301,8 +359,11 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
     return 0;
   }
 
-  /* Allocate memory for delay line */
-  if ((ptrFIR->T = (float *) malloc ((lenh0 - 1) * sizeof (fak))) == (float *) 0) {
+  /* Number of input samples per dot product: lenh0/idwnup per polyphase branch for up-sampling, lenh0 otherwise */
+  ptrFIR->lenhp = (hswitch == 'U') ? lenh0 / idwnup : lenh0;
+
+  /* Allocate memory for delay line: the last lenhp input samples are kept twice in a circular buffer */
+  if ((ptrFIR->T = (float *) malloc (2 * ptrFIR->lenhp * sizeof (fak))) == (float *) 0) {
     free (ptrFIR);              /* deallocate struct FIR */
     return 0;
   }
@@ -314,6 +375,14 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
     return 0;
   }
 
+  /* Allocate memory for polyphase coefficient bank */
+  if ((ptrFIR->hp = (float *) malloc (lenh0 * sizeof (fak))) == (float *) 0) {
+    free (ptrFIR->h0);          /* deallocate impulse response */
+    free (ptrFIR->T);           /* deallocate delay line */
+    free (ptrFIR);              /* deallocate struct FIR */
+    return 0;
+  }
+
 /*
  * ......... STORE VARIABLES INTO STATE VARIABLE .........
  */
@@ -328,12 +397,23 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   /* Store down-/up-sampling factor */
   ptrFIR->dwn_up = idwnup;
 
+  /* Fill polyphase coefficient bank: branch 'iup' holds the coefficients h0[iup], h0[iup+idwnup], h0[iup+2*idwnup], ..., which are the only ones hitting non-zero samples of the zero-stuffed input. Down-sampling uses a single branch with all coefficients (fir_downsampling_kernel() already evaluates only the kept output samples). Branches are stored time-reversed, so that the dot products run over ascending, contiguous arrays */
+  if (hswitch == 'U') {
+    for (iup = 0; iup < idwnup; iup++)
+      for (k = 0; k < ptrFIR->lenhp; k++)
+        ptrFIR->hp[iup * ptrFIR->lenhp + ptrFIR->lenhp - 1 - k] = ptrFIR->h0[iup + k * idwnup];
+  } else {
+    for (k = 0; k < lenh0; k++)
+      ptrFIR->hp[lenh0 - 1 - k] = ptrFIR->h0[k];
+  }
+
   /* Store switch to FIR-kernel (up- or downsampling function) */
   ptrFIR->hswitch = hswitch;
 
   /* Clear Delay Line */
-  for (k = 0; k < ptrFIR->lenh0 - 1; k++)
+  for (k = 0; k < 2 * ptrFIR->lenhp; k++)
     ptrFIR->T[k] = 0.0;
+  ptrFIR->kT = 0;
 
   /* Store default starting index for the x-array */
   /* NOTE: for down-sampling: if the number of input samples is not a multiple of the down-sampling factor, k0 points to the first sample in the next input segment to be processed */
@@ -350,8 +430,9 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   ============================================================================
 
         long fir_downsampling_kernel (long lenx, float *x_ptr, float *y_ptr,
-        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *h0_ptr, float *T_ptr,
-                                      long downfac, long *k0_ptr);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *hr_ptr, float *T_ptr,
+                                      long *kT_ptr, long downfac,
+                                      long *k0_ptr);
 
         Description:
         ~~~~~~~~~~~~
@@ -359,14 +440,22 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
         FIR-Filter (kernel) (for down-sampling, including downsampling
         factor 1).
 
+        Every input sample is stored in the doubled circular delay line
+        T[] at positions kT and kT+lenh0, so that T[kT+1 .. kT+lenh0]
+        always holds the last lenh0 input samples in a contiguous
+        window, oldest first. Output samples are the dot products of
+        this window with the time-reversed coefficients, computed every
+        'downfac' input samples.
+
         Parameters:
         ~~~~~~~~~~~
         lenx: ..... (In)    length of input signal
         x: ........ (In)    array with input samples
         y: ........ (Out)   array with output samples
         lenh0: .... (In)    number of  FIR-coefficients
-        h0: ....... (In)    array with FIR-coefficients
-        T: ........ (InOut) state variables
+        hr: ....... (In)    array with time-reversed FIR-coefficients
+        T: ........ (InOut) state variables (2*lenh0 samples)
+        kT: ....... (InOut) position of the oldest sample in T[]
         downfac: .. (In)    downsampling factor
         k0: ....... (InOut) offset in x-array
 
@@ -382,80 +471,37 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
         28.Feb.1992 v1.0 Release of 1st version <hf@pkinbg.uucp>
         12.Jul.2000 -    Bug identified; correction solicited  <simao>
 		03.Dec.2004 v2.3 Sample-based bug solved. <Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+        16.Oct.2026 v2.4 Time-reversed coefficients; steady state computed
+                         by the selected dot-product kernel.
+        16.Oct.2026 v2.5 Doubled circular delay line: no transition
+                         part, no update of T[] at the end of the segment.
 
  ============================================================================
 */
-static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0, float *h0, float *T, long downfac, long *k0) {
-  long ktrans, kx, kStart, ky, kappa;   /* loop indices */
-
+static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0, float *hr, float *T, long *kT, long downfac, long *k0) {
+  long kx, ky, kw;              /* loop indices */
 
-/*
-  * ......... First Step: Transition from k=0 ... k=lenh0-2 .........
-  */
 
-  kStart = *k0;
   ky = 0;                       /* starting index in output array (y) */
-  ktrans = lenh0 - 1;
-  if (ktrans > lenx - 1)
-    ktrans = lenx - 1;          /* x[*] less than h0[*]? */
-
-  for (kx = *k0; kx <= ktrans; kx += downfac) {
-    y[ky] = x[kx] * h0[0];      /* first part in dot-product */
-    for (kappa = 1; kappa <= kx; kappa++) {     /* first part from x-array */
-      y[ky] += x[kx - kappa] * h0[kappa];
-    }
+  kw = *kT;                     /* position of oldest sample in delay line */
 
-    for (kappa = kx + 1; kappa < lenh0; kappa++) {      /* second part from * T-array */
-      y[ky] += T[lenh0 - 2 + kx + 1 - kappa] * h0[kappa];
-    }
-    ky++;
-    kStart = kx;                /* Save index of last processed sample */
-  }
+  for (kx = 0; kx <= lenx - 1; kx++) {
+    /* Store the new sample twice in the circular delay line */
+    T[kw] = T[kw + lenh0] = x[kx];
+    if (++kw == lenh0)
+      kw = 0;
 
-
-/*
-  * ......... Second Step: remaining part in x-array .........
-  */
-
-  *k0 = kStart;
-  for (kx = kStart + downfac; kx <= lenx - 1; kx += downfac) {
-    y[ky] = x[kx] * h0[0];      /* first part in dot-product */
-    for (kappa = 1; kappa <= lenh0 - 1; kappa++) {
-      y[ky] += x[kx - kappa] * h0[kappa];       /* remaining part of dot-product */
+    /* Compute output only for every 'downfac'-th input sample */
+    if (kx == *k0) {
+      y[ky] = fir_dot (&T[kw], hr, lenh0);      /* dot-product with the last lenh0 samples */
+      ky++;
+      *k0 += downfac;
     }
-    ky++;
-    *k0 = kx;
   }
+  *kT = kw;
 
   /* if the number of input samples is not a multiple of the down sampling factor, k0 points to the first sample in the next input segment to be processed */
-  if (*k0 <= lenx - 1) {
-    *k0 = *k0 + downfac;
-    *k0 = *k0 - lenx;
-  } else {                      /* if the offset was greater than the block length, nothing was done. * Just decrease the value of this offset with the size of this "skipped" block */
-    *k0 = *k0 - lenx;
-  }
-
-
-/*
- * ......... Last Step: copy end of x-array into T-array .........
- *                      (update of delay line)
- */
-
-  if (lenx >= lenh0 - 1) {      /* ... all samples taken from x-array */
-    for (kappa = 0; kappa <= lenh0 - 2; kappa++) {
-      T[kappa] = x[lenx + 1 - lenh0 + kappa];
-    }
-  } else {
-    /* Left-Shift of T-array */
-    for (kappa = 0; kappa <= lenh0 - 2 - lenx; kappa++) {
-      T[kappa] = T[kappa + lenx];
-    }
-
-    /* Copy complete x-array -> T-array */
-    for (kappa = lenh0 - 1 - lenx; kappa <= lenh0 - 2; kappa++) {
-      T[kappa] = x[lenx - 1 + kappa - (lenh0 - 2)];
-    }
-  }
+  *k0 -= lenx;
 
   /* Return number of output samples */
   return ky;
@@ -469,22 +515,30 @@ static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0,
   ============================================================================
 
         long fir_upsampling_kernel (long lenx, float *x_ptr, float *y_ptr,
-        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *h0_ptr, float *T_ptr,
-                                    long iupfac);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenhp, float *hp_ptr, float *T_ptr,
+                                    long *kT_ptr, long iupfac);
 
         Description:
         ~~~~~~~~~~~~
 
-        FIR-Filter (kernel) for upsampling routine.
+        FIR-Filter (kernel) for upsampling routine. The filter is
+        evaluated in polyphase form: for every input sample, each of the
+        'iupfac' output samples is the dot product of one branch of the
+        polyphase coefficient bank with the last 'lenhp' input samples,
+        i.e. the zero-stuffed samples are never multiplied.
+
+        The input samples are stored in the doubled circular delay line
+        T[] as in fir_downsampling_kernel().
 
         Parameters:
         ~~~~~~~~~~~
         lenx: .... (In)    length of input signal
         x: ....... (In)    array with input samples
         y: ....... (Out)   array with output samples
-        lenh0: ... (In)    number of  FIR-coefficients
-        h0: ...... (In)    array with FIR-coefficients
-        T: ....... (InOut) state variables
+        lenhp: ... (In)    number of coefficients per polyphase branch
+        hp: ...... (In)    time-reversed polyphase bank (iupfac x lenhp)
+        T: ....... (InOut) state variables (2*lenhp samples)
+        kT: ...... (InOut) position of the oldest sample in T[]
         iupfac: .. (In)    upsampling factor
 
         Return value:
@@ -497,95 +551,261 @@ static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0,
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Use contiguous polyphase branches instead of
+                       strided access to the FIR-coefficients.
+        16.Oct.26 v1.2 Time-reversed branches; steady state computed by
+                       the selected dot-product kernel.
+        16.Oct.26 v1.3 Doubled circular delay line: no transition part,
+                       no update of T[] at the end of the segment.
 
  ============================================================================
 */
-static long fir_upsampling_kernel (lenx, x, y, lenh0, h0, T, iupfac)
-     long lenx;
-     float *x, *y;
-     long lenh0;
-     float *h0, *T;
-     long iupfac;
-{
-  long ktrans, iup, kx, kStart, ky, kappa;      /* loop indices */
+static long fir_upsampling_kernel (long lenx, float *x, float *y, long lenhp, float *hp, float *T, long *kT, long iupfac) {
+  long iup, kx, ky, kw;         /* loop indices */
+  float *h;                     /* current polyphase branch */
 
 
   ky = 0;                       /* starting index in output array (y) */
+  kw = *kT;                     /* position of oldest sample in delay line */
 
-/*
-  * ......... FIRST STEP: Transition from k=(0..lenh0/iupasm-2) .........
-  */
-
-  kStart = 0;
-  ktrans = (lenh0 / iupfac > lenx ?     /* length of transition */
-            lenx : lenh0 / iupfac);
-  for (kx = 0; kx <= ktrans - 1; kx++) {
-    /* Loop over #iupfac partial FIR coefficients */
-    for (iup = 0; iup <= iupfac - 1; iup++) {
-      /* ... first contribution in dot-product */
-      y[ky] = x[kx] * h0[iup];
-
-      /* ... compute partial dot-product with source data from x-array */
-      for (kappa = 1; kappa <= kx; kappa++) {
-        y[ky] += x[kx - kappa] * h0[iup + kappa * iupfac];
-      }
-
-      /* ... compute rest of dot-product with source data from T-array */
-      for (kappa = kx + 1; kappa < lenh0 / iupfac; kappa++) {
-        y[ky] += T[lenh0 / iupfac - 2 + kx + 1 - kappa]
-          * h0[iup + kappa * iupfac];
-      }
+  for (kx = 0; kx <= lenx - 1; kx++) {
+    /* Store the new sample twice in the circular delay line */
+    T[kw] = T[kw + lenhp] = x[kx];
+    if (++kw == lenhp)
+      kw = 0;
+
+    /* Loop over #iupfac polyphase branches */
+    for (iup = 0, h = hp; iup <= iupfac - 1; iup++, h += lenhp) {
+      y[ky] = fir_dot (&T[kw], h, lenhp);       /* dot-product with the last lenhp samples */
       ky++;
     }
-    kStart = kx;                /* Save index of last processed sample */
   }
+  *kT = kw;
+
+  return ky;
+}
+
+/* ................. End of fir_upsampling_kernel() .................. */
 
 
 /*
- * ......... SECOND STEP: compute remaining dot-products ..........
- *                        completely with data from x[*]
- */
+  ============================================================================
 
-  for (kx = kStart + 1; kx <= lenx - 1; kx++) {
-    for (iup = 0; iup <= iupfac - 1; iup++) {
-      /* ... first contribution in dot-product */
-      y[ky] = x[kx] * h0[iup];
+        float fir_dot_exact (float *x, float *hr, long n);
+        ~~~~~~~~~~~~~~~~~~~
 
-      /* ... compute partial dot-product with source data from x-array */
-      for (kappa = 1; kappa <= lenh0 / iupfac - 1; kappa++) {
-        y[ky] += x[kx - kappa] * h0[iup + kappa * iupfac];
-      }
-      ky++;
-    }
+        float fir_dot_scalar (float *x, float *hr, long n);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        float fir_dot_sse2 (float *x, float *hr, long n);
+        ~~~~~~~~~~~~~~~~~~
+
+        float fir_dot_avx (float *x, float *hr, long n);
+        ~~~~~~~~~~~~~~~~~
+
+        float fir_dot_neon (float *x, float *hr, long n);
+        ~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Dot product of the n most recent input samples x[0..n-1] (oldest
+        first) with the time-reversed coefficients hr[0..n-1], i.e. the
+        FIR output sum(kappa) x[n-1-kappa]*h0[kappa].
+
+        fir_dot_exact() accumulates in single precision starting at the
+        most recent sample, which is the order of the original STL loops,
+        and is therefore bit-exact to them. The other kernels use several
+        partial sums (SIMD lanes), so the result may differ in the last
+        bits.
+
+        Parameters:
+        ~~~~~~~~~~~
+        x: ....... (In) input samples, oldest first
+        hr: ...... (In) time-reversed FIR-coefficients
+        n: ....... (In) number of coefficients (n >= 1)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The dot product.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static float fir_dot_exact (float *x, float *hr, long n) {
+  float acc;
+  long j;
+
+  acc = x[n - 1] * hr[n - 1];
+  for (j = n - 2; j >= 0; j--)
+    acc += x[j] * hr[j];
+  return acc;
+}
+
+static float fir_dot_scalar (float *x, float *hr, long n) {
+  float acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+  long j;
+
+  for (j = 0; j + 3 < n; j += 4) {
+    acc0 += x[j] * hr[j];
+    acc1 += x[j + 1] * hr[j + 1];
+    acc2 += x[j + 2] * hr[j + 2];
+    acc3 += x[j + 3] * hr[j + 3];
+  }
+  for (; j < n; j++)
+    acc0 += x[j] * hr[j];
+  return (acc0 + acc1) + (acc2 + acc3);
+}
+
+#ifdef FIR_USE_SSE2
+static float fir_dot_sse2 (float *x, float *hr, long n) {
+  __m128 acc0 = _mm_setzero_ps (), acc1 = _mm_setzero_ps ();
+  float part[4], acc;
+  long j;
+
+  for (j = 0; j + 7 < n; j += 8) {
+    acc0 = _mm_add_ps (acc0, _mm_mul_ps (_mm_loadu_ps (x + j), _mm_loadu_ps (hr + j)));
+    acc1 = _mm_add_ps (acc1, _mm_mul_ps (_mm_loadu_ps (x + j + 4), _mm_loadu_ps (hr + j + 4)));
+  }
+  _mm_storeu_ps (part, _mm_add_ps (acc0, acc1));
+  acc = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; j < n; j++)
+    acc += x[j] * hr[j];
+  return acc;
+}
+#endif
+
+#ifdef FIR_USE_AVX
+__attribute__ ((target ("avx")))
+static float fir_dot_avx (float *x, float *hr, long n) {
+  __m256 acc0 = _mm256_setzero_ps (), acc1 = _mm256_setzero_ps ();
+  __m128 acc4;
+  float part[4], acc;
+  long j;
+
+  for (j = 0; j + 15 < n; j += 16) {
+    acc0 = _mm256_add_ps (acc0, _mm256_mul_ps (_mm256_loadu_ps (x + j), _mm256_loadu_ps (hr + j)));
+    acc1 = _mm256_add_ps (acc1, _mm256_mul_ps (_mm256_loadu_ps (x + j + 8), _mm256_loadu_ps (hr + j + 8)));
+  }
+  acc0 = _mm256_add_ps (acc0, acc1);
+  acc4 = _mm_add_ps (_mm256_castps256_ps128 (acc0), _mm256_extractf128_ps (acc0, 1));
+  _mm_storeu_ps (part, acc4);
+  acc = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; j < n; j++)
+    acc += x[j] * hr[j];
+  return acc;
+}
+#endif
+
+#ifdef FIR_USE_NEON
+static float fir_dot_neon (float *x, float *hr, long n) {
+  float32x4_t acc0 = vdupq_n_f32 (0), acc1 = vdupq_n_f32 (0);
+  float part[4], acc;
+  long j;
+
+  for (j = 0; j + 7 < n; j += 8) {
+    acc0 = vmlaq_f32 (acc0, vld1q_f32 (x + j), vld1q_f32 (hr + j));
+    acc1 = vmlaq_f32 (acc1, vld1q_f32 (x + j + 4), vld1q_f32 (hr + j + 4));
   }
+  vst1q_f32 (part, vaddq_f32 (acc0, acc1));
+  acc = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; j < n; j++)
+    acc += x[j] * hr[j];
+  return acc;
+}
+#endif
+
+/* ...................... End of fir_dot_*() ...................... */
 
 
 /*
- * ......... Last Step: copy end of x-array into T-array .........
- *                        (update of delay line)
- */
+  ============================================================================
 
-  if (lenx >= lenh0 / iupfac - 1) {
-    /* ... all samples taken from x-array */
-    for (kappa = 0; kappa <= lenh0 / iupfac - 2; kappa++) {
-      T[kappa] = x[lenx + 1 - lenh0 / iupfac + kappa];
-    }
-  } else {
-    /* ... left-Shift of T-array */
-    for (kappa = 0; kappa <= lenh0 / iupfac - 2 - lenx; kappa++) {
-      T[kappa] = T[kappa + lenx];
-    }
+        void hq_kernel_mode (int mode);
+        ~~~~~~~~~~~~~~~~~~~
 
-    /* ... copy complete x-array -> T-array */
-    for (kappa = lenh0 / iupfac - 1 - lenx; kappa <= lenh0 / iupfac - 2; kappa++) {
-      T[kappa] = x[lenx - 1 + kappa - (lenh0 / iupfac - 2)];
-    }
+        Description:
+        ~~~~~~~~~~~~
+
+        Select the dot-product kernel used by hq_kernel() for all FIR
+        filters. FIR_KERNEL_FAST selects the fastest SIMD kernel
+        supported by the CPU at run time: AVX or SSE2 on x86, NEON on
+        ARM, or a portable scalar kernel with four partial sums.
+        FIR_KERNEL_EXACT (the default) selects the scalar kernel that is
+        bit-exact to the original STL implementation.
+
+        The selection is process-wide and should be done before any
+        filtering takes place.
+
+        Parameters:
+        ~~~~~~~~~~~
+        mode: .... (In) FIR_KERNEL_FAST or FIR_KERNEL_EXACT
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_kernel_mode (int mode) {
+  if (mode == FIR_KERNEL_EXACT) {
+    fir_dot = fir_dot_exact;
+    fir_dot_name = "exact";
+    return;
   }
 
-  return ky;
+  fir_dot = fir_dot_scalar;
+  fir_dot_name = "scalar";
+#ifdef FIR_USE_NEON
+  fir_dot = fir_dot_neon;
+  fir_dot_name = "neon";
+#endif
+#ifdef FIR_USE_SSE2
+  fir_dot = fir_dot_sse2;
+  fir_dot_name = "sse2";
+#endif
+#ifdef FIR_USE_AVX
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx")) {
+    fir_dot = fir_dot_avx;
+    fir_dot_name = "avx";
+  }
+#endif
 }
 
-/* ................. End of fir_upsampling_kernel() .................. */
+/* ...................... End of hq_kernel_mode() ...................... */
+
+
+/*
+  ============================================================================
+
+        char *hq_kernel_name (void);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Return the name of the dot-product kernel currently selected:
+        "exact" (the default), "scalar", "sse2", "avx" or "neon".
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+char *hq_kernel_name () {
+  return fir_dot_name;
+}
+
+/* ...................... End of hq_kernel_name() ...................... */
 
 
 /* **************************** END OF FIR-LIB.C ************************** */
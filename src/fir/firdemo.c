@@ -77,6 +77,10 @@
         -ht ..... uses the half-tilt IRS (if IRS was selected)
         -lseg ... changes the segment (block) length (default:LSEG0=256)
         -q ...... quiet processing (no progress flag)
+        -fast ... use the fastest (SIMD) dot-product kernel for this
+                  CPU; results may differ by +-1 LSB from the reference
+        -exact .. use the scalar dot-product kernel that is bit-exact to
+                  the reference implementation (default)
 
 
         Compilation:
@@ -280,6 +284,8 @@ void display_usage () {
   printf ("  -ht ........ uses the half-tilt for 16 kHz IRS, if IRS filtering is selected\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
   printf ("  -lseg ...... changes the segment (block) length (default:%d)\n", LSEG0);
+  printf ("  -fast ...... use the SIMD FIR kernel (may differ by +-1 LSB)\n");
+  printf ("  -exact ..... use the bit-exact scalar FIR kernel (default)\n");
 
   /* Quit program */
   exit (-128);
@@ -388,6 +394,20 @@ int main (int argc, char *argv[]) {
         /* Don't print progress indicator */
         quiet = 1;
 
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Use fastest FIR dot-product kernel */
+        hq_kernel_mode (FIR_KERNEL_FAST);
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-exact") == 0) {
+        /* Use bit-exact FIR dot-product kernel */
+        hq_kernel_mode (FIR_KERNEL_EXACT);
+
         /* Move argv over the option to the next argument */
         argv++;
         argc--;
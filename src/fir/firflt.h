@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: FIRFLT.H                                           v.2.5 -  31.Dec.2008
+   File: FIRFLT.H                                           v.2.6 -  16.Oct.2026
   ============================================================================
 
 	    ITU-T STL HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
@@ -18,6 +18,10 @@
    15.May.07	v2.4+	Added protoype for the [20Hz-20kHz] filter 
 						and the 1.5kHz, 14kHz. 20kHz LP filters	<Ericsson>
    31.Dec.2008  v2.5    Added LP filters (12kHz) for fs=48kHz < huawei >
+   16.Oct.2026  v2.6    Added polyphase coefficient bank to SCD_FIR
+   16.Oct.2026  v2.7    Polyphase bank stored time-reversed; added
+                        hq_kernel_mode() and hq_kernel_name()
+   16.Oct.2026  v2.8    Doubled circular delay line in SCD_FIR
 
   ============================================================================
 */
@@ -45,11 +49,24 @@ typedef struct {
   long k0;                      /* start index in next segment */
   /* (needed in segmentwise filtering) */
   float *h0;                    /* pointer to array with FIR coeff.  */
-  float *T;                     /* pointer to delay line */
+  float *T;                     /* pointer to circular delay line, */
+  /* with the last lenhp input samples stored twice (2*lenhp) */
   char hswitch;                 /* switch to FIR-kernel */
+  long lenhp;                   /* number of coefficients per polyphase branch */
+  float *hp;                    /* pointer to time-reversed polyphase bank: */
+  /* hp[iup*lenhp+lenhp-1-kappa] = h0[iup+kappa*dwn_up] for up-sampling, */
+  /* hp[lenh0-1-kappa] = h0[kappa] (single branch) for down-sampling */
+  long kT;                      /* position of the oldest sample in T */
 } SCD_FIR;
 
 
+/*
+ * ..... Dot-product kernel modes (see hq_kernel_mode()) .....
+ */
+#define FIR_KERNEL_FAST  0      /* fastest kernel for this CPU (SSE2/AVX/NEON) */
+#define FIR_KERNEL_EXACT 1      /* scalar kernel, bit-exact to the reference (default) */
+
+
 /* 
  * ..... Global function prototypes ..... 
  */
@@ -89,6 +106,8 @@ SCD_FIR *LP12_48kHz_init ARGS ((void));
 // FILTER_12k48k_HW
 void hq_free ARGS ((SCD_FIR * fir_ptr));
 void hq_reset ARGS ((SCD_FIR * fir_ptr));
+void hq_kernel_mode ARGS ((int mode));
+char *hq_kernel_name ARGS ((void));
 
 #endif /* FIRFLT_FIRstruct_defined */
 
@@ -0,0 +1,663 @@
+/*                                                           16.Oct.2026 v1.0
+  ===========================================================================
+
+  FLTBATCH.C
+  ~~~~~~~~~~
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Batch driver for the STL FIR and IIR filters. A list of input/output
+  file pairs (the "manifest") is processed by a fixed chain of filters,
+  spread across a pool of worker threads. Each worker owns one instance
+  of every filter in the chain and its own sample buffers, which are
+  reset and reused from one file to the next, so that no process needs
+  to be started per file.
+
+  Within the chain, samples are passed from one filter to the next in
+  floating point, as in firdemo.c and pcmdemo.c. A chain with a single
+  filter gives the same output as the program filter.c with the same
+  filter type and block size.
+
+  Usage:
+  ~~~~~~
+  $ fltbatch [-options] Chain Manifest
+
+  where:
+  Chain         is the filter chain: a comma-separated list of filter
+                types (as in filter.c), each optionally followed by
+                ":up" (upsampling instead of downsampling, for HQ2, HQ3,
+                FLAT, PCM and IFLAT) or ":mod" (modified IRS, for IRS16),
+                e.g. "HQ2:up,IRS16:mod,HQ2";
+  Manifest      is a text file with one "InpFile OutFile" pair per line;
+                empty lines and lines starting with '#' are ignored.
+
+  Options:
+  -jobs n ....... number of worker threads (default: number of on-line
+                  processors)
+  -lseg l ....... block size, in number of samples (default: 256)
+  -q ............ quiet processing (no per-file report)
+  -fast ......... use the fastest (SIMD) FIR dot-product kernel for this
+                  CPU; results may differ by +-1 LSB from the reference
+  -exact ........ use the scalar FIR dot-product kernel that is bit-exact to
+                  the reference implementation (default)
+
+  Valid filter types:
+   IRS8, IRS16, IRS48, HIRS16, TIRS, RXIRS8, RXIRS16, DSM, PSO, GSM1
+   (or MSIN), HQ2, HQ3, FLAT, FLAT1, P341, 5KBP, 100_5KBP, 14KBP, 20KBP,
+   LP1p5, LP35, LP7, LP10, LP12, LP14, LP20 (FIR); PCM, PCM1 (parallel-
+   form IIR); IFLAT (cascade-form IIR); DC (direct-form IIR). See filter.c
+   for their description.
+
+  Exit value:
+  ~~~~~~~~~~~
+  0 if all files were processed, 1 if any file failed, >1 for errors in
+  the command line or in the initialization.
+
+  Compilation:
+  ~~~~~~~~~~~~
+  Link with ../utl/ugst-thr.c, which needs POSIX threads (pthreads), or
+  the Win32 API when _WIN32 is defined.
+
+  History:
+  ~~~~~~~~
+  16.Oct.2026 v1.0  Created.
+  ===========================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+/* UGST MODULES */
+#include "ugstdemo.h"
+#include "iirflt.h"
+#include "firflt.h"
+#include "ugst-utl.h"
+#include "ugst-thr.h"
+
+/* LOCAL DEFINITIONS */
+#define LSEG0     256           /* default block size */
+#define MAX_STAGE 16            /* maximum number of filters in a chain */
+#define MAX_JOBS  256           /* maximum number of worker threads */
+
+#ifndef max
+#define max(x,y) ((x)>(y)?(x):(y))
+#endif
+
+/* Define filter type identifiers */
+enum filter_kernel_type { FIR, IIR_PARALLEL, IIR_CASCADE, IIR_DIRECT };
+
+/* One filter of the chain */
+typedef struct {
+  char kernel_type;             /* FIR, IIR_PARALLEL, ... */
+  SCD_FIR *fir_state;
+  SCD_IIR *parallel_iir_state;
+  CASCADE_IIR *cascade_iir_state;
+  DIRECT_IIR *direct_iir_state;
+  long factor;                  /* rate change factor */
+  char hswitch;                 /* 'U' for upsampling, 'D' otherwise */
+} FLT_STAGE;
+
+/* Filter chain specification, as parsed from the command line */
+typedef struct {
+  char name[MAX_STRLEN];        /* filter type */
+  char upsample;                /* ":up" given */
+  char modified_IRS;            /* ":mod" given */
+} FLT_SPEC;
+
+/* One entry of the manifest and its result */
+typedef struct {
+  char *inp, *out;              /* file names */
+  int status;                   /* 0: OK, 2: can't open input, 3: can't create output, 5/6: read/write error */
+  long total;                   /* number of output samples */
+  long satur;                   /* number of saturated samples */
+} FLT_JOB;
+
+/* Per-thread data: own filter instances and buffers */
+typedef struct {
+  FLT_STAGE stage[MAX_STAGE];
+  float *BuffA, *BuffB;         /* float ping-pong buffers */
+  short *TmpBuff;               /* short input/output buffer */
+  THREAD_T thread;
+} FLT_WORKER;
+
+/* Data shared by all workers */
+FLT_SPEC chain[MAX_STAGE];
+long nstage = 0;
+FLT_JOB *job = NULL;
+long njob = 0, next_job = 0;
+long N = LSEG0;
+MUTEX_T job_mutex;
+
+
+/*
+ * Case-insensitive comparison of two strings
+ * Return: 1 -> equal
+ *         0 -> different
+ */
+int same_name (char *a, char *b) {
+  for (; *a && *b; a++, b++)
+    if (toupper ((unsigned char) *a) != toupper ((unsigned char) *b))
+      return 0;
+  return *a == *b;
+}
+
+
+/*
+ * Parse the filter chain "type[:up|:mod],type[:up|:mod],..."
+ * Return: number of filters in the chain, or 0 if invalid
+ */
+long parse_chain (char *spec) {
+  char *tok, *opt;
+  char buf[MAX_STRLEN];
+  long n = 0;
+
+  strncpy (buf, spec, MAX_STRLEN - 1);
+  buf[MAX_STRLEN - 1] = '\0';
+
+  for (tok = strtok (buf, ","); tok != NULL; tok = strtok (NULL, ",")) {
+    if (n == MAX_STAGE)
+      return 0;
+    chain[n].upsample = chain[n].modified_IRS = 0;
+    if ((opt = strchr (tok, ':')) != NULL)
+      *opt++ = '\0';
+    while (opt != NULL) {
+      char *next = strchr (opt, ':');
+      if (next != NULL)
+        *next++ = '\0';
+      if (same_name (opt, "up"))
+        chain[n].upsample = 1;
+      else if (same_name (opt, "down"))
+        chain[n].upsample = 0;
+      else if (same_name (opt, "mod"))
+        chain[n].modified_IRS = 1;
+      else
+        return 0;
+      opt = next;
+    }
+    strcpy (chain[n].name, tok);
+    n++;
+  }
+  return n;
+}
+
+
+/*
+ * Create the filter for one element of the chain
+ * Return: 1 -> OK
+ *         0 -> invalid filter type or out of memory
+ */
+int init_stage (FLT_STAGE * st, FLT_SPEC * sp) {
+  char *t = sp->name;
+
+  memset (st, 0, sizeof (FLT_STAGE));
+  st->kernel_type = FIR;
+
+  /* FIR filters */
+  if (same_name (t, "IRS8") && !sp->modified_IRS)
+    st->fir_state = irs_8khz_init ();
+  else if (same_name (t, "IRS16"))
+    st->fir_state = sp->modified_IRS ? mod_irs_16khz_init () : irs_16khz_init ();
+  else if (same_name (t, "IRS48"))
+    st->fir_state = mod_irs_48khz_init ();
+  else if (same_name (t, "RXIRS8"))
+    st->fir_state = rx_mod_irs_8khz_init ();
+  else if (same_name (t, "RXIRS16"))
+    st->fir_state = rx_mod_irs_16khz_init ();
+  else if (same_name (t, "HIRS16"))
+    st->fir_state = ht_irs_16khz_init ();
+  else if (same_name (t, "TIRS"))
+    st->fir_state = tia_irs_8khz_init ();
+  else if (same_name (t, "DSM"))
+    st->fir_state = delta_sm_16khz_init ();
+  else if (same_name (t, "PSO"))
+    st->fir_state = psophometric_8khz_init ();
+  else if (same_name (t, "GSM1") || same_name (t, "MSIN"))
+    st->fir_state = msin_16khz_init ();
+  else if (same_name (t, "FLAT1"))
+    st->fir_state = linear_phase_pb_1_to_1_init ();
+  else if (same_name (t, "FLAT"))
+    st->fir_state = sp->upsample ? linear_phase_pb_1_to_2_init () : linear_phase_pb_2_to_1_init ();
+  else if (same_name (t, "HQ2"))
+    st->fir_state = sp->upsample ? hq_up_1_to_2_init () : hq_down_2_to_1_init ();
+  else if (same_name (t, "HQ3"))
+    st->fir_state = sp->upsample ? hq_up_1_to_3_init () : hq_down_3_to_1_init ();
+  else if (same_name (t, "P341"))
+    st->fir_state = p341_16khz_init ();
+  else if (same_name (t, "5KBP"))
+    st->fir_state = bp5k_16khz_init ();
+  else if (same_name (t, "100_5KBP"))
+    st->fir_state = bp100_5k_16khz_init ();
+  else if (same_name (t, "14KBP"))
+    st->fir_state = bp14k_32khz_init ();
+  else if (same_name (t, "20KBP"))
+    st->fir_state = bp20k_48khz_init ();
+  else if (same_name (t, "LP1p5"))
+    st->fir_state = LP1p5_48kHz_init ();
+  else if (same_name (t, "LP35"))
+    st->fir_state = LP35_48kHz_init ();
+  else if (same_name (t, "LP7"))
+    st->fir_state = LP7_48kHz_init ();
+  else if (same_name (t, "LP10"))
+    st->fir_state = LP10_48kHz_init ();
+  else if (same_name (t, "LP12"))
+    st->fir_state = LP12_48kHz_init ();
+  else if (same_name (t, "LP14"))
+    st->fir_state = LP14_48kHz_init ();
+  else if (same_name (t, "LP20"))
+    st->fir_state = LP20_48kHz_init ();
+
+  /* IIR filters */
+  else if (same_name (t, "PCM1")) {
+    st->kernel_type = IIR_PARALLEL;
+    st->parallel_iir_state = stdpcm_16khz_init ();
+  } else if (same_name (t, "PCM")) {
+    st->kernel_type = IIR_PARALLEL;
+    st->parallel_iir_state = sp->upsample ? stdpcm_1_to_2_init () : stdpcm_2_to_1_init ();
+  } else if (same_name (t, "IFLAT")) {
+    st->kernel_type = IIR_CASCADE;
+    st->cascade_iir_state = sp->upsample ? iir_casc_lp_1_to_3_init () : iir_casc_lp_3_to_1_init ();
+  } else if (same_name (t, "DC")) {
+    st->kernel_type = IIR_DIRECT;
+    st->direct_iir_state = iir_dir_dc_removal_init ();
+  } else
+    return 0;
+
+  /* Find rate change factor */
+  switch (st->kernel_type) {
+  case FIR:
+    if (st->fir_state == NULL)
+      return 0;
+    st->factor = st->fir_state->dwn_up;
+    st->hswitch = st->fir_state->hswitch;
+    break;
+  case IIR_PARALLEL:
+    if (st->parallel_iir_state == NULL)
+      return 0;
+    st->factor = st->parallel_iir_state->idown;
+    st->hswitch = st->parallel_iir_state->hswitch;
+    break;
+  case IIR_CASCADE:
+    if (st->cascade_iir_state == NULL)
+      return 0;
+    st->factor = st->cascade_iir_state->idown;
+    st->hswitch = st->cascade_iir_state->hswitch;
+    break;
+  case IIR_DIRECT:
+    if (st->direct_iir_state == NULL)
+      return 0;
+    st->factor = st->direct_iir_state->idown;
+    st->hswitch = st->direct_iir_state->hswitch;
+    break;
+  }
+  return 1;
+}
+
+
+/*
+ * Clear the state variables of a filter
+ */
+void reset_stage (FLT_STAGE * st) {
+  switch (st->kernel_type) {
+  case FIR:
+    hq_reset (st->fir_state);
+    break;
+  case IIR_PARALLEL:
+    stdpcm_reset (st->parallel_iir_state);
+    break;
+  case IIR_CASCADE:
+    cascade_iir_reset (st->cascade_iir_state);
+    break;
+  case IIR_DIRECT:
+    direct_reset (st->direct_iir_state);
+    break;
+  }
+}
+
+
+/*
+ * Release the memory of a filter
+ */
+void free_stage (FLT_STAGE * st) {
+  switch (st->kernel_type) {
+  case FIR:
+    hq_free (st->fir_state);
+    break;
+  case IIR_PARALLEL:
+    stdpcm_free (st->parallel_iir_state);
+    break;
+  case IIR_CASCADE:
+    cascade_iir_free (st->cascade_iir_state);
+    break;
+  case IIR_DIRECT:
+    direct_iir_free (st->direct_iir_state);
+    break;
+  }
+}
+
+
+/*
+ * Run one block of samples through a filter
+ * Return: number of output samples
+ */
+long run_stage (FLT_STAGE * st, long smpno, float *x, float *y) {
+  switch (st->kernel_type) {
+  case FIR:
+    return hq_kernel (smpno, x, st->fir_state, y);
+  case IIR_PARALLEL:
+    return stdpcm_kernel (smpno, x, st->parallel_iir_state, y);
+  case IIR_CASCADE:
+    return cascade_iir_kernel (smpno, x, st->cascade_iir_state, y);
+  case IIR_DIRECT:
+    return direct_iir_kernel (smpno, x, st->direct_iir_state, y);
+  }
+  return 0;
+}
+
+
+/*
+ * Create the filter chain and the buffers of one worker
+ * Return: 1 -> OK
+ *         0 -> invalid chain or out of memory
+ */
+int init_worker (FLT_WORKER * w) {
+  long k, size, max_size;
+
+  /* Create the filters, following the block size along the chain */
+  max_size = size = N;
+  for (k = 0; k < nstage; k++) {
+    if (!init_stage (&w->stage[k], &chain[k]))
+      return 0;
+    size = (w->stage[k].hswitch == 'U') ? size * w->stage[k].factor : (long) ceil (size / (double) w->stage[k].factor);
+    max_size = max (max_size, size);
+  }
+
+  /* Allocate buffers big enough for any point in the chain */
+  if ((w->BuffA = (float *) calloc (max_size, sizeof (float))) == NULL)
+    return 0;
+  if ((w->BuffB = (float *) calloc (max_size, sizeof (float))) == NULL)
+    return 0;
+  if ((w->TmpBuff = (short *) calloc (max_size, sizeof (short))) == NULL)
+    return 0;
+  return 1;
+}
+
+
+/*
+ * Filter one file of the manifest with the filters of a worker
+ */
+void process_file (FLT_WORKER * w, FLT_JOB * jb) {
+  FILE *Fi, *Fo;
+  float *x, *y, *tmp;
+  long smpno, k;
+
+  /* Restart all filters of the chain */
+  for (k = 0; k < nstage; k++)
+    reset_stage (&w->stage[k]);
+
+  jb->total = jb->satur = 0;
+  if ((Fi = fopen (jb->inp, RB)) == NULL) {
+    jb->status = 2;
+    return;
+  }
+  if ((Fo = fopen (jb->out, WB)) == NULL) {
+    fclose (Fi);
+    jb->status = 3;
+    return;
+  }
+
+  while ((smpno = fread (w->TmpBuff, sizeof (short), N, Fi)) > 0) {
+    /* Convert short to float, normalizing */
+    x = w->BuffA;
+    y = w->BuffB;
+    sh2fl_16bit (smpno, w->TmpBuff, x, 1);
+
+    /* Pipe the block through the chain */
+    for (k = 0; k < nstage; k++) {
+      smpno = run_stage (&w->stage[k], smpno, x, y);
+      tmp = x;
+      x = y;
+      y = tmp;
+    }
+
+    /* Convert the filtered data back to short and save */
+    jb->satur += fl2sh_16bit (smpno, x, w->TmpBuff, (int) 1);
+    if (smpno > 0 && fwrite (w->TmpBuff, sizeof (short), smpno, Fo) != (size_t) smpno) {
+      jb->status = 6;
+      break;
+    }
+    jb->total += smpno;
+  }
+  if (ferror (Fi))
+    jb->status = 5;
+
+  fclose (Fi);
+  if (fclose (Fo) != 0 && jb->status == 0)
+    jb->status = 6;
+}
+
+
+/*
+ * Worker thread: take the next file of the manifest until all are done
+ */
+THREAD_PROC (worker_main) {
+  FLT_WORKER *w = (FLT_WORKER *) arg;
+  long cur;
+
+  for (;;) {
+    mutex_lock (&job_mutex);
+    cur = next_job++;
+    mutex_unlock (&job_mutex);
+    if (cur >= njob)
+      break;
+    process_file (w, &job[cur]);
+  }
+  return 0;
+}
+
+
+/*
+ * Read the manifest file into job[]
+ * Return: number of entries, or -1 if the file can't be read
+ */
+long read_manifest (char *name) {
+  FILE *F;
+  char line[3 * MAX_STRLEN], inp[MAX_STRLEN], out[MAX_STRLEN];
+  long n = 0, nmax = 0;
+
+  if ((F = fopen (name, "r")) == NULL)
+    return -1;
+
+  while (fgets (line, sizeof (line), F) != NULL) {
+    if (sscanf (line, "%1023s %1023s", inp, out) != 2 || inp[0] == '#')
+      continue;
+    if (n == nmax) {
+      nmax = nmax ? 2 * nmax : 64;
+      if ((job = (FLT_JOB *) realloc (job, nmax * sizeof (FLT_JOB))) == NULL)
+        error_terminate ("Can't allocate memory for manifest\n", 10);
+    }
+    job[n].inp = (char *) malloc (strlen (inp) + 1);
+    job[n].out = (char *) malloc (strlen (out) + 1);
+    if (job[n].inp == NULL || job[n].out == NULL)
+      error_terminate ("Can't allocate memory for manifest\n", 10);
+    strcpy (job[n].inp, inp);
+    strcpy (job[n].out, out);
+    job[n].status = 0;
+    n++;
+  }
+  fclose (F);
+  return n;
+}
+
+
+/*
+ * Function to display usage
+ */
+void display_usage () {
+  printf ("FLTBATCH.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Batch driver for the STL filters: the files listed in a manifest\n");
+  printf (" are processed by a fixed chain of filters, using a pool of worker\n");
+  printf (" threads. Each worker has its own instance of the filters.\n");
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ fltbatch [-options] Chain Manifest\n");
+  printf (" where:\n");
+  printf ("  Chain        comma-separated list of filter types (see filter.c),\n");
+  printf ("               each optionally followed by :up (HQ2, HQ3, FLAT, PCM,\n");
+  printf ("               IFLAT) or :mod (IRS16), e.g. HQ2:up,IRS16:mod,HQ2\n");
+  printf ("  Manifest     text file with one \"InpFile OutFile\" pair per line\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -jobs n .... number of worker threads (default: no. of processors)\n");
+  printf ("  -lseg l .... block size, in number of samples (default: %d)\n", LSEG0);
+  printf ("  -q ......... quiet processing (no per-file report)\n");
+  printf ("  -fast ...... use the SIMD FIR kernel (may differ by +-1 LSB)\n");
+  printf ("  -exact ..... use the bit-exact scalar FIR kernel (default)\n");
+
+  /* Quit program */
+  exit (-128);
+}
+
+
+/*============================== */
+int main (int argc, char *argv[]) {
+  char Chain[MAX_STRLEN], Manifest[MAX_STRLEN];
+  FLT_WORKER *worker;
+  long jobs = 0, k, failed = 0;
+  char quiet = 0, kernel_mode = FIR_KERNEL_EXACT;
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  /* Check options */
+  if (argc < 2)
+    display_usage ();
+  else {
+    while (argc > 1 && argv[1][0] == '-')
+      if (strcmp (argv[1], "-jobs") == 0) {
+        /* Number of worker threads */
+        jobs = atol (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-lseg") == 0) {
+        /* Block size */
+        N = atol (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-q") == 0) {
+        /* Quiet operation */
+        quiet = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Use fastest FIR dot-product kernel */
+        kernel_mode = FIR_KERNEL_FAST;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-exact") == 0) {
+        /* Use bit-exact FIR dot-product kernel */
+        kernel_mode = FIR_KERNEL_EXACT;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+        /* Display help message */
+        display_usage ();
+      } else {
+        fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+        display_usage ();
+      }
+  }
+
+  /* Read parameters for processing */
+  GET_PAR_S (1, "_Filter chain: ................ ", Chain);
+  GET_PAR_S (2, "_Manifest: .................... ", Manifest);
+
+
+  /* ......... CHECK CONSISTENCY ......... */
+
+  if (N <= 0)
+    error_terminate ("Block size must be positive! Aborted.\n", 5);
+  if ((nstage = parse_chain (Chain)) == 0)
+    error_terminate ("Invalid filter chain! Aborted.\n", 2);
+  if ((njob = read_manifest (Manifest)) < 0)
+    KILL (Manifest, 2);
+  if (jobs <= 0)
+    jobs = cpu_count ();
+  if (jobs > MAX_JOBS)
+    jobs = MAX_JOBS;
+  if (jobs > njob)
+    jobs = njob > 0 ? njob : 1;
+
+
+  /* ......... INITIALIZATION ......... */
+
+  /* The FIR kernel is process-wide: select it before any thread runs */
+  hq_kernel_mode (kernel_mode);
+
+  /* Create the filters and buffers of every worker */
+  if ((worker = (FLT_WORKER *) calloc (jobs, sizeof (FLT_WORKER))) == NULL)
+    error_terminate ("Can't allocate memory for workers\n", 10);
+  for (k = 0; k < jobs; k++)
+    if (!init_worker (&worker[k]))
+      error_terminate ("Invalid filter chain or out of memory! Aborted.\n", 2);
+
+  if (!quiet)
+    fprintf (stderr, "%ld file(s), %ld filter(s), %ld thread(s), FIR kernel: %s\n", njob, nstage, jobs, hq_kernel_name ());
+
+
+  /* ......... FILTERING OPERATION ......... */
+
+  mutex_init (&job_mutex);
+  for (k = 0; k < jobs; k++)
+    if (!thread_create (&worker[k].thread, worker_main, &worker[k]))
+      error_terminate ("Can't create worker thread\n", 10);
+  for (k = 0; k < jobs; k++)
+    thread_join (worker[k].thread);
+  mutex_destroy (&job_mutex);
+
+
+  /* ......... REPORT, in the order of the manifest ......... */
+
+  for (k = 0; k < njob; k++) {
+    if (job[k].status != 0) {
+      failed++;
+      fprintf (stderr, "%s -> %s: %s\n", job[k].inp, job[k].out,
+               job[k].status == 2 ? "can't open input file" :
+               job[k].status == 3 ? "can't create output file" : job[k].status == 5 ? "read error" : "write error");
+    } else if (!quiet)
+      fprintf (stderr, "%s -> %s: %ld samples, %ld saturated\n", job[k].inp, job[k].out, job[k].total, job[k].satur);
+  }
+
+
+  /* FINALIZATIONS */
+  for (k = 0; k < jobs; k++) {
+    long i;
+    for (i = 0; i < nstage; i++)
+      free_stage (&worker[k].stage[i]);
+    free (worker[k].TmpBuff);
+    free (worker[k].BuffB);
+    free (worker[k].BuffA);
+  }
+  free (worker);
+  for (k = 0; k < njob; k++) {
+    free (job[k].inp);
+    free (job[k].out);
+  }
+  free (job);
+
+  return failed ? 1 : 0;
+}
@@ -14,6 +14,13 @@
         long-term energy of a sinewave before and after the filtering,
         converting the ratio to dB.
 
+        Alternatively (option -ir), the impulse response of the
+        filter is captured once (one impulse per input phase for
+        down-sampling filters) and the gain at each frequency of the
+        grid is evaluated on it with the Goertzel algorithm, which
+        is much faster for long filters and fine grids. Option -check
+        computes both and prints the difference.
+
 	--------------------------------------------------------------
         NOTE! the output dB values are ALWAYS relative to the given
         sampling frequency, not to the output one, whatever it is !!!
@@ -47,6 +54,10 @@
         -mod .......... uses the modified IRS characteristic instead of the
                         "regular" one.
         -fs ........... set the sampling frequency, in Hz [def: 8000]
+        -ir ........... evaluate the response on the impulse response
+        -check ........ evaluate on the impulse response and with the
+                        sine sweep, and print the difference; the exit
+                        code is 1 if it exceeds 0.1 dB above -60 dB
 
 	Valid combinations of filter and sampling rate:
 
@@ -82,6 +93,7 @@
                         <tdsimao@venus.cpqd.ansp.br>
         20.Apr.94  3.0  Now displays tool information (previously not logged)
         02.Feb.10  3.1  Modified maximum string length for filenames (y.hiwasaki)
+        16.Oct.26  3.2  Added the impulse response mode (-ir, -check)
 
 * ----------------------------------------------------------------------
 */
@@ -105,6 +117,8 @@
 
 /* Other stufs */
 #define TWO_PI (8*atan(1.0))
+#define IR_LEN 8192             /* input samples per impulse, long enough for the IIR tails */
+#define CHECK_TOL 0.1           /* max. difference [dB] between both methods with -check */
 
 
 /*
@@ -124,12 +138,165 @@ int valid_filter (F_type)
 }
 
 
+/*
+ * Filter a buffer with the FIR or the IIR filter
+ * Return: number of output samples
+ */
+long run_filter (is_fir, fir_state, iir_state, n, inp, out)
+     int is_fir;
+     SCD_FIR *fir_state;
+     SCD_IIR *iir_state;
+     long n;
+     float *inp, *out;
+{
+  if (is_fir)
+    return hq_kernel (n, inp, fir_state, out);
+  else
+    return stdpcm_kernel (n, inp, iir_state, out);
+}
+
+
+/*
+ * Gain at normalized frequency f (relative to the input sampling rate)
+ * from the long-term energy of a sinewave before and after the filtering.
+ * BufInp has inp_size samples, BufOut out_size samples; the first and last
+ * 2*N output samples are skipped.
+ * Return: gain in dB
+ */
+double sine_response (is_fir, fir_state, iir_state, f, BufInp, inp_size, BufOut, out_size, N)
+     int is_fir;
+     SCD_FIR *fir_state;
+     SCD_IIR *iir_state;
+     double f;
+     float *BufInp, *BufOut;
+     long inp_size, out_size, N;
+{
+  double inp_pwr, H_k;
+  long j;
+
+  /* Reset output buffer */
+  memset (BufOut, '\0', out_size * sizeof (float));
+
+  /* Calculate as a temporary the frequency in radians */
+  inp_pwr = f * TWO_PI;
+
+  /* Generate sine samples with peak 20000 ... */
+  for (j = 0; j < inp_size; j++)
+    BufInp[j] = 20000.0 * sin (inp_pwr * j);
+
+  /* Calculate power of input signal */
+  for (inp_pwr = 0, j = 0; j < inp_size; j++)
+    inp_pwr += BufInp[j] * BufInp[j];
+
+  /* Convert to dB */
+  inp_pwr = 10.0 * log10 (inp_pwr / (double) inp_size);
+
+  /* Filtering ... */
+  run_filter (is_fir, fir_state, iir_state, inp_size, BufInp, BufOut);
+
+  /* Compute power of output signal */
+  for (H_k = 0, j = 2 * N; j < out_size - 2 * N; j++)
+    H_k += BufOut[j] * BufOut[j];
+
+  /* Convert to dB */
+  return 10 * log10 (H_k / (double) (out_size - 4 * N)) - inp_pwr;
+}
+
+
+/*
+ * Capture the impulse response h[] of the filter at the highest of the
+ * input and output rates. An up-sampling filter by L gives
+ * y[n] = sum_m x[m] h[n-L*m], so one impulse gives h[]; a down-sampling
+ * filter by M gives y[n] = sum_m x[m] h[M*n-m], so the impulse is applied
+ * at each of the M input phases and the outputs are interleaved. The
+ * filter state is reset before and after.
+ * Return: length of h[], which is allocated here
+ */
+long impulse_response (is_fir, fir_state, iir_state, h)
+     int is_fir;
+     SCD_FIR *fir_state;
+     SCD_IIR *iir_state;
+     double **h;
+{
+  float *inp, *out;
+  long factor, up, p, j, h_len, out_len;
+
+  if (is_fir) {
+    factor = fir_state->dwn_up;
+    up = fir_state->hswitch == 'U';
+  } else {
+    factor = iir_state->idown;
+    up = iir_state->hswitch == 'U';
+  }
+  h_len = up ? IR_LEN * factor : IR_LEN;
+
+  inp = (float *) calloc (IR_LEN, sizeof (float));
+  out = (float *) calloc (IR_LEN * factor, sizeof (float));
+  if ((*h = (double *) calloc (h_len, sizeof (double))) == NULL || inp == NULL || out == NULL)
+    error_terminate ("Can't allocate memory for impulse response\n", 10);
+
+  for (p = 0; p < (up ? 1 : factor); p++) {
+    if (is_fir)
+      hq_reset (fir_state);
+    else
+      stdpcm_reset (iir_state);
+
+    /* Unit impulse at input phase p */
+    memset (inp, '\0', IR_LEN * sizeof (float));
+    inp[p] = 1.0;
+    out_len = run_filter (is_fir, fir_state, iir_state, IR_LEN, inp, out);
+
+    /* h[M*n-p], shifted by M-1 to keep the index positive */
+    if (up)
+      for (j = 0; j < out_len && j < h_len; j++)
+        (*h)[j] = out[j];
+    else
+      for (j = 0; j < out_len && j * factor + factor - 1 - p < h_len; j++)
+        (*h)[j * factor + factor - 1 - p] = out[j];
+  }
+
+  if (is_fir)
+    hq_reset (fir_state);
+  else
+    stdpcm_reset (iir_state);
+
+  free (inp);
+  free (out);
+  return h_len;
+}
+
+
+/*
+ * Power gain of the impulse response h[] at w radians per sample, with
+ * the Goertzel algorithm.
+ * Return: |H(w)|^2
+ */
+double goertzel_power (h, h_len, w)
+     double *h;
+     long h_len;
+     double w;
+{
+  double coef, s0, s1, s2;
+  long j;
+
+  coef = 2 * cos (w);
+  for (s1 = s2 = 0, j = 0; j < h_len; j++) {
+    s0 = h[j] + coef * s1 - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+
+  /* |H(w)|^2 = s1^2 + s2^2 - coef*s1*s2 */
+  return s1 * s1 + s2 * s2 - coef * s1 * s2;
+}
+
+
 /*
  * Function to display usage
  * By: Simao in 20.Apr.94
  */
 void display_usage () {
-  printf ("FLTRESP -- Version 3.1 of 02.Feb.2010 --\n");
+  printf ("FLTRESP -- Version 3.2 of 16.Oct.2026 --\n");
   printf ("%s%s", "Test program to evaluate the frequence  ", "response of filters.\n");
   printf ("%s%s", "Depending on the function called, the program  ", "will be able\n");
   printf ("to evaluate the frequence response for the range of\n");
@@ -157,6 +324,10 @@ void display_usage () {
   printf ("-fs: .... define sampling frequency, in Hz [def:8000Hz]\n");
   printf ("-mod: ... use modified IRS filters\n");
   printf ("-q: ..... quiet mode - don't print funny chars\n");
+  printf ("-ir: .... evaluate on the impulse response (Goertzel)\n");
+  printf ("-check: . evaluate on the impulse response and with the sine\n");
+  printf ("          sweep, and print the difference; the exit code is 1\n");
+  printf ("          if it exceeds 0.1 dB above -60 dB\n\n");
 
   printf ("Valid combinations of filter and sampling rate:\n\n");
 
@@ -189,11 +360,14 @@ int main (int argc, char *argv[]) {
 
   float *BufInp, *BufOut;
   char F_type[MAX_STRLEN];
-  long j, k, N, N2;
+  long k, N, N2;
   char modified_IRS = 0, quiet = 0;
+  char use_ir = 0, check = 0;
   long inp_size, out_size;
-  double f, f0, fstep, ff, fs = 8000, inp_pwr;
-  double H_k, cur_f;
+  double f, f0, fstep, ff, fs = 8000;
+  double H_k, H_sine, cur_f, max_diff = 0;
+  double *h = NULL, nyq_out = 0.5, ir_gain = 0;
+  long h_len = 0, n_img = 1, i;
   static char is_fir = 1;
 
   /* PREAMBLE */
@@ -227,6 +401,20 @@ int main (int argc, char *argv[]) {
         /* Change sampling frequency */
         quiet = 1;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-ir") == 0) {
+        /* Evaluate on the impulse response */
+        use_ir = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-check") == 0) {
+        /* Evaluate both ways and compare */
+        use_ir = check = 1;
+
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
@@ -374,10 +562,10 @@ int main (int argc, char *argv[]) {
   /* Calculate Output buffer size */
   if (is_fir) {
     out_size = (fir_state->hswitch == 'U')
-      ? inp_size * fir_state->dwn_up : inp_size / fir_state->dwn_up;
+      ? inp_size * fir_state->dwn_up : (inp_size + fir_state->dwn_up - 1) / fir_state->dwn_up;
   } else {
     out_size = (iir_state->hswitch == 'U')
-      ? inp_size * iir_state->idown : inp_size / iir_state->idown;
+      ? inp_size * iir_state->idown : (inp_size + iir_state->idown - 1) / iir_state->idown;
   }
 
   /* Allocate memory for input buffer */
@@ -389,13 +577,24 @@ int main (int argc, char *argv[]) {
     error_terminate ("Can't allocate memory for data buffer\n", 10);
 
 
+  /* Capture the impulse response, at the output rate for up-sampling. */
+  /* Like the sine sweep, which measures the power of the whole output, */
+  /* an up-sampling filter by L sums the power of the L images of f */
+  /* and is relative to the gain L of the interpolation filter */
+  if (use_ir) {
+    h_len = impulse_response (is_fir, fir_state, iir_state, &h);
+    if (is_fir ? fir_state->hswitch == 'U' : iir_state->hswitch == 'U') {
+      n_img = is_fir ? fir_state->dwn_up : iir_state->idown;
+      ir_gain = -20 * log10 ((double) n_img);
+    } else
+      nyq_out = 0.5 / (is_fir ? fir_state->dwn_up : iir_state->idown);
+  }
+
+
   /* FILTERING OPERATION! */
 
   for (k = 0, f = f0; f <= ff; f += fstep, k++) {
 
-    /* Reset output buffer */
-    memset (BufOut, '\0', out_size * sizeof (float));
-
     /* Current frequency, in Hz, and print */
     cur_f = f * fs;
     fprintf (stderr, "\nFrequency %f", cur_f);
@@ -404,64 +603,34 @@ int main (int argc, char *argv[]) {
     if (fabs (f - 0.5) < 1e-8 / fs)
       f -= (0.05 * fstep);
 
-    /* Calculate as a temporary the frequency in radians */
-    inp_pwr = f * TWO_PI;
-
-    /* Generate sine samples with peak 20000 ... */
-    for (j = 0; j < inp_size; j++)
-      BufInp[j] = 20000.0 * sin (inp_pwr * j);
-
-    /* Calculate power of input signal */
-    for (inp_pwr = 0, j = 0; j < inp_size; j++)
-      inp_pwr += BufInp[j] * BufInp[j];
-
-    /* Convert to dB */
-    inp_pwr = 10.0 * log10 (inp_pwr / (double) inp_size);
-
-#ifdef OLD_WAY
-    for (cur_frame = 0; cur_frame < N2; cur_frame++) {
-      /* Information on processing phase */
-      fprintf (stderr, "\r%c", funny[cur_frame % 9]);
-
-      /* Copy data from big array to small one */
-      for (l = cur_frame * N, j = 0; j < N; j++)
-        inp[j] = (float) BufInp[l + j];
-
-      /* Filtering ... */
-      if (is_fir)
-        j = hq_kernel (N, inp, fir_state, out);
-      else
-        j = stdpcm_kernel (N, inp, iir_state, out);
-
-      /* Convert data from float to short */
-      for (l = cur_frame * N, j = 0; j < N; j++)
-        BufInp[l + j] = (float) out[j];
-    }
-#else /* NEW_WAY */
-
-    /* Filtering ... */
-    if (is_fir)
-      j = hq_kernel (inp_size, BufInp, fir_state, BufOut);
-    else
-      j = stdpcm_kernel (inp_size, BufInp, iir_state, BufOut);
-
-#endif
-
-    /* Compute power of output signal */
-    for (H_k = 0, j = 2 * N; j < out_size - 2 * N; j++)
-      H_k += BufOut[j] * BufOut[j];
-
-    /* Convert to dB */
-    H_k = 10 * log10 (H_k / (double) (out_size - 4 * N)) - inp_pwr;
+    if (use_ir) {
+      for (H_k = 0, i = 0; i < n_img; i++)
+        H_k += goertzel_power (h, h_len, (f + i) * TWO_PI / n_img);
+      H_k = 10 * log10 (H_k) + ir_gain;
+    } else
+      H_k = sine_response (is_fir, fir_state, iir_state, f, BufInp, inp_size, BufOut, out_size, N);
 
     /* Printout of gain at the current frequency */
-    printf ("\nH( %4.0f ) \t = %7.3f dB\n", f * fs, H_k);
+    if (check) {
+      H_sine = sine_response (is_fir, fir_state, iir_state, f, BufInp, inp_size, BufOut, out_size, N);
+      printf ("\nH( %4.0f ) \t = %7.3f dB \t(sweep: %7.3f dB, diff: %7.3f dB)\n", f * fs, H_k, H_sine, H_k - H_sine);
+      /* The sweep is not accurate close to the input and output fs/2 */
+      if (H_sine > -60 && fabs (f - 0.5) > 0.01 && fabs (f - nyq_out) > 0.01 && fabs (H_k - H_sine) > max_diff)
+        max_diff = fabs (H_k - H_sine);
+    } else
+      printf ("\nH( %4.0f ) \t = %7.3f dB\n", f * fs, H_k);
 
   }
 
+  if (check)
+    printf ("\nMax. difference above -60 dB, away from fs/2: %.3f dB\n", max_diff);
+
 
   /* FINALIZATIONS */
   fprintf (stderr, "\n");
+  free (h);
+  if (max_diff > CHECK_TOL)
+    return (1);
 
 #ifndef VMS
   return (0);
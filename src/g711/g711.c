@@ -1,4 +1,4 @@
-/*                                                 Version 3.01 - 31.Jan.2000
+/*                                                 Version 3.02 - 16.Oct.2026
 =============================================================================
 
                           U    U   GGG    SSS  TTTTT
@@ -54,6 +54,9 @@ ulaw_expand: ..... expands 1 vector of u-law samples to linear PCM
                    use 8 Least Sig. Bits (LSBs) from input and
                    14 Most Sig.Bits (MSBs) on output.
 
+g711_kernel_mode:  selects the table-driven (default) or the original
+                   per-sample implementation of the functions above.
+
 PROTOTYPES: in g711.h
 
 HISTORY:
@@ -64,6 +67,12 @@ Apr/91       1.0   First version of the G711 module
 08/Feb/1992  3.0   Demo as separate file;
 31/Jan/2000  3.01  Updated documentation text; no change in functions
                    <simao.campos@labs.comsat.com>
+16/Oct/2026  3.02  Table-driven compression and expansion. The constant
+                   tables (g711tab.h) were generated with the original
+                   per-sample code, so that the codes and samples are
+                   identical to it for every input value; the original
+                   code is still available through
+                   g711_kernel_mode(G711_KERNEL_REF).
 =============================================================================
 */
 
@@ -74,19 +83,36 @@ Apr/91       1.0   First version of the G711 module
 /* Global prototype functions */
 #include "g711.h"
 
+/* Compression and expansion tables */
+#include "g711tab.h"
+
+/*
+ *	.......... L O C A L   V A R I A B L E S ..........
+ */
+
+/* Selected implementation: G711_KERNEL_TABLE or G711_KERNEL_REF */
+static int g711_mode = G711_KERNEL_TABLE;
+
+/* Original per-sample implementation */
+static void alaw_compress_ref ARGS ((long lseg, short *linbuf, short *logbuf));
+static void alaw_expand_ref ARGS ((long lseg, short *logbuf, short *linbuf));
+static void ulaw_compress_ref ARGS ((long lseg, short *linbuf, short *logbuf));
+static void ulaw_expand_ref ARGS ((long lseg, short *logbuf, short *linbuf));
+
+
 /*
  *	.......... F U N C T I O N S ..........
  */
 
-/* ................... Begin of alaw_compress() ..................... */
+/* ................... Begin of alaw_compress_ref() ..................... */
 /*
   ==========================================================================
 
-   FUNCTION NAME: alaw_compress
+   FUNCTION NAME: alaw_compress_ref
 
    DESCRIPTION: ALaw encoding rule according ITU-T Rec. G.711.
 
-   PROTOTYPE: void alaw_compress(long lseg, short *linbuf, short *logbuf)
+   PROTOTYPE: static void alaw_compress_ref(long lseg, short *linbuf, short *logbuf)
 
    PARAMETERS:
      lseg:	(In)  number of samples
@@ -99,10 +125,11 @@ Apr/91       1.0   First version of the G711 module
 
    HISTORY:
    10.Dec.91	1.0	Separated A-law compression function
+   16.Oct.26	1.1	Renamed from alaw_compress(); used to build the tables
 
   ==========================================================================
 */
-void alaw_compress (long lseg, short *linbuf, short *logbuf) {
+static void alaw_compress_ref (long lseg, short *linbuf, short *logbuf) {
   short ix, iexp;
   long n;
 
@@ -129,18 +156,18 @@ void alaw_compress (long lseg, short *linbuf, short *logbuf) {
   }
 }
 
-/* ................... End of alaw_compress() ..................... */
+/* ................... End of alaw_compress_ref() ..................... */
 
 
-/* ................... Begin of alaw_expand() ..................... */
+/* ................... Begin of alaw_expand_ref() ..................... */
 /*
   ==========================================================================
 
-   FUNCTION NAME: alaw_expand
+   FUNCTION NAME: alaw_expand_ref
 
    DESCRIPTION: ALaw decoding rule according ITU-T Rec. G.711.
 
-   PROTOTYPE: void alaw_expand(long lseg, short *logbuf, short *linbuf)
+   PROTOTYPE: static void alaw_expand_ref(long lseg, short *logbuf, short *linbuf)
 
    PARAMETERS:
      lseg:	(In)  number of samples
@@ -152,10 +179,11 @@ void alaw_compress (long lseg, short *linbuf, short *logbuf) {
 
    HISTORY:
    10.Dec.91	1.0	Separated A-law expansion function
+   16.Oct.26	1.1	Renamed from alaw_expand(); used to build the tables
 
   ============================================================================
 */
-void alaw_expand (long lseg, short *logbuf, short *linbuf) {
+static void alaw_expand_ref (long lseg, short *logbuf, short *linbuf) {
   short ix, mant, iexp;
   long n;
 
@@ -178,18 +206,18 @@ void alaw_expand (long lseg, short *logbuf, short *linbuf) {
   }
 }
 
-/* ................... End of alaw_expand() ..................... */
+/* ................... End of alaw_expand_ref() ..................... */
 
 
-/* ................... Begin of ulaw_compress() ..................... */
+/* ................... Begin of ulaw_compress_ref() ..................... */
 /*
   ==========================================================================
 
-   FUNCTION NAME: ulaw_compress
+   FUNCTION NAME: ulaw_compress_ref
 
    DESCRIPTION: Mu law encoding rule according ITU-T Rec. G.711.
 
-   PROTOTYPE: void ulaw_compress(long lseg, short *linbuf, short *logbuf)
+   PROTOTYPE: static void ulaw_compress_ref(long lseg, short *linbuf, short *logbuf)
 
    PARAMETERS:
      lseg:	(In)  number of samples
@@ -202,10 +230,11 @@ void alaw_expand (long lseg, short *logbuf, short *linbuf) {
 
    HISTORY:
    10.Dec.91	1.0	Separated mu-law compression function
+   16.Oct.26	1.1	Renamed from ulaw_compress(); used to build the tables
 
   ==========================================================================
 */
-void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
+static void ulaw_compress_ref (long lseg, short *linbuf, short *logbuf) {
   long n;                       /* samples's count */
   short i;                      /* aux.var. */
   short absno;                  /* absolute value of linear (input) sample */
@@ -251,19 +280,19 @@ void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
   }
 }
 
-/* ................... End of ulaw_compress() ..................... */
+/* ................... End of ulaw_compress_ref() ..................... */
 
 
 
-/* ................... Begin of ulaw_expand() ..................... */
+/* ................... Begin of ulaw_expand_ref() ..................... */
 /*
   ==========================================================================
 
-   FUNCTION NAME: ulaw_expand
+   FUNCTION NAME: ulaw_expand_ref
 
    DESCRIPTION: Mu law decoding rule according ITU-T Rec. G.711.
 
-   PROTOTYPE: void ulaw_expand(long lseg, short *logbuf, short *linbuf)
+   PROTOTYPE: static void ulaw_expand_ref(long lseg, short *logbuf, short *linbuf)
 
    PARAMETERS:
      lseg:	(In)  number of samples
@@ -275,11 +304,12 @@ void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
 
    HISTORY:
    10.Dec.91	1.0	Separated mu law expansion function
+   16.Oct.26	1.1	Renamed from ulaw_expand(); used to build the tables
 
   ============================================================================
 */
 
-void ulaw_expand (long lseg, short *logbuf, short *linbuf) {
+static void ulaw_expand_ref (long lseg, short *logbuf, short *linbuf) {
   long n;                       /* aux.var. */
   short segment;                /* segment (Table 2/G711, column 1) */
   short mantissa;               /* low nibble of log companded sample */
@@ -306,4 +336,220 @@ void ulaw_expand (long lseg, short *logbuf, short *linbuf) {
   }
 }
 
+/* ................... End of ulaw_expand_ref() ..................... */
+
+
+/* ................... Begin of alaw_compress() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: alaw_compress
+
+   DESCRIPTION: ALaw encoding rule according ITU-T Rec. G.711.
+
+                The code of each sample is read from a table indexed by
+                the 12 MSBs of the linear sample, generated with
+                alaw_compress_ref() (g711tab.h). Identical to
+                alaw_compress_ref().
+
+   PROTOTYPE: void alaw_compress(long lseg, short *linbuf, short *logbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     linbuf:	(In)  buffer with linear samples (only 12 MSBits are taken
+                      into account)
+     logbuf:	(Out) buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Table-driven version
+
+  ==========================================================================
+*/
+void alaw_compress (long lseg, short *linbuf, short *logbuf) {
+  long n;
+
+  if (g711_mode == G711_KERNEL_REF) {
+    alaw_compress_ref (lseg, linbuf, logbuf);
+    return;
+  }
+
+
+  for (n = 0; n < lseg; n++)
+    logbuf[n] = alaw_comp_tab[(linbuf[n] >> 4) & 0x0FFF];
+}
+
+/* ................... End of alaw_compress() ..................... */
+
+
+/* ................... Begin of alaw_expand() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: alaw_expand
+
+   DESCRIPTION: ALaw decoding rule according ITU-T Rec. G.711.
+
+                The samples are read from a table of the 256 log codes,
+                generated with alaw_expand_ref(); values outside
+                0..255 are passed to alaw_expand_ref(). Identical to
+                alaw_expand_ref().
+
+   PROTOTYPE: void alaw_expand(long lseg, short *logbuf, short *linbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     logbuf:	(In)  buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+     linbuf:	(Out) buffer with linear samples (13 bits left justified)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Table-driven version
+
+  ============================================================================
+*/
+void alaw_expand (long lseg, short *logbuf, short *linbuf) {
+  long n;
+
+  if (g711_mode == G711_KERNEL_REF) {
+    alaw_expand_ref (lseg, logbuf, linbuf);
+    return;
+  }
+
+
+  for (n = 0; n < lseg; n++)
+    if ((unsigned short) logbuf[n] < 256)
+      linbuf[n] = alaw_exp_tab[logbuf[n]];
+    else
+      alaw_expand_ref (1, &logbuf[n], &linbuf[n]);
+}
+
+/* ................... End of alaw_expand() ..................... */
+
+
+/* ................... Begin of ulaw_compress() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: ulaw_compress
+
+   DESCRIPTION: Mu law encoding rule according ITU-T Rec. G.711.
+
+                The code of each sample is read from a table indexed by
+                the 14 MSBs of the linear sample, generated with
+                ulaw_compress_ref() (g711tab.h). Identical to
+                ulaw_compress_ref().
+
+   PROTOTYPE: void ulaw_compress(long lseg, short *linbuf, short *logbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     linbuf:	(In)  buffer with linear samples (only 12 MSBits are taken
+                      into account)
+     logbuf:	(Out) buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Table-driven version
+
+  ==========================================================================
+*/
+void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
+  long n;
+
+  if (g711_mode == G711_KERNEL_REF) {
+    ulaw_compress_ref (lseg, linbuf, logbuf);
+    return;
+  }
+
+
+  for (n = 0; n < lseg; n++)
+    logbuf[n] = ulaw_comp_tab[(linbuf[n] >> 2) & 0x3FFF];
+}
+
+/* ................... End of ulaw_compress() ..................... */
+
+
+/* ................... Begin of ulaw_expand() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: ulaw_expand
+
+   DESCRIPTION: Mu law decoding rule according ITU-T Rec. G.711.
+
+                The samples are read from a table of the 256 log codes,
+                generated with ulaw_expand_ref(); values outside
+                0..255 are passed to ulaw_expand_ref(). Identical to
+                ulaw_expand_ref().
+
+   PROTOTYPE: void ulaw_expand(long lseg, short *logbuf, short *linbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     logbuf:	(In)  buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+     linbuf:	(Out) buffer with linear samples (14 bits left justified)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Table-driven version
+
+  ============================================================================
+*/
+void ulaw_expand (long lseg, short *logbuf, short *linbuf) {
+  long n;
+
+  if (g711_mode == G711_KERNEL_REF) {
+    ulaw_expand_ref (lseg, logbuf, linbuf);
+    return;
+  }
+
+
+  for (n = 0; n < lseg; n++)
+    if ((unsigned short) logbuf[n] < 256)
+      linbuf[n] = ulaw_exp_tab[logbuf[n]];
+    else
+      ulaw_expand_ref (1, &logbuf[n], &linbuf[n]);
+}
+
 /* ................... End of ulaw_expand() ..................... */
+
+
+/* ................... Begin of g711_kernel_mode() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: g711_kernel_mode
+
+   DESCRIPTION: Selects the implementation used by alaw_compress(),
+                alaw_expand(), ulaw_compress() and ulaw_expand():
+                G711_KERNEL_TABLE (default) for the table-driven one,
+                G711_KERNEL_REF for the original per-sample code. Both
+                give identical results; the selection is meant for
+                benchmarking.
+
+   PROTOTYPE: void g711_kernel_mode(int mode)
+
+   PARAMETERS:
+     mode:	(In)  G711_KERNEL_TABLE or G711_KERNEL_REF
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ==========================================================================
+*/
+void g711_kernel_mode (int mode) {
+  g711_mode = (mode == G711_KERNEL_REF) ? G711_KERNEL_REF : G711_KERNEL_TABLE;
+}
+
+/* ................... End of g711_kernel_mode() ..................... */
@@ -16,10 +16,11 @@
 			and <Volker.Springer@eedn.ericsson.se>
    31.Jan.2000  v3.01   [version no.aligned with g711.c] Updated list of 
                         compilers for smart prototypes
+   16.Oct.2026  v3.02   Added g711_kernel_mode()
   ============================================================================
 */
 #ifndef G711_defined
-#define G711_defined 301
+#define G711_defined 302
 
 /* Smart function prototypes: for [ag]cc, VaxC, and [tb]cc */
 #if !defined(ARGS)
@@ -36,10 +37,15 @@ void alaw_compress ARGS ((long lseg, short *linbuf, short *logbuf));
 void alaw_expand ARGS ((long lseg, short *logbuf, short *linbuf));
 void ulaw_compress ARGS ((long lseg, short *linbuf, short *logbuf));
 void ulaw_expand ARGS ((long lseg, short *logbuf, short *linbuf));
+void g711_kernel_mode ARGS ((int mode));
 
 /* Definitions for better user interface (?!) */
 #define IS_LIN 1
 #define IS_LOG 0
 
+/* Implementations selected by g711_kernel_mode() */
+#define G711_KERNEL_TABLE 0     /* table-driven (default) */
+#define G711_KERNEL_REF   1     /* original per-sample code */
+
 #endif
 /* .......................... End of G711.H ........................... */
@@ -1,4 +1,4 @@
-/*                                                        02.Feb.2010 v3.3
+/*                                                        16.Oct.2026 v3.4
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   G711DEMO.C
@@ -10,7 +10,7 @@
 
   Usage:
   ~~~~~~
-  $ g711demo [-?] [-r] [-skip skip] Law Transf InpFile OutFile
+  $ g711demo [-?] [-r] [-skip skip] [-ref] [-bench n] Law Transf InpFile OutFile
              [BlockSize [1stBlock [NoOfBlocks]]]
 
   where:
@@ -39,6 +39,12 @@
                 read from a file.
   -skip         is the number of samples to skip before the beginning
                 of the 1st block.
+  -ref          uses the original per-sample G.711 code instead of the
+                (default) table-driven one.
+  -bench n      before processing the file, compares the table-driven and
+                the original code for all input values (65536 linear
+                samples or 256 log codes) of the selected law and transform, and reports the CPU-time of
+                n passes over them with each of the implementations.
 
   Example:
   $ G711 u lili voice.ref voice.rel 256 3 45
@@ -111,6 +117,7 @@
    7   invalid law
    8   invalid conversion
   10   error allocating memory
+  11   table-driven and original code differ (-bench)
 
   Prototypes:
   ~~~~~~~~~~~
@@ -146,6 +153,7 @@
                    size is not a multiple of the file
                    size. <simao.campos@labs.comsat.com>
   02.Feb.2010 v3.3 Modified maximum string length (y.hiwasaki)
+  16.Oct.2026 v3.4 Added options -ref and -bench.
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ugstdemo.h"           /* UGST defines for demo programs */
 
@@ -179,7 +187,7 @@
   --------------------------------------------------------------------------
 */
 void display_usage () {
-  fprintf (stderr, "\n  G711DEMO.C   --- Version v3.3 of 02.Feb.2010 \n");
+  fprintf (stderr, "\n  G711DEMO.C   --- Version v3.4 of 16.Oct.2026 \n");
   fprintf (stderr, "\n");
   fprintf (stderr, "  Description:\n");
   fprintf (stderr, "  ~~~~~~~~~~~~\n");
@@ -188,7 +196,7 @@ void display_usage () {
   fprintf (stderr, "\n");
   fprintf (stderr, "  Usage:\n");
   fprintf (stderr, "  ~~~~~~\n");
-  fprintf (stderr, "  $ G711 [-r] Law Transf InpFile OutFile BlkSize 1stBlock NoOfBlocks\n");
+  fprintf (stderr, "  $ G711 [-r] [-ref] [-bench n] Law Transf InpFile OutFile BlkSize 1stBlock NoOfBlocks\n");
   fprintf (stderr, "\n");
   fprintf (stderr, "  where:\n");
   fprintf (stderr, "  Law	   is the law desired (either A or u)\n");
@@ -208,6 +216,9 @@ void display_usage () {
   fprintf (stderr, "  -?         displays this message.\n");
   fprintf (stderr, "  -r         disables even-bit swap by A-law encoding and decoding.\n");
   fprintf (stderr, "  -skip      is the number of samples to skip.\n");
+  fprintf (stderr, "  -ref       uses the original per-sample code instead of the tables.\n");
+  fprintf (stderr, "  -bench n   compares table-driven and original code for all input\n");
+  fprintf (stderr, "             values and reports the CPU-time of n passes of each.\n");
   fprintf (stderr, "\n");
 
   /* Quit program */
@@ -217,6 +228,84 @@ void display_usage () {
 /* ..................... End of display_usage() .......................... */
 
 
+/*
+  --------------------------------------------------------------------------
+   int bench_g711(char law, short inp_type, short out_type, long passes)
+
+   Compares the table-driven and the original (per-sample) G.711 code
+   for all 65536 linear samples (or 256 times all log codes), for the
+   given law and transform, and prints the CPU-time needed by each implementation for
+   `passes' passes over these values. Leaves the table-driven code
+   selected.
+
+   Returns 1 if both implementations give identical results, 0 otherwise.
+
+   Created 16.Oct.2026
+
+  --------------------------------------------------------------------------
+*/
+int bench_g711 (char law, short inp_type, short out_type, long passes) {
+  short *inp, *tmp, *out[2];
+  long i, p;
+  int mode, same = 1;
+  clock_t t1;
+  double t[2];
+
+  if ((inp = (short *) calloc (65536, sizeof (short))) == NULL || (tmp = (short *) calloc (65536, sizeof (short))) == NULL
+      || (out[0] = (short *) calloc (65536, sizeof (short))) == NULL || (out[1] = (short *) calloc (65536, sizeof (short))) == NULL)
+    error_terminate ("Can't allocate memory for benchmark buffers\n", 10);
+
+  /* All 16-bit linear samples, or all 8-bit codes for log input */
+  for (i = 0; i < 65536; i++)
+    inp[i] = (inp_type == IS_LOG) ? (short) (i & 0xFF) : (short) (i - 32768);
+
+  for (mode = G711_KERNEL_TABLE; mode <= G711_KERNEL_REF; mode++) {
+    g711_kernel_mode (mode);
+    t1 = clock ();
+    for (p = 0; p < passes; p++) {
+      if (inp_type == IS_LOG) {
+        if (law == 'A')
+          alaw_expand (65536, inp, out[mode]);
+        else
+          ulaw_expand (65536, inp, out[mode]);
+      } else if (out_type == IS_LOG) {
+        if (law == 'A')
+          alaw_compress (65536, inp, out[mode]);
+        else
+          ulaw_compress (65536, inp, out[mode]);
+      } else {
+        if (law == 'A') {
+          alaw_compress (65536, inp, tmp);
+          alaw_expand (65536, tmp, out[mode]);
+        } else {
+          ulaw_compress (65536, inp, tmp);
+          ulaw_expand (65536, tmp, out[mode]);
+        }
+      }
+    }
+    t[mode] = (clock () - t1) / (double) CLOCKS_PER_SEC;
+  }
+  g711_kernel_mode (G711_KERNEL_TABLE);
+
+  for (i = 0; i < 65536; i++)
+    if (out[G711_KERNEL_TABLE][i] != out[G711_KERNEL_REF][i]) {
+      fprintf (stderr, "Mismatch for input %d: table %d, original %d\n", inp[i], out[G711_KERNEL_TABLE][i], out[G711_KERNEL_REF][i]);
+      same = 0;
+      break;
+    }
+
+  printf ("Benchmark (%ld x 65536 samples): table %f sec, original %f sec CPU-time; results %s\n", passes, t[G711_KERNEL_TABLE], t[G711_KERNEL_REF], same ? "identical" : "DIFFER");
+
+  free (out[1]);
+  free (out[0]);
+  free (tmp);
+  free (inp);
+  return same;
+}
+
+/* ....................... End of bench_g711() .......................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -241,6 +330,8 @@ int main (int argc, char *argv[]) {
   char mrs[15];                 /* for correct mrs in VMS environment */
 #endif
   long start_byte, skip = 0;
+  long bench = 0;
+  char use_ref = 0;
 
 /*
  * GETTING PARAMETERS
@@ -250,7 +341,21 @@ int main (int argc, char *argv[]) {
     display_usage ();
   else {
     while (argc > 1 && argv[1][0] == '-')
-      if (argv[1][1] == 'r') {
+      if (strcmp (argv[1], "-ref") == 0) {
+        /* Use the original per-sample code */
+        use_ref = 1;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-bench") == 0) {
+        /* Get number of benchmark passes */
+        bench = atol (argv[2]);
+
+        /* Move argv over the option to the next argument */
+        argv += 2;
+        argc -= 2;
+      } else if (argv[1][1] == 'r') {
         /* Disable revertion of even bits */
         revert_even_bits = 0;
 
@@ -308,6 +413,13 @@ int main (int argc, char *argv[]) {
   if ((law[0] != (char) 'A') && (law[0] != (char) 'U'))
     error_terminate (" Invalid law!\n", 7);
 
+  /* .......... BENCHMARK, IF REQUESTED .......... */
+
+  if (bench > 0 && !bench_g711 (law[0], inp_type, out_type, bench))
+    error_terminate ("Table-driven and original G.711 code differ!\n", 11);
+  if (use_ref)
+    g711_kernel_mode (G711_KERNEL_REF);
+
   /* .......... ALLOCATION OF BUFFERS .......... */
 
   if ((lin_buff = (short *) calloc (N, sizeof (short))) == NULL)
@@ -1,4 +1,4 @@
-/*                                                        24.May.2005 v1.0
+/*                                                        16.Oct.2026 v1.1
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   g711iplc.c
@@ -15,6 +15,10 @@
 	Options:
 		-noplc		simulate silence insertion instead of concealment
 		-stats		print out concealed frame statistics
+		-multi N	process N concurrent streams, interleaved sample
+				by sample in speechin and speechout, each with its
+				own PLC instance; the erasure flags are read frame
+				by frame, one per stream in stream order
 
 	File Formats:
 		plcpattern	G.192 FER file
@@ -39,6 +43,7 @@
   ~~~~~~~~
   24.May.2005 v1.0 Release of 1st demo program for G711 PLC module <AT&T>.
 				   Integration of this module in STL2005 <Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+  16.Oct.2026 v1.1 Added option -multi, to process many concurrent streams.
 
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
@@ -49,7 +54,7 @@
 #include "lowcfe.h"
 
 char usage[] = "\
-G711IPLC Version 1.0 of 24/May/2005\n\
+G711IPLC Version 1.1 of 16/Oct/2026\n\
   UGST/ITU-T G.711 Appendix I Packet Loss Concealment module\n\
   (*) G711IPLC module: COPYRIGTH 1997-2001 AT&T Corp.\n\
 ANSI C Version\n\
@@ -59,6 +64,8 @@ Usage:\n\
 Options:\n\
 	-noplc		simulate silence insertion instead of concealment\n\
 	-stats		print out concealed frame statistics\n\
+	-multi N	process N concurrent streams, interleaved in speechin\n\
+			and speechout, with one erasure flag per stream and frame\n\
 File Formats:\n\
 	plcpattern	G.192 FER file\n\
 	speechin	Headerless binary 8kHz 16-bit PCM file\n\
@@ -66,7 +73,8 @@ File Formats:\n\
 ";
 
 int main (int argc, char *argv[]) {
-  int i;
+  int i, n;
+  int nstreams = 1;             /* number of concurrent streams */
   int dostats = 0;              /* if set print out erasure stats */
   int dofe = 1;                 /* if not set use silence insertion */
   int nframes;                  /* processed frame count */
@@ -74,9 +82,10 @@ int main (int argc, char *argv[]) {
   char *arg;
   FILE *fi;                     /* input file */
   FILE *fo;                     /* output file */
-  LowcFE_c lc;                  /* PLC simulation data */
+  LowcFE_c *lc;                 /* PLC simulation data, one per stream */
   readplcmask mask;             /* error pattern file reader */
-  short in[FRAMESZ];            /* i/o buffer */
+  short *buf;                   /* interleaved i/o buffer */
+  short in[FRAMESZ];            /* frame of one stream */
 
   argc--;
   argv++;
@@ -86,7 +95,15 @@ int main (int argc, char *argv[]) {
       dofe = 0;
     else if (!strcmp ("-stats", arg))
       dostats = 1;
-    else {
+    else if (!strcmp ("-multi", arg) && argc > 1) {
+      nstreams = atoi (argv[1]);
+      if (nstreams < 1) {
+        fprintf (stderr, "Invalid number of streams: %s\n", argv[1]);
+        exit (EXIT_FAILURE);
+      }
+      argc--;
+      argv++;
+    } else {
       fprintf (stderr, "%s", usage);
       exit (EXIT_FAILURE);
     }
@@ -106,30 +123,41 @@ int main (int argc, char *argv[]) {
     fprintf (stderr, "Can't open output file: %s", argv[2]);
     exit (EXIT_FAILURE);
   }
+  if ((lc = (LowcFE_c *) malloc (nstreams * sizeof (LowcFE_c))) == NULL || (buf = (short *) malloc (nstreams * FRAMESZ * sizeof (short))) == NULL) {
+    fprintf (stderr, "Can't allocate memory for %d streams", nstreams);
+    exit (EXIT_FAILURE);
+  }
   nframes = nerased = 0;
-  g711plc_construct (&lc);
-  while (fread (in, sizeof (short), FRAMESZ, fi) == FRAMESZ) {
+  for (n = 0; n < nstreams; n++)
+    g711plc_construct (&lc[n]);
+  while (fread (buf, sizeof (short), nstreams * FRAMESZ, fi) == (size_t) (nstreams * FRAMESZ)) {
     nframes++;
-    if (readplcmask_erased (&mask)) {
-      nerased++;                /* frame is erased */
-      if (dofe)                 /* simulate concealment */
-        g711plc_dofe (&lc, in);
-      else {                    /* simulate silence insertion */
-        for (i = 0; i < FRAMESZ; i++)
-          in[i] = 0;
-        g711plc_addtohistory (&lc, in);
-      }
-    } else
-      g711plc_addtohistory (&lc, in);   /* frame is not erased */
+    for (n = 0; n < nstreams; n++) {
+      for (i = 0; i < FRAMESZ; i++)
+        in[i] = buf[i * nstreams + n];
+      if (readplcmask_erased (&mask)) {
+        nerased++;              /* frame is erased */
+        if (dofe)               /* simulate concealment */
+          g711plc_dofe (&lc[n], in);
+        else {                  /* simulate silence insertion */
+          for (i = 0; i < FRAMESZ; i++)
+            in[i] = 0;
+          g711plc_addtohistory (&lc[n], in);
+        }
+      } else
+        g711plc_addtohistory (&lc[n], in);      /* frame is not erased */
+      for (i = 0; i < FRAMESZ; i++)
+        buf[i * nstreams + n] = in[i];
+    }
     /* 
      * The concealment algorithm delays the signal by
      * POVERLAPMAX samples. Remove the delay so the output
      * file is time-aligned with the input file.
      */
     if (nframes == 1)
-      fwrite (&in[POVERLAPMAX], sizeof (short), FRAMESZ - POVERLAPMAX, fo);
+      fwrite (&buf[POVERLAPMAX * nstreams], sizeof (short), (FRAMESZ - POVERLAPMAX) * nstreams, fo);
     else
-      fwrite (in, sizeof (short), FRAMESZ, fo);
+      fwrite (buf, sizeof (short), FRAMESZ * nstreams, fo);
   }
   /* 
    * the following code outputs the delayed speech in the history buffer
@@ -137,16 +165,23 @@ int main (int argc, char *argv[]) {
    * the frame size.
    */
   if (nframes) {
-    for (i = 0; i < FRAMESZ; i++)
-      in[i] = 0;
-    g711plc_addtohistory (&lc, in);
-    fwrite (in, sizeof (short), POVERLAPMAX, fo);
+    for (n = 0; n < nstreams; n++) {
+      for (i = 0; i < FRAMESZ; i++)
+        in[i] = 0;
+      g711plc_addtohistory (&lc[n], in);
+      for (i = 0; i < POVERLAPMAX; i++)
+        buf[i * nstreams + n] = in[i];
+    }
+    fwrite (buf, sizeof (short), POVERLAPMAX * nstreams, fo);
   }
+  nframes *= nstreams;
   if (dostats && nframes)
     printf ("%d of %d frames concealed = %.2f%%\n", nerased, nframes, (double) nerased / nframes * 100.);
   /* cleanup */
   fclose (fo);
   fclose (fi);
   readplcmask_close (&mask);
+  free (buf);
+  free (lc);
   return 0;
 }
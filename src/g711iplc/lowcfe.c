@@ -47,6 +47,8 @@ HISTORY:
 
   24.May.05  v1.0  Release of 1st G711 PLC module <AT&T>.
 				   Integration of this module in STL2005 <Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>.
+  16.Oct.26  v1.1  g711plc_findpitch() computes the correlations of all the
+                   candidate lags at once, with identical results.
 =============================================================================
 */
 
@@ -57,6 +59,7 @@ static void g711plc_scalespeech (LowcFE_c *, short *out);
 static void g711plc_getfespeech (LowcFE_c *, short *out, int sz);
 static void g711plc_savespeech (LowcFE_c *, short *s);
 static int g711plc_findpitch (LowcFE_c *);
+static void g711plc_crosscorr (Float * r, Float * l, Float * corr, int nlags, int ndec, int len);
 static void g711plc_overlapadd (Float * l, Float * r, Float * o, int cnt);
 static void g711plc_overlapadds (short *l, short *r, short *o, int cnt);
 static void g711plc_overlapaddatend (LowcFE_c *, short *s, short *f, int cnt);
@@ -264,10 +267,49 @@ static void g711plc_overlapadds (short *l, short *r, short *o, int cnt) {
   }
 }
 
+/*
+ * Cross-correlate l with r at nlags lags, ndec samples apart, over
+ * len samples decimated by ndec:
+ *   corr[j] = sum(i = 0, ndec, ... < len) r[j * ndec + i] * l[i]
+ * All the lags are computed in one pass over l, the inner loop running
+ * over the lags on contiguous (decimated) data, so that it vectorizes.
+ * Each corr[j] is summed in the same order as the plain loop over i,
+ * hence the results are identical to it. len / ndec must be a
+ * multiple of 4, as is CORRLEN / NDEC.
+ */
+static void g711plc_crosscorr (Float * r, Float * l, Float * corr, int nlags, int ndec, int len) {
+  int i, j, n = len / ndec;
+  Float rd[CORRBUFLEN];         /* decimated r */
+  Float t0, t1, t2, t3, c;
+
+  for (i = 0; i < nlags + n - 1; i++)
+    rd[i] = r[i * ndec];
+  for (j = 0; j < nlags; j++)
+    corr[j] = (Float) 0.;
+  /* 4 samples per pass over the lags, still added one after the other */
+  for (i = 0; i < n; i += 4) {
+    t0 = l[i * ndec];
+    t1 = l[(i + 1) * ndec];
+    t2 = l[(i + 2) * ndec];
+    t3 = l[(i + 3) * ndec];
+    for (j = 0; j < nlags; j++) {
+      c = corr[j];
+      c += rd[i + j] * t0;
+      c += rd[i + j + 1] * t1;
+      c += rd[i + j + 2] * t2;
+      c += rd[i + j + 3] * t3;
+      corr[j] = c;
+    }
+  }
+}
+
 /*
  * Estimate the pitch.
  * l - pointer to first sample in last 20 msec of speech.
  * r - points to the sample PITCH_MAX before l
+ * The correlations for all the candidate lags of each search are
+ * computed at once by g711plc_crosscorr(); the normalization and the
+ * choice of the best lag are those of the original lag-by-lag search.
  */
 static int g711plc_findpitch (LowcFE_c * lc) {
   int i, j, k;
@@ -279,28 +321,25 @@ static int g711plc_findpitch (LowcFE_c * lc) {
   Float *rp;                    /* segment to match */
   Float *l = lc->pitchbufend - CORRLEN;
   Float *r = lc->pitchbufend - CORRBUFLEN;
+  Float corrs[PITCHDIFF / NDEC + 1];    /* correlation at each lag */
 
   /* coarse search */
+  g711plc_crosscorr (r, l, corrs, PITCHDIFF / NDEC + 1, NDEC, CORRLEN);
   rp = r;
   energy = (Float) 0.;
-  corr = (Float) 0.;
-  for (i = 0; i < CORRLEN; i += NDEC) {
+  for (i = 0; i < CORRLEN; i += NDEC)
     energy += rp[i] * rp[i];
-    corr += rp[i] * l[i];
-  }
   scale = energy;
   if (scale < CORRMINPOWER)
     scale = CORRMINPOWER;
-  corr = corr / (Float) sqrt (scale);
+  corr = corrs[0] / (Float) sqrt (scale);
   bestcorr = corr;
   bestmatch = 0;
   for (j = NDEC; j <= PITCHDIFF; j += NDEC) {
     energy -= rp[0] * rp[0];
     energy += rp[CORRLEN] * rp[CORRLEN];
     rp += NDEC;
-    corr = 0.f;
-    for (i = 0; i < CORRLEN; i += NDEC)
-      corr += rp[i] * l[i];
+    corr = corrs[j / NDEC];
     scale = energy;
     if (scale < CORRMINPOWER)
       scale = CORRMINPOWER;
@@ -318,25 +357,21 @@ static int g711plc_findpitch (LowcFE_c * lc) {
   if (k > PITCHDIFF)
     k = PITCHDIFF;
   rp = &r[j];
+  g711plc_crosscorr (rp, l, corrs, k - j + 1, 1, CORRLEN);
   energy = 0.f;
-  corr = 0.f;
-  for (i = 0; i < CORRLEN; i++) {
+  for (i = 0; i < CORRLEN; i++)
     energy += rp[i] * rp[i];
-    corr += rp[i] * l[i];
-  }
   scale = energy;
   if (scale < CORRMINPOWER)
     scale = CORRMINPOWER;
-  corr = corr / (Float) sqrt (scale);
+  corr = corrs[0] / (Float) sqrt (scale);
   bestcorr = corr;
   bestmatch = j;
-  for (j++; j <= k; j++) {
+  for (i = 1, j++; j <= k; i++, j++) {
     energy -= rp[0] * rp[0];
     energy += rp[CORRLEN] * rp[CORRLEN];
     rp++;
-    corr = 0.f;
-    for (i = 0; i < CORRLEN; i++)
-      corr += rp[i] * l[i];
+    corr = corrs[i];
     scale = energy;
     if (scale < CORRMINPOWER)
       scale = CORRMINPOWER;
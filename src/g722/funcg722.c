@@ -42,6 +42,7 @@ History:
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Added block QMF qmf_tx_block() and qmf_rx_block()
   ============================================================================
 */
 
@@ -1538,4 +1539,195 @@ void qmf_rx (Word16 rl, Word16 rh, Word16 * xout1, Word16 * xout2, g722_state *
 #undef delayx
 /* ..................... End of qmf_rx() ..................... */
 
+
+#ifndef WMOPS                   /* qmf_tx()/qmf_rx() are used with WMOPS */
+/*___________________________________________________________________________
+
+    Function Name : qmf_block_filter
+
+    Purpose :
+
+     Common part of qmf_tx_block() and qmf_rx_block(): the 24-tap QMF
+     for n <= QMF_BLK_LEN sample pairs, split into its two polyphase
+     components. Sample x0[i] takes the place of delayx[0] and x1[i]
+     that of delayx[1] for pair i; acca[i] and accb[i] are accuma and
+     accumb of qmf_tx()/qmf_rx(). The history of each component is
+     copied from the delay line into a linear buffer, so that there is
+     no shift per sample pair, and the dot products are loops over the
+     sample pairs that compilers vectorize. They use plain 32-bit
+     arithmetic: with |x| <= 32768, no accumulator can exceed
+     12964*32768 < 2^29, hence L_mult0()/L_mac0() would never saturate.
+
+    Inputs :
+     x0     - n samples for the even taps (read-only)
+     x1     - n samples for the odd taps (read-only)
+     acca   - n sums of the even taps (write-only)
+     accb   - n sums of the odd taps (write-only)
+     n      - number of sample pairs, up to QMF_BLK_LEN
+     delayx - QMF delay line, left as after n calls of qmf_tx() (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+static void qmf_block_filter (Word16 * x0, Word16 * x1, Word32 * acca, Word32 * accb, Word16 n, Word16 * delayx) {
+  Word16 b0[11 + QMF_BLK_LEN], b1[11 + QMF_BLK_LEN];
+  Word32 ca, cb;
+  Word16 i, m;
+
+  /* Polyphase delay lines: 11 past samples, then the new ones */
+  for (i = 0; i < 11; i++) {
+    b0[10 - i] = delayx[2 + 2 * i];
+    b1[10 - i] = delayx[3 + 2 * i];
+  }
+  for (i = 0; i < n; i++) {
+    b0[11 + i] = x0[i];
+    b1[11 + i] = x1[i];
+  }
+
+  /* QMF filtering */
+  for (i = 0; i < n; i++) {
+    acca[i] = 0;
+    accb[i] = 0;
+  }
+  for (m = 0; m < 12; m++) {
+    ca = coef_qmf[2 * m];
+    cb = coef_qmf[2 * m + 1];
+    for (i = 0; i < n; i++) {
+      acca[i] += ca * b0[11 + i - m];
+      accb[i] += cb * b1[11 + i - m];
+    }
+  }
+
+  /* Delay line as left by qmf_tx()/qmf_rx() after the last pair */
+  if (n > 0) {
+    delayx[0] = x0[n - 1];
+    delayx[1] = x1[n - 1];
+    for (i = 0; i < 11; i++) {
+      delayx[2 + 2 * i] = b0[10 + n - i];
+      delayx[3 + 2 * i] = b1[10 + n - i];
+    }
+  }
+}
+
+/* ..................... End of qmf_block_filter() ..................... */
+#endif /* ifndef WMOPS */
+
+
+/*___________________________________________________________________________
+
+    Function Name : qmf_tx_block
+
+    Purpose :
+
+     G722 QMF analysis (encoder) filter for a block of sample pairs.
+     Gives the same results, and leaves the same state, as calling
+     qmf_tx() for each pair, but without the per-sample operators (see
+     qmf_block_filter()). With WMOPS, qmf_tx() is used instead, so that
+     the complexity counted is that of the reference filter.
+
+    Inputs :
+     xin  - 2*n input samples, in time order (read-only)
+     xl   - n lower band samples (write-only)
+     xh   - n higher band samples (write-only)
+     n    - number of sample pairs
+     s    - pointer to state variable structure (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+void qmf_tx_block (Word16 * xin, Word16 * xl, Word16 * xh, Word32 n, g722_state * s) {
+#ifdef WMOPS
+  Word32 i;
+
+  for (i = 0; i < n; i++)
+    qmf_tx (xin[2 * i + 1], xin[2 * i], &xl[i], &xh[i], s);
+#else
+  Word16 x0[QMF_BLK_LEN], x1[QMF_BLK_LEN];
+  Word32 acca[QMF_BLK_LEN], accb[QMF_BLK_LEN];
+  Word32 comp_low, comp_high;
+  Word16 i, len;
+
+  for (; n > 0; n -= len, xin += 2 * len, xl += len, xh += len) {
+    len = (Word16) ((n < QMF_BLK_LEN) ? n : QMF_BLK_LEN);
+
+    /* Split the input into the two phases */
+    for (i = 0; i < len; i++) {
+      x1[i] = xin[2 * i];
+      x0[i] = xin[2 * i + 1];
+    }
+    qmf_block_filter (x0, x1, acca, accb, len, s->qmf_tx_delayx);
+
+    /* Descaling */
+    for (i = 0; i < len; i++) {
+      comp_low = L_add (acca[i], accb[i]);
+      comp_low = L_add (comp_low, comp_low);
+      comp_high = L_sub (acca[i], accb[i]);
+      comp_high = L_add (comp_high, comp_high);
+      xl[i] = limit ((Word16) L_shr (comp_low, (Word16) 16));
+      xh[i] = limit ((Word16) L_shr (comp_high, (Word16) 16));
+    }
+  }
+#endif
+}
+
+/* ..................... End of qmf_tx_block() ..................... */
+
+
+/*___________________________________________________________________________
+
+    Function Name : qmf_rx_block
+
+    Purpose :
+
+     G722 QMF synthesis (decoder) filter for a block of sample pairs.
+     Gives the same results, and leaves the same state, as calling
+     qmf_rx() for each pair, but without the per-sample operators (see
+     qmf_block_filter()). With WMOPS, qmf_rx() is used instead, so that
+     the complexity counted is that of the reference filter.
+
+    Inputs :
+     rl   - n lower band samples (read-only)
+     rh   - n higher band samples (read-only)
+     xout - 2*n output samples, in time order (write-only)
+     n    - number of sample pairs
+     s    - pointer to state variable structure (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+void qmf_rx_block (Word16 * rl, Word16 * rh, Word16 * xout, Word32 n, g722_state * s) {
+#ifdef WMOPS
+  Word32 i;
+
+  for (i = 0; i < n; i++)
+    qmf_rx (rl[i], rh[i], &xout[2 * i], &xout[2 * i + 1], s);
+#else
+  Word16 x0[QMF_BLK_LEN], x1[QMF_BLK_LEN];
+  Word32 acca[QMF_BLK_LEN], accb[QMF_BLK_LEN];
+  Word16 i, len;
+
+  for (; n > 0; n -= len, rl += len, rh += len, xout += 2 * len) {
+    len = (Word16) ((n < QMF_BLK_LEN) ? n : QMF_BLK_LEN);
+
+    /* compute sum and difference from lower-band (rl) and higher-band (rh) signals */
+    for (i = 0; i < len; i++) {
+      x1[i] = add (rl[i], rh[i]);
+      x0[i] = sub (rl[i], rh[i]);
+    }
+    qmf_block_filter (x0, x1, acca, accb, len, s->qmf_rx_delayx);
+
+    /* compute output samples */
+    for (i = 0; i < len; i++) {
+      xout[2 * i] = extract_h (L_shl (acca[i], 4));
+      xout[2 * i + 1] = extract_h (L_shl (accb[i], 4));
+    }
+  }
+#endif
+}
+
+/* ..................... End of qmf_rx_block() ..................... */
+
 /* ******************** End of funcg722.c ***************************** */
@@ -25,11 +25,15 @@
                         based on the CNET's 07/01/90 version 2.00
    01.Jul.95    v2.0    Smart prototypes that work with many compilers; 
                         reformated; state variable structure added. 
+   16.Oct.26    v3.1    Block QMF functions
   ============================================================================
 */
 #ifndef FUNCG722_H
 #define FUNCG722_H 200
 
+/* Number of sample pairs filtered at a time by qmf_tx_block()/qmf_rx_block() */
+#define QMF_BLK_LEN 80
+
 #ifdef OLD_WAY
 Word16 scalel ();
 
@@ -72,6 +76,10 @@ Word16 logscl ();
 void qmf_tx ();
 
 void qmf_rx ();
+
+void qmf_tx_block ();
+
+void qmf_rx_block ();
 #endif
 
 /* DEFINITION FOR SMART PROTOTYPES */
@@ -105,6 +113,8 @@ void uppol2 ARGS ((Word16 al[], Word16 plt[]));
 void upzero ARGS ((Word16 dlt[], Word16 bl[]));
 void qmf_tx ARGS ((Word16 xin0, Word16 xin1, Word16 * xl, Word16 * xh, g722_state * s));
 void qmf_rx ARGS ((Word16 rl, Word16 rh, Word16 * xout1, Word16 * xout2, g722_state * s));
+void qmf_tx_block ARGS ((Word16 * xin, Word16 * xl, Word16 * xh, Word32 n, g722_state * s));
+void qmf_rx_block ARGS ((Word16 * rl, Word16 * rh, Word16 * xout, Word32 n, g722_state * s));
 
 #endif /* FUNCG722_H */
 /* ........................ End of file funcg722.h ......................... */
@@ -39,6 +39,7 @@ History:
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       g722_encode() and g722_decode() use the block QMF
   ============================================================================
 */
 #include "g722.h"
@@ -68,42 +69,43 @@ void g722_reset_encoder (g722_state * encoder) {
 
 Word32 g722_encode (short *incode, short *code, Word32 read1, g722_state * encoder) {
   /* Encoder variables */
-  Word16 xl, il;
-  Word16 xh, ih;
-  Word16 xin0, xin1;
+  Word16 xl[QMF_BLK_LEN], il;
+  Word16 xh[QMF_BLK_LEN], ih;
 
   /* Auxiliary variables */
   Word32 i;
-  Word16 *p_incode;
+  Word16 j, len;
 
   /* Divide sample counter by 2 to account for QMF operation */
   read1 = L_shr (read1, 1);
 
   /* Main loop - never reset */
-  p_incode = incode;
 #ifdef WMOPS
   move16 ();
 #endif
-  for (i = 0; i < read1; i++) {
-    xin1 = *incode++;
-    xin0 = *incode++;
+  for (i = 0; i < read1; i += len) {
+    len = (Word16) ((read1 - i < QMF_BLK_LEN) ? read1 - i : QMF_BLK_LEN);
+
+    /* Calculation of the synthesis QMF samples for a block */
+    qmf_tx_block (incode, xl, xh, len, encoder);
+    incode += 2 * len;
+
+    for (j = 0; j < len; j++) {
 #ifdef WMOPS
-    move16 ();
-    move16 ();
+      move16 ();
+      move16 ();
 #endif
 
-    /* Calculation of the synthesis QMF samples */
-    qmf_tx (xin0, xin1, &xl, &xh, encoder);
-
-    /* Call the upper and lower band ADPCM encoders */
-    il = lsbcod (xl, 0, encoder);
-    ih = hsbcod (xh, 0, encoder);
+      /* Call the upper and lower band ADPCM encoders */
+      il = lsbcod (xl[j], 0, encoder);
+      ih = hsbcod (xh[j], 0, encoder);
 
-    /* Mount the output G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
-    code[i] = s_and (add (shl (ih, 6), il), 0xFF);
+      /* Mount the output G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
+      code[i + j] = s_and (add (shl (ih, 6), il), 0xFF);
 #ifdef WMOPS
-    move16 ();
+      move16 ();
 #endif
+    }
   }
 
   /* Return number of samples read */
@@ -139,31 +141,33 @@ void g722_reset_decoder (g722_state * decoder) {
 short g722_decode (short *code, short *outcode, short mode, short read1, g722_state * decoder) {
   /* Decoder variables */
   Word16 il, ih;
-  Word16 rl, rh;
-  Word16 xout1, xout2;
+  Word16 rl[QMF_BLK_LEN], rh[QMF_BLK_LEN];
 
   /* Auxiliary variables */
-  short i;
+  short i, j, len;
 
   /* Decode - reset is never applied here */
-  for (i = 0; i < read1; i++) {
-    /* Separate the input G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
-    il = s_and (code[i], 0x3F); /* 6 bits of low SB */
-    ih = s_and (lshr (code[i], 6), 0x03);       /* 2 bits of high SB */
-
-    /* Call the upper and lower band ADPCM decoders */
-    rl = lsbdec (il, mode, 0, decoder);
-    rh = hsbdec (ih, 0, decoder);
-
-    /* Calculation of output samples from QMF filter */
-    qmf_rx (rl, rh, &xout1, &xout2, decoder);
-
-    /* Save samples in output vector */
-    *outcode++ = xout1;
-    *outcode++ = xout2;
+  for (i = 0; i < read1; i += len) {
+    len = (read1 - i < QMF_BLK_LEN) ? read1 - i : QMF_BLK_LEN;
+
+    for (j = 0; j < len; j++) {
+      /* Separate the input G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
+      il = s_and (code[i + j], 0x3F);   /* 6 bits of low SB */
+      ih = s_and (lshr (code[i + j], 6), 0x03); /* 2 bits of high SB */
+
+      /* Call the upper and lower band ADPCM decoders */
+      rl[j] = lsbdec (il, mode, 0, decoder);
+      rh[j] = hsbdec (ih, 0, decoder);
+    }
+
+    /* Calculation of output samples from QMF filter for a block */
+    qmf_rx_block (rl, rh, outcode, len, decoder);
+    outcode += 2 * len;
 #ifdef WMOPS
-    move16 ();
-    move16 ();
+    for (j = 0; j < len; j++) {
+      move16 ();
+      move16 ();
+    }
 #endif
   }
 
@@ -1,4 +1,4 @@
-/*                                                           v2.0 24.Jan.2000
+/*                                                           v2.1 16.Oct.2026
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -39,6 +39,9 @@ HISTORY:
                   processing of test vector ri40fa. Corrected code
                   provided by Jayesh Patel <jayesh@dspse.com>.
 		  Verified by <simao.campos@labs.comsat.com>
+16.Oct.2026 v2.1  Added G726_encode_multi() and G726_decode_multi(), which
+                  run several channels in lockstep on a structure of arrays
+                  state, bit-exact to G726_encode()/G726_decode().
 
 FUNCTIONS:
 Public:
@@ -46,6 +49,10 @@ Public:
 
   G726_decode ..... G726 decoder function;
 
+  G726_encode_multi G726 multi-channel encoder function;
+
+  G726_decode_multi G726 multi-channel decoder function;
+
 Private:
   G726_accum ...... addition of predictor outputs to form the partial
                     signal estimate (from the sixth order predictor) and
@@ -566,6 +573,435 @@ void G726_decode (short *inp_buf, short *out_buf, long smpno, char *law, short r
 /* ...................... end of G726_decode() ...................... */
 
 
+/*
+  ----------------------------------------------------------------------------
+
+        Multi-channel (structure of arrays) encoder and decoder
+
+        G726_encode_multi() and G726_decode_multi() run `nchan'
+        independent channels in lockstep: for each sample instant, every
+        block of G.726 is applied to all the channels before moving on to
+        the next block. The state of the channels is kept in a
+        G726_multi_state, where each state variable of G726_state is an
+        array indexed by the channel. The adaptive predictor and the
+        adaptation of the quantizer scale factor, speed control and
+        predictor coefficients, which make up most of the work, are
+        written below as branch-free loops over the channels, so that
+        an optimizing compiler can vectorize them; the quantizer, the
+        table look-ups and the synchronous coding adjustment of the
+        decoder use the block functions of the single-channel version.
+
+        The temporaries use `int' (at least 32 bits in the platforms
+        supported) instead of `long', so that the vector lanes are 32 bits
+        wide. The results are bit-exact to G726_encode()/G726_decode()
+        run on each channel separately.
+
+ ----------------------------------------------------------------------------
+*/
+
+/* Number of significant bits of 0 <= m <= 32767; replaces the chains of
+   comparisons used by G726_floata(), G726_floatb() and G726_fmult() */
+static int G726_bitlen (int m) {
+  return (m >= 1) + (m >= 2) + (m >= 4) + (m >= 8) + (m >= 16) + (m >= 32) + (m >= 64) + (m >= 128) + (m >= 256) + (m >= 512) + (m >= 1024) + (m >= 2048) + (m >= 4096) + (m >= 8192) + (m >= 16384);
+}
+
+
+/* G726_fmult() on values; returns the 16-bit product, without sign
+   extension. Since wanexp <= 28, both branches of the conversion to
+   magnitude of G726_fmult() reduce to a single right shift. */
+static int G726_fmult_v (int an, int srn) {
+  int anmag, anexp, anmant, ans;
+  int srns, srnexp, srnmant;
+  int wans, wanexp, wanmant, wanmag;
+
+  an &= 65535;
+  srn &= 65535;
+  ans = an >> 15;
+  anmag = (ans == 0) ? (an >> 2) : ((16384 - (an >> 2)) & 8191);
+  anexp = G726_bitlen (anmag);
+  anmant = (anmag == 0) ? (1 << 5) : ((anmag << 6) >> anexp);
+
+  srns = srn >> 10;
+  srnexp = (srn >> 6) & 15;
+  srnmant = srn & 63;
+
+  wans = srns ^ ans;
+  wanexp = srnexp + anexp;
+  wanmant = ((srnmant * anmant) + 48) >> 4;
+  wanmag = ((wanmant << 9) >> (28 - wanexp)) & 32767;
+
+  return (wans == 0) ? wanmag : ((65536 - wanmag) & 65535);
+}
+
+
+/* G726_floata() and G726_floatb() on values, after the sign and
+   magnitude have been extracted */
+static int G726_float_v (int s, int mag) {
+  int exp_ = G726_bitlen (mag);
+
+  return (s << 10) + (exp_ << 6) + ((mag == 0) ? (1 << 5) : ((mag << 6) >> exp_));
+}
+
+
+/* G726_upb() and G726_trigb() on values; `ugb' is the gain for u=0
+   (0 if dq is zero), `leak' and `param' depend on the rate */
+static int G726_upb_v (int b, int u, int ugb, int leak, int param, int tr) {
+  int bb = b & 65535;
+  int ulb;
+
+  ulb = ((bb >> 15) ? (65536 - ((bb >> leak) + param)) : (65536 - (bb >> leak))) & 65535;
+  return tr ? 0 : ((bb + ((((u == 0) ? ugb : (65536 - ugb)) + ulb) & 65535)) & 65535);
+}
+
+
+/* Apply the reset to channels 0..nchan-1; all the state variables are
+   read through the delaya..delayd blocks, hence the reset at the first
+   sample is the same as starting from the values those blocks output */
+static void G726_multi_reset (G726_multi_state * st, short nchan) {
+  short c;
+
+  for (c = 0; c < nchan; c++) {
+    st->sr0[c] = st->sr1[c] = 32;
+    st->a1r[c] = st->a2r[c] = 0;
+    st->b1r[c] = st->b2r[c] = st->b3r[c] = st->b4r[c] = st->b5r[c] = st->b6r[c] = 0;
+    st->dq5[c] = st->dq4[c] = st->dq3[c] = st->dq2[c] = st->dq1[c] = st->dq0[c] = 32;
+    st->dmsp[c] = st->dmlp[c] = st->apr[c] = 0;
+    st->yup[c] = 544;
+    st->tdr[c] = 0;
+    st->pk0[c] = st->pk1[c] = 0;
+    st->ylp[c] = 34816;
+  }
+}
+
+
+/* `Known-state' parts of 4.2.4 to 4.2.6: signal estimate and scale factor */
+static void G726_multi_predict (G726_multi_state * st, short nchan) {
+  int sr2, dq6, wa1, wa2, wb1, wb2, wb3, wb4, wb5, wb6;
+  int sezi, sei, al, yl, dif, difs, difm, prodm, prod;
+  short c;
+
+  for (c = 0; c < nchan; c++) {
+    /* 4.2.6: delays and products of the predictor */
+    sr2 = st->sr1[c];
+    st->sr1[c] = st->sr0[c];
+    wa2 = G726_fmult_v (st->a2r[c], sr2);
+    wa1 = G726_fmult_v (st->a1r[c], st->sr1[c]);
+
+    dq6 = st->dq5[c];
+    st->dq5[c] = st->dq4[c];
+    st->dq4[c] = st->dq3[c];
+    st->dq3[c] = st->dq2[c];
+    st->dq2[c] = st->dq1[c];
+    st->dq1[c] = st->dq0[c];
+    wb1 = G726_fmult_v (st->b1r[c], st->dq1[c]);
+    wb2 = G726_fmult_v (st->b2r[c], st->dq2[c]);
+    wb3 = G726_fmult_v (st->b3r[c], st->dq3[c]);
+    wb4 = G726_fmult_v (st->b4r[c], st->dq4[c]);
+    wb5 = G726_fmult_v (st->b5r[c], st->dq5[c]);
+    wb6 = G726_fmult_v (st->b6r[c], dq6);
+
+    /* G726_accum() */
+    sezi = (((((((((wb1 + wb2) & 65535) + wb3) & 65535) + wb4) & 65535) + wb5) & 65535) + wb6) & 65535;
+    sei = (((sezi + wa2) & 65535) + wa1) & 65535;
+    st->sez[c] = (short) (sezi >> 1);
+    st->se[c] = (short) (sei >> 1);
+    st->dq6[c] = (short) dq6;
+
+    /* 4.2.5: G726_lima(); 4.2.4: G726_mix() */
+    al = (st->apr[c] >= 256) ? 64 : (st->apr[c] >> 2);
+    yl = st->ylp[c];
+    dif = (st->yup[c] + 16384 - (yl >> 6)) & 16383;
+    difs = dif >> 13;
+    difm = (difs == 0) ? dif : ((16384 - dif) & 8191);
+    prodm = (difm * al) >> 6;
+    prod = (difs == 0) ? prodm : ((16384 - prodm) & 16383);
+    st->y[c] = (short) (((yl >> 6) + prod) & 8191);
+  }
+}
+
+
+/* 4.2.3, 4.2.5: table look-ups indexed by the ADPCM codeword */
+static void G726_multi_lookup (G726_multi_state * st, short rate, short nchan) {
+  short c;
+
+  for (c = 0; c < nchan; c++) {
+    G726_reconst (rate, &st->i[c], &st->dqln[c], &st->dqs[c]);
+    G726_functf (rate, &st->i[c], &st->fi[c]);
+    G726_functw (rate, &st->i[c], &st->wi[c]);
+  }
+}
+
+
+/* Remaining parts of 4.2.3 to 4.2.7: update of the state */
+static void G726_multi_update (G726_multi_state * st, short rate, short nchan) {
+  int y, yl, dql, dqmag, dq, dqs, dqi, sr, sez, se;
+  int dms, dml, fi, ap, app, ax, dif, difs, difm, difsx;
+  int yut, yup, td, tr, thr1, thr2, ylint, ylfrac;
+  int pk0, pk1, pk2, sigpk, dqsez, mag, srs;
+  int a1, a2, a11, a21, fa, fa1, uga2, uga2b, ula2, a2t, a2p, uga1, ula1, a1t, a1p, a1ll, a1ul, tdp;
+  int leak, param, ugb;
+  short c;
+
+  /* Leak factor of the sixth order predictor */
+  leak = (rate != 5) ? 8 : 9;
+  param = (rate != 5) ? 65280 : 65408;
+
+  for (c = 0; c < nchan; c++) {
+    y = st->y[c];
+    yl = st->ylp[c];
+
+    /* 4.2.3: G726_adda(), G726_antilog() */
+    dql = (st->dqln[c] + (y >> 2)) & 4095;
+    dqmag = (dql >> 11) ? 0 : ((((dql & 127) + 128) << 7) >> (14 - ((dql >> 7) & 15)));
+    dqs = st->dqs[c];
+    dq = dqmag - (dqs << 15);
+
+    /* 4.2.5: G726_filta(), G726_filtb() */
+    fi = st->fi[c];
+    dms = st->dmsp[c];
+    dif = ((fi << 9) + 8192 - dms) & 8191;
+    difsx = (dif >> 12) ? ((dif >> 5) + 3840) : (dif >> 5);
+    st->dmsp[c] = (short) ((difsx + dms) & 4095);
+    dml = st->dmlp[c];
+    dif = ((fi << 11) + 32768 - dml) & 32767;
+    difsx = (dif >> 14) ? ((dif >> 7) + 16128) : (dif >> 7);
+    st->dmlp[c] = (short) ((difsx + dml) & 16383);
+
+    /* 4.2.4: G726_filtd(), G726_limb(), G726_filte() */
+    dif = ((st->wi[c] << 5) + 131072 - y) & 131071;
+    difsx = (dif >> 16) ? ((dif >> 5) + 4096) : (dif >> 5);
+    yut = (y + difsx) & 8191;
+    yup = (((yut + 15840) & 16383) >> 13) ? 544 : ((((yut + 11264) & 16383) >> 13) ? yut : 5120);
+    st->yup[c] = (short) yup;
+    dif = (yup + ((1048576 - yl) >> 6)) & 16383;
+    difsx = (dif >> 13) ? (dif + 507904) : dif;
+    st->ylp[c] = (yl + difsx) & 524287;
+
+    /* 4.2.7: G726_trans() */
+    td = st->tdr[c];
+    ylint = yl >> 15;
+    ylfrac = (yl >> 10) & 31;
+    thr1 = (ylfrac + 32) << ylint;
+    thr2 = (ylint > 9) ? 31744 : thr1;
+    tr = ((dq & 32767) > ((thr2 + (thr2 >> 1)) >> 1) && td == 1) ? 1 : 0;
+
+    /* 4.2.6: update of `pk's, G726_addc() */
+    sez = st->sez[c];
+    dqi = (dqs == 0) ? (dq & 65535) : ((65536 - (dq & 32767)) & 65535);
+    dqsez = (dqi + ((sez >> 14) ? (sez + 32768) : sez)) & 65535;
+    pk2 = st->pk1[c];
+    pk1 = st->pk0[c];
+    pk0 = dqsez >> 15;
+    sigpk = (dqsez == 0) ? 1 : 0;
+    st->pk1[c] = (short) pk1;
+    st->pk0[c] = (short) pk0;
+
+    /* 4.2.6: find sr0 (G726_addb(), G726_floatb()) */
+    se = st->se[c];
+    sr = (dqi + ((se >> 14) ? ((1 << 15) + se) : se)) & 65535;
+    st->sr[c] = (short) sr;
+    srs = sr >> 15;
+    mag = (srs == 0) ? sr : ((65536 - sr) & 32767);
+    st->sr0[c] = (short) G726_float_v (srs, mag);
+
+    /* 4.2.6: find dq0 (G726_floata()) */
+    st->dq0[c] = (short) G726_float_v (dqs, dq & 32767);
+
+    /* 4.2.6: prepare a2(r) (G726_upa2(), G726_limc()) */
+    a1 = st->a1r[c];
+    a2 = st->a2r[c];
+    a11 = a1 & 65535;
+    a21 = a2 & 65535;
+    if (a1 >= 0)
+      fa1 = (a11 <= 8191) ? (a11 << 2) : (8191 << 2);
+    else
+      fa1 = (a11 >= 57345) ? ((a11 << 2) & 131071) : (24577 << 2);
+    fa = (pk0 ^ pk1) ? fa1 : ((131072 - fa1) & 131071);
+    uga2b = (((pk0 ^ pk2) == 0 ? 16384 : 114688) + fa) & 131071;
+    uga2 = (sigpk == 1) ? 0 : ((uga2b >> 16) ? ((uga2b >> 7) + 64512) : (uga2b >> 7));
+    ula2 = (a2 >= 0) ? ((65536 - (a21 >> 7)) & 65535) : ((65536 - ((a21 >> 7) + 65024)) & 65535);
+    a2t = (a21 + ((uga2 + ula2) & 65535)) & 65535;
+    if (a2t >= 32768 && a2t <= 53248)
+      a2p = 53248;
+    else if (a2t >= 12288 && a2t <= 32767)
+      a2p = 12288;
+    else
+      a2p = a2t;
+    st->a2r[c] = (short) (tr ? 0 : a2p);
+
+    /* 4.2.6: prepare a1(r) (G726_upa1(), G726_limd()) */
+    uga1 = (sigpk == 1) ? 0 : (((pk0 ^ pk1) == 0) ? 192 : 65344);
+    ula1 = ((a11 >> 15) ? (65536 - ((a11 >> 8) + 65280)) : (65536 - (a11 >> 8))) & 65535;
+    a1t = (a11 + ((uga1 + ula1) & 65535)) & 65535;
+    a1ul = (15360 + 65536 - a2p) & 65535;
+    a1ll = (a2p + 65536 - 15360) & 65535;
+    if (a1t >= 32768 && a1t <= a1ll)
+      a1p = a1ll;
+    else if (a1t >= a1ul && a1t <= 32767)
+      a1p = a1ul;
+    else
+      a1p = a1t;
+    st->a1r[c] = (short) (tr ? 0 : a1p);
+
+    /* 4.2.7: G726_tone() */
+    tdp = (a2p >= 32768 && a2p < 53760) ? 1 : 0;
+    st->tdr[c] = (short) (tr ? 0 : tdp);
+
+    /* 4.2.5: G726_subtc(), G726_filtc(), G726_triga() */
+    dif = ((st->dmsp[c] << 2) + 32768 - st->dmlp[c]) & 32767;
+    difs = dif >> 14;
+    difm = (difs == 0) ? dif : ((32768 - dif) & 16383);
+    ax = (y >= 1536 && difm < (st->dmlp[c] >> 3) && tdp == 0) ? 0 : 1;
+    ap = st->apr[c];
+    dif = ((ax << 9) + 2048 - ap) & 2047;
+    difsx = (dif >> 10) ? ((dif >> 4) + 896) : (dif >> 4);
+    app = (difsx + ap) & 1023;
+    st->apr[c] = (short) (tr ? 256 : app);
+
+    /* 4.2.6: update of all `b's (G726_xor(), G726_upb(), G726_trigb()) */
+    ugb = ((dq & 32767) == 0) ? 0 : 128;
+    st->b1r[c] = (short) G726_upb_v (st->b1r[c], dqs ^ (st->dq1[c] >> 10), ugb, leak, param, tr);
+    st->b2r[c] = (short) G726_upb_v (st->b2r[c], dqs ^ (st->dq2[c] >> 10), ugb, leak, param, tr);
+    st->b3r[c] = (short) G726_upb_v (st->b3r[c], dqs ^ (st->dq3[c] >> 10), ugb, leak, param, tr);
+    st->b4r[c] = (short) G726_upb_v (st->b4r[c], dqs ^ (st->dq4[c] >> 10), ugb, leak, param, tr);
+    st->b5r[c] = (short) G726_upb_v (st->b5r[c], dqs ^ (st->dq5[c] >> 10), ugb, leak, param, tr);
+    st->b6r[c] = (short) G726_upb_v (st->b6r[c], dqs ^ (st->dq6[c] >> 10), ugb, leak, param, tr);
+  }
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+
+        void G726_encode_multi (short *inp_buf, short *out_buf, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~~  short nchan, char *law, short rate, short r,
+                                G726_multi_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Multi-channel version of G726_encode(): encodes `smpno' samples
+        of each of the `nchan' channels (nchan <= G726_MAX_CHAN), all at
+        the same `rate' and `law'. The buffers are interleaved, i.e.,
+        sample j of channel c is at index j*nchan+c of `inp_buf' and
+        `out_buf'. Unlike G726_encode(), `inp_buf' is not modified for
+        A law.
+
+        The reset (r equal to 1) applies to all the channels at the first
+        sample. The output of each channel is the same as that of
+        G726_encode() with the channel's own G726_state.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created based on G726_encode()
+
+ ----------------------------------------------------------------------------
+*/
+void G726_encode_multi (short *inp_buf, short *out_buf, long smpno, short nchan, char *law, short rate, short r, G726_multi_state * state) {
+  short s, sl, d, dl, ds, dln;
+  short mask = (*law == '1') ? 85 : 0;
+  short c;
+  long j;
+
+  if (r)
+    G726_multi_reset (state, nchan);
+
+  for (j = 0; j < smpno; j++, inp_buf += nchan, out_buf += nchan) {
+    G726_multi_predict (state, nchan);
+
+    /* Process 4.2.1 and 4.2.2 */
+    for (c = 0; c < nchan; c++) {
+      s = inp_buf[c] ^ mask;
+      G726_expand (&s, law, &sl);
+      G726_subta (&sl, &state->se[c], &d);
+      G726_log (&d, &dl, &ds);
+      G726_subtb (&dl, &state->y[c], &dln);
+      G726_quan (rate, &dln, &ds, &state->i[c]);
+      out_buf[c] = state->i[c];
+    }
+
+    G726_multi_lookup (state, rate, nchan);
+    G726_multi_update (state, rate, nchan);
+  }
+}
+
+/* ................... end of G726_encode_multi() ................... */
+
+
+/*
+  ----------------------------------------------------------------------------
+
+        void G726_decode_multi (short *inp_buf, short *out_buf, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~~  short nchan, char *law, short rate, short r,
+                                G726_multi_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Multi-channel version of G726_decode(): decodes `smpno' samples
+        of each of the `nchan' channels (nchan <= G726_MAX_CHAN), all at
+        the same `rate' and `law'. The buffers are interleaved, as for
+        G726_encode_multi().
+
+        The reset (r equal to 1) applies to all the channels at the first
+        sample. The output of each channel is the same as that of
+        G726_decode() with the channel's own G726_state.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created based on G726_decode()
+
+ ----------------------------------------------------------------------------
+*/
+void G726_decode_multi (short *inp_buf, short *out_buf, long smpno, short nchan, char *law, short rate, short r, G726_multi_state * state) {
+  short sp, slx, dx, dlx, dsx, dlnx, sd;
+  short mask = (*law == '1') ? 85 : 0;
+  short c;
+  long j;
+
+  if (r)
+    G726_multi_reset (state, nchan);
+
+  for (j = 0; j < smpno; j++, inp_buf += nchan, out_buf += nchan) {
+    G726_multi_predict (state, nchan);
+
+    /* Retrieve ADPCM samples from input buffer */
+    for (c = 0; c < nchan; c++)
+      state->i[c] = inp_buf[c];
+
+    G726_multi_lookup (state, rate, nchan);
+    G726_multi_update (state, rate, nchan);
+
+    /* Process 4.2.8, which does not change the state */
+    for (c = 0; c < nchan; c++) {
+      G726_compress (&state->sr[c], law, &sp);
+      G726_expand (&sp, law, &slx);
+      G726_subta (&slx, &state->se[c], &dx);
+      G726_log (&dx, &dlx, &dsx);
+      G726_subtb (&dlx, &state->y[c], &dlnx);
+      G726_sync (rate, &state->i[c], &sp, &dlnx, &dsx, law, &sd);
+      out_buf[c] = sd ^ mask;
+    }
+  }
+}
+
+/* ................... end of G726_decode_multi() ................... */
+
+
 /*
   ----------------------------------------------------------------------
 
@@ -10,6 +10,7 @@
    History:
    28.Feb.92	v1.0	First version <simao@cpqd.br>
    06.May.94    v2.0    Smart prototypes that work with many compilers <simao>
+   16.Oct.26    v2.1    Multi-channel state and prototypes
   ============================================================================
 */
 #ifndef G726_defined
@@ -50,9 +51,55 @@ typedef struct {
   long ylp;                     /* Slow quantizer scale factor */
 } G726_state;
 
+/* Maximum number of channels of the multi-channel encoder and decoder */
+#ifndef G726_MAX_CHAN
+#define G726_MAX_CHAN 64
+#endif
+
+/* State for G726 multi-channel encoder and decoder: the variables of
+   G726_state, each one an array indexed by the channel */
+typedef struct {
+  short sr0[G726_MAX_CHAN], sr1[G726_MAX_CHAN];
+  short a1r[G726_MAX_CHAN], a2r[G726_MAX_CHAN];
+  short b1r[G726_MAX_CHAN];
+  short b2r[G726_MAX_CHAN];
+  short b3r[G726_MAX_CHAN];
+  short b4r[G726_MAX_CHAN];
+  short b5r[G726_MAX_CHAN];
+  short b6r[G726_MAX_CHAN];
+  short dq5[G726_MAX_CHAN];
+  short dq4[G726_MAX_CHAN];
+  short dq3[G726_MAX_CHAN];
+  short dq2[G726_MAX_CHAN];
+  short dq1[G726_MAX_CHAN];
+  short dq0[G726_MAX_CHAN];
+  short dmsp[G726_MAX_CHAN];
+  short dmlp[G726_MAX_CHAN];
+  short apr[G726_MAX_CHAN];
+  short yup[G726_MAX_CHAN];
+  short tdr[G726_MAX_CHAN];
+  short pk0[G726_MAX_CHAN], pk1[G726_MAX_CHAN];
+  int ylp[G726_MAX_CHAN];       /* 19 bits; int for 32-bit vector lanes */
+
+  /* Values passed between the blocks within a sample, not part of the
+     state; kept here so that all the arrays share a base pointer */
+  short se[G726_MAX_CHAN];      /* Signal estimate */
+  short sez[G726_MAX_CHAN];     /* Partial signal estimate */
+  short y[G726_MAX_CHAN];       /* Quantizer scale factor */
+  short dq6[G726_MAX_CHAN];     /* Quantized difference signal with delay 6 */
+  short i[G726_MAX_CHAN];       /* ADPCM codeword */
+  short dqln[G726_MAX_CHAN];    /* Log. quantized difference signal */
+  short dqs[G726_MAX_CHAN];     /* Sign of the quantized difference signal */
+  short fi[G726_MAX_CHAN];      /* F(I) */
+  short wi[G726_MAX_CHAN];      /* W(I) */
+  short sr[G726_MAX_CHAN];      /* Reconstructed signal */
+} G726_multi_state;
+
 /* Function prototypes */
 void G726_encode ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
 void G726_decode ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+void G726_encode_multi ARGS ((short *inp_buf, short *out_buf, long smpno, short nchan, char *law, short rate, short r, G726_multi_state * state));
+void G726_decode_multi ARGS ((short *inp_buf, short *out_buf, long smpno, short nchan, char *law, short rate, short r, G726_multi_state * state));
 void G726_expand ARGS ((short *s, char *law, short *sl));
 void G726_subta ARGS ((short *sl, short *se, short *d));
 void G726_log ARGS ((short *d, short *dl, short *ds));
@@ -1,4 +1,4 @@
-/*                                                           03.Feb.2010 v1.4
+/*                                                           16.Oct.2026 v1.5
   ============================================================================
 
   VBR-G726.C
@@ -59,6 +59,11 @@
   -dec        run only the G.726 decoder on the samples
               [default: run encoder and decoder]
   -noreset    don't apply reset to the encoder/decoder
+  -multi #    run # channels (up to G726_MAX_CHAN) in lockstep with the
+              multi-channel encoder/decoder; the input and output
+              files hold the # channels interleaved sample by sample,
+              and the block parameters count samples per channel
+              [default: single-channel encoder/decoder]
   -?/-help    print help message
 
   Example:
@@ -93,6 +98,7 @@
   7  invalid law
   8  invalid conversion
   9  invalid rate
+  10 invalid number of channels
 
   Original author:
   ~~~~~~~~~~~~~~~~
@@ -116,6 +122,8 @@
                     when the block size is not a multiple of the file
                     size. <simao.campos@labs.comsat.com>
   02.Feb.2010 v1.4  Modified maximum string length (y.hiwasaki)
+  16.Oct.2026 v1.5  Added option -multi, to run the multi-channel
+                    encoder/decoder
   ============================================================================
 */
 
@@ -223,7 +231,7 @@ int parse_rate (char *str, short **rate) {
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("Version 1.3 of 21/Mar/2000 \n\n");
+  printf ("Version 1.5 of 16/Oct/2026 \n\n");
 
   printf ("  VBR-G726.C \n");
   printf ("  Demonstration program for UGST/ITU-T G.726 module using the variable\n");
@@ -272,6 +280,11 @@ void display_usage () {
   printf ("  -dec        run only the G.726 decoder on the samples \n");
   printf ("              [default: run encoder and decoder]\n");
   printf ("  -noreset    don't apply reset to the encoder/decoder\n");
+  printf ("  -multi #    run # channels (up to %d) in lockstep with the\n", G726_MAX_CHAN);
+  printf ("              multi-channel encoder/decoder; the input and output\n");
+  printf ("              files hold the # channels interleaved sample by sample,\n");
+  printf ("              and the block parameters count samples per channel\n");
+  printf ("              [default: single-channel encoder/decoder]\n");
   printf ("  -?/-help    print help message\n\n");
 
   /* Quit program */
@@ -291,8 +304,11 @@ void display_usage () {
 */
 int main (int argc, char *argv[]) {
   G726_state encoder_state, decoder_state;
-  long N = 16, N1 = 1, N2 = 0, cur_blk, smpno;
+  static G726_multi_state multi_encoder_state, multi_decoder_state;
+  long N = 16, N1 = 1, N2 = 0, Nf, cur_blk, smpno;
   short *tmp_buf, *inp_buf, *out_buf, reset = 1;
+  short *minp_buf = 0, *mout_buf = 0, *mtmp_buf = 0, nchan = 0;
+  short *fin_buf, *fout_buf, *ftmp_buf;
   short inp_type, out_type, *rate = 0;
   char encode = 1, decode = 1, law[4] = "A", def_rate[] = "32";
   int rateno = 1, rate_idx;
@@ -358,6 +374,15 @@ int main (int argc, char *argv[]) {
           error_terminate (" Invalid law (A or u)! Aborted...\n", 7);
         }
 
+        /* Move argv over the option to the next argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-multi") == 0) {
+        /* Number of channels for the multi-channel encoder/decoder */
+        nchan = atoi (argv[2]);
+        if (nchan < 1 || nchan > G726_MAX_CHAN)
+          error_terminate (" Invalid number of channels! Aborted...\n", 10);
+
         /* Move argv over the option to the next argument */
         argv += 2;
         argc -= 2;
@@ -408,8 +433,11 @@ int main (int argc, char *argv[]) {
   /* Inform user of the compading law used: 0->u, 1->A, 2->linear */
   fprintf (stderr, "Using %s\n", law[0] == '1' ? "A-law" : (law[0] == '0' ? "u-law" : "linear PCM"));
 
+  /* Samples per block in the files: one for each channel with -multi */
+  Nf = nchan ? N * nchan : N;
+
   /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
+  start_byte = sizeof (short) * (long) (--N1) * (long) Nf;
 
   /* Check if is to process the whole file */
   if (N2 == 0) {
@@ -417,7 +445,7 @@ int main (int argc, char *argv[]) {
 
     /* ... find the input file size ... */
     stat (FileIn, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
+    N2 = ceil ((st.st_size - start_byte) / (double) (Nf * sizeof (short)));
   }
 
   /* Define correct data I/O types */
@@ -445,6 +473,19 @@ int main (int argc, char *argv[]) {
     error_terminate ("Error in memory allocation!\n", 1);
   if ((tmp_buf = (short *) calloc (N, sizeof (short))) == NULL)
     error_terminate ("Error in memory allocation!\n", 1);
+  if (nchan) {
+    if ((minp_buf = (short *) calloc (N * nchan, sizeof (short))) == NULL)
+      error_terminate ("Error in memory allocation!\n", 1);
+    if ((mout_buf = (short *) calloc (N * nchan, sizeof (short))) == NULL)
+      error_terminate ("Error in memory allocation!\n", 1);
+    if ((mtmp_buf = (short *) calloc (N * nchan, sizeof (short))) == NULL)
+      error_terminate ("Error in memory allocation!\n", 1);
+  }
+
+  /* Buffers for the file I/O: interleaved channels with -multi */
+  fin_buf = nchan ? minp_buf : inp_buf;
+  fout_buf = nchan ? mout_buf : out_buf;
+  ftmp_buf = nchan ? mtmp_buf : tmp_buf;
 
 /*
  * ......... FILE PREPARATION .........
@@ -486,23 +527,35 @@ int main (int argc, char *argv[]) {
 #endif
 
     /* Read a block of samples */
-    if ((smpno = fread (inp_buf, sizeof (short), N, Fi)) < 0)
+    if ((smpno = fread (fin_buf, sizeof (short), Nf, Fi)) < 0)
       KILL (FileIn, 5);
+    if (nchan)
+      smpno -= smpno % nchan;   /* only whole samples of all channels */
 
     /* Compress linear input samples */
     if (inp_type == IS_LIN) {
       /* Compress using A-law */
-      alaw_compress (smpno, inp_buf, tmp_buf);
+      alaw_compress (smpno, fin_buf, ftmp_buf);
 
       /* copy temporary buffer over input buffer */
-      memcpy (inp_buf, tmp_buf, sizeof (short) * smpno);
+      memcpy (fin_buf, ftmp_buf, sizeof (short) * smpno);
     }
 
     /* Check if reset is needed */
     reset = (reset == 1 && cur_blk == 0) ? 1 : 0;
 
     /* Carry out the desired operation */
-    if (encode && !decode)
+    if (nchan) {
+      /* Channels interleaved sample by sample */
+      if (encode && !decode)
+        G726_encode_multi (minp_buf, mout_buf, smpno / nchan, nchan, law, rate[rate_idx], reset, &multi_encoder_state);
+      else if (decode && !encode)
+        G726_decode_multi (minp_buf, mout_buf, smpno / nchan, nchan, law, rate[rate_idx], reset, &multi_decoder_state);
+      else if (encode && decode) {
+        G726_encode_multi (minp_buf, mtmp_buf, smpno / nchan, nchan, law, rate[rate_idx], reset, &multi_encoder_state);
+        G726_decode_multi (mtmp_buf, mout_buf, smpno / nchan, nchan, law, rate[rate_idx], reset, &multi_decoder_state);
+      }
+    } else if (encode && !decode)
       G726_encode (inp_buf, out_buf, smpno, law, rate[rate_idx], reset, &encoder_state);
     else if (decode && !encode)
       G726_decode (inp_buf, out_buf, smpno, law, rate[rate_idx], reset, &decoder_state);
@@ -514,14 +567,14 @@ int main (int argc, char *argv[]) {
     /* Expand linear input samples */
     if (out_type == IS_LIN) {
       /* Compress using A-law */
-      alaw_expand (smpno, out_buf, tmp_buf);
+      alaw_expand (smpno, fout_buf, ftmp_buf);
 
       /* copy temporary buffer over input buffer */
-      memcpy (out_buf, tmp_buf, sizeof (short) * smpno);
+      memcpy (fout_buf, ftmp_buf, sizeof (short) * smpno);
     }
 
     /* Write ADPCM output word */
-    if ((smpno = fwrite (out_buf, sizeof (short), smpno, Fo)) < 0)
+    if ((smpno = fwrite (fout_buf, sizeof (short), smpno, Fo)) < 0)
       KILL (FileOut, 6);
   }
 
@@ -530,6 +583,11 @@ int main (int argc, char *argv[]) {
  */
 
   /* Free allocated memory */
+  if (nchan) {
+    free (mtmp_buf);
+    free (mout_buf);
+    free (minp_buf);
+  }
   free (tmp_buf);
   free (out_buf);
   free (inp_buf);
@@ -1,4 +1,4 @@
-/*                                                           v3.1 - 22/Feb/1996
+/*                                                           v3.3 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -61,6 +61,12 @@ HISTORY:
     22.Feb.96 v3.1 Changed inclusion of stdlib.h to inconditional, as
                    suggested by Kirchherr (FI/DBP Telekom) to run under
 		   OpenVMS/AXP <simao@ctd.comsat.com>
+    16.Oct.26 v3.2 Cascade-form kernels process blocks of samples stage by
+                   stage (cascade_form_iir_stage()), keeping the biquad state
+                   and coefficients in registers; bit-exact to v3.1.
+    16.Oct.26 v3.3 Pointers to the new structs in the initialization
+                   functions are no longer static, so that filters can be
+                   created concurrently by several threads.
 
   =============================================================================
 */
@@ -94,6 +100,11 @@ static long cascade_form_iir_down_kernel ARGS ((long lenx, float *x, float *y, l
 
 static long cascade_form_iir_up_kernel ARGS ((long lenx, float *x, float *y, long iup, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]));
 
+static void cascade_form_iir_stage ARGS ((long lenw, double *w, float *a, float *b, float *T));
+
+/* Number of samples passed through each cascade stage at a time */
+#define CASCADE_BLK 256
+
 CASCADE_IIR *cascade_iir_init ARGS ((long nblocks, float (*a)[2], float (*b)[2], double gain, long idown, char hswitch));
 
 
@@ -240,7 +251,7 @@ void stdpcm_reset (SCD_IIR * iir_ptr) {
  ============================================================================
 */
 SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double direct_cof, double gain, long idown, char hswitch) {
-  static SCD_IIR *ptrIIR;       /* pointer to the new struct */
+  SCD_IIR *ptrIIR;              /* pointer to the new struct */
   float fak;
   float (*T_ptr)[2];
   long n;
@@ -666,39 +677,36 @@ long cascade_iir_kernel (long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Blocks of CASCADE_BLK samples filtered stage by stage.
 
  ============================================================================
 */
 static long cascade_form_iir_down_kernel (long lenx, float *x, float *y, long *k0, long idown, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]) {
-  long kx, ky, n;
-  double xj, yj;
+  long kx, ky, k, n, lenw;
+  double w[CASCADE_BLK];        /* samples between stages */
 
 
   ky = 0;                       /* starting index in output array (y) */
-  for (kx = 0; kx < lenx; kx++) {       /* loop over all input samples */
-    xj = x[kx];                 /* direct path */
-    for (n = 0; n < nblocks; n++) {     /* loop over all second order filter */
-      yj = xj + a[n][0] * T[n][0] + a[n][1] * T[n][1];
-      yj -= (b[n][0] * T[n][2] + b[n][1] * T[n][3]);
-
-      /* Save samples in memory */
-      T[n][1] = T[n][0];
-      T[n][0] = xj;
-      T[n][3] = T[n][2];
-      T[n][2] = yj;
-
-      /* The yj of this stage is the xj of the next */
-      xj = yj;
-    }
+  for (kx = 0; kx < lenx; kx += lenw) { /* loop over blocks of input samples */
+    lenw = (lenx - kx < CASCADE_BLK) ? lenx - kx : CASCADE_BLK;
 
-    if (*k0 % idown == 0) {     /* compute output only every "idown" * samples */
-      /* Apply gain and update y-samples' counter */
-      y[ky] = yj * gain;
-      ky++;
+    for (k = 0; k < lenw; k++)  /* direct path */
+      w[k] = x[kx + k];
+
+    /* Filter the block through all second order stages; the output of one stage is the input of the next */
+    for (n = 0; n < nblocks; n++)
+      cascade_form_iir_stage (lenw, w, a[n], b[n], T[n]);
+
+    for (k = 0; k < lenw; k++) {
+      if (*k0 % idown == 0) {   /* compute output only every "idown" * samples */
+        /* Apply gain and update y-samples' counter */
+        y[ky] = w[k] * gain;
+        ky++;
+      }
+      (*k0)++;
     }
-    (*k0)++;
+    *k0 %= idown;               /* avoid overflow by (*k0)++ */
   }
-  *k0 %= idown;                 /* avoid overflow by (*k0)++ */
   return ky;
 }
 
@@ -742,40 +750,33 @@ static long cascade_form_iir_down_kernel (long lenx, float *x, float *y, long *k
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Blocks of CASCADE_BLK samples filtered stage by stage.
 
  ============================================================================
 */
 static long cascade_form_iir_up_kernel (long lenx, float *x, float *y, long iup, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]) {
-  long kx, ky, n;
-  double xj, yj;
+  long kx, ky, k, n, lenw;
+  double w[CASCADE_BLK];        /* samples between stages */
 
   kx = 0;                       /* starting index in input array (x) */
-  for (ky = 0; ky < iup * lenx; ky++) { /* loop over all input samples */
-    /* Compute output only every "iup" compute output only every "iup" samples by taking one input sample direct path OR by using a zero-valued sample */
-    if (ky % iup == 0)
-      xj = x[kx];
-    else
-      xj = 0.;
+  for (ky = 0; ky < iup * lenx; ky += lenw) {   /* loop over blocks of output samples */
+    lenw = (iup * lenx - ky < CASCADE_BLK) ? iup * lenx - ky : CASCADE_BLK;
+
+    /* Take one input sample every "iup" samples (direct path), and use zero-valued samples in between */
+    for (k = 0; k < lenw; k++) {
+      if ((ky + k) % iup == 0)
+        w[k] = x[kx++];
+      else
+        w[k] = 0.;
+    }
 
     /* Filter samples through all cascade stages */
-    for (n = 0; n < nblocks; n++) {
-      yj = xj + a[n][0] * T[n][0] + a[n][1] * T[n][1];
-      yj -= (b[n][0] * T[n][2] + b[n][1] * T[n][3]);
-
-      /* Save samples in memory */
-      T[n][1] = T[n][0];
-      T[n][0] = xj;
-      T[n][3] = T[n][2];
-      T[n][2] = yj;
-
-      /* The yj of this stage is the xj of the next */
-      xj = yj;
-    }
+    for (n = 0; n < nblocks; n++)
+      cascade_form_iir_stage (lenw, w, a[n], b[n], T[n]);
 
-    /* Apply the gain and update x counter if needed */
-    y[ky] = yj * gain;
-    if (ky % iup == 0)
-      kx++;
+    /* Apply the gain */
+    for (k = 0; k < lenw; k++)
+      y[ky + k] = w[k] * gain;
   }
   return ky;
 }
@@ -783,6 +784,69 @@ static long cascade_form_iir_up_kernel (long lenx, float *x, float *y, long iup,
 /* ............... End of cascade_form_iir_up_kernel() ............... */
 
 
+/*
+  ============================================================================
+
+  void cascade_form_iir_stage (long lenw, double *w, float *a,
+  ~~~~~~~~~~~~~~~~~~~~~~~~~~~  float *b, float *T);
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Filter, in place, a block of samples through one second order
+  stage of a cascade-form IIR-filter. The arithmetic is the same as
+  the sample-by-sample loop of the STL96 kernels (products of the
+  single-precision coefficients and states, accumulated in double
+  precision), so the cascade gives bit-exact results whichever way
+  the samples are scheduled across the stages.
+
+  Parameters:
+  ~~~~~~~~~~~
+  lenw: ........ (In) number of samples in w[]
+  w: ........... (In/Out) stage input, replaced by the stage output
+  a: ........... (In) numerator coefficients of the stage
+  b: ........... (In) denominator coefficients of the stage
+  T: ........... (In/Out) state variables of the stage
+
+  Return value:
+  ~~~~~~~~~~~~~
+  None.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static void cascade_form_iir_stage (long lenw, double *w, float *a, float *b, float *T) {
+  long k;
+  double xj, yj;
+  float a0 = a[0], a1 = a[1], b0 = b[0], b1 = b[1];
+  float T0 = T[0], T1 = T[1], T2 = T[2], T3 = T[3];
+
+  for (k = 0; k < lenw; k++) {
+    xj = w[k];
+    yj = xj + a0 * T0 + a1 * T1;
+    yj -= (b0 * T2 + b1 * T3);
+
+    /* Save samples in memory */
+    T1 = T0;
+    T0 = xj;
+    T3 = T2;
+    T2 = yj;
+
+    w[k] = yj;
+  }
+
+  T[0] = T0;
+  T[1] = T1;
+  T[2] = T2;
+  T[3] = T3;
+}
+
+/* ................ End of cascade_form_iir_stage() ................ */
+
+
 /*
   ============================================================================
 
@@ -817,7 +881,7 @@ static long cascade_form_iir_up_kernel (long lenx, float *x, float *y, long iup,
  ============================================================================
 */
 CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], double gain, long idown, char hswitch) {
-  static CASCADE_IIR *ptrIIR;   /* pointer to the new struct */
+  CASCADE_IIR *ptrIIR;          /* pointer to the new struct */
   float fak;
   float (*T_ptr)[4];
   long n;
@@ -1227,7 +1291,7 @@ static long direct_form_iir_up_kernel (long lenx, float *x, float *y, long iup,
  ============================================================================
 */
 DIRECT_IIR *direct_iir_init (long zerono, long poleno, float *a, float *b, double gain, long idown, char hswitch) {
-  static DIRECT_IIR *ptrIIR;    /* pointer to the new struct */
+  DIRECT_IIR *ptrIIR;           /* pointer to the new struct */
   float fak;
   float (*T_ptr)[2];
   long n;
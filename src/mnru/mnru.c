@@ -43,6 +43,13 @@ MNRU_process: ......	Processes the `input' buffer of `n' samples (in
                         model (input data is sampled at 8 kHz). Its prototype
                         is in mnru.h.
 
+MNRU_process_batch: ..	Processes the same `input' buffer as MNRU_process for
+                        several values of `Q' at once, sharing the DC removal
+                        and the noise generation. Its prototype is in mnru.h.
+
+random_MNRU_block: .... Generates a block of `n' noise samples, the same as
+                        `n' calls of random_MNRU. Its prototype is in mnru.h.
+
 random_MNRU: .......... Generates gaussian-like noise samples for use by the
                         MNRU_process function. Depends on a seed when `*mode'
                         is 1 (RANDOM_RESET), causing the initialization of
@@ -67,6 +74,9 @@ HISTORY:
                         To increase speed, a new random number generator
                         has been included. Works for both narrow-band and
                         wideband speech.
+  16.Oct.26  v2.1       Noise generated per block with a jump-ahead of the
+                        index LCG (random_MNRU_block), bit-exact; added
+                        MNRU_process_batch for several Q values.
 =============================================================================
 */
 
@@ -88,6 +98,7 @@ HISTORY:
 
 /* Local function prototypes */
 float new_random_MNRU ARGS ((char *mode, new_RANDOM_state * r, long seed, float *fseed));
+static void new_random_MNRU_table ARGS ((new_RANDOM_state * r));
 float ran_vax ARGS ((void));
 
 /*
@@ -137,7 +148,8 @@ float ran_vax ARGS ((void));
 #define TABLE_SIZE 8192         /* 2^13 */
 #define ITER_NO 8
 #define FACTOR 8                /* = 65536(max.no returned by ran16_32c) div.by TABLE_SIZE */
-float new_random_MNRU (char *mode, RANDOM_state * r, long seed, float *fseed) {
+#define BIT24  16777216.0
+static void new_random_MNRU_table (new_RANDOM_state * r) {
   long i;
   double z1;                    /* white random number -8...8 */
   /* weighted with a gaussian distribution */
@@ -146,6 +158,28 @@ float new_random_MNRU (char *mode, RANDOM_state * r, long seed, float *fseed) {
 
   extern float ran_vax ();
 
+  /* Allocate memory for gaussian table */
+  r->gauss = (float *) calloc (TABLE_SIZE, sizeof (float));
+
+  /* Generate gaussian random number table */
+  for (i = 0L; i < TABLE_SIZE; i++) {
+    /* Interact until find gaussian sample */
+    do {
+      z1 = S1 + DIF * (double) ran_vax ();
+      phi = exp (-(z1) * (z1) / MO);
+      z2 = (double) ran_vax ();
+    } while (z2 > phi);
+
+    /* Save gaussian-distributed sample in table */
+    r->gauss[i] = (float) z1;
+  }
+}
+
+float new_random_MNRU (char *mode, RANDOM_state * r, long seed, float *fseed) {
+  long i;
+  double z1;                    /* white random number -8...8 */
+  /* weighted with a gaussian distribution */
+
   long index;
 
   /* *** RUN INITIALIZATION SEQUENCE *** */
@@ -153,21 +187,8 @@ float new_random_MNRU (char *mode, RANDOM_state * r, long seed, float *fseed) {
     /* Toogle mode from reset to run */
     *mode = RANDOM_RUN;
 
-    /* Allocate memory for gaussian table */
-    r->gauss = (float *) calloc (TABLE_SIZE, sizeof (float));
-
     /* Generate gaussian random number table */
-    for (i = 0L; i < TABLE_SIZE; i++) {
-      /* Interact until find gaussian sample */
-      do {
-        z1 = S1 + DIF * (double) ran_vax ();
-        phi = exp (-(z1) * (z1) / MO);
-        z2 = (double) ran_vax ();
-      } while (z2 > phi);
-
-      /* Save gaussian-distributed sample in table */
-      r->gauss[i] = (float) z1;
-    }
+    new_random_MNRU_table (r);
   }
 
   /* *** REAL GENERATOR (after initialization) ** */
@@ -181,6 +202,77 @@ float new_random_MNRU (char *mode, RANDOM_state * r, long seed, float *fseed) {
   return ((float) z1);
 }
 
+/*
+  =============================================================================
+
+	random_MNRU_block (char *mode, RANDOM_state *r, long seed, float *fseed,
+        ~~~~~~~~~~~~~~~~~  double *noise, long n)
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Generates `n' noise samples, the same as `n' calls of
+        new_random_MNRU(), saving them to `noise'.
+
+        With a seed that is an integer in 0..2^24-1, as set by the
+        callers and kept by ran16_32c(), ran16_32c() is the LCG
+        s(k+1) = (253*s(k)+1) mod 2^24 returning s(k+1)/256, and the
+        table index is s(k+1)/2^11. The ITER_NO states of a sample are
+        computed from the last state of the previous sample, as
+        s(k+j) = (A[j]*s(k)+C[j]) mod 2^24, so they are independent of
+        each other. Other seeds fall back to new_random_MNRU().
+
+        Prototype: MNRU.H
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26  1.0	Created.
+
+=============================================================================
+*/
+void random_MNRU_block (char *mode, RANDOM_state * r, long seed, float *fseed, double *noise, long n) {
+  unsigned long A[ITER_NO], C[ITER_NO], st[ITER_NO], s0;
+  long i, j;
+  double z1;
+
+  if (*fseed < 0 || *fseed >= BIT24 || *fseed != floor (*fseed)) {
+    for (i = 0; i < n; i++)
+      noise[i] = (double) new_random_MNRU (mode, r, seed, fseed);
+    return;
+  }
+
+  /* *** RUN INITIALIZATION SEQUENCE *** */
+  if (*mode == RANDOM_RESET) {
+    *mode = RANDOM_RUN;
+    new_random_MNRU_table (r);
+  }
+
+  /* Jump-ahead coefficients of the LCG for 1..ITER_NO steps */
+  A[0] = 253;
+  C[0] = 1;
+  for (j = 1; j < ITER_NO; j++) {
+    A[j] = (253 * A[j - 1]) & 0xFFFFFF;
+    C[j] = (253 * C[j - 1] + 1) & 0xFFFFFF;
+  }
+
+  s0 = (unsigned long) *fseed;
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < ITER_NO; j++)
+      st[j] = (A[j] * s0 + C[j]) & 0xFFFFFF;
+
+    /* Same order of accumulation as new_random_MNRU() */
+    for (z1 = 0, j = 0; j < ITER_NO; j++)
+      z1 += r->gauss[(st[j] >> 8) / FACTOR];
+    z1 /= 2;
+
+    noise[i] = (double) (float) z1;
+    s0 = st[ITER_NO - 1];
+  }
+  *fseed = (float) s0;
+}
+
+#undef BIT24
 #undef TABLE_SIZE
 #undef BIT15
 #undef MO
@@ -385,6 +477,14 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 #undef FAC
 /*  .................... End of ori_random_MNRU() ....................... */
 
+/* Block of `n' samples of ori_random_MNRU() */
+void random_MNRU_block (char *mode, RANDOM_state * r, long seed, float *fseed, double *noise, long n) {
+  long i;
+
+  for (i = 0; i < n; i++)
+    noise[i] = (double) ori_random_MNRU (mode, r, seed);
+}
+
 #endif /* *********************** STL92_RNG ****************************** */
 
 
@@ -447,8 +547,9 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
         Return Value:
         ~~~~~~~~~~~~~
         Returns a (double *)NULL if uninitialized or if initialization
-        failed; returns a (double *) to the 20 kHz data vector if reset was
-        OK and/or is in "run" (MNRU_CONTINUE) operation.
+        failed; returns a (double *) to the noise samples of the block
+        (before modulation) if reset was OK and/or is in "run"
+        (MNRU_CONTINUE) operation.
 
 
         History:
@@ -485,13 +586,147 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 #define NOISE_GAIN 0.3793
 #endif
 
+/*
+  --------------------------------------------------------------------------
+  static void MNRU_init_state (MNRU_state *s, char mode, double Q);
+
+  Set the gains of the signal and noise paths for `mode' and `Q', flag
+  the random sequence for initialization and reset the input DC-removal
+  and output low-pass filters. Used by MNRU_process() and
+  MNRU_process_batch() at MNRU_START.
+  --------------------------------------------------------------------------
+*/
+static void MNRU_init_state (MNRU_state * s, char mode, double Q) {
+  /* Gain for signal path */
+  if (mode == MOD_NOISE)
+    s->signal_gain = 1.000;
+  else if (mode == SIGNAL_ONLY)
+    s->signal_gain = 1.000;
+  else                        /* (mode == NOISE_ONLY) */
+    s->signal_gain = 0.000;
+
+  /* Gain for noise path */
+  if (mode == MOD_NOISE || mode == NOISE_ONLY)
+    s->noise_gain = NOISE_GAIN * pow (10.0, (-0.05 * Q));
+  else                        /* (mode == SIGNAL_ONLY) */
+    s->noise_gain = 0;
+
+  /* Flag for random sequence initialization */
+  s->rnd_mode = RANDOM_RESET;
+#ifndef STL92_RNG
+  s->rnd_state.gauss = (float *) NULL;  /* not allocated for SIGNAL_ONLY */
+#endif
+
+  /* Initialization of the input DC-removal filter */
+  s->last_xk = s->last_yk = 0;
+
+  /* Initialization of the output low-pass filter */
+  /* Cleanup memory */
+  memset (s->DLY, '\0', sizeof (s->DLY));
+
+#ifdef NBMNRU_MASK_ONLY
+  /* Load numerator coefficients */
+  s->A[0][0] = 0.758717518025;
+  s->A[0][1] = 1.50771485802;
+  s->A[0][2] = 0.758717518025;
+  s->A[1][0] = 0.758717518025;
+  s->A[1][1] = 1.46756552150;
+  s->A[1][2] = 0.758717518025;
+
+  /* Load denominator coefficients */
+  s->B[0][0] = 1.16833932919;
+  s->B[0][1] = 0.400250061172;
+  s->B[1][0] = 1.66492368687;
+  s->B[1][1] = 0.850653444434;
+#else
+  /* Load numerator coefficients */
+  s->A[0][0] = 0.775841885724;
+  s->A[0][1] = 1.54552788762;
+  s->A[0][2] = 0.775841885724;
+  s->A[1][0] = 0.775841885724;
+  s->A[1][1] = 1.51915539326;
+  s->A[1][2] = 0.775841885724;
+
+  /* Load denominator coefficients */
+  s->B[0][0] = 1.23307153957;
+  s->B[0][1] = 0.430807372835;
+  s->B[1][0] = 1.71128410940;
+  s->B[1][1] = 0.859087959597;
+#endif
+}
+
+/*
+  --------------------------------------------------------------------------
+  static double MNRU_remove_dc (MNRU_state *s, double inp_smp);
+
+  Remove DC from the input sample, H(z)= (1-Z-1)/(1-a.Z-1), unless
+  compiled with NO_DC_REMOVAL.
+  --------------------------------------------------------------------------
+*/
+static double MNRU_remove_dc (MNRU_state * s, double inp_smp) {
+#ifndef NO_DC_REMOVAL
+  double tmp;
+
+  tmp = inp_smp - s->last_xk;
+  tmp += ALPHA * s->last_yk;
+
+  /* Update for next time */
+  s->last_xk = inp_smp;
+  s->last_yk = tmp;
+
+  /* DC-removed version of the input signal */
+  inp_smp = tmp;
+#endif
+  return inp_smp;
+}
+
+/*
+  --------------------------------------------------------------------------
+  static double MNRU_modulate (MNRU_state *s, char mode, double noise,
+                               double inp_smp);
+
+  Modulate the `noise' sample by the (DC-removed) input sample, add the
+  signal and filter by the output low-pass filter, with the gains, clip
+  counter and filter state of `s'. Returns the output sample.
+  --------------------------------------------------------------------------
+*/
+static double MNRU_modulate (MNRU_state * s, char mode, double noise, double inp_smp) {
+  long i;
+  register double out_tmp, out_flt;
+
+  if (mode == SIGNAL_ONLY)
+    noise = 0;
+  else {
+    noise *= s->noise_gain * inp_smp;   /* noise modulated by input sample */
+    if (noise > 1.00 || noise < -1.00)
+      s->clip++;                /* clip counter */
+  }
+
+  /* Addition of signal and modulated noise */
+  out_tmp = noise + inp_smp * s->signal_gain;
+
+#ifdef NO_OUT_FILTER
+  out_flt = out_tmp;
+#else
+  /* Filter output sample by each stage of the low-pass IIR filter */
+  for (i = 0; i < MNRU_STAGE_OUT_FLT; i++) {
+    out_flt = out_tmp * s->A[i][0] + s->DLY[i][1];
+    s->DLY[i][1] = out_tmp * s->A[i][1] - out_flt * s->B[i][0] + s->DLY[i][0];
+    s->DLY[i][0] = out_tmp * s->A[i][2] - out_flt * s->B[i][1];
+
+    out_tmp = out_flt;          /* output becomes input for next stage */
+  }
+#endif
+
+  return out_flt;
+}
+
 double *MNRU_process (char operation, MNRU_state * s, float *input, float *output, long n, long seed, char mode, double Q, float *fseed) {
 // Noise gain definition for P.50 FB MNRU
 #define P50_NOISE_GAIN 3.0287
 
-  long count, i;
-  double noise, tmp;
-  register double inp_smp, out_tmp, out_flt;
+  long count;
+  double inp_smp;
 
 
 
@@ -512,126 +747,117 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
     /* Seed for random number generation */
     s->seed = seed;
 
-    /* Gain for signal path */
-    if (mode == MOD_NOISE)
-      s->signal_gain = 1.000;
-    else if (mode == SIGNAL_ONLY)
-      s->signal_gain = 1.000;
-    else                        /* (mode == NOISE_ONLY) */
-      s->signal_gain = 0.000;
+    /* Gains, random sequence flag and filters */
+    MNRU_init_state (s, mode, Q);
+  }
 
-    /* Gain for noise path */
-    if (mode == MOD_NOISE || mode == NOISE_ONLY)
-      s->noise_gain = NOISE_GAIN * pow (10.0, (-0.05 * Q));
-    else                        /* (mode == SIGNAL_ONLY) */
-      s->noise_gain = 0;
+  /*
+   *    ..... REAL MNRU WORK .....
+   */
 
-    /* Flag for random sequence initialization */
-    s->rnd_mode = RANDOM_RESET;
+  /* Noise for the whole block, in vet */
+  if (mode == SIGNAL_ONLY)
+    memset (s->vet, '\0', n * sizeof (double));
+  else
+    random_MNRU_block (&s->rnd_mode, &s->rnd_state, s->seed, fseed, s->vet, n);
 
-    /* Initialization of the output low-pass filter */
-    /* Cleanup memory */
-    memset (s->DLY, '\0', sizeof (s->DLY));
+  for (count = 0; count < n; count++) {
+    /* Remove DC from input sample */
+    inp_smp = MNRU_remove_dc (s, *input++);
 
-#ifdef NBMNRU_MASK_ONLY
-    /* Load numerator coefficients */
-    s->A[0][0] = 0.758717518025;
-    s->A[0][1] = 1.50771485802;
-    s->A[0][2] = 0.758717518025;
-    s->A[1][0] = 0.758717518025;
-    s->A[1][1] = 1.46756552150;
-    s->A[1][2] = 0.758717518025;
-
-    /* Load denominator coefficients */
-    s->B[0][0] = 1.16833932919;
-    s->B[0][1] = 0.400250061172;
-    s->B[1][0] = 1.66492368687;
-    s->B[1][1] = 0.850653444434;
-#else
-    /* Load numerator coefficients */
-    s->A[0][0] = 0.775841885724;
-    s->A[0][1] = 1.54552788762;
-    s->A[0][2] = 0.775841885724;
-    s->A[1][0] = 0.775841885724;
-    s->A[1][1] = 1.51915539326;
-    s->A[1][2] = 0.775841885724;
-
-    /* Load denominator coefficients */
-    s->B[0][0] = 1.23307153957;
-    s->B[0][1] = 0.430807372835;
-    s->B[1][0] = 1.71128410940;
-    s->B[1][1] = 0.859087959597;
-#endif
+    /* Noise-modulated speech sample to output vector */
+    *output++ = MNRU_modulate (s, mode, s->vet[count], inp_smp);
+  }
 
-    /* Initialization of the input DC-removal filter */
-    s->last_xk = s->last_yk = 0;
+  /* Check if is end of operation THEN release memory buffer */
+  if (operation == MNRU_STOP) {
+    free (s->rnd_state.gauss);
+    free (s->vet);
+    s->vet = (double *) DNULL;
   }
 
-  /*
-   *    ..... REAL MNRU WORK .....
-   */
+  /* Return address of vet: if NULL, nothing is allocated */
+  return ((double *) s->vet);
+}
+/*  .................... End of MNRU_process() ....................... */
 
-  /* Initialize memory */
-  memset (s->vet, '\0', n * sizeof (double));
 
-  for (count = 0; count < n; count++) {
-    /* Copy sample to local variable */
-    inp_smp = *input++;
+/*
+  ==========================================================================
 
-#ifndef NO_DC_REMOVAL
-    /* Remove DC from input sample: H(z)= (1-Z-1)/(1-a.Z-1) */
-    tmp = inp_smp - s->last_xk;
-    tmp += ALPHA * s->last_yk;
+        double *MNRU_process_batch (char operation, MNRU_state *s,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long nq, float *input, float **output,
+                                    long n, long seed, char mode,
+                                    double *Q, float *fseed)
 
-    /* Update for next time */
-    s->last_xk = inp_smp;
-    s->last_yk = tmp;
+        Description:
+        ~~~~~~~~~~~~
 
-    /* Overwrite DC-removed version of the input signal */
-    inp_smp = tmp;
-#endif
+        Same as MNRU_process() for each of the `nq' values `Q[k]', with
+        the state variables in `s[k]' and the output in `output[k]'. All
+        outputs are the same as `nq' separate MNRU_process() runs on
+        `input' with the same `seed', `mode' and initial `fseed' (and a
+        fresh gaussian table), but the input DC removal and the noise
+        generation, which are the same for all the `Q' values, are done
+        once, with the state variables in `s[0]'.
 
-    /* Random number generation */
-    if (mode == SIGNAL_ONLY)
-      noise = 0;
-    else {
-      noise = (double) random_MNRU (&s->rnd_mode, &s->rnd_state, s->seed, fseed);
-      noise *= s->noise_gain * inp_smp; /* noise modulated by input sample */
-      if (noise > 1.00 || noise < -1.00)
-        s->clip++;              /* clip counter */
-    }
+        Return Value:
+        ~~~~~~~~~~~~~
+        As MNRU_process(), for `s[0]'.
 
-    /* Addition of signal and modulated noise */
-    out_tmp = noise + inp_smp * s->signal_gain;
+        History:
+        ~~~~~~~~
+        16.Oct.2026     1.00 Created.
 
-#ifdef NO_OUT_FILTER
-    out_flt = out_tmp;
-#else
-    /* Filter output sample by each stage of the low-pass IIR filter */
-    for (i = 0; i < MNRU_STAGE_OUT_FLT; i++) {
-      out_flt = out_tmp * s->A[i][0] + s->DLY[i][1];
-      s->DLY[i][1] = out_tmp * s->A[i][1] - out_flt * s->B[i][0] + s->DLY[i][0];
-      s->DLY[i][0] = out_tmp * s->A[i][2] - out_flt * s->B[i][1];
+  ==========================================================================
+*/
+double *MNRU_process_batch (char operation, MNRU_state * s, long nq, float *input, float **output, long n, long seed, char mode, double *Q, float *fseed) {
+  long count, k;
+  double inp_smp;
+
+  /*
+   *    ..... RESET PORTION .....
+   */
+  if (operation == MNRU_START) {
+    /* Allocate memory for the noise buffer, shared by all Q values */
+    if ((s[0].vet = (double *) calloc (n, sizeof (double))) == DNULL)
+      return ((double *) DNULL);
 
-      out_tmp = out_flt;        /* output becomes input for next stage */
+    for (k = 0; k < nq; k++) {
+      s[k].clip = 0;
+      s[k].seed = seed;
+      MNRU_init_state (&s[k], mode, Q[k]);
     }
-#endif
+  }
+
+  /*
+   *    ..... REAL MNRU WORK .....
+   */
+
+  /* Noise for the whole block, in vet */
+  if (mode == SIGNAL_ONLY)
+    memset (s[0].vet, '\0', n * sizeof (double));
+  else
+    random_MNRU_block (&s[0].rnd_mode, &s[0].rnd_state, s[0].seed, fseed, s[0].vet, n);
+
+  for (count = 0; count < n; count++) {
+    /* Remove DC from input sample, once for all Q values */
+    inp_smp = MNRU_remove_dc (&s[0], input[count]);
 
-    /* Copy noise-modulated speech sample to output vector */
-    *output++ = out_flt;
+    for (k = 0; k < nq; k++)
+      output[k][count] = MNRU_modulate (&s[k], mode, s[0].vet[count], inp_smp);
   }
 
   /* Check if is end of operation THEN release memory buffer */
   if (operation == MNRU_STOP) {
-    free (s->rnd_state.gauss);
-    free (s->vet);
-    s->vet = (double *) DNULL;
+    free (s[0].rnd_state.gauss);
+    free (s[0].vet);
+    s[0].vet = (double *) DNULL;
   }
 
-  /* Return address of vet: if NULL, nothing is allocated */
-  return ((double *) s->vet);
+  return ((double *) s[0].vet);
 }
-/*  .................... End of MNRU_process() ....................... */
+/*  ................. End of MNRU_process_batch() .................... */
 
 
 /**
@@ -775,16 +1001,7 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 	  memset(filteredNoiseTemp, 0, n * sizeof(double));
 
 	  //Fill noise array
-	  for (count = 0; count < n; count++)
-	  {
-		 /* Random number generation */
-		 if (mode == SIGNAL_ONLY)
-			s->vet[count] = 0;
-		 else
-		 {
-			s->vet[count] = (double) random_MNRU(&s->rnd_mode, &s->rnd_state, s->seed, fseed);
-		 }
-	  }
+	  random_MNRU_block(&s->rnd_mode, &s->rnd_state, s->seed, fseed, s->vet, n);
 
 	  for (count = 0; count < n; count++)
 		  s->vet[count] *= s->noise_gain;
@@ -50,8 +50,10 @@ typedef struct {
 /* Prototype for MNRU and random function(s) */
 double *MNRU_process ARGS ((char operation, MNRU_state * s, float *input, float *output, long n, long seed, char mode, double Q, float *fseed));
 double *P50_MNRU_process ARGS ((char operation, MNRU_state * s, double *input, double *output, long n, char mode, double Q, char dcRemoval, float *fseed));
+double *MNRU_process_batch ARGS ((char operation, MNRU_state * s, long nq, float *input, float **output, long n, long seed, char mode, double *Q, float *fseed));
 
 float random_MNRU ARGS ((char *mode, RANDOM_state * r, long seed));
+void random_MNRU_block ARGS ((char *mode, RANDOM_state * r, long seed, float *fseed, double *noise, long n));
 
 /* Definitions for the MNRU algorithm */
 #define MOD_NOISE    1
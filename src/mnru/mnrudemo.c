@@ -1,4 +1,4 @@
-/*                                                Version: 2.2 - 02.Feb.2010
+/*                                                Version: 2.3 - 16.Oct.2026
   --------------------------------------------------------------------------
 
   MNRUDEMO.C
@@ -38,6 +38,11 @@
   -noise          define MNRU mode as noise-only
   -signal         define MNRU mode as signal-only
   -mod            define MNRU mode as modulated noise (default)
+  -Qlist q1,q2,.. render the input at each of the Q values listed, from
+                  one read of the input; `fileout' is then a printf()
+                  template with one %f, %e or %g conversion for the Q
+                  value, e.g. out.q%02.0f. The outputs
+                  are the same as separate runs for each Q value.
 
   History:
   ~~~~~~~~
@@ -53,6 +58,7 @@
                     are specified. <simao.campos@labs.comsat.com>
   02.Feb.2010  2.2  Modified maximum string length, implicit casting of
                     toupper() argument removed (y.hiwasaki)
+  16.Oct.2026  2.3  Added option -Qlist (batch of Q values)
   --------------------------------------------------------------------------
 */
 
@@ -76,6 +82,9 @@
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
 
+/* Maximum number of Q values with -Qlist */
+#define MAX_QLIST 64
+
 
 /*
  -------------------------------------------------------------------------
@@ -90,7 +99,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("MNRU.C - Version 2.2 of 02.Feb.2010 \n");
+  printf ("MNRU.C - Version 2.3 of 16.Oct.2026 \n");
   printf ("Demonstration program for generating files with modulated\n");
   printf ("noise added based on UGST's MNRU module, which is based in the\n");
   printf ("Recommendation P.81 (Blue Book).\n");
@@ -116,6 +125,10 @@ void display_usage () {
   printf (" -noise     define MNRU mode as noise-only\n");
   printf (" -signal    define MNRU mode as signal-only\n");
   printf (" -mod       define MNRU mode as modulated noise (default)\n");
+  printf (" -Qlist q1,q2,...\n");
+  printf ("            render the input at each Q value listed (at most %d),\n", MAX_QLIST);
+  printf ("            from one read of the input; filout is then a printf()\n");
+  printf ("            template for the Q value, e.g. out.q%%02.0f\n");
 
   /* Quit program */
   exit (-128);
@@ -124,6 +137,50 @@ void display_usage () {
 /* .................... End of display_usage() ........................... */
 
 
+/*
+ -------------------------------------------------------------------------
+ int check_q_template(char *name);
+ ~~~~~~~~~~~~~~~~~~~~
+ Check that the output file name given with -Qlist is a valid printf()
+ template for the Q value: it must have exactly one floating-point
+ conversion (%f, %e or %g, with optional flags, width and precision);
+ `%%' stands for a literal `%'. Returns 1 if valid, 0 otherwise.
+
+ History:
+ ~~~~~~~~
+ 16.Oct.2026 v1.0 Created.
+ -------------------------------------------------------------------------
+*/
+int check_q_template (char *name) {
+  int conversions = 0;
+
+  for (; *name; name++) {
+    if (*name != '%')
+      continue;
+    if (*++name == '%')
+      continue;
+
+    /* Flags, width and precision */
+    name += strspn (name, "-+ #0");
+    name += strspn (name, "0123456789");
+    if (*name == '.') {
+      name++;
+      name += strspn (name, "0123456789");
+    }
+    if (*name == 'l')
+      name++;
+
+    /* Conversion */
+    if (*name == '\0' || strchr ("fFeEgG", *name) == NULL)
+      return 0;
+    conversions++;
+  }
+  return conversions == 1;
+}
+
+/* ................... End of check_q_template() ......................... */
+
+
 
 /*
    **************************************************************************
@@ -138,21 +195,25 @@ int main (int argc, char *argv[]) {
 
 /* File variables */
   char FileIn[80], FileOut[80];
-  FILE *Fi, *Fo;
-  int fhi, fho;
+  FILE *Fi, *Fo[MAX_QLIST];
+  int fhi;
 #ifdef VMS
   char mrs[15];
 #endif
 
 /* Algorithm variables */
-  MNRU_state state;
+  MNRU_state state, *states = NULL;
+  double Qlist[MAX_QLIST];
+  long nq = 0, nout, k;
+  char *p;
+  char qname[MAX_STRLEN];
 
   short *Buf;
-  float *inp, *out;
+  float *inp, *out[MAX_QLIST];
   double QdB = 100;             /* defaults to a high value */
   long cur_frame, l, N, N1, N2;
   char MNRU_mode = MOD_NOISE, operation;
-  long size, over = 0;
+  long size, over[MAX_QLIST];
   char quiet = 0;
   long start_byte;
   float fseed;
@@ -186,6 +247,25 @@ int main (int argc, char *argv[]) {
         /* No reset */
         QdB = atof (argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-Qlist") == 0) {
+        /* Batch of Q values, comma-separated */
+        for (p = argv[2]; nq < MAX_QLIST && *p; nq++) {
+          Qlist[nq] = strtod (p, &p);
+          if (*p == ',')
+            p++;
+          else if (*p) {
+            fprintf (stderr, "ERROR! Invalid Q list \"%s\"\n\n", argv[2]);
+            display_usage ();
+          }
+        }
+        if (nq == 0 || *p) {
+          fprintf (stderr, "ERROR! Q list must have 1 to %d values\n\n", MAX_QLIST);
+          display_usage ();
+        }
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -270,11 +350,23 @@ int main (int argc, char *argv[]) {
     N2 = (st.st_size - start_byte) / (N * sizeof (short));
   }
 
+  /* With -Qlist, the output file name is a template for the Q value */
+  if (nq > 0 && !check_q_template (FileOut)) {
+    fprintf (stderr, "ERROR! Output file name \"%s\" must have exactly one %%f, %%e or %%g conversion for the Q value\n", FileOut);
+    exit (2);
+  }
+
+  /* One output and, with -Qlist, one MNRU state per Q value */
+  nout = nq > 0 ? nq : 1;
+  if (nq > 0 && (states = (MNRU_state *) calloc (nq, sizeof (MNRU_state))) == NULL)
+    KILL ("Error allocating MNRU states\n", 10);
+
   /* Allocate memory for data vectors */
   if ((inp = (float *) calloc (N, sizeof (float))) == NULL)
     KILL ("Error allocating input buffer\n", 10);
-  if ((out = (float *) calloc (N, sizeof (float))) == NULL)
-    KILL ("Error allocating output buffer\n", 10);
+  for (k = 0; k < nout; k++)
+    if ((out[k] = (float *) calloc (N, sizeof (float))) == NULL)
+      KILL ("Error allocating output buffer\n", 10);
 
   /* Opening input file; abort if there's any problem */
 #ifdef VMS
@@ -284,10 +376,16 @@ int main (int argc, char *argv[]) {
     KILL (FileIn, 2);
   fhi = fileno (Fi);
 
-  /* Creates output file */
-  if ((Fo = fopen (FileOut, WB)) == NULL)
-    KILL (FileOut, 3);
-  fho = fileno (Fo);
+  /* Creates output file(s) */
+  for (k = 0; k < nout; k++) {
+    if (nq == 0)
+      strcpy (qname, FileOut);
+    else if (snprintf (qname, sizeof (qname), FileOut, Qlist[k]) >= (int) sizeof (qname))
+      KILL ("Output file name too long\n", 3);
+    if ((Fo[k] = fopen (qname, WB)) == NULL)
+      KILL (qname, 3);
+    over[k] = 0;
+  }
 
   /* Move pointer to 1st block of interest */
   if (fseek (Fi, start_byte, 0) < 0l)
@@ -323,26 +421,42 @@ int main (int argc, char *argv[]) {
     else
       operation = MNRU_CONTINUE;
 
-    /* MNRU processing */
-    MNRU_process (operation, &state, inp, out, (long) l, (long) 314159265, MNRU_mode, QdB, &fseed);
+    /* MNRU processing, for one or for each of the listed Q values */
+    if (nq == 0)
+      MNRU_process (operation, &state, inp, out[0], (long) l, (long) 314159265, MNRU_mode, QdB, &fseed);
+    else
+      MNRU_process_batch (operation, states, nq, inp, out, (long) l, (long) 314159265, MNRU_mode, Qlist, &fseed);
 
-    /* Convert from float to short with hard clip and truncation */
-    over += fl2sh_16bit ((long) l, out, Buf, 1);
+    for (k = 0; k < nout; k++) {
+      /* Convert from float to short with hard clip and truncation */
+      over[k] += fl2sh_16bit ((long) l, out[k], Buf, 1);
 
-    /* Save data to file */
-    if ((l = fwrite (Buf, sizeof (short), l, Fo)) <= 0)
-      KILL (FileOut, 4);
+      /* Save data to file */
+      if (fwrite (Buf, sizeof (short), l, Fo[k]) < (size_t) l)
+        KILL (FileOut, 4);
+    }
   }
 
 
   /*
    * ........ FINALIZATIONS .........
    */
-  fprintf (stderr, "\nOverflow samples: %ld", over);
-  fprintf (stderr, "\nClipped noise samples: %ld", state.clip);
+  if (nq == 0) {
+    fprintf (stderr, "\nOverflow samples: %ld", over[0]);
+    fprintf (stderr, "\nClipped noise samples: %ld", state.clip);
+  } else
+    for (k = 0; k < nq; k++)
+      fprintf (stderr, "\nQ %.1f dB: overflow samples: %ld, clipped noise samples: %ld", Qlist[k], over[k], states[k].clip);
   fprintf (stderr, "\n");
   fclose (Fi);
-  fclose (Fo);
+  for (k = 0; k < nout; k++) {
+    fclose (Fo[k]);
+    free (out[k]);
+  }
+  free (inp);
+  free (Buf);
+  if (nq > 0)
+    free (states);
 #ifndef VMS
   return (0);
 #endif
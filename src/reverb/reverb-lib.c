@@ -27,10 +27,17 @@
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		conv_fft_init(...)	:		Allocates and initializes the partitioned FFT convolver
+		conv_fft(...)		:		Convolves a block of the input file using the partitioned FFT convolver
+		conv_fft_free(...)	:		Releases the memory of the partitioned FFT convolver
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
     10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+    16.Oct.26   v1.02   Added uniformly partitioned overlap-save FFT convolver.
+                        conv_fft() computes the convolution in double precision,
+                        whereas conv() accumulates in single precision; the
+                        outputs of both routines are equivalent within +-1 LSB.
 
   AUTHORS :
 	v1.0 Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -38,6 +45,15 @@
 
 */
 
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "reverb-lib.h"
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
 
 
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
@@ -97,3 +113,197 @@ void conv_old (float *IR, short *buffIn, short *buffRvb, float alignFact, long N
     buffRvb[k] = (short) (alignFact * tmpRvb + 0.5);    /* +0.5 : rounding during the 'short' truncation */
   }
 }
+
+
+/* ............... Partitioned overlap-save FFT convolver ............... */
+
+/* in-place radix-2 complex FFT of n points (interleaved re/im); isgn=-1: forward, isgn=+1: inverse (unscaled) */
+static void cfft (double *a, long n, double *cosTab, double *sinTab, int isgn) {
+  long i, j, k, m, len, half, step;
+  double wr, wi, tr, ti;
+
+  /* bit reversal permutation */
+  for (i = 1, j = 0; i < n; i++) {
+    m = n >> 1;
+    while (j & m) {
+      j ^= m;
+      m >>= 1;
+    }
+    j |= m;
+    if (i < j) {
+      tr = a[2 * i];
+      ti = a[2 * i + 1];
+      a[2 * i] = a[2 * j];
+      a[2 * i + 1] = a[2 * j + 1];
+      a[2 * j] = tr;
+      a[2 * j + 1] = ti;
+    }
+  }
+
+  /* butterflies */
+  for (len = 2; len <= n; len <<= 1) {
+    half = len >> 1;
+    step = n / len;
+    for (i = 0; i < n; i += len) {
+      for (k = 0; k < half; k++) {
+        wr = cosTab[k * step];
+        wi = isgn * sinTab[k * step];
+        j = i + k + half;
+        tr = a[2 * j] * wr - a[2 * j + 1] * wi;
+        ti = a[2 * j] * wi + a[2 * j + 1] * wr;
+        a[2 * j] = a[2 * (i + k)] - tr;
+        a[2 * j + 1] = a[2 * (i + k) + 1] - ti;
+        a[2 * (i + k)] += tr;
+        a[2 * (i + k) + 1] += ti;
+      }
+    }
+  }
+}
+
+
+/* this routine allocates the FFT convolver for the impulse response IR (length N) */
+/* using partitions of B samples; B must be a power of two. Returns NULL on failure */
+FFTCONV_state *conv_fft_init (float *IR, long N, long B) {
+  FFTCONV_state *st;
+  long p, k, j;
+
+  /* B must be a positive power of two */
+  if (N <= 0 || B <= 0 || (B & (B - 1)) != 0)
+    return NULL;
+
+  if ((st = (FFTCONV_state *) calloc (1, sizeof (FFTCONV_state))) == NULL)
+    return NULL;
+
+  st->N = N;
+  st->B = B;
+  st->P = (N + B - 1) / B;
+  st->nfft = 2 * B;
+  st->nbin = B + 1;
+  st->head = 0;
+
+  st->H = (double *) calloc (2 * st->P * st->nbin, sizeof (double));
+  st->X = (double *) calloc (2 * st->P * st->nbin, sizeof (double));
+  st->frame = (double *) calloc (2 * st->nfft, sizeof (double));
+  st->acc = (double *) calloc (2 * st->nbin, sizeof (double));
+  st->cosTab = (double *) calloc (st->nfft / 2, sizeof (double));
+  st->sinTab = (double *) calloc (st->nfft / 2, sizeof (double));
+  st->prev = (short *) calloc (B, sizeof (short));
+  if (st->H == NULL || st->X == NULL || st->frame == NULL || st->acc == NULL || st->cosTab == NULL || st->sinTab == NULL || st->prev == NULL) {
+    conv_fft_free (st);
+    return NULL;
+  }
+
+  /* twiddle factors */
+  for (k = 0; k < st->nfft / 2; k++) {
+    st->cosTab[k] = cos (2.0 * PI * k / st->nfft);
+    st->sinTab[k] = sin (2.0 * PI * k / st->nfft);
+  }
+
+  /* spectra of the zero-padded impulse response partitions */
+  for (p = 0; p < st->P; p++) {
+    memset (st->frame, 0, 2 * st->nfft * sizeof (double));
+    for (j = 0; j < B && p * B + j < N; j++)
+      st->frame[2 * j] = IR[p * B + j];
+    cfft (st->frame, st->nfft, st->cosTab, st->sinTab, -1);
+    memcpy (st->H + 2 * p * st->nbin, st->frame, 2 * st->nbin * sizeof (double));
+  }
+
+  return st;
+}
+
+
+/* this routine convolves one block of L<=B new input samples with the impulse response */
+/* and stores the processed data into buffRvb */
+/* alignFact is used to align the energy of the input file with an other file */
+/* the ouput sat_warning is used to provide a warning of there is 16 bit saturation, 
+  a positive value indicates position of overflow */
+long conv_fft (FFTCONV_state * st, short *buffIn, short *buffRvb, float alignFact, long L) {
+  long k, p, q, B, nbin;
+  double *X, *H, *acc;
+  float tmpRvb;
+  long sat_warning;
+
+  B = st->B;
+  nbin = st->nbin;
+  sat_warning = -1;
+  if (L <= 0)
+    return sat_warning;
+  if (L > B)
+    L = B;
+
+  /* overlap-save frame: B previous input samples followed by B new ones */
+  for (k = 0; k < B; k++) {
+    st->frame[2 * k] = st->prev[k];
+    st->frame[2 * k + 1] = 0;
+  }
+  for (k = 0; k < B; k++) {
+    st->frame[2 * (B + k)] = (k < L) ? buffIn[k] : 0;
+    st->frame[2 * (B + k) + 1] = 0;
+  }
+  for (k = 0; k < B; k++)
+    st->prev[k] = (k < L) ? buffIn[k] : 0;
+
+  /* insert the new input spectrum in the frequency-domain delay line */
+  cfft (st->frame, st->nfft, st->cosTab, st->sinTab, -1);
+  st->head = (st->head + st->P - 1) % st->P;
+  memcpy (st->X + 2 * st->head * nbin, st->frame, 2 * nbin * sizeof (double));
+
+  /* accumulate the products of the delayed input spectra with the IR partition spectra */
+  acc = st->acc;
+  memset (acc, 0, 2 * nbin * sizeof (double));
+  for (p = 0; p < st->P; p++) {
+    q = (st->head + p) % st->P;
+    X = st->X + 2 * q * nbin;
+    H = st->H + 2 * p * nbin;
+    for (k = 0; k < nbin; k++) {
+      acc[2 * k] += X[2 * k] * H[2 * k] - X[2 * k + 1] * H[2 * k + 1];
+      acc[2 * k + 1] += X[2 * k] * H[2 * k + 1] + X[2 * k + 1] * H[2 * k];
+    }
+  }
+
+  /* rebuild the full (hermitian) spectrum and go back to the time domain */
+  for (k = 0; k < nbin; k++) {
+    st->frame[2 * k] = acc[2 * k];
+    st->frame[2 * k + 1] = acc[2 * k + 1];
+  }
+  for (k = nbin; k < st->nfft; k++) {
+    st->frame[2 * k] = acc[2 * (st->nfft - k)];
+    st->frame[2 * k + 1] = -acc[2 * (st->nfft - k) + 1];
+  }
+  cfft (st->frame, st->nfft, st->cosTab, st->sinTab, 1);
+
+  /* the last B samples of the frame are the valid (non-aliased) output */
+  for (k = 0; k < L; k++) {
+    tmpRvb = (float) (st->frame[2 * (B + k)] / st->nfft);
+    tmpRvb = (float) (alignFact * tmpRvb + 0.5);        /* +0.5 : rounding for the 'short' truncation */
+
+    /* perform 16 bit saturation */
+    if (tmpRvb < -32768.0) {
+      buffRvb[k] = -32768;
+      sat_warning = k;
+    } else {
+      if (tmpRvb > 32767.0) {
+        buffRvb[k] = 32767;
+        sat_warning = k;
+      } else {
+        buffRvb[k] = (short) tmpRvb;
+      }
+    }
+  }
+  return sat_warning;
+}
+
+
+/* this routine releases the memory allocated by conv_fft_init() */
+void conv_fft_free (FFTCONV_state * st) {
+  if (st == NULL)
+    return;
+  free (st->H);
+  free (st->X);
+  free (st->frame);
+  free (st->acc);
+  free (st->cosTab);
+  free (st->sinTab);
+  free (st->prev);
+  free (st);
+}
@@ -28,10 +28,14 @@
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		conv_fft_init(...)	:		Allocates and initializes the partitioned FFT convolver
+		conv_fft(...)		:		Convolves a block of the input file using the partitioned FFT convolver
+		conv_fft_free(...)	:		Releases the memory of the partitioned FFT convolver
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
 	10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+	16.Oct.26   v1.02   Added uniformly partitioned overlap-save FFT convolver
 
 
   AUTHORS :
@@ -54,3 +58,45 @@ long conv (float *IR,           /* impulse response buffer */
            long N,              /* length of the impulse response */
            long L               /* length of the input buffer to process */
   );
+
+
+/* state of the uniformly partitioned overlap-save FFT convolver */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long B;                       /* partition (block) length, a power of two */
+  long P;                       /* number of partitions of the impulse response */
+  long nfft;                    /* FFT length (2*B) */
+  long nbin;                    /* number of non-redundant frequency bins (B+1) */
+  long head;                    /* position of the most recent input spectrum in the delay line */
+  double *H;                    /* spectra of the impulse response partitions, P x nbin complex */
+  double *X;                    /* frequency-domain delay line of input spectra, P x nbin complex */
+  double *frame;                /* time-domain / frequency-domain work frame, nfft complex */
+  double *acc;                  /* spectral accumulator, nbin complex */
+  double *cosTab;               /* FFT twiddle factors (cosine), nfft/2 entries */
+  double *sinTab;               /* FFT twiddle factors (sine), nfft/2 entries */
+  short *prev;                  /* last B input samples (overlap part of the frame) */
+} FFTCONV_state;
+
+
+/* this routine allocates the FFT convolver for the impulse response IR (length N) */
+/* using partitions of B samples; B must be a power of two. Returns NULL on failure */
+FFTCONV_state *conv_fft_init (float *IR,        /* impulse response buffer */
+                              long N,   /* length of the impulse response */
+                              long B    /* partition (block) length */
+  );
+
+
+/* this routine convolves one block of L<=B new input samples with the impulse response */
+/* and stores the processed data into buffRvb. Blocks shorter than B are zero-padded, */
+/* so only the last block of a signal may be shorter than B. */
+/* alignFact and the returned saturation position behave as for conv() */
+long conv_fft (FFTCONV_state * st,      /* convolver state */
+               short *buffIn,   /* block of new input samples */
+               short *buffRvb,  /* reverberated data */
+               float alignFact, /* energy alignment factor */
+               long L           /* number of new input samples (<= B) */
+  );
+
+
+/* this routine releases the memory allocated by conv_fft_init() */
+void conv_fft_free (FFTCONV_state * st);
@@ -1,4 +1,4 @@
-/*                                                         02/Feb/2010 v1.02 */
+/*                                                         16/Oct/2026 v1.03 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -26,6 +26,8 @@
 	02.Feb.05	v1.0	First Beta version
 	10.Jul.08 v1.01 Added 16 bit saturation and saturation warning
 	02.Feb.10 v1.02 Modified maximum string length to avoid buffer overrun
+	16.Oct.26 v1.03 Added options -fft and -blk to select the uniformly
+	                partitioned overlap-save FFT convolver
 
   AUTHORS :
 	v1.0  Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -42,8 +44,10 @@
 
 #include "reverb-lib.h"
 
+#define DEF_FFT_BLK	1024            /* default partition length of the FFT convolver */
+
 static void display_usage () {
-  printf ("REVERB.C - Version 1.02 of 02.Feb.2010 \n\n");
+  printf ("REVERB.C - Version 1.03 of 16.Oct.2026 \n\n");
 
   printf (" Program to add reverberation to a signal\n");
   printf (" This program convolves a signal with the impulse response of a room\n");
@@ -61,6 +65,9 @@ static void display_usage () {
   printf (" Options:\n");
   printf ("  -align A...... multiplicative factor to apply to the reverberated sound\n");
   printf ("				   in order to align its energy level with a second file\n");
+  printf ("  -fft ......... use the partitioned FFT convolver instead of the direct\n");
+  printf ("				   convolution (output equivalent within +-1 LSB)\n");
+  printf ("  -blk B ....... partition length for -fft, a power of two [default: %d]\n", DEF_FFT_BLK);
   printf ("\n");
 }
 
@@ -80,12 +87,15 @@ int main (int argc, char *argv[]) {
   short *buffRvb;               /* buffer for the reverberated Sound */
   short *buffIn;                /* buffer for the input sound file */
   float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
+  FFTCONV_state *fftState = NULL;       /* state of the partitioned FFT convolver */
 
   /* Algorithm variables */
   float alignFact = 1.0;        /* multiplicative factor for the reverberated sound (energy alignment with another file to compare) */
   long N;                       /* length of the impulse response */
   long count, global_count;
   long local_sat_pos;
+  int useFFT = 0;               /* 1: partitioned FFT convolution, 0: direct convolution */
+  long blk = DEF_FFT_BLK;       /* partition length of the FFT convolver */
 
   global_count = 0;
   local_sat_pos = -1;           /* local position of last saturation */
@@ -102,6 +112,20 @@ int main (int argc, char *argv[]) {
         /* Set the energy alignment factor */
         alignFact = (float) atof (argv[2]);
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-fft") == 0) {
+        /* Use the partitioned FFT convolver */
+        useFFT = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-blk") == 0) {
+        /* Set the partition length of the FFT convolver */
+        blk = atol (argv[2]);
+
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
@@ -162,8 +186,18 @@ int main (int argc, char *argv[]) {
     exit (-1);
   }
   /* allocate memory for the buffers */
-  buffIn = (short *) calloc (2 * N - 1, sizeof (short));        /* allocate memory for a block of the input file */
-  buffRvb = (short *) malloc (N * sizeof (short));      /* allocate memory for the processed block */
+  if (useFFT) {
+    fftState = conv_fft_init (IR, N, blk);
+    if (fftState == NULL) {
+      fprintf (stderr, "\nUnable to initialize the FFT convolver (partition length must be a power of two)\n");
+      exit (-1);
+    }
+    buffIn = (short *) calloc (blk, sizeof (short));    /* allocate memory for a block of the input file */
+    buffRvb = (short *) malloc (blk * sizeof (short));  /* allocate memory for the processed block */
+  } else {
+    buffIn = (short *) calloc (2 * N - 1, sizeof (short));      /* allocate memory for a block of the input file */
+    buffRvb = (short *) malloc (N * sizeof (short));    /* allocate memory for the processed block */
+  }
 
   /* check consistency */
   if ((buffIn == NULL) || (buffRvb == NULL)) {
@@ -178,7 +212,17 @@ int main (int argc, char *argv[]) {
   /* .......FILTERING OPERATION ........ */
 
   /* Filter the sound File */
-  while (!feof (ptr_fileIn)) {
+  while (useFFT && !feof (ptr_fileIn)) {
+    count = (long) fread (buffIn, sizeof (short), blk, ptr_fileIn);     /* read a block of the input file */
+
+    local_sat_pos = conv_fft (fftState, buffIn, buffRvb, alignFact, count);     /* convolves a block of the input file with the impulse response */
+    if (local_sat_pos >= 0) {
+      fprintf (stderr, "\nWarning warning!! Saturation(s) in output file.  In  sample %ld\n", local_sat_pos + global_count);
+    }
+    global_count += count;
+    fwrite (buffRvb, sizeof (short), count, ptr_fileOut);       /* output the processed block */
+  }
+  while (!useFFT && !feof (ptr_fileIn)) {
     count = (long) fread (buffIn + N - 1, sizeof (short), N, ptr_fileIn);       /* read a block of the input file */
 
     local_sat_pos = conv (IR, buffIn, buffRvb, alignFact, N, count);    /* convolves a block of the input file with the impulse response */
@@ -200,6 +244,7 @@ int main (int argc, char *argv[]) {
   free (buffIn);
   free (buffRvb);
   free (IR);
+  conv_fft_free (fftState);
   /* close the opened files */
   fclose (ptr_fileIn);
   fclose (ptr_fileOut);
@@ -1,4 +1,4 @@
-/*                                                              V2.4 10.Jun.98
+/*                                                              V2.6 16.Oct.26
   ============================================================================
 
   ACTLEVEL.C
@@ -63,6 +63,24 @@
   -log file .. print the statistics log into file rather than stdout
   -q ......... quiet operation; don't print progress flag, results are
                printed all in one line.
+  -win nb .... also report, for every block, the active level of the
+               last `nb' blocks (0: of all blocks read so far), and the
+               gain for -lev, as the file is read.
+
+  -jobs n .... measure the files concurrently using `n' threads (0: one
+               per processor), each with its own speech voltmeter. Files
+               are memory-mapped where possible. Results are reported in
+               the order of the files in the command line, as for a
+               single thread.
+  -list file . also measure the files listed in `file', one per line
+               (lines starting with # are skipped); implies -jobs 1
+  -csv ....... report the results as a CSV table with one row per file;
+               implies -jobs 1
+  -json ...... report the results as a JSON array with one object per
+               file; implies -jobs 1
+
+  A file name "-" reads the samples from stdin until the end of the
+  input, so the level of a live pipe can be followed with -win.
 
 
   Modules used:
@@ -125,6 +143,11 @@
                            characters and changing strcpy() to
                            strncpy() in the filename copy process.
                            <simao>
+  16.Oct.26     2.5        Added option -win for block-by-block reporting
+                           of the level of a look-behind window, and
+                           input from stdin.
+  16.Oct.26     2.6        Added options -jobs, -list, -csv and -json for
+                           concurrent measurement of many files.
   ============================================================================
 */
 
@@ -150,15 +173,55 @@
 #include <sys/stat.h>
 #endif
 
+/* ... Includes for memory-mapped input (option -jobs) ... */
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
 /* ... Include of speech-voltmeter-related routines ... */
 #include "sv-p56.h"
 
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
+#include "ugst-thr.h"
 
 /* ... Local definitions ... */
 #define DEF_BLK_LEN 256         /* samples per block */
 #define MIN_LOG_OFFSET 1.0e-20  /* To avoid sigularity with log(0.0) */
+#define MAX_JOBS 256            /* maximum number of worker threads */
+
+/* Formats of the results table */
+enum act_format { FMT_TEXT, FMT_CSV, FMT_JSON };
+
+/* One file measured in batch mode */
+typedef struct {
+  char *name;                   /* file name */
+  SVP56_state state;            /* P.56 statistics of the file */
+  double level;                 /* active speech level */
+  long blocks;                  /* number of blocks measured */
+  int status;                   /* 0 if OK, else exit code as in sequential mode */
+} ACT_JOB;
+
+/* Input samples of a file: memory-mapped, or read into memory */
+typedef struct {
+  short *data;                  /* samples of the file */
+  long smpno;                   /* number of samples */
+  size_t bytes;                 /* size of the mapping */
+  char mapped;                  /* 1 if mapped, 0 if allocated */
+} ACT_INPUT;
+
+/* Batch of files, shared by the worker threads */
+static ACT_JOB *job = NULL;
+static long njob = 0, next_job = 0;
+static MUTEX_T job_mutex;
+
+/* Measurement parameters, common to all files */
+static long blk_len = DEF_BLK_LEN, first_blk = 0, blk_no = 0, bit_no = 16;
+static double samp_freq = 16000;
 
 
 /*
@@ -221,6 +284,14 @@ void display_usage () {
   printf ("  -log file ... log statistics into file rather than stdout\n");
   printf ("  -q ......... quiet operation; don't print progress flag, results\n");
   printf ("               are printed all in one line.\n");
+  printf ("  -win nb .... report for every block the active level of the last\n");
+  printf ("               `nb' blocks (0: all blocks so far).\n");
+  printf ("  -jobs n .... measure files concurrently with `n' threads\n");
+  printf ("               (0: one per processor); same results and order.\n");
+  printf ("  -list file . also measure the files listed in `file'\n");
+  printf ("  -csv ....... report results as a CSV table\n");
+  printf ("  -json ...... report results as a JSON array\n");
+  printf (" A file name \"-\" reads from stdin until end of input.\n");
 
   /* Quit program */
   exit (-128);
@@ -402,6 +473,477 @@ void print_act_short_summary (FILE * out, char *file, SVP56_state state, double
 /* ................... End of print_act_short_summary() .................... */
 
 
+/*
+  ============================================================================
+
+       void print_act_table_row (FILE *out, int fmt, ACT_JOB *jb,
+       ~~~~~~~~~~~~~~~~~~~~~~~~  double ratio, double gain, int first);
+
+       Print the statistics of one file as a row of a CSV table, or as an
+       object of a JSON array. The header of the table (or the opening
+       bracket of the array) is printed before the first row, if `first'
+       is set; the caller closes the JSON array. Numbers are printed with
+       the same precision as the one-line summary. Fields that do not
+       apply (empty file, no -lev) are left empty (CSV) or null (JSON).
+
+       Parameter:
+       ~~~~~~~~~~
+       out ...... output file
+       fmt ...... FMT_CSV or FMT_JSON
+       jb ....... file measured
+       ratio .... ratio of maximum number representable in the system to
+                  the range of the input signal, as for print_act_short_summary
+       gain ..... gain to equalize file to desired level, or 0 if none
+       first .... 1 for the first row of the table
+
+       Returns
+       ~~~~~~~
+       None
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+void print_act_table_row (FILE * out, int fmt, ACT_JOB * jb, double ratio, double gain, int first) {
+  static char *key[] = { "min", "max", "dc", "rms_dB", "act_dB", "activity", "rms_pkf_dB", "act_pkf_dB", "gain" };
+  static char *dft[] = { "%.0f", "%.0f", "%.2f", "%.3f", "%.3f", "%.3f", "%.3f", "%.3f", "%.3f" };
+  double val[9], abs_max_dB;
+  long k, nval;
+  char *c;
+
+  /* Header of the table */
+  if (first) {
+    if (fmt == FMT_CSV) {
+      fprintf (out, "file,samples");
+      for (k = 0; k < 9; k++)
+        fprintf (out, ",%s", key[k]);
+      fprintf (out, "\n");
+    } else
+      fprintf (out, "[\n");
+  }
+
+  /* Statistics, as in print_act_short_summary() */
+  abs_max_dB = 20 * log10 (SVP56_get_abs_max (jb->state) + MIN_LOG_OFFSET) - jb->state.refdB;
+  val[0] = ratio * jb->state.maxN;
+  val[1] = ratio * jb->state.maxP;
+  val[2] = ratio * jb->state.DClevel;
+  val[3] = jb->state.rmsdB;
+  val[4] = jb->level;
+  val[5] = jb->state.ActivityFactor * 100;
+  val[6] = abs_max_dB - SVP56_get_rms_dB (jb->state);
+  val[7] = abs_max_dB - jb->level;
+  val[8] = gain;
+  nval = (jb->state.n == 0) ? 0 : (gain > 0) ? 9 : 8;
+
+  /* File name, quoted/escaped as needed */
+  if (fmt == FMT_CSV) {
+    if (strpbrk (jb->name, ",\"\n") == NULL)
+      fprintf (out, "%s", jb->name);
+    else {
+      fputc ('"', out);
+      for (c = jb->name; *c; c++) {
+        if (*c == '"')
+          fputc ('"', out);
+        fputc (*c, out);
+      }
+      fputc ('"', out);
+    }
+    fprintf (out, ",%lu", jb->state.n);
+  } else {
+    fprintf (out, "%s  {\"file\": \"", first ? "" : ",\n");
+    for (c = jb->name; *c; c++) {
+      if (*c == '"' || *c == '\\')
+        fprintf (out, "\\%c", *c);
+      else if ((unsigned char) *c < 0x20)
+        fprintf (out, "\\u%04x", (unsigned char) *c);
+      else
+        fputc (*c, out);
+    }
+    fprintf (out, "\", \"samples\": %lu", jb->state.n);
+  }
+
+  /* Values */
+  for (k = 0; k < 9; k++) {
+    if (fmt == FMT_CSV)
+      fputc (',', out);
+    else
+      fprintf (out, ", \"%s\": ", key[k]);
+    if (k < nval)
+      fprintf (out, dft[k], val[k]);
+    else if (fmt == FMT_JSON)
+      fprintf (out, "null");
+  }
+  fprintf (out, fmt == FMT_CSV ? "\n" : "}");
+}
+
+/* .................... End of print_act_table_row() ...................... */
+
+
+/*
+  ============================================================================
+
+       int open_input (char *name, ACT_INPUT *inp);
+       ~~~~~~~~~~~~~~
+
+       Map the samples of a file into memory. Where the file can't be
+       mapped (stdin, pipes, empty files, or systems without mmap()), the
+       samples are read into allocated memory instead.
+
+       Parameter:
+       ~~~~~~~~~~
+       name ..... file name, or "-" for stdin
+       inp ...... input samples
+
+       Returns
+       ~~~~~~~
+       0 if OK, 2 if the file can't be opened, 5 on a read error.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+int open_input (char *name, ACT_INPUT * inp) {
+  FILE *Fi;
+  size_t n, nmax;
+  short *p;
+
+  inp->data = NULL;
+  inp->smpno = 0;
+  inp->bytes = 0;
+  inp->mapped = 0;
+
+  /* Map regular files */
+  if (strcmp (name, "-") != 0) {
+#if defined(_WIN32)
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+
+    if ((file = CreateFileA (name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL)) == INVALID_HANDLE_VALUE)
+      return 2;
+    if (GetFileSizeEx (file, &size) && size.QuadPart > 0 && (mapping = CreateFileMapping (file, NULL, PAGE_READONLY, 0, 0, NULL)) != NULL) {
+      inp->data = (short *) MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle (mapping);
+      inp->bytes = (size_t) size.QuadPart;
+    }
+    CloseHandle (file);
+#else
+    struct stat st;
+    void *map;
+    int fd;
+
+    if ((fd = open (name, O_RDONLY)) < 0)
+      return 2;
+    if (fstat (fd, &st) == 0 && S_ISREG (st.st_mode) && st.st_size > 0) {
+      map = mmap (NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED) {
+#if defined(MADV_SEQUENTIAL)
+        madvise (map, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+        inp->data = (short *) map;
+        inp->bytes = (size_t) st.st_size;
+      }
+    }
+    close (fd);
+#endif
+    if (inp->data != NULL) {
+      inp->smpno = (long) (inp->bytes / sizeof (short));
+      inp->mapped = 1;
+      return 0;
+    }
+  }
+
+  /* Otherwise, read the whole file */
+  if (strcmp (name, "-") == 0) {
+    Fi = stdin;
+#if defined(MSDOS)
+    setmode (fileno (stdin), O_BINARY);
+#endif
+  } else if ((Fi = fopen (name, RB)) == NULL)
+    return 2;
+  for (n = 0, nmax = 0;;) {
+    if (n == nmax) {
+      nmax = nmax ? 2 * nmax : 65536;
+      if ((p = (short *) realloc (inp->data, nmax * sizeof (short))) == NULL)
+        break;
+      inp->data = p;
+    }
+    n += fread (inp->data + n, sizeof (short), nmax - n, Fi);
+    if (n < nmax)
+      break;
+  }
+  inp->smpno = (long) n;
+  if (Fi != stdin)
+    fclose (Fi);
+  return (n < nmax) ? 0 : 5;
+}
+
+/* ......................... End of open_input() ........................... */
+
+
+/*
+  ============================================================================
+
+       void close_input (ACT_INPUT *inp);
+       ~~~~~~~~~~~~~~~~
+
+       Release the samples obtained by open_input().
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+void close_input (ACT_INPUT * inp) {
+  if (!inp->mapped)
+    free (inp->data);
+  else
+#if defined(_WIN32)
+    UnmapViewOfFile (inp->data);
+#else
+    munmap ((void *) inp->data, inp->bytes);
+#endif
+  inp->data = NULL;
+}
+
+/* ........................ End of close_input() ........................... */
+
+
+/*
+  ============================================================================
+
+       void measure_file (ACT_JOB *jb, float *Buf);
+       ~~~~~~~~~~~~~~~~~
+
+       Measure the blocks of interest of one file in batch mode. The
+       samples are converted and measured in blocks of `blk_len' samples,
+       exactly as in the sequential mode. If no number of blocks is given,
+       the file is measured from the first block of interest to its end.
+
+       Parameter:
+       ~~~~~~~~~~
+       jb ....... file to be measured; statistics are saved here
+       Buf ...... work buffer of blk_len samples
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+void measure_file (ACT_JOB * jb, float *Buf) {
+  ACT_INPUT inp;
+  long i, l, start;
+
+  init_speech_voltmeter (&jb->state, samp_freq);
+  jb->level = 0;
+  jb->blocks = 0;
+  if ((jb->status = open_input (jb->name, &inp)) != 0)
+    return;
+
+  /* Blocks of interest */
+  start = first_blk * blk_len;
+  if (blk_no > 0)
+    jb->blocks = blk_no;
+  else if (inp.smpno > start)
+    jb->blocks = (inp.smpno - start + blk_len - 1) / blk_len;
+
+  /* Measure */
+  for (i = 0; i < jb->blocks; i++, start += blk_len) {
+    if ((l = inp.smpno - start) <= 0) {
+      jb->status = 5;
+      break;
+    }
+    if (l > blk_len)
+      l = blk_len;
+    sh2fl (l, inp.data + start, Buf, bit_no, 1);
+    jb->level = speech_voltmeter (Buf, l, &jb->state);
+  }
+
+  close_input (&inp);
+}
+
+/* ....................... End of measure_file() ........................... */
+
+
+/*
+ * Worker thread: measure the next file of the batch until all are done
+ */
+THREAD_PROC (worker_main) {
+  float *Buf = (float *) arg;
+  long cur;
+
+  for (;;) {
+    mutex_lock (&job_mutex);
+    cur = next_job++;
+    mutex_unlock (&job_mutex);
+    if (cur >= njob)
+      break;
+    measure_file (&job[cur], Buf);
+  }
+  return 0;
+}
+
+
+/*
+ * Add a file to the batch
+ */
+void add_job (char *name) {
+  static long nmax = 0;
+
+  if (njob == nmax) {
+    nmax = nmax ? 2 * nmax : 256;
+    if ((job = (ACT_JOB *) realloc (job, nmax * sizeof (ACT_JOB))) == NULL)
+      error_terminate ("Can't allocate memory for file list\n", 10);
+  }
+  if ((job[njob].name = (char *) malloc (strlen (name) + 1)) == NULL)
+    error_terminate ("Can't allocate memory for file list\n", 10);
+  strcpy (job[njob].name, name);
+  job[njob].status = 0;
+  njob++;
+}
+
+
+/*
+ * Add the files listed in a text file, one per line, to the batch.
+ * Empty lines and lines starting with `#' are skipped.
+ * Return: 0 if the list can't be read, 1 otherwise
+ */
+int read_list (char *name) {
+  FILE *F;
+  char line[MAX_STRLEN + 2];
+  size_t l;
+
+  if ((F = fopen (name, "r")) == NULL)
+    return 0;
+  while (fgets (line, sizeof (line), F) != NULL) {
+    for (l = strlen (line); l > 0 && (line[l - 1] == '\n' || line[l - 1] == '\r'); l--)
+      line[l - 1] = 0;
+    if (l > 0 && line[0] != '#')
+      add_job (line);
+  }
+  fclose (F);
+  return 1;
+}
+
+
+/*
+  ============================================================================
+
+       int measure_batch (FILE *out, long jobs, int fmt, char quiet,
+       ~~~~~~~~~~~~~~~~~  double level, char use_active_level);
+
+       Measure all files of the batch using `jobs' threads, each with its
+       own speech voltmeter state, and print the results in the order of
+       the files in the command line/list, regardless of which thread
+       measured each file and when.
+
+       Parameter:
+       ~~~~~~~~~~
+       out ...... where to print the results
+       jobs ..... number of threads (<=0: number of processors)
+       fmt ...... FMT_TEXT, FMT_CSV or FMT_JSON
+       quiet .... text format: 1 for one-line summaries
+       level .... desired level for the gain report, or 0 for none
+       use_active_level .. 0 to report the gain for the long term level
+
+       Returns
+       ~~~~~~~
+       0 if all files were measured, else the exit code of the first file
+       in error.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+int measure_batch (FILE * out, long jobs, int fmt, char quiet, double level, char use_active_level) {
+  THREAD_T *thread;
+  float **Buf;
+  double Overflow, gain = 0;
+  long k, nrow = 0;
+  int status = 0;
+
+  /* Overflow (saturation) point */
+  Overflow = pow ((double) 2.0, (double) (bit_no - 1));
+
+  /* Number of threads */
+  if (jobs <= 0)
+    jobs = cpu_count ();
+  if (jobs > MAX_JOBS)
+    jobs = MAX_JOBS;
+  if (jobs > njob)
+    jobs = njob > 0 ? njob : 1;
+
+  /* Allocate the buffers of the threads */
+  thread = (THREAD_T *) calloc (jobs, sizeof (THREAD_T));
+  Buf = (float **) calloc (jobs, sizeof (float *));
+  if (thread == NULL || Buf == NULL)
+    error_terminate ("Can't allocate memory for threads\n", 10);
+  for (k = 0; k < jobs; k++)
+    if ((Buf[k] = (float *) calloc (blk_len, sizeof (float))) == NULL)
+      error_terminate ("Can't allocate memory for threads\n", 10);
+
+  if (!quiet)
+    fprintf (stderr, "%ld file(s), %ld thread(s)\n", njob, jobs);
+
+  /* Measure */
+  mutex_init (&job_mutex);
+  for (k = 0; k < jobs; k++)
+    if (!thread_create (&thread[k], worker_main, Buf[k]))
+      error_terminate ("Can't create worker thread\n", 10);
+  for (k = 0; k < jobs; k++)
+    thread_join (thread[k]);
+  mutex_destroy (&job_mutex);
+
+  /* Report, in the order of the batch */
+  for (k = 0; k < njob; k++) {
+    if (job[k].status != 0) {
+      fprintf (stderr, "%s: %s\n", job[k].name, job[k].status == 2 ? "can't open file" : "read error");
+      if (status == 0)
+        status = job[k].status;
+      continue;
+    }
+
+    /* Computes the equalization factor */
+    if (level != 0)
+      gain = pow (10.0, (level - (use_active_level ? job[k].level : SVP56_get_rms_dB (job[k].state))) / 20.0);
+
+    if (fmt != FMT_TEXT)
+      print_act_table_row (out, fmt, &job[k], Overflow, gain, nrow == 0);
+    else if (!quiet)
+      print_act_long_summary (out, job[k].name, job[k].state, job[k].level, level, Overflow, gain, blk_len, first_blk, job[k].blocks, bit_no);
+    else
+      print_act_short_summary (out, job[k].name, job[k].state, job[k].level, Overflow, gain);
+    nrow++;
+  }
+
+  /* Empty table, and end of the JSON array */
+  if (fmt == FMT_CSV && nrow == 0)
+    fprintf (out, "file,samples,min,max,dc,rms_dB,act_dB,activity,rms_pkf_dB,act_pkf_dB,gain\n");
+  if (fmt == FMT_JSON)
+    fprintf (out, nrow ? "\n]\n" : "[\n]\n");
+
+  /* Release memory */
+  for (k = 0; k < jobs; k++)
+    free (Buf[k]);
+  free (Buf);
+  free (thread);
+  for (k = 0; k < njob; k++)
+    free (job[k].name);
+  free (job);
+
+  return (status);
+}
+
+/* ....................... End of measure_batch() .......................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -417,6 +959,8 @@ int main (int argc, char *argv[]) {
 
   /* Intermediate storage variables for speech voltmeter */
   SVP56_state state;
+  SVP56_window window;
+  long win_blocks = -1;         /* <0: no block-by-block report */
 #ifdef LOCAL_PRINT
   double abs_max_dB;
 #endif
@@ -440,6 +984,9 @@ int main (int argc, char *argv[]) {
   static char unity[5] = "dBov";
 #endif
   char use_active_level = 1;
+  char batch = 0;               /* 1: measure with option -jobs */
+  long jobs = 1;
+  int fmt = FMT_TEXT;
 
   /* ......... GET PARAMETERS ......... */
 
@@ -447,7 +994,7 @@ int main (int argc, char *argv[]) {
   if (argc < 2)
     display_usage ();
   else {
-    while (argc > 1 && argv[1][0] == '-')
+    while (argc > 1 && argv[1][0] == '-' && argv[1][1] != 0)
       if (strcmp (argv[1], "-sf") == 0) {
         /* Change default sampling frequency */
         sf = atof (argv[2]);
@@ -514,6 +1061,48 @@ int main (int argc, char *argv[]) {
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
+      } else if (strcmp (argv[1], "-win") == 0) {
+        /* Report the level of a look-behind window for every block */
+        win_blocks = atol (argv[2]);
+        if (win_blocks < 0)
+          win_blocks = 0;
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-jobs") == 0) {
+        /* Measure files concurrently */
+        jobs = atol (argv[2]);
+        batch = 1;
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-list") == 0) {
+        /* Add the files in a list to the batch */
+        if (!read_list (argv[2]))
+          KILL (argv[2], 2);
+        batch = 1;
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-csv") == 0) {
+        /* Results as a CSV table */
+        fmt = FMT_CSV;
+        batch = 1;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-json") == 0) {
+        /* Results as a JSON array */
+        fmt = FMT_JSON;
+        batch = 1;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
       } else if (strcmp (argv[1], "-q") == 0) {
         /* Don't print progress indicator */
         quiet = 1;
@@ -547,6 +1136,29 @@ int main (int argc, char *argv[]) {
   Overflow = pow ((double) 2.0, (double) (bitno - 1));
 
 
+  /* MEASURE ALL FILES CONCURRENTLY, IF REQUESTED */
+  if (batch) {
+    if (win_blocks >= 0)
+      error_terminate ("Option -win can't be used with -jobs/-csv/-json/-list\n", 1);
+
+    /* Files in the command line follow those in the list */
+    for (; argc > 1; argv++, argc--)
+      add_job (argv[1]);
+
+    /* Parameters common to all files */
+    blk_len = N;
+    first_blk = N1;
+    blk_no = N2;
+    bit_no = bitno;
+    samp_freq = sf;
+
+    i = measure_batch (out, jobs, fmt, quiet, level, use_active_level);
+    if (out != stdout)
+      fclose (out);
+    return ((int) i);
+  }
+
+
   /* REPEAT FOR ALL FILES IN THE COMMAND LINE */
   while (argc > 1) {
     /* Get new file name and update argument line pointer/counter */
@@ -555,7 +1167,12 @@ int main (int argc, char *argv[]) {
     argc--;
 
     /* Reset variables for speech level measurements */
-    init_speech_voltmeter (&state, sf);
+    if (win_blocks < 0)
+      init_speech_voltmeter (&state, sf);
+    else if (!init_speech_voltmeter_window (&window, sf, win_blocks)) {
+      fprintf (stderr, "Can't allocate memory for the look-behind window\n");
+      exit (1);
+    }
 
     /* ......... FILE PREPARATION ......... */
 
@@ -563,21 +1180,30 @@ int main (int argc, char *argv[]) {
 #ifdef VMS
     sprintf (mrs, "mrs=%d", 2 * N);
 #endif
-    if ((Fi = fopen (FileIn, RB)) == NULL)
+    if (strcmp (FileIn, "-") == 0) {
+      Fi = stdin;
+#if defined(MSDOS)
+      setmode (fileno (stdin), O_BINARY);
+#endif
+    } else if ((Fi = fopen (FileIn, RB)) == NULL)
       KILL (FileIn, 2);
 
     /* Reinitialize number of blocks as specified initially */
     N2 = N2_ori;
 
-    /* Check if is to process the whole file */
-    if (N2 == 0) {
+    /* Check if is to process the whole file; stdin is read until EOF */
+    if (N2 == 0 && Fi != stdin) {
       struct stat st;
       stat (FileIn, &st);
       N2 = ceil (st.st_size / (double) (N * sizeof (short)));
     }
 
-    /* Move pointer to 1st block of interest */
-    if (fseek (Fi, start_byte, 0) < 0l)
+    /* Move pointer to 1st block of interest; a pipe is skipped by reading */
+    if (Fi == stdin) {
+      for (i = 0; i < N1; i++)
+        if (fread (buffer, sizeof (short), N, Fi) < (size_t) N)
+          KILL (FileIn, 4);
+    } else if (fseek (Fi, start_byte, 0) < 0l)
       KILL (FileIn, 4);
 
 
@@ -586,17 +1212,29 @@ int main (int argc, char *argv[]) {
     /* Read samples ... */
     if (!quiet)
       fprintf (stderr, "  Processing \r");
-    for (i = 0; i < N2; i++) {
+    for (i = 0; N2 == 0 || i < N2; i++) {
       if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
         /* ... Convert samples to float */
         sh2fl ((long) l, buffer, Buf, bitno, 1);
 
         /* ... Get the active level */
-        ActiveLeveldB = speech_voltmeter (Buf, (long) l, &state);
+        if (win_blocks < 0)
+          ActiveLeveldB = speech_voltmeter (Buf, (long) l, &state);
+        else {
+          /* ... report the level of the window for this block */
+          ActiveLeveldB = speech_voltmeter_window (Buf, (long) l, &window);
+          fprintf (out, "Block: %5ld ActLev[dB]: %7.3f RMSLev[dB]: %7.3f %%Active: %7.3f", N1 + i + 1, ActiveLeveldB, window.rmsdB, window.ActivityFactor * 100);
+          if (level != 0 && (use_active_level ? window.ActivityFactor > 0 : window.rmsdB > -100))
+            fprintf (out, " Gain[]: %7.3f", pow (10.0, (level - (use_active_level ? ActiveLeveldB : window.rmsdB)) / 20.0));
+          fprintf (out, "\t%s\n", FileIn);
+        }
 
         /* Print progress flag */
         if (!quiet)
           fprintf (stderr, "%c\r", funny[i % funny_size]);
+      } else if (N2 == 0) {
+        /* End of stdin */
+        break;
       } else {
         KILL (FileIn, 5);
       }
@@ -604,6 +1242,17 @@ int main (int argc, char *argv[]) {
     if (!quiet)
       fprintf (stderr, "\n");
 
+    /* Number of blocks read from stdin */
+    if (N2 == 0)
+      N2 = i;
+
+    /* Statistics of the whole file; an empty call just computes its level */
+    if (win_blocks >= 0) {
+      state = window.state;
+      ActiveLeveldB = speech_voltmeter (Buf, 0l, &state);
+      free_speech_voltmeter_window (&window);
+    }
+
 #ifdef LOCAL_PRINT
     /* Convert absolute maximum sample to dB */
     abs_max_dB = 20 * log10 (SVP56_get_abs_max (state)) - state.refdB;
@@ -681,7 +1330,8 @@ int main (int argc, char *argv[]) {
 #endif /* LOCAL_PRINT */
 
     /* Close current file */
-    fclose (Fi);
+    if (Fi != stdin)
+      fclose (Fi);
   }
 
   /* FINALIZATIONS */
@@ -1,4 +1,4 @@
-/*                                                             v2.3 19.MAY.05
+/*                                                             v2.4 16.OCT.26
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -40,6 +40,14 @@ speech_voltmeter .............. measurement of the active speech level of
                                 data in a buffer according to P.56. Other
 				relevant statistics are also available.
 
+init_speech_voltmeter_window .. initialization of a speech voltmeter with
+                                a look-behind window (SVP56_window).
+
+speech_voltmeter_window ....... as speech_voltmeter(), also returning the
+                                active speech level of the last blocks.
+
+free_speech_voltmeter_window .. release of the memory of a SVP56_window.
+
 HISTORY:
 
    07.Oct.91 v1.0 Release of 1st version to UGST.
@@ -57,6 +65,11 @@ HISTORY:
 				  suggested by Mr Kabal.
 				  Upper and lower bounds are updated during the interpolation.
 						<Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com>
+   16.Oct.26 v2.4 speech_voltmeter() updates the activity counts only when
+                  the envelope crosses a threshold, instead of testing all
+                  thresholds for every sample; the results (and all
+                  fields of SVP56_state) are identical to v2.3. Added the
+                  look-behind window functions *_speech_voltmeter_window().
 
 =============================================================================
 */
@@ -67,6 +80,7 @@ HISTORY:
 
 /* System includes ... */
 #include <math.h>
+#include <stdlib.h>
 
 /* Specific includes ... */
 #ifndef SPEECH_VOLTMETER_defined
@@ -259,6 +273,100 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
 /* .................. End of init_speech_voltmeter() ..................... */
 
 
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        static double p56_level (double sq, unsigned long n,
+        ~~~~~~~~~~~~~~~~~~~~~~~  unsigned long *a, double *c, double refdB,
+                                 double *rmsdB, double *ActivityFactor);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Computes the long term level, the active speech level and the
+        activity factor according to P.56 from the squared sum `sq' of
+        `n' samples and the activity counts `a' for the thresholds `c'.
+        Used by speech_voltmeter() for the whole signal, and by
+        speech_voltmeter_window() for the samples in the look-behind
+        window.
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        sq              I        squared sum of the samples
+        n               I        number of samples
+        a               I        activity count for each threshold
+        c               I        threshold levels
+        refdB           I        0 dB reference point, in [dB]
+        rmsdB           O        long term (rms) level, in dB
+        ActivityFactor  O        activity factor (0 .. 1)
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        Returns the active speech level, in dBov, as a double.
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0       Moved from speech_voltmeter().
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+#define M        15.9           /* in [dB] */
+#define THRES_NO 15             /* number of thresholds in the speech voltmeter */
+
+/* Hooked to eliminate sigularity with log(0.0) (happens w/all-0 data blocks */
+#define MIN_LOG_OFFSET 1.0e-20
+
+static double p56_level (double sq, unsigned long n, unsigned long *a, double *c, double refdB, double *rmsdB, double *ActivityFactor) {
+  int j;
+  double AdB, CdB, AmdB, CmdB, ActiveSpeechLevel;
+  double LongTermLevel, Delta[15];
+
+  LongTermLevel = 10 * log10 ((sq) / (n) + MIN_LOG_OFFSET);
+  *rmsdB = LongTermLevel - refdB;
+  *ActivityFactor = 0;
+  ActiveSpeechLevel = -100.0;
+
+  /* Test the lower active counter; if 0, is silence */
+  if (a[0] == 0)
+    return (ActiveSpeechLevel);
+  else
+    AdB = 10 * log10 (((sq) / a[0]) + MIN_LOG_OFFSET);
+
+  /* Test if the lower act.counter is below the margin: if yes, is silence */
+  CdB = 20 * log10 ((double) c[0]);
+  if (AdB - CdB < M)
+    return (ActiveSpeechLevel);
+
+  /* Proceed serially for steps 2 and up -- this is the most common case */
+  for (j = 1; j < THRES_NO; j++) {
+    if (a[j] != 0) {
+      AdB = 10 * log10 (((sq) / a[j]) + MIN_LOG_OFFSET);
+      CdB = 20 * log10 (((double) c[j]) + MIN_LOG_OFFSET);
+      Delta[j] = AdB - CdB;
+      if (Delta[j] <= M) {      /* then interpolates to find the active */
+        /* level and the activity factor and exits */
+        /* AmdB is AdB for j-1, CmdB is CdB for j-1 */
+        AmdB = 10 * log10 (((sq) / a[j - 1]) + MIN_LOG_OFFSET);
+        CmdB = 20 * log10 (((double) c[j - 1] + MIN_LOG_OFFSET));
+
+        ActiveSpeechLevel = bin_interp (AdB, AmdB, CdB, CmdB, M, 0.5 /* dB */ );
+
+        *ActivityFactor = pow (10.0, ((LongTermLevel - ActiveSpeechLevel) / 10));
+        ActiveSpeechLevel -= (refdB);
+        break;
+      }
+    }
+  }
+
+  return (ActiveSpeechLevel);
+}
+
+#undef MIN_LOG_OFFSET
+#undef M
+#undef THRES_NO
+/* ......................... End of p56_level() .......................... */
+
+
 /*
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
@@ -336,6 +444,12 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
 				DEC Alpha VMS workstation and extended
                                 to ther platforms as well. Exceptions are
                                 VMS and gcc on PC. <simao@ctd.comsat.com>
+        16.Oct.26     2.4       The thresholds below the envelope always
+                                are c[0..J-1], so only the index J is
+                                tracked per sample; the activity counts
+                                and hangover counters are updated when J
+                                changes and at the end of the buffer.
+                                Statistics moved to p56_level().
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 */
 #define T        0.03           /* in [s] */
@@ -348,15 +462,20 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
 
 double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
   int I, j;
-  long k;
-  double g, x, AdB, CdB, AmdB, CmdB, ActiveSpeechLevel;
-  double LongTermLevel, Delta[15];
+  long k, J, gap;
+  long run[THRES_NO];           /* start of the current run above/below each threshold */
+  double g, x;
 
 
   /* Some initializations */
   I = floor (H * state->f + 0.5);
   g = exp (-1.0 / (state->f * T));
 
+  /* Thresholds are increasing, so the ones reached by the envelope are c[0..J-1]. For these, run[] is the start of the run above the threshold; for the others, the start of the run below it, which began hang[j] samples before this buffer (the hangover counts already in a[]) */
+  for (J = 0; J < THRES_NO && state->q >= state->c[J]; J++);
+  for (j = 0; j < THRES_NO; j++)
+    run[j] = (j < J) ? 0 : -(long) state->hang[j];
+
   /* Calculates statistics for all given data points */
   for (k = 0; k < smpno; k++) {
     x = (double) buffer[k];
@@ -379,65 +498,218 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
     state->p = g * (state->p) + (1 - g) * ((x > 0) ? x : -x);
     state->q = g * (state->q) + (1 - g) * (state->p);
 
-    /* Applies threshold to the envelope q */
-    for (j = 0; j < THRES_NO; j++) {
-      if ((state->q) >= state->c[j]) {
-        state->a[j]++;
-        state->hang[j] = 0;
-      }
-      if (((state->q) < state->c[j]) && (state->hang[j] < I)) {
-        state->a[j]++;
-        state->hang[j] += 1;
-      }
-      /* if (((state->q)<state->c[j])&&(state->hang[j]=I)), do nothing */
-    }                           /* [j] */
+    /* Applies thresholds to the envelope q: only those crossed now change state */
+    if (J < THRES_NO && (state->q) >= state->c[J]) {
+      do {
+        /* Run below c[J] ends: at most I of its samples are active (hangover) */
+        gap = k - run[J];
+        state->a[J] += ((gap < I) ? gap : I) - ((run[J] < 0) ? -run[J] : 0);
+        run[J] = k;
+      } while (++J < THRES_NO && (state->q) >= state->c[J]);
+    } else if (J > 0 && (state->q) < state->c[J - 1]) {
+      do {
+        /* Run above c[J-1] ends: all of its samples are active */
+        J--;
+        state->a[J] += k - run[J];
+        run[J] = k;
+      } while (J > 0 && (state->q) < state->c[J - 1]);
+    }
   }                             /* [k] */
 
+  /* Close the runs at the end of the buffer, updating the hangover counters */
+  for (j = 0; j < THRES_NO; j++) {
+    if (j < J) {
+      state->a[j] += smpno - run[j];
+      state->hang[j] = 0;
+    } else {
+      gap = smpno - run[j];
+      gap = (gap < I) ? gap : I;
+      state->a[j] += gap - ((run[j] < 0) ? -run[j] : 0);
+      state->hang[j] = gap;
+    }
+  }
+
   /* Computes the statistics */
   state->DClevel = (state->s) / (state->n);
-  LongTermLevel = 10 * log10 ((state->sq) / (state->n) + MIN_LOG_OFFSET);
-  state->rmsdB = LongTermLevel - state->refdB;
-  state->ActivityFactor = 0;
-  ActiveSpeechLevel = -100.0;
+  return (p56_level (state->sq, state->n, state->a, state->c, state->refdB, &(state->rmsdB), &(state->ActivityFactor)));
+}
 
-  /* Test the lower active counter; if 0, is silence */
-  if (state->a[0] == 0)
-    return (ActiveSpeechLevel);
-  else
-    AdB = 10 * log10 (((state->sq) / state->a[0]) + MIN_LOG_OFFSET);
+#undef MIN_LOG_OFFSET
+#undef M
+#undef H
+#undef T
+#undef THRES_NO
+/* .................... End of speech_voltmeter() ........................ */
 
-  /* Test if the lower act.counter is below the margin: if yes, is silence */
-  CdB = 20 * log10 ((double) state->c[0]);
-  if (AdB - CdB < M)
-    return (ActiveSpeechLevel);
 
-  /* Proceed serially for steps 2 and up -- this is the most common case */
-  for (j = 1; j < THRES_NO; j++) {
-    if (state->a[j] != 0) {
-      AdB = 10 * log10 (((state->sq) / state->a[j]) + MIN_LOG_OFFSET);
-      CdB = 20 * log10 (((double) state->c[j]) + MIN_LOG_OFFSET);
-      Delta[j] = AdB - CdB;
-      if (Delta[j] <= M) {      /* then interpolates to find the active */
-        /* level and the activity factor and exits */
-        /* AmdB is AdB for j-1, CmdB is CdB for j-1 */
-        AmdB = 10 * log10 (((state->sq) / state->a[j - 1]) + MIN_LOG_OFFSET);
-        CmdB = 20 * log10 (((double) state->c[j - 1] + MIN_LOG_OFFSET));
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-        ActiveSpeechLevel = bin_interp (AdB, AmdB, CdB, CmdB, M, 0.5 /* dB */ );
+        int init_speech_voltmeter_window (SVP56_window *w, double sampl_freq,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long blocks);
 
-        state->ActivityFactor = pow (10.0, ((LongTermLevel - ActiveSpeechLevel) / 10));
-        ActiveSpeechLevel -= (state->refdB);
-        break;
-      }
+        Description:
+        ~~~~~~~~~~~~
+
+        Initializes a speech voltmeter with a look-behind window of the
+        last `blocks' calls of speech_voltmeter_window(). The statistics
+        of the whole signal are kept in w->state, as for a plain
+        SVP56_state. For blocks = 0, the window is the whole signal.
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        w              I/O       speech voltmeter with look-behind window
+        sampl_freq      I        input signal's sampling frequency
+        blocks          I        length of the window, in blocks
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        1 on success, 0 if memory for the window can't be allocated.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0   Created.
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+#define THRES_NO 15             /* number of thresholds in the speech voltmeter */
+
+int init_speech_voltmeter_window (SVP56_window * w, double sampl_freq, long blocks) {
+  init_speech_voltmeter (&(w->state), sampl_freq);
+
+  w->blocks = (blocks > 0) ? blocks : 0;
+  w->head = w->count = 0;
+  w->sq = NULL;
+  w->n = w->a = NULL;
+  w->rmsdB = w->ActivityFactor = 0;
+
+  /* Allocate the ring of cumulative statistics */
+  if (w->blocks > 0) {
+    w->sq = (double *) calloc (w->blocks, sizeof (double));
+    w->n = (unsigned long *) calloc (w->blocks, sizeof (unsigned long));
+    w->a = (unsigned long *) calloc (w->blocks * THRES_NO, sizeof (unsigned long));
+    if (w->sq == NULL || w->n == NULL || w->a == NULL) {
+      free_speech_voltmeter_window (w);
+      return 0;
     }
   }
+  return 1;
+}
 
-  return (ActiveSpeechLevel);
+/* ............... End of init_speech_voltmeter_window() ................. */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        double speech_voltmeter_window (float *buffer, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  SVP56_window *w);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Adds the samples in `buffer' to the measurement of the whole
+        signal in w->state, as speech_voltmeter(), and returns the active
+        speech level of the samples in the look-behind window, i.e. in
+        this and the previous (blocks-1) buffers. The activity counts of
+        the window are the differences of the cumulative counts of the
+        whole signal, so the envelope and hangover at the start of the
+        window are those of the continuous measurement. The long term
+        level and the activity factor of the window are left in w->rmsdB
+        and w->ActivityFactor.
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        buffer          I        input samples vector
+        smpno           I        number of samples in vector `buffer'
+        w              I/O       speech voltmeter with look-behind window
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        Returns the active speech level in the window, in dBov.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0   Created.
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+double speech_voltmeter_window (float *buffer, long smpno, SVP56_window * w) {
+  SVP56_state *state = &(w->state);
+  unsigned long a[THRES_NO], *a0;
+  long slot, j;
+  double level;
+
+  /* Whole signal */
+  if (w->blocks == 0) {
+    level = speech_voltmeter (buffer, smpno, state);
+    w->rmsdB = state->rmsdB;
+    w->ActivityFactor = state->ActivityFactor;
+    return (level);
+  }
+
+  /* Save the cumulative statistics before this buffer, replacing the oldest entry if the ring is full */
+  if (w->count < w->blocks)
+    slot = (w->head + w->count++) % w->blocks;
+  else {
+    slot = w->head;
+    w->head = (w->head + 1) % w->blocks;
+  }
+  w->sq[slot] = state->sq;
+  w->n[slot] = state->n;
+  for (j = 0; j < THRES_NO; j++)
+    w->a[slot * THRES_NO + j] = state->a[j];
+
+  /* Update the statistics of the whole signal */
+  speech_voltmeter (buffer, smpno, state);
+
+  /* Statistics of the window: difference to the oldest entry */
+  a0 = &(w->a[w->head * THRES_NO]);
+  for (j = 0; j < THRES_NO; j++)
+    a[j] = state->a[j] - a0[j];
+
+  return (p56_level (state->sq - w->sq[w->head], state->n - w->n[w->head], a, state->c, state->refdB, &(w->rmsdB), &(w->ActivityFactor)));
+}
+
+/* ................. End of speech_voltmeter_window() ..................... */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        void free_speech_voltmeter_window (SVP56_window *w);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Releases the memory allocated by init_speech_voltmeter_window().
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0   Created.
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+void free_speech_voltmeter_window (SVP56_window * w) {
+  free (w->a);
+  free (w->n);
+  free (w->sq);
+  w->sq = NULL;
+  w->n = w->a = NULL;
+  w->blocks = w->head = w->count = 0;
 }
 
-#undef MIN_LOG_OFFSET
-#undef M
-#undef H
-#undef T
 #undef THRES_NO
-/* .................... End of speech_voltmeter() ........................ */
+/* ............... End of free_speech_voltmeter_window() .................. */
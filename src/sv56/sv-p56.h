@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: SV-P56.H                                             01.SEP.1995 v2.2
+   File: SV-P56.H                                             16.OCT.2026 v2.4
   ============================================================================
 
                       UGST/ITU-T SPEECH VOLTMETER MODULE
@@ -23,11 +23,13 @@
                         <tdsimao@venus.cpqd.ansp.br>
    01.Sep.95    v2.2    Updated version number to match sv-p56.c and added 
                         smart prototypes <simao@ctd.comsat.com>
+   16.Oct.26    v2.4    Added SVP56_window and the look-behind window
+                        functions
 
   ============================================================================
 */
 #ifndef SPEECH_VOLTMETER_defined
-#define SPEECH_VOLTMETER_defined 220
+#define SPEECH_VOLTMETER_defined 240
 
 /* DEFINITION FOR SMART PROTOTYPES */
 #ifndef ARGS
@@ -57,10 +59,25 @@ typedef struct {
   double ActivityFactor;        /* Activity factor since last reset */
 } SVP56_state;
 
+/* State for speech voltmeter with a look-behind window */
+typedef struct {
+  SVP56_state state;            /* statistics of the whole signal since reset */
+  long blocks;                  /* window length, in blocks (0: whole signal) */
+  long head, count;             /* oldest entry and no.of entries in the ring */
+  double *sq;                   /* squared sum before each block in window */
+  unsigned long *n;             /* no.of samples before each block in window */
+  unsigned long *a;             /* activity counts before each block (15 each) */
+  double rmsdB;                 /* rms value in the window */
+  double ActivityFactor;        /* activity factor in the window */
+} SVP56_window;
+
 /* Speech voltmeter prototypes */
 double bin_interp ARGS ((double upcount, double lwcount, double upthr, double lwthr, double Margin, double tol));
 void init_speech_voltmeter ARGS ((SVP56_state * state, double sampl_freq));
 double speech_voltmeter ARGS ((float *buffer, long smpno, SVP56_state * state));
+int init_speech_voltmeter_window ARGS ((SVP56_window * w, double sampl_freq, long blocks));
+double speech_voltmeter_window ARGS ((float *buffer, long smpno, SVP56_window * w));
+void free_speech_voltmeter_window ARGS ((SVP56_window * w));
 
 
 /* Definitions for getting statistics from a `SVP56_state' variable */
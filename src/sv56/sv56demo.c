@@ -1,4 +1,4 @@
-/*                                                              v3.5 02.Feb.10
+/*                                                              v3.6 16.Oct.26
   ============================================================================
 
   SV56DEMO.C
@@ -81,6 +81,12 @@
   -end eb ........ define `eb' as the last block to be measured
   -n nb .......... define `nb' as the number of blocks to be measured;
                    equivalent to parameter N2 above [default: whole file]
+  -win nb ........ level-equalize in a single pass: each block is scaled
+                   using the active level of the last `nb' blocks (0: of
+                   all the blocks read so far) instead of the level of the
+                   whole file. In this mode, FileIn and FileOut can be "-"
+                   for stdin and stdout; when FileOut is stdout, statistics
+                   go to stderr and the progress flag is disabled.
 
   Modules used:
   ~~~~~~~~~~~~~
@@ -155,6 +161,9 @@
                            a multiple of the block size <simao>.
   02.Feb.10     3.5        Modified maximum string length to avoid
                            buffer overruns (y.hiwasaki)
+  16.Oct.26     3.6        Added option -win for single-pass equalization
+                           using the level of a look-behind window, with
+                           input/output from/to pipes.
 
   ============================================================================
 */
@@ -202,7 +211,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("SV56DEMO.C: Version 3.5 of 02.Feb.2010 \n\n");
+  printf ("SV56DEMO.C: Version 3.6 of 16.Oct.2026 \n\n");
   printf ("  Program to level-equalize a speech file \"NdB\" dBs below\n");
   printf ("  the overload point for a linear n-bit (default: 16 bit) system.\n");
   printf ("  using the P.56 speech voltmeter algorithm.\n");
@@ -239,6 +248,9 @@ void display_usage () {
   printf ("  -end eb ..... define `eb' as the last block to be measured\n");
   printf ("  -n nb ....... define `nb' as the number of blocks to be measured;\n");
   printf ("                equiv. to param.NoOfBlocks above [dft: whole file]\n");
+  printf ("  -win nb ..... single-pass equalization using the level of the\n");
+  printf ("                last `nb' blocks (0: all blocks so far); FileIn and\n");
+  printf ("                FileOut can then be \"-\" for stdin/stdout.\n");
   printf ("  -log file ... log statistics into file rather than stdout\n");
   printf ("  -q .......... quiet operation - does not print the progress flag.\n");
   printf ("                Saves time and avoids trash in batch processings.\n");
@@ -429,6 +441,8 @@ int main (int argc, char *argv[]) {
 
   /* Intermediate storage variables for speech voltmeter */
   SVP56_state state;
+  SVP56_window window;
+  long win_blocks = -1;         /* <0: two-pass equalization */
 
   /* File-related variables */
   char FileIn[MAX_STRLEN], FileOut[MAX_STRLEN];
@@ -455,7 +469,7 @@ int main (int argc, char *argv[]) {
   if (argc < 2)
     display_usage ();
   else {
-    while (argc > 1 && argv[1][0] == '-')
+    while (argc > 1 && argv[1][0] == '-' && argv[1][1] != 0)
       if (strcmp (argv[1], "-lev") == 0) {
         /* Change default level normalization */
         NdB = atof (argv[2]);
@@ -509,6 +523,15 @@ int main (int argc, char *argv[]) {
         /* Change default number of blocks */
         N2 = atol (argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-win") == 0) {
+        /* Single-pass equalization with a look-behind window */
+        win_blocks = atol (argv[2]);
+        if (win_blocks < 0)
+          win_blocks = 0;
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -562,8 +585,14 @@ int main (int argc, char *argv[]) {
   start_byte = --N1;
   start_byte *= N * sizeof (short);
 
-  /* Check if is to process the whole file */
-  if (N2 == 0) {
+  /* Pipes can only be used in a single pass */
+  if (win_blocks < 0 && (strcmp (FileIn, "-") == 0 || strcmp (FileOut, "-") == 0)) {
+    fprintf (stderr, "Pipes can only be used with option -win. Aborted.\n");
+    exit (2);
+  }
+
+  /* Check if is to process the whole file; single pass reads until EOF */
+  if (N2 == 0 && win_blocks < 0) {
     struct stat st;
 
     /* ... find the input file size ... */
@@ -586,18 +615,104 @@ int main (int argc, char *argv[]) {
 #ifdef VMS
   sprintf (mrs, "mrs=%d", 2 * N);
 #endif
-  if ((Fi = fopen (FileIn, RB)) == NULL)
+  if (strcmp (FileIn, "-") == 0) {
+    Fi = stdin;
+#if defined(MSDOS)
+    setmode (fileno (stdin), O_BINARY);
+#endif
+  } else if ((Fi = fopen (FileIn, RB)) == NULL)
     KILL (FileIn, 2);
 
-  /* Creates output file */
-  if ((Fo = fopen (FileOut, WB)) == NULL)
+  /* Creates output file; statistics can't go to stdout along with data */
+  if (strcmp (FileOut, "-") == 0) {
+    Fo = stdout;
+#if defined(MSDOS)
+    setmode (fileno (stdout), O_BINARY);
+#endif
+    if (out == stdout)
+      out = stderr;
+    quiet = 1;
+  } else if ((Fo = fopen (FileOut, WB)) == NULL)
     KILL (FileOut, 3);
 
-  /* Move pointer to 1st block of interest */
-  if (fseek (Fi, start_byte, 0) < 0l)
+  /* Move pointer to 1st block of interest; a pipe is skipped by reading */
+  if (Fi == stdin) {
+    for (i = 0; i < N1; i++)
+      if (fread (buffer, sizeof (short), N, Fi) < (size_t) N)
+        KILL (FileIn, 4);
+  } else if (fseek (Fi, start_byte, 0) < 0l)
     KILL (FileIn, 4);
 
 
+  /* ... SINGLE-PASS EQUALIZATION WITH A LOOK-BEHIND WINDOW ... */
+  if (win_blocks >= 0) {
+    if (!init_speech_voltmeter_window (&window, sf, win_blocks)) {
+      fprintf (stderr, "Can't allocate memory for the look-behind window\n");
+      exit (1);
+    }
+
+    /* Keep unity gain until there is active speech in the window */
+    factor = 1.0;
+    if (!quiet)
+      printf ("  Processing \r");
+
+    /* Process selected blocks, or until the end of the input */
+    for (i = 0; N2 == 0 || i < N2; i++) {
+      if ((l = fread (buffer, sizeof (short), N, Fi)) <= 0)
+        break;
+
+      /* Convert samples to float and update the level of the window */
+      sh2fl ((long) l, buffer, Buf, bitno, 1);
+      ActiveLeveldB = speech_voltmeter_window (Buf, (long) l, &window);
+
+      /* Gain for the current window */
+      if (use_active_level) {
+        if (window.ActivityFactor > 0)
+          factor = pow (10.0, (NdB - ActiveLeveldB) / 20.0);
+      } else if (window.rmsdB > -100)
+        factor = pow (10.0, (NdB - window.rmsdB) / 20.0);
+
+      /* Equalize, convert back to short and save */
+      scale (Buf, (long) l, (double) factor);
+      NrSat += fl2sh ((long) l, Buf, buffer, (double) 0.0, mask[16 - bitno]);
+      if ((long) fwrite (buffer, sizeof (short), l, Fo) < l)
+        KILL (FileOut, 6);
+      fflush (Fo);
+
+      if (!quiet)
+        printf ("%c\r", funny[i % 5]);
+    }
+    N2 = i;
+    if (!quiet)
+      printf ("\n");
+
+    /* Summary of the whole signal; an empty call just computes its level */
+    state = window.state;
+    ActiveLeveldB = speech_voltmeter (Buf, 0l, &state);
+    if (long_summary)
+      print_p56_long_summary (out, FileIn, state, ActiveLeveldB, NdB, Overflow, factor, N, N1, N2, bitno);
+    else
+      print_p56_short_summary (out, FileIn, state, ActiveLeveldB, Overflow, factor);
+    if (NrSat != 0)
+      fprintf (out, "\n  Number of clippings: .......... %7ld []\n", NrSat);
+    else
+      fprintf (out, "\n");
+
+    if (!quiet)
+      printf ("---> DONE    \n");
+
+    /* Release memory and close files */
+    free_speech_voltmeter_window (&window);
+    if (Fi != stdin)
+      fclose (Fi);
+    if (Fo != stdout)
+      fclose (Fo);
+    if (out != stdout && out != stderr)
+      fclose (out);
+    return (0);
+  }
+
+
   /* ... MEASUREMENT OF ACTIVE SPEECH LEVEL ACCORDING P.56 ... */
 
   /* Print info */
@@ -0,0 +1,145 @@
+/*                                                            v1.0  16.Oct.26
+=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+
+MODULE:         UGST-THR.C, PORTABLE THREAD FUNCTIONS
+
+PROTOTYPE:      in ugst-thr.h
+
+FUNCTIONS:
+
+    thread_create: .. start a thread
+    thread_join: .... wait for a thread to finish and release it
+    cpu_count: ...... number of on-line processors
+
+    mutex_init, mutex_lock, mutex_unlock and mutex_destroy are
+    implemented as macros in ugst-thr.h.
+
+    Needs POSIX threads (pthreads), or the Win32 API when _WIN32 is
+    defined.
+
+HISTORY:
+
+  16.Oct.26 v1.0 Created, from the copies in fltbatch.c and actlevel.c.
+=============================================================================
+*/
+
+
+/*
+ * .................... INCLUDES ....................
+ */
+#if !defined(_WIN32)
+#include <unistd.h>             /* For sysconf() */
+#endif
+#include "ugst-thr.h"           /* Module Function prototypes */
+
+
+/*
+ * .................... FUNCTIONS ....................
+ */
+
+/*
+  ============================================================================
+
+       int thread_create (THREAD_T *thread, THREAD_FUNC proc, void *arg);
+       ~~~~~~~~~~~~~~~~~
+
+       Start a thread running proc(arg). proc should be defined with the
+       THREAD_PROC() macro.
+
+       Return value:
+       ~~~~~~~~~~~~~
+       1 if the thread was started, 0 otherwise.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+int thread_create (THREAD_T * thread, THREAD_FUNC proc, void *arg) {
+#if defined(_WIN32)
+  return (*thread = CreateThread (NULL, 0, proc, arg, 0, NULL)) != NULL;
+#else
+  return pthread_create (thread, NULL, proc, arg) == 0;
+#endif
+}
+
+/* ....................... End of thread_create() ........................ */
+
+
+/*
+  ============================================================================
+
+       void thread_join (THREAD_T thread);
+       ~~~~~~~~~~~~~~~~
+
+       Wait for a thread started by thread_create() to finish, and
+       release it.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+void thread_join (THREAD_T thread) {
+#if defined(_WIN32)
+  WaitForSingleObject (thread, INFINITE);
+  CloseHandle (thread);
+#else
+  pthread_join (thread, NULL);
+#endif
+}
+
+/* ........................ End of thread_join() ......................... */
+
+
+/*
+  ============================================================================
+
+       long cpu_count (void);
+       ~~~~~~~~~~~~~~
+
+       Number of on-line processors, used as the default number of
+       threads. Returns 1 when it can't be found.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+long cpu_count (void) {
+#if defined(_WIN32)
+  SYSTEM_INFO si;
+  GetSystemInfo (&si);
+  return (long) si.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf (_SC_NPROCESSORS_ONLN);
+  return n > 0 ? n : 1;
+#else
+  return 1;
+#endif
+}
+
+/* ......................... End of cpu_count() .......................... */
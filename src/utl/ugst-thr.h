@@ -0,0 +1,63 @@
+/*
+  ============================================================================
+   File: UGST-THR.H                                                16.Oct.26
+  ============================================================================
+
+                         UGST/ITU-T UTILITIES MODULE
+
+                  PORTABLE THREADS: DEFINITIONS AND PROTOTYPES
+
+   Thin layer over POSIX threads, or the Win32 API when _WIN32 is
+   defined, used by the tools that process several files in parallel.
+
+   History:
+   16.Oct.26    v1.0    Created, from the copies in fltbatch.c and
+                        actlevel.c.
+  ============================================================================
+*/
+#ifndef UGST_THREADS_defined
+#define UGST_THREADS_defined 100
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/* macros for smart prototypes */
+#ifndef ARGS
+#if (defined(__STDC__) || defined(VMS) || defined(__DECC)  || defined(MSDOS) || defined(__MSDOS__))
+#define ARGS(x) x
+#else /* Unix: no parameters in prototype! */
+#define ARGS(x) ()
+#endif
+#endif
+
+/* Threads, mutexes, and the signature of a thread's main function */
+#if defined(_WIN32)
+typedef HANDLE THREAD_T;
+typedef CRITICAL_SECTION MUTEX_T;
+typedef LPTHREAD_START_ROUTINE THREAD_FUNC;
+#define THREAD_PROC(name) DWORD WINAPI name (LPVOID arg)
+#define mutex_init(m)    InitializeCriticalSection(m)
+#define mutex_lock(m)    EnterCriticalSection(m)
+#define mutex_unlock(m)  LeaveCriticalSection(m)
+#define mutex_destroy(m) DeleteCriticalSection(m)
+#else
+typedef pthread_t THREAD_T;
+typedef pthread_mutex_t MUTEX_T;
+typedef void *(*THREAD_FUNC) (void *);
+#define THREAD_PROC(name) void *name (void *arg)
+#define mutex_init(m)    pthread_mutex_init(m, NULL)
+#define mutex_lock(m)    pthread_mutex_lock(m)
+#define mutex_unlock(m)  pthread_mutex_unlock(m)
+#define mutex_destroy(m) pthread_mutex_destroy(m)
+#endif
+
+/* Prototypes */
+int thread_create ARGS ((THREAD_T * thread, THREAD_FUNC proc, void *arg));
+void thread_join ARGS ((THREAD_T thread));
+long cpu_count ARGS ((void));
+
+#endif
+/* ........................ End of UGST-THR.H .......................... */
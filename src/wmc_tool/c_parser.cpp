@@ -51,6 +51,7 @@
 #define INSERT_TBL_MEM_INCREMENT  256  /* in # of entries (yields 4kB) */
 #define FCTCALL_TBL_MEM_INCREMENT 512  /* in # of entries (yields 4kB) */
 #define POINTER_TBL_MEM_INCREMENT 2048 /* in # of entries (yields 4kB) */
+#define REGION_IDX_MIN_LEVEL_SIZE 64   /* in # of entries (smaller are searched linearly) */
 
 /*****************************************
  * Instrumentation Strings
@@ -246,6 +247,19 @@ typedef struct
     int misc;
 } PROM_Ops_Weights_defs;
 
+/* Region Index Search (see Find_Region) */
+typedef struct
+{
+    Parse_Tbl_def *ParseTbl_ptr;
+    const char *ptr;      /* Location */
+    Item_Type item_class; /* Region Specification */
+    Item_Type item_spec;
+    int idx;              /* Search Start Index in Parse Table */
+    MOVE_DIRECTION step;
+    int nKeys;            /* # of Level Keys Starting at or before 'ptr' */
+    int found;            /* Matching Entry (-1 if none) */
+} Region_Query_def;
+
 /*-------------------------------------------------------------------*
  * Local Data
  *-------------------------------------------------------------------*/
@@ -700,7 +714,9 @@ static TOOL_ERROR Allocate_Region( Parse_Tbl_def *ParseTbl_ptr )
         /* Copy Current Table in Newly Allocated Memory */
         memmove( ptr, ParseTbl_ptr->Data, PARSE_REC_SIZE * ParseTbl_ptr->Size );
         /* Free Currently Allocated Parse Table Memory */
-        Free_Parse_Table_Memory( ParseTbl_ptr );
+        /* (the Region Index is kept, Entries are Unchanged) */
+        if ( ParseTbl_ptr->MaxSize != 0 )
+            free( ParseTbl_ptr->Data );
         /* Set Base Pointer in Parse Table Context */
         ParseTbl_ptr->Data = ptr;
         /* Set Parse Table Max Size in Parse Table Context */
@@ -711,6 +727,25 @@ ret:
     return ErrCode;
 }
 
+/*-------------------------------------------------------------------*
+ * Free_Region_Index
+ *-------------------------------------------------------------------*/
+static void Free_Region_Index( Parse_Tbl_def *ParseTbl_ptr )
+{
+    Region_Idx_def *Index_ptr = &ParseTbl_ptr->Index;
+    Region_Lvl_def *Level_ptr;
+
+    /* Free all Levels */
+    while ( Index_ptr->nLevels > 0 )
+    {
+        Level_ptr = &Index_ptr->Level[--Index_ptr->nLevels];
+        free( Level_ptr->Key );
+        free( Level_ptr->MaxEnd );
+    }
+    /* No Entry Covered */
+    Index_ptr->Size = 0;
+}
+
 /*-------------------------------------------------------------------*
  * Add_Region
  *-------------------------------------------------------------------*/
@@ -802,6 +837,9 @@ static int Parse_Table_Entries_Cmp( const void *elem1, const void *elem2 )
  *-------------------------------------------------------------------*/
 static void Sort_Parse_Table( Parse_Tbl_def *ParseTbl_ptr )
 {
+    /* Entries will Move (Region Index must be Rebuilt) */
+    Free_Region_Index( ParseTbl_ptr );
+
     qsort( ParseTbl_ptr->Data,
            ParseTbl_ptr->Size,
            PARSE_REC_SIZE,
@@ -1189,6 +1227,257 @@ static TOOL_ERROR Add_Pointer(
 }
 
 
+/*-------------------------------------------------------------------*
+ * Region_Matches
+ *-------------------------------------------------------------------*/
+static inline bool Region_Matches(
+    const Parse_Rec_def *ParseRec_ptr,
+    const char *ptr,
+    Item_Type item_class,
+    Item_Type item_spec )
+{
+    /* Region Matches Specification? */
+    if ( ParseRec_ptr->item_type & item_class && ( ParseRec_ptr->item_type & item_spec ) == item_spec )
+    { /* Yes */
+        /* In a Region? */
+        if ( ( ParseRec_ptr->item_start <= ptr && ptr < ParseRec_ptr->item_end ) || ptr == NULL )
+        { /* Yes */
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*
+ * Region_Keys_Cmp
+ *-------------------------------------------------------------------*/
+static int Region_Keys_Cmp( const void *elem1, const void *elem2 )
+{
+    Region_Key_def *ptr1 = (Region_Key_def *) elem1;
+    Region_Key_def *ptr2 = (Region_Key_def *) elem2;
+
+    if ( ptr1->item_start < ptr2->item_start )
+        return -1;
+    if ( ptr1->item_start > ptr2->item_start )
+        return 1;
+
+    return ptr1->entry - ptr2->entry;
+}
+
+/*-------------------------------------------------------------------*
+ * Update_Region_Index
+ *-------------------------------------------------------------------*
+ * The Index covers the Parse Table Entries [0, Index.Size[ with a
+ * few Levels, each covering a contiguous Range of Entries. A Level
+ * holds its Entries Sorted by Start Location plus a Binary Tree of
+ * the Largest End Location, so the Regions containing a Location
+ * are found without looking at the others. Entries Added after the
+ * last Update are Searched Linearly until there are enough of them
+ * to make a new Level; smaller Levels are then Merged into it, which
+ * keeps the # of Levels Logarithmic.
+ * The Item Types are not Indexed because they get Updated in Place.
+ *-------------------------------------------------------------------*/
+static void Update_Region_Index( Parse_Tbl_def *ParseTbl_ptr )
+{
+    Region_Idx_def *Index_ptr = &ParseTbl_ptr->Index;
+    Region_Lvl_def *Level_ptr;
+    Region_Key_def *Key_ptr;
+    Parse_Rec_def *ParseRec_ptr;
+    char **MaxEnd_ptr;
+    int i, base, size, leaves;
+
+    /* Table was Shrunk? */
+    if ( ParseTbl_ptr->Size < Index_ptr->Size )
+    { /* Yes */
+        Free_Region_Index( ParseTbl_ptr );
+    }
+
+    /* Enough New Entries for a Level? */
+    base = Index_ptr->Size;
+    size = ParseTbl_ptr->Size - base;
+    if ( size < REGION_IDX_MIN_LEVEL_SIZE )
+    { /* No */
+        return;
+    }
+
+    /* Merge the Levels that are not at least Twice as Big */
+    while ( Index_ptr->nLevels > 0 &&
+            ( Index_ptr->Level[Index_ptr->nLevels - 1].Size < 2 * size ||
+              Index_ptr->nLevels == REGION_IDX_MAX_LEVELS ) )
+    {
+        Level_ptr = &Index_ptr->Level[--Index_ptr->nLevels];
+        base = Level_ptr->Base;
+        size += Level_ptr->Size;
+        free( Level_ptr->Key );
+        free( Level_ptr->MaxEnd );
+    }
+    Index_ptr->Size = base;
+
+    /* Get # of Leaves (Power of 2) */
+    for ( leaves = 1; leaves < size; leaves *= 2 )
+        ;
+
+    /* Allocate Memory */
+    Key_ptr = (Region_Key_def *) malloc( sizeof( Region_Key_def ) * size );
+    MaxEnd_ptr = (char **) malloc( sizeof( char * ) * 2 * leaves );
+    if ( Key_ptr == NULL || MaxEnd_ptr == NULL )
+    { /* Failed (Remaining Entries will be Searched Linearly) */
+        free( Key_ptr );
+        free( MaxEnd_ptr );
+        return;
+    }
+
+    /* Sort Entries by Start Location */
+    ParseRec_ptr = &ParseTbl_ptr->Data[base];
+    for ( i = 0; i < size; i++ )
+    {
+        Key_ptr[i].item_start = ParseRec_ptr->item_start;
+        Key_ptr[i].item_end = ParseRec_ptr->item_end;
+        Key_ptr[i].entry = base + i;
+        ParseRec_ptr++;
+    }
+    qsort( Key_ptr, size, sizeof( Region_Key_def ), Region_Keys_Cmp );
+
+    /* Build Largest End Location Tree */
+    for ( i = 0; i < leaves; i++ )
+    {
+        MaxEnd_ptr[leaves + i] = i < size ? Key_ptr[i].item_end : NULL;
+    }
+    for ( i = leaves - 1; i > 0; i-- )
+    {
+        MaxEnd_ptr[i] = MaxEnd_ptr[2 * i] > MaxEnd_ptr[2 * i + 1] ? MaxEnd_ptr[2 * i] : MaxEnd_ptr[2 * i + 1];
+    }
+
+    /* Add Level */
+    Level_ptr = &Index_ptr->Level[Index_ptr->nLevels++];
+    Level_ptr->Base = base;
+    Level_ptr->Size = size;
+    Level_ptr->Leaves = leaves;
+    Level_ptr->Key = Key_ptr;
+    Level_ptr->MaxEnd = MaxEnd_ptr;
+    Index_ptr->Size = base + size;
+}
+
+/*-------------------------------------------------------------------*
+ * Search_Region_Level
+ *-------------------------------------------------------------------*/
+static void Search_Region_Level(
+    const Region_Lvl_def *Level_ptr,
+    Region_Query_def *Query_ptr,
+    int node,  /* Tree Node */
+    int first, /* 1st Leaf of the Node */
+    int width ) /* # of Leaves of the Node */
+{
+    int entry;
+
+    /* All Regions Start after or End before the Location? */
+    if ( first >= Query_ptr->nKeys || Level_ptr->MaxEnd[node] <= Query_ptr->ptr )
+    { /* Yes */
+        return;
+    }
+
+    /* Leaf? */
+    if ( width == 1 )
+    { /* Yes */
+        entry = Level_ptr->Key[first].entry;
+        /* Closer to Search Start Index? */
+        if ( Query_ptr->step == FORWARD ? entry >= Query_ptr->idx && ( Query_ptr->found < 0 || entry < Query_ptr->found )
+                                        : entry <= Query_ptr->idx && entry > Query_ptr->found )
+        { /* Yes */
+            if ( Region_Matches( &Query_ptr->ParseTbl_ptr->Data[entry], Query_ptr->ptr,
+                                 Query_ptr->item_class, Query_ptr->item_spec ) )
+            {
+                Query_ptr->found = entry;
+            }
+        }
+        return;
+    }
+
+    /* Search Both Halves */
+    width /= 2;
+    Search_Region_Level( Level_ptr, Query_ptr, 2 * node, first, width );
+    Search_Region_Level( Level_ptr, Query_ptr, 2 * node + 1, first + width, width );
+}
+
+/*-------------------------------------------------------------------*
+ * Find_Indexed_Region
+ *-------------------------------------------------------------------*/
+static int Find_Indexed_Region( Region_Query_def *Query_ptr )
+{
+    Parse_Tbl_def *ParseTbl_ptr = Query_ptr->ParseTbl_ptr;
+    Region_Idx_def *Index_ptr = &ParseTbl_ptr->Index;
+    const Region_Lvl_def *Level_ptr;
+    int i, lo, hi, mid, level;
+
+    /* Index the Entries Added since Last Time (if Worth it) */
+    Update_Region_Index( ParseTbl_ptr );
+
+    /* Levels are in Entry Order, so the first Level (in the Search */
+    /* Direction) with a Match has the Entry that the Linear Search */
+    /* would Find. Entries not Indexed yet are Searched Linearly.  */
+    Query_ptr->found = -1;
+
+    /* Search Backwards? */
+    if ( Query_ptr->step != FORWARD )
+    { /* Yes */
+        for ( i = Query_ptr->idx; i >= Index_ptr->Size; i-- )
+        {
+            if ( Region_Matches( &ParseTbl_ptr->Data[i], Query_ptr->ptr,
+                                 Query_ptr->item_class, Query_ptr->item_spec ) )
+            {
+                return i;
+            }
+        }
+    }
+
+    for ( level = 0; level < Index_ptr->nLevels; level++ )
+    {
+        Level_ptr = &Index_ptr->Level[Query_ptr->step == FORWARD ? level : Index_ptr->nLevels - 1 - level];
+
+        /* Level out of Search Range? */
+        if ( Query_ptr->step == FORWARD ? Level_ptr->Base + Level_ptr->Size <= Query_ptr->idx
+                                        : Level_ptr->Base > Query_ptr->idx )
+        { /* Yes */
+            continue;
+        }
+
+        /* Get # of Regions Starting at or before the Location */
+        lo = 0;
+        hi = Level_ptr->Size;
+        while ( lo < hi )
+        {
+            mid = ( lo + hi ) / 2;
+            if ( Level_ptr->Key[mid].item_start <= Query_ptr->ptr )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        Query_ptr->nKeys = lo;
+
+        Search_Region_Level( Level_ptr, Query_ptr, 1, 0, Level_ptr->Leaves );
+        if ( Query_ptr->found >= 0 )
+        {
+            return Query_ptr->found;
+        }
+    }
+
+    /* Search Forward? */
+    if ( Query_ptr->step == FORWARD )
+    { /* Yes */
+        for ( i = Query_ptr->idx > Index_ptr->Size ? Query_ptr->idx : Index_ptr->Size; i < ParseTbl_ptr->Size; i++ )
+        {
+            if ( Region_Matches( &ParseTbl_ptr->Data[i], Query_ptr->ptr,
+                                 Query_ptr->item_class, Query_ptr->item_spec ) )
+            {
+                return i;
+            }
+        }
+    }
+
+    return -1; /* not found*/
+}
+
 /*-------------------------------------------------------------------*
  * Find_Region
  *-------------------------------------------------------------------*/
@@ -1201,6 +1490,7 @@ static int Find_Region(
 {
     int i, size;
     Parse_Rec_def *ParseRec_ptr;
+    Region_Query_def Query;
 
     /* Get Table Size */
     size = ParseTbl_ptr->Size;
@@ -1217,6 +1507,19 @@ static int Find_Region(
         Item_Type item_class = item_spec & ITEM_CLASS;
         item_spec -= item_class;
 
+        /* Location Specified and Start Index Valid? */
+        if ( ptr != NULL && (unsigned int) idx < (unsigned int) size )
+        { /* Yes */
+            /* Use the Region Index */
+            Query.ParseTbl_ptr = ParseTbl_ptr;
+            Query.ptr = ptr;
+            Query.item_class = item_class;
+            Query.item_spec = item_spec;
+            Query.idx = idx;
+            Query.step = step;
+            return Find_Indexed_Region( &Query );
+        }
+
         /* Start at Entry 'idx' */
         ParseRec_ptr = &ParseTbl_ptr->Data[idx];
         /* Go through the Parse Table */
@@ -1228,14 +1531,10 @@ static int Find_Region(
         for ( i = idx; (unsigned int) i < (unsigned int) size; i += step )
         {
             /* Region Matches Specification? */
-            if ( ParseRec_ptr->item_type & item_class && ( ParseRec_ptr->item_type & item_spec ) == item_spec )
+            if ( Region_Matches( ParseRec_ptr, ptr, item_class, item_spec ) )
             { /* Yes */
-                /* In a Region? */
-                if ( (ParseRec_ptr->item_start <= ptr && ptr < ParseRec_ptr->item_end) || ptr == NULL )
-                { /* Yes */
-                    /* Done */
-                    return i;
-                }
+                /* Done */
+                return i;
             }
             /* Next Parse Table Record */
             ParseRec_ptr += step;
@@ -6204,6 +6503,7 @@ void Free_Parse_Table_Memory(
         /* Mark as Free */
         ParseTbl_ptr->MaxSize = 0;
     }
+    Free_Region_Index( ParseTbl_ptr );
 }
 
 /*-------------------------------------------------------------------*
@@ -6292,6 +6592,7 @@ TOOL_ERROR Setup_Regions(
 
     /* Erase Parse Table */
     ParseCtx_ptr->ParseTbl.Size = 0;
+    Free_Region_Index( &ParseCtx_ptr->ParseTbl );
 
     /* Check for Invalid Chars */
     while ( ptr != end )
@@ -7108,6 +7409,8 @@ TOOL_ERROR DesInstrument(
             /* Adjust Locations */
             ParseRec_ptr->item_start = start;
             ParseRec_ptr->item_end = tmp;
+            /* Region Index is now Stale */
+            Free_Region_Index( ParseTbl_ptr );
             /* Item will Stay Instrumentation */
             ParseRec_ptr->item_type ^= ITEM_INSTRUMENTATION;
         }
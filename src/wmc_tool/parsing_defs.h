@@ -239,9 +239,35 @@ typedef struct
 
 typedef struct
 {
-    int Size;            /* # of Entries of the Parsing Table */
-    Parse_Rec_def *Data; /* Pointer to the Record Table */
-    int MaxSize;         /* # of Allocated Entries (can be > than Size) */
+    char *item_start; /* Region Start Location */
+    char *item_end;   /* Region End Location */
+    int entry;        /* Parse Table Entry # */
+} Region_Key_def;
+
+typedef struct
+{
+    int Base;            /* 1st Parse Table Entry Covered */
+    int Size;            /* # of Parse Table Entries Covered */
+    int Leaves;          /* # of Leaves of the 'MaxEnd' Tree (Power of 2) */
+    Region_Key_def *Key; /* Covered Entries Sorted by Start Location */
+    char **MaxEnd;       /* Binary Tree of the Largest End Locations */
+} Region_Lvl_def;
+
+#define REGION_IDX_MAX_LEVELS 32
+
+typedef struct
+{
+    int nLevels; /* # of Levels in Use */
+    int Size;    /* # of Parse Table Entries Covered by the Levels */
+    Region_Lvl_def Level[REGION_IDX_MAX_LEVELS];
+} Region_Idx_def;
+
+typedef struct
+{
+    int Size;             /* # of Entries of the Parsing Table */
+    Parse_Rec_def *Data;  /* Pointer to the Record Table */
+    int MaxSize;          /* # of Allocated Entries (can be > than Size) */
+    Region_Idx_def Index; /* Location Index of the Entries (see Find_Region) */
 } Parse_Tbl_def;
 
 typedef struct
@@ -40,6 +40,7 @@
 #define MAX_CHAR    64
 #define MAX_STACK   64
 #define DOUBLE_MAX  0x80000000
+#define MAX_HASH    ( 2 * MAX_RECORDS ) /* size of the label hash table (power of 2) */
 
 struct wmops_record
 {
@@ -47,6 +48,8 @@ struct wmops_record
     long call_number;
     long update_cnt;
     int call_tree[MAX_RECORDS];
+    int call_tree_size;
+    unsigned int call_tree_flag[( MAX_RECORDS + 31 ) / 32]; /* set of the records in call_tree[] */
     double start_selfcnt;
     double current_selfcnt;
     double max_selfcnt;
@@ -70,6 +73,7 @@ double prom_cnt;
 double inst_cnt[NUM_INST];
 
 static struct wmops_record wmops[MAX_RECORDS];
+static int wmops_hash[MAX_HASH]; /* record index by label (open addressing), -1 if empty */
 static int stack[MAX_STACK];
 static int sptr;
 static int num_records;
@@ -97,6 +101,8 @@ void reset_wmops( void )
         {
             wmops[i].call_tree[j] = -1;
         }
+        wmops[i].call_tree_size = 0;
+        memset( wmops[i].call_tree_flag, 0, sizeof( wmops[i].call_tree_flag ) );
         wmops[i].start_selfcnt = 0.0;
         wmops[i].current_selfcnt = 0.0;
         wmops[i].max_selfcnt = 0.0;
@@ -114,6 +120,11 @@ void reset_wmops( void )
 #endif
     }
 
+    for ( i = 0; i < MAX_HASH; i++ )
+    {
+        wmops_hash[i] = -1;
+    }
+
     for ( i = 0; i < MAX_STACK; i++ )
     {
         stack[i] = -1;
@@ -130,32 +141,44 @@ void reset_wmops( void )
 }
 
 
+static unsigned int hash_label( const char *label )
+{
+    unsigned int h = 2166136261u; /* FNV-1a */
+
+    while ( *label != '\0' )
+    {
+        h ^= (unsigned char) *label++;
+        h *= 16777619u;
+    }
+
+    return h & ( MAX_HASH - 1 );
+}
+
 void push_wmops( const char *label )
 {
-    int new_flag;
-    int i, j;
+    unsigned int h;
+    int i;
 
-    /* Check if new function record label */
-    new_flag = 1;
-    for ( i = 0; i < num_records; i++ )
+    /* Look up the function record label */
+    for ( h = hash_label( label ); ( i = wmops_hash[h] ) >= 0; h = ( h + 1 ) & ( MAX_HASH - 1 ) )
     {
         if ( strcmp( wmops[i].label, label ) == 0 )
         {
-            new_flag = 0;
             break;
         }
     }
 
     /* Configure new record */
-    if ( new_flag )
+    if ( i < 0 )
     {
         if ( num_records >= MAX_RECORDS )
         {
             fprintf( stdout, "push_wmops(): exceeded MAX_RECORDS count.\n\n" );
             exit( -1 );
         }
+        i = num_records++;
         strcpy( wmops[i].label, label );
-        num_records++;
+        wmops_hash[h] = i;
     }
 
     /* Push current context onto stack */
@@ -172,17 +195,10 @@ void push_wmops( const char *label )
         wmops[current_record].current_selfcnt += ops_cnt - wmops[current_record].start_selfcnt;
 
         /* update call tree */
-        for ( j = 0; j < MAX_RECORDS; j++ )
+        if ( ( wmops[i].call_tree_flag[current_record / 32] & ( 1u << ( current_record % 32 ) ) ) == 0 )
         {
-            if ( wmops[i].call_tree[j] == current_record )
-            {
-                break;
-            }
-            else if ( wmops[i].call_tree[j] == -1 )
-            {
-                wmops[i].call_tree[j] = current_record;
-                break;
-            }
+            wmops[i].call_tree_flag[current_record / 32] |= 1u << ( current_record % 32 );
+            wmops[i].call_tree[wmops[i].call_tree_size++] = current_record;
         }
     }
 
@@ -532,8 +548,9 @@ void print_wmops( void )
 #define MAX_RECORDABLE_CALLS         100
 #define MAX_FUNCTION_NAME_LENGTH     35  /* Maximum length that the function string will be truncated to */
 #define MAX_PARAMS_LENGTH            50  /* Maximum length that the parameter string will be truncated to */
-#define MAX_NUM_RECORDS              300 /* Initial maximum number of memory records -> mightb be increased during runtime, if needed */
-#define MAX_NUM_RECORDS_REALLOC_STEP 50  /* When re-allocating the list of memory records, increase the number of records by this number */
+#define MAX_NUM_RECORDS              300 /* Initial maximum number of memory records -> doubled during runtime, if needed */
+#define MIN_FREE_RECORDS             8   /* Initial size of the list of free memory records with the same hash */
+#define MIN_HASH_TABLE_SIZE          512 /* Initial size of the hash tables of memory records (power of 2) */
 
 /* This is the value (in bytes) towards which the block size is rounded. For example, a block of 123 bytes, when using
    a 32 bits system, will end up taking 124 bytes since the last unused byte cannot be used for another block. */
@@ -576,8 +593,23 @@ typedef struct
     int frame_allocated;            /* Frame number in which the Memory Block has been allocated (-1 if not allocated at the moment) */
     int OOB_Flag;
     int noccurances; /* Number of times that the memory block has been allocated in a frame */
+    int list_pos[2]; /* Position in the current intra-frame [0] and inter-frame [1] heap lists (-1 if not listed) */
 } allocator_record;
 
+typedef struct
+{
+    unsigned long hash;
+    int *records; /* Min-heap of the indices of the records with this hash that may be free */
+    int n_records;
+    int max_records; /* 0 for an unused hash table entry */
+} free_record_list;
+
+typedef struct
+{
+    void *block_ptr; /* NULL for an unused hash table entry */
+    int index_record;
+} block_record_map;
+
 allocator_record *allocation_list = NULL;
 
 static int16_t *ptr_base_stack = 0;    /* Pointer to the bottom of stack (base pointer). Stack grows up. */
@@ -593,13 +625,22 @@ static size_t Stat_Cnt_Size = USE_BYTES;
 static const char *Count_Unit[] = { "bytes", "words", "words" };
 
 static int *list_wc_intra_frame_heap, n_items_wc_intra_frame_heap, max_items_wc_intra_frame_heap, size_wc_intra_frame_heap, location_wc_intra_frame_heap;
-static int *list_current_inter_frame_heap, n_items_current_inter_frame_heap, max_items_current_inter_frame_heap, size_current_inter_frame_heap;
+static int *list_current_inter_frame_heap, n_items_current_inter_frame_heap, max_items_current_inter_frame_heap, size_current_inter_frame_heap, n_holes_current_inter_frame_heap;
 static int *list_wc_inter_frame_heap, n_items_wc_inter_frame_heap, max_items_wc_inter_frame_heap, size_wc_inter_frame_heap, location_wc_inter_frame_heap;
 
+static free_record_list *free_record_table = NULL; /* Free records by hash (open addressing) */
+static int free_record_table_size = 0, free_record_table_count = 0;
+static block_record_map *block_record_table = NULL; /* Records by allocated memory block (open addressing) */
+static int block_record_table_size = 0, block_record_table_count = 0;
+
 /* Local Functions */
 static unsigned long malloc_hash( const char *func_name, int func_lineno, char *size_str );
 allocator_record *get_mem_record( unsigned long *hash, const char *func_name, int func_lineno, char *size_str, int *index_record );
 static void *mem_alloc_block( size_t size, const char *size_str );
+static void release_mem_record( int index_record );
+static void map_block_record( void *block_ptr, int index_record );
+static int unmap_block_record( void *block_ptr );
+static void free_mem_record_tables( void );
 
 /*-------------------------------------------------------------------*
  * reset_mem()
@@ -674,6 +715,7 @@ void reset_mem( Counting_Size cnt_size )
         memset( list_current_inter_frame_heap, -1, max_items_current_inter_frame_heap * sizeof( int ) );
     }
     n_items_current_inter_frame_heap = 0;
+    n_holes_current_inter_frame_heap = 0;
     size_current_inter_frame_heap = 0;
 
     /* wc inter-frame heap */
@@ -687,6 +729,9 @@ void reset_mem( Counting_Size cnt_size )
     size_wc_inter_frame_heap = 0;
     location_wc_inter_frame_heap = -1;
 
+    /* hash tables of memory records */
+    free_mem_record_tables();
+
     return;
 }
 
@@ -902,18 +947,7 @@ void *mem_alloc(
     }
 
     /* Search for an existing record (that has been de-allocated before) */
-    index_record = 0;
-    while ( ( ptr_record = get_mem_record( &hash, func_name, func_lineno, size_str, &index_record ) ) != NULL )
-    {
-        if ( ptr_record->frame_allocated == -1 )
-        {
-            break;
-        }
-        else
-        {
-            index_record++;
-        }
-    }
+    ptr_record = get_mem_record( &hash, func_name, func_lineno, size_str, &index_record );
 
     /* Create new record */
     if ( ptr_record == NULL )
@@ -921,7 +955,7 @@ void *mem_alloc(
         if ( Num_Records >= Max_Num_Records )
         {
             /* There is no room for a new record -> reallocate memory */
-            Max_Num_Records += MAX_NUM_RECORDS_REALLOC_STEP;
+            Max_Num_Records *= 2;
             allocation_list = realloc( allocation_list, Max_Num_Records * sizeof( allocator_record ) );
         }
 
@@ -936,6 +970,8 @@ void *mem_alloc(
         ptr_record->OOB_Flag = 0;
         ptr_record->wc_heap_size_intra_frame = -1;
         ptr_record->wc_heap_size_inter_frame = -1;
+        ptr_record->list_pos[0] = -1;
+        ptr_record->list_pos[1] = -1;
 
         index_record = Num_Records;
         Num_Records++;
@@ -949,6 +985,7 @@ void *mem_alloc(
         fprintf( stderr, "Fct=%s, Ln=%i: %s!\n", func_name, func_lineno, "Error: Cannot Allocate Memory!" );
         exit( -1 );
     }
+    map_block_record( ptr_record->block_ptr, index_record );
 
     /* Save all auxiliary information about the memory block */
     strncpy( ptr_record->name, func_name, MAX_FUNCTION_NAME_LENGTH );
@@ -988,7 +1025,7 @@ void *mem_alloc(
     /* check, if the maximum size of the call tree has been reached -> resize if so */
     if ( heap_allocation_call_tree_size >= heap_allocation_call_tree_max_size )
     {
-        heap_allocation_call_tree_max_size += MAX_NUM_RECORDS_REALLOC_STEP;
+        heap_allocation_call_tree_max_size *= 2;
         heap_allocation_call_tree = (int *) realloc( heap_allocation_call_tree, heap_allocation_call_tree_max_size * sizeof( int ) );
     }
 
@@ -1217,31 +1254,160 @@ static unsigned long malloc_hash( const char *func_name, int func_lineno, char *
 }
 
 /*-------------------------------------------------------------------*
- * get_mem_record()
+ * get_free_record_list()
  *
- * Search for memory record in the internal list, return NULL if not found
- * Start from index_record
+ * Find the list of free memory records with the given hash in the hash table, create it if requested
+ * Return NULL if not found
  *--------------------------------------------------------------------*/
 
-allocator_record *get_mem_record( unsigned long *hash, const char *func_name, int func_lineno, char *size_str, int *index_record )
+static free_record_list *get_free_record_list( unsigned long hash, int create )
 {
-    int i;
+    int i, j, size;
+    free_record_list *table;
 
-    if ( *index_record < 0 || *index_record > Num_Records )
+    /* check, if the hash table is more than half full -> resize if so */
+    if ( create && 2 * ( free_record_table_count + 1 ) > free_record_table_size )
+    {
+        size = free_record_table_size == 0 ? MIN_HASH_TABLE_SIZE : 2 * free_record_table_size;
+        table = (free_record_list *) calloc( size, sizeof( free_record_list ) );
+        if ( table == NULL )
+        {
+            fprintf( stderr, "Error: Unable to Create Hash Table of Memory Records!" );
+            exit( -1 );
+        }
+        for ( i = 0; i < free_record_table_size; i++ )
+        {
+            if ( free_record_table[i].max_records != 0 )
+            {
+                for ( j = free_record_table[i].hash & ( size - 1 ); table[j].max_records != 0; j = ( j + 1 ) & ( size - 1 ) )
+                    ;
+                table[j] = free_record_table[i];
+            }
+        }
+        free( free_record_table );
+        free_record_table = table;
+        free_record_table_size = size;
+    }
+
+    if ( free_record_table_size == 0 )
     {
         return NULL;
     }
 
+    /* linear probing */
+    for ( i = hash & ( free_record_table_size - 1 ); free_record_table[i].max_records != 0; i = ( i + 1 ) & ( free_record_table_size - 1 ) )
+    {
+        if ( free_record_table[i].hash == hash )
+        {
+            return &( free_record_table[i] );
+        }
+    }
+
+    if ( !create )
+    {
+        return NULL;
+    }
+
+    /* new list */
+    free_record_table[i].hash = hash;
+    free_record_table[i].records = (int *) malloc( MIN_FREE_RECORDS * sizeof( int ) );
+    if ( free_record_table[i].records == NULL )
+    {
+        fprintf( stderr, "Error: Unable to Create List of Free Memory Records!" );
+        exit( -1 );
+    }
+    free_record_table[i].n_records = 0;
+    free_record_table[i].max_records = MIN_FREE_RECORDS;
+    free_record_table_count++;
+
+    return &( free_record_table[i] );
+}
+
+
+/*-------------------------------------------------------------------*
+ * release_mem_record()
+ *
+ * Make a de-allocated memory record available for reuse in mem_alloc()
+ * The free records with the same hash are kept in a min-heap, so that the one with the lowest index is reused first
+ *--------------------------------------------------------------------*/
+
+static void release_mem_record( int index_record )
+{
+    int i, parent;
+    free_record_list *list_ptr;
+
+    /* check, if the record is free */
+    if ( allocation_list[index_record].block_ptr != NULL || allocation_list[index_record].frame_allocated != -1 )
+    {
+        return;
+    }
+
+    list_ptr = get_free_record_list( allocation_list[index_record].hash, 1 );
+
+    /* check, if the maximum size of the list has been reached -> resize if so */
+    if ( list_ptr->n_records >= list_ptr->max_records )
+    {
+        list_ptr->max_records *= 2;
+        list_ptr->records = (int *) realloc( list_ptr->records, list_ptr->max_records * sizeof( int ) );
+    }
+
+    /* push to heap */
+    for ( i = list_ptr->n_records++; i > 0; i = parent )
+    {
+        parent = ( i - 1 ) / 2;
+        if ( list_ptr->records[parent] <= index_record )
+        {
+            break;
+        }
+        list_ptr->records[i] = list_ptr->records[parent];
+    }
+    list_ptr->records[i] = index_record;
+
+    return;
+}
+
+
+/*-------------------------------------------------------------------*
+ * get_mem_record()
+ *
+ * Search for a free memory record (de-allocated in a previous frame) with the same hash, return NULL if not found
+ * The record with the lowest index is returned and removed from the list of free records
+ *--------------------------------------------------------------------*/
+
+allocator_record *get_mem_record( unsigned long *hash, const char *func_name, int func_lineno, char *size_str, int *index_record )
+{
+    int i, child, last;
+    free_record_list *list_ptr;
+
     /* calculate hash */
     *hash = malloc_hash( func_name, func_lineno, size_str );
 
-    for ( i = *index_record; i < Num_Records; i++ )
+    list_ptr = get_free_record_list( *hash, 0 );
+
+    while ( list_ptr != NULL && list_ptr->n_records > 0 )
     {
-        /* check, if memory block is not allocated at the moment and the hash matches */
-        if ( allocation_list[i].block_ptr == NULL && *hash == allocation_list[i].hash )
+        *index_record = list_ptr->records[0];
+
+        /* pop from heap */
+        last = list_ptr->records[--list_ptr->n_records];
+        for ( i = 0; ( child = 2 * i + 1 ) < list_ptr->n_records; i = child )
+        {
+            if ( child + 1 < list_ptr->n_records && list_ptr->records[child + 1] < list_ptr->records[child] )
+            {
+                child++;
+            }
+            if ( last <= list_ptr->records[child] )
+            {
+                break;
+            }
+            list_ptr->records[i] = list_ptr->records[child];
+        }
+        list_ptr->records[i] = last;
+
+        /* check, if memory block is not allocated at the moment (the list may contain records that have been reused since) */
+        if ( allocation_list[*index_record].block_ptr == NULL && allocation_list[*index_record].frame_allocated == -1 )
         {
-            *index_record = i;
-            return &( allocation_list[i] );
+            return &( allocation_list[*index_record] );
         }
     }
 
@@ -1251,6 +1417,132 @@ allocator_record *get_mem_record( unsigned long *hash, const char *func_name, in
 }
 
 
+/*-------------------------------------------------------------------*
+ * map_block_record()
+ *
+ * Add allocated memory block to the hash table of memory records
+ *--------------------------------------------------------------------*/
+
+static unsigned int hash_block_ptr( void *block_ptr, int size )
+{
+    return (unsigned int) ( ( (uintptr_t) block_ptr / BLOCK_ROUNDING ) * 2654435761u ) & ( size - 1 );
+}
+
+static void map_block_record( void *block_ptr, int index_record )
+{
+    int i, j, size;
+    block_record_map *table;
+
+    /* check, if the hash table is more than half full -> resize if so */
+    if ( 2 * ( block_record_table_count + 1 ) > block_record_table_size )
+    {
+        size = block_record_table_size == 0 ? MIN_HASH_TABLE_SIZE : 2 * block_record_table_size;
+        table = (block_record_map *) calloc( size, sizeof( block_record_map ) );
+        if ( table == NULL )
+        {
+            fprintf( stderr, "Error: Unable to Create Hash Table of Memory Blocks!" );
+            exit( -1 );
+        }
+        for ( i = 0; i < block_record_table_size; i++ )
+        {
+            if ( block_record_table[i].block_ptr != NULL )
+            {
+                for ( j = hash_block_ptr( block_record_table[i].block_ptr, size ); table[j].block_ptr != NULL; j = ( j + 1 ) & ( size - 1 ) )
+                    ;
+                table[j] = block_record_table[i];
+            }
+        }
+        free( block_record_table );
+        block_record_table = table;
+        block_record_table_size = size;
+    }
+
+    /* linear probing */
+    for ( i = hash_block_ptr( block_ptr, block_record_table_size ); block_record_table[i].block_ptr != NULL; i = ( i + 1 ) & ( block_record_table_size - 1 ) )
+        ;
+    block_record_table[i].block_ptr = block_ptr;
+    block_record_table[i].index_record = index_record;
+    block_record_table_count++;
+
+    return;
+}
+
+
+/*-------------------------------------------------------------------*
+ * unmap_block_record()
+ *
+ * Remove memory block from the hash table of memory records
+ * Return the index of its record (-1 if not found)
+ *--------------------------------------------------------------------*/
+
+static int unmap_block_record( void *block_ptr )
+{
+    int i, j, k, index_record;
+    int mask = block_record_table_size - 1;
+
+    if ( block_record_table_size == 0 )
+    {
+        return -1;
+    }
+
+    /* linear probing */
+    for ( i = hash_block_ptr( block_ptr, block_record_table_size ); block_record_table[i].block_ptr != block_ptr; i = ( i + 1 ) & mask )
+    {
+        if ( block_record_table[i].block_ptr == NULL )
+        {
+            return -1;
+        }
+    }
+    index_record = block_record_table[i].index_record;
+    block_record_table_count--;
+
+    /* move back the following entries that would not be found anymore */
+    for ( j = ( i + 1 ) & mask; block_record_table[j].block_ptr != NULL; j = ( j + 1 ) & mask )
+    {
+        k = hash_block_ptr( block_record_table[j].block_ptr, block_record_table_size );
+        if ( ( ( j - k ) & mask ) >= ( ( j - i ) & mask ) )
+        {
+            block_record_table[i] = block_record_table[j];
+            i = j;
+        }
+    }
+    block_record_table[i].block_ptr = NULL;
+
+    return index_record;
+}
+
+
+/*-------------------------------------------------------------------*
+ * free_mem_record_tables()
+ *
+ * Empty the hash tables of memory records
+ *--------------------------------------------------------------------*/
+
+static void free_mem_record_tables( void )
+{
+    int i;
+
+    for ( i = 0; i < free_record_table_size; i++ )
+    {
+        if ( free_record_table[i].max_records != 0 )
+        {
+            free( free_record_table[i].records );
+        }
+    }
+    free( free_record_table );
+    free_record_table = NULL;
+    free_record_table_size = 0;
+    free_record_table_count = 0;
+
+    free( block_record_table );
+    block_record_table = NULL;
+    block_record_table_size = 0;
+    block_record_table_count = 0;
+
+    return;
+}
+
+
 /*-------------------------------------------------------------------*
  * mem_free()
  *
@@ -1269,13 +1561,25 @@ void mem_free( const char *func_name, int func_lineno, void *ptr )
     /* Search for the Block Pointer in the List */
     ptr_record = NULL;
     index_record = -1;
-    for ( i = 0; i < Num_Records; i++ )
+    if ( ptr != NULL )
     {
-        if ( ptr == allocation_list[i].block_ptr )
-        { /* Yes, Found it */
-            ptr_record = &( allocation_list[i] );
-            index_record = i;
-            break;
+        index_record = unmap_block_record( ptr );
+        if ( index_record >= 0 )
+        {
+            ptr_record = &( allocation_list[index_record] );
+        }
+    }
+    else
+    {
+        /* NULL pointer matches the first de-allocated block */
+        for ( i = 0; i < Num_Records; i++ )
+        {
+            if ( ptr == allocation_list[i].block_ptr )
+            { /* Yes, Found it */
+                ptr_record = &( allocation_list[i] );
+                index_record = i;
+                break;
+            }
         }
     }
 
@@ -1310,7 +1614,7 @@ void mem_free( const char *func_name, int func_lineno, void *ptr )
     /* check, if the maximum size of the call tree has been reached -> resize if so */
     if ( heap_allocation_call_tree_size >= heap_allocation_call_tree_max_size )
     {
-        heap_allocation_call_tree_max_size += MAX_NUM_RECORDS_REALLOC_STEP;
+        heap_allocation_call_tree_max_size *= 2;
         heap_allocation_call_tree = (int *) realloc( heap_allocation_call_tree, heap_allocation_call_tree_max_size * sizeof( int ) );
     }
 
@@ -1318,11 +1622,87 @@ void mem_free( const char *func_name, int func_lineno, void *ptr )
 
     /* Reset memory block pointer (this is checked when updating wc intra-frame and inter-frame memory) */
     ptr_record->block_ptr = NULL;
+    release_mem_record( index_record );
 
     return;
 }
 
 
+/*-------------------------------------------------------------------*
+ * remove_from_heap_list()
+ *
+ * Remove memory record from the current intra-frame (which = 0) or inter-frame (which = 1) heap list
+ * The entry is replaced by a hole (-1) so that the order of the list is kept, the list is compacted when half of it are holes
+ *--------------------------------------------------------------------*/
+
+static void remove_from_heap_list( int *list, int *n_items, int *n_holes, int which, int i_record )
+{
+    int j, k;
+
+    j = allocation_list[i_record].list_pos[which];
+    if ( j < 0 )
+    {
+        /* not in the list -> the last item is dropped */
+        if ( *n_items == 0 )
+        {
+            return;
+        }
+        j = *n_items - 1;
+    }
+
+    allocation_list[list[j]].list_pos[which] = -1;
+    list[j] = -1;
+    ( *n_holes )++;
+
+    /* remove trailing holes */
+    while ( *n_items > 0 && list[*n_items - 1] == -1 )
+    {
+        ( *n_items )--;
+        ( *n_holes )--;
+    }
+
+    /* compact the list */
+    if ( 2 * *n_holes > *n_items )
+    {
+        for ( j = k = 0; j < *n_items; j++ )
+        {
+            if ( list[j] != -1 )
+            {
+                list[k] = list[j];
+                allocation_list[list[k]].list_pos[which] = k;
+                k++;
+            }
+        }
+        *n_items = k;
+        *n_holes = 0;
+    }
+
+    return;
+}
+
+
+/*-------------------------------------------------------------------*
+ * copy_heap_list()
+ *
+ * Copy the current intra-frame or inter-frame heap list without the holes, return the number of items
+ *--------------------------------------------------------------------*/
+
+static int copy_heap_list( int *wc_list, const int *list, int n_items )
+{
+    int j, k;
+
+    for ( j = k = 0; j < n_items; j++ )
+    {
+        if ( list[j] != -1 )
+        {
+            wc_list[k++] = list[j];
+        }
+    }
+
+    return k;
+}
+
+
 /*-------------------------------------------------------------------*
  * update_mem()
  *
@@ -1331,13 +1711,14 @@ void mem_free( const char *func_name, int func_lineno, void *ptr )
 
 void update_mem( void )
 {
-    int i, j, flag_alloc = -1, i_record;
+    int i, flag_alloc = -1, i_record;
     int32_t size_current_intra_frame_heap;
-    int *list_current_intra_frame_heap = NULL, n_items_current_intra_frame_heap;
+    int *list_current_intra_frame_heap = NULL, n_items_current_intra_frame_heap, n_holes_current_intra_frame_heap;
     allocator_record *ptr_record;
 
     /* process the heap allocation call tree */
     n_items_current_intra_frame_heap = 0;
+    n_holes_current_intra_frame_heap = 0;
     size_current_intra_frame_heap = 0;
     for ( i = 0; i < heap_allocation_call_tree_size; i++ )
     {
@@ -1353,6 +1734,7 @@ void update_mem( void )
             flag_alloc = 0;
             i_record = -i_record;
         }
+
         ptr_record = &( allocation_list[i_record] );
 
         if ( ptr_record->frame_allocated == update_cnt && ptr_record->block_ptr == NULL )
@@ -1364,23 +1746,16 @@ void update_mem( void )
                 memset( list_current_intra_frame_heap, -1, heap_allocation_call_tree_size * sizeof( int ) );
             }
 
-            /* zero index doesn't have sign to determine whether it's  allocated or de-allocated -> we need to search the list */
+            /* zero index doesn't have sign to determine whether it's  allocated or de-allocated -> check if it is in the list */
             if ( i_record == 0 )
             {
-                flag_alloc = 1;
-                for ( j = 0; j < n_items_current_intra_frame_heap; j++ )
-                {
-                    if ( list_current_intra_frame_heap[j] == i_record )
-                    {
-                        flag_alloc = 0;
-                        break;
-                    }
-                }
+                flag_alloc = ptr_record->list_pos[0] < 0;
             }
 
             if ( flag_alloc )
             {
                 /* add to list */
+                ptr_record->list_pos[0] = n_items_current_intra_frame_heap;
                 list_current_intra_frame_heap[n_items_current_intra_frame_heap++] = i_record;
                 size_current_intra_frame_heap += ptr_record->block_size;
 
@@ -1390,13 +1765,12 @@ void update_mem( void )
                     if ( n_items_current_intra_frame_heap >= max_items_wc_intra_frame_heap )
                     {
                         /* resize list, if needed */
-                        max_items_wc_intra_frame_heap = n_items_current_intra_frame_heap + MAX_NUM_RECORDS_REALLOC_STEP;
+                        max_items_wc_intra_frame_heap = 2 * n_items_current_intra_frame_heap;
                         list_wc_intra_frame_heap = realloc( list_wc_intra_frame_heap, max_items_wc_intra_frame_heap * sizeof( int ) );
                     }
 
                     /* save to wc list */
-                    memmove( list_wc_intra_frame_heap, list_current_intra_frame_heap, n_items_current_intra_frame_heap * sizeof( int ) );
-                    n_items_wc_intra_frame_heap = n_items_current_intra_frame_heap;
+                    n_items_wc_intra_frame_heap = copy_heap_list( list_wc_intra_frame_heap, list_current_intra_frame_heap, n_items_current_intra_frame_heap );
                     size_wc_intra_frame_heap = size_current_intra_frame_heap;
                     location_wc_intra_frame_heap = update_cnt;
                     ptr_record->wc_heap_size_intra_frame = ptr_record->block_size;
@@ -1405,38 +1779,23 @@ void update_mem( void )
             else
             {
                 /* remove from list */
-                for ( j = 0; j < n_items_current_intra_frame_heap; j++ )
-                {
-                    if ( list_current_intra_frame_heap[j] == i_record )
-                    {
-                        break;
-                    }
-                }
-                memmove( &list_current_intra_frame_heap[j], &list_current_intra_frame_heap[j + 1], ( n_items_current_intra_frame_heap - j ) * sizeof( int ) );
-                n_items_current_intra_frame_heap--;
+                remove_from_heap_list( list_current_intra_frame_heap, &n_items_current_intra_frame_heap, &n_holes_current_intra_frame_heap, 0, i_record );
                 size_current_intra_frame_heap -= ptr_record->block_size;
 
                 /* reset block size */
                 ptr_record->frame_allocated = -1;
                 ptr_record->block_size = 0;
+                release_mem_record( i_record );
             }
         }
         else
         {
             /* inter-frame heap memory */
 
-            /* zero index doesn't have sign to determine whether it's  allocated or de-allocated -> we need to search the list */
+            /* zero index doesn't have sign to determine whether it's  allocated or de-allocated -> check if it is in the list */
             if ( i_record == 0 )
             {
-                flag_alloc = 1;
-                for ( j = 0; j < n_items_current_inter_frame_heap; j++ )
-                {
-                    if ( list_current_inter_frame_heap[j] == i_record )
-                    {
-                        flag_alloc = 0;
-                        break;
-                    }
-                }
+                flag_alloc = ptr_record->list_pos[1] < 0;
             }
 
             if ( flag_alloc )
@@ -1445,10 +1804,11 @@ void update_mem( void )
                 if ( n_items_current_inter_frame_heap >= max_items_current_inter_frame_heap )
                 {
                     /* resize list, if needed */
-                    max_items_current_inter_frame_heap = n_items_current_inter_frame_heap + MAX_NUM_RECORDS_REALLOC_STEP;
+                    max_items_current_inter_frame_heap = 2 * n_items_current_inter_frame_heap;
                     list_current_inter_frame_heap = realloc( list_current_inter_frame_heap, max_items_current_inter_frame_heap * sizeof( int ) );
                 }
 
+                ptr_record->list_pos[1] = n_items_current_inter_frame_heap;
                 list_current_inter_frame_heap[n_items_current_inter_frame_heap++] = i_record;
                 size_current_inter_frame_heap += ptr_record->block_size;
 
@@ -1458,12 +1818,11 @@ void update_mem( void )
                     if ( n_items_current_inter_frame_heap >= max_items_wc_inter_frame_heap )
                     {
                         /* resize list, if needed */
-                        max_items_wc_inter_frame_heap = n_items_current_inter_frame_heap + MAX_NUM_RECORDS_REALLOC_STEP;
+                        max_items_wc_inter_frame_heap = 2 * n_items_current_inter_frame_heap;
                         list_wc_inter_frame_heap = realloc( list_wc_inter_frame_heap, max_items_wc_inter_frame_heap * sizeof( int ) );
                     }
 
-                    memmove( list_wc_inter_frame_heap, list_current_inter_frame_heap, n_items_current_inter_frame_heap * sizeof( int ) );
-                    n_items_wc_inter_frame_heap = n_items_current_inter_frame_heap;
+                    n_items_wc_inter_frame_heap = copy_heap_list( list_wc_inter_frame_heap, list_current_inter_frame_heap, n_items_current_inter_frame_heap );
                     size_wc_inter_frame_heap = size_current_inter_frame_heap;
                     location_wc_inter_frame_heap = update_cnt;
                     ptr_record->wc_heap_size_inter_frame = ptr_record->block_size;
@@ -1472,20 +1831,13 @@ void update_mem( void )
             else
             {
                 /* remove from list */
-                for ( j = 0; j < n_items_current_inter_frame_heap; j++ )
-                {
-                    if ( list_current_inter_frame_heap[j] == i_record )
-                    {
-                        break;
-                    }
-                }
-                memmove( &list_current_inter_frame_heap[j], &list_current_inter_frame_heap[j + 1], ( n_items_current_inter_frame_heap - j ) * sizeof( int ) );
-                n_items_current_inter_frame_heap--;
+                remove_from_heap_list( list_current_inter_frame_heap, &n_items_current_inter_frame_heap, &n_holes_current_inter_frame_heap, 1, i_record );
                 size_current_inter_frame_heap -= ptr_record->block_size;
 
                 /* reset block size */
                 ptr_record->frame_allocated = -1;
                 ptr_record->block_size = 0;
+                release_mem_record( i_record );
             }
         }
     }
@@ -1495,6 +1847,15 @@ void update_mem( void )
 
     if ( list_current_intra_frame_heap )
     {
+        /* records left in the intra-frame list are not listed anymore */
+        for ( i = 0; i < n_items_current_intra_frame_heap; i++ )
+        {
+            if ( list_current_intra_frame_heap[i] != -1 )
+            {
+                allocation_list[list_current_intra_frame_heap[i]].list_pos[0] = -1;
+            }
+        }
+
         free( list_current_intra_frame_heap );
     }
 
@@ -1879,6 +2240,9 @@ void print_mem( ROM_Size_Lookup_Table Const_Data_PROM_Table[] )
         free( allocation_list );
     }
 
+    /* De-allocate hash tables of memory records */
+    free_mem_record_tables();
+
     /* De-allocate heap allocation call tree */
     if ( heap_allocation_call_tree != NULL )
     {
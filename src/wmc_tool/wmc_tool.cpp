@@ -1105,6 +1105,8 @@ int main( int argc, char *argv[] )
     /* Initialization */
     ParseContext.File.MaxSize = 0;
     ParseContext.ParseTbl.MaxSize = 0;
+    ParseContext.ParseTbl.Index.nLevels = 0;
+    ParseContext.ParseTbl.Index.Size = 0;
     ParseContext.InsertTbl.MaxSize = 0;
     ParseContext.FctCallTbl.MaxSize = 0;
     ParseContext.PointerTbl.MaxSize = 0;
@@ -1346,6 +1348,8 @@ int main( int argc, char *argv[] )
         /* Initialize Context (No Memory Allocated by Default) */
         ParseContext.File.MaxSize = 0;
         ParseContext.ParseTbl.MaxSize = 0;
+        ParseContext.ParseTbl.Index.nLevels = 0;
+        ParseContext.ParseTbl.Index.Size = 0;
         ParseContext.InsertTbl.MaxSize = 0;
         ParseContext.FctCallTbl.MaxSize = 0;
         ParseContext.PointerTbl.MaxSize = 0;